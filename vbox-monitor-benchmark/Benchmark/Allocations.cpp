@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Benchmark/Allocations.hpp"
+#include <atomic>
+#include <new>
+#include <cstdlib>
+
+namespace VBox
+{
+    namespace Benchmark
+    {
+        namespace Allocations
+        {
+            static thread_local bool       Tracking = false;
+            static std::atomic< uint64_t > Count( 0 );
+            
+            void track( bool enabled )
+            {
+                Tracking = enabled;
+            }
+            
+            uint64_t count( void )
+            {
+                return Count.load();
+            }
+            
+            static void * allocate( size_t size )
+            {
+                void * p( std::malloc( ( size == 0 ) ? 1 : size ) );
+                
+                if( p == nullptr )
+                {
+                    throw std::bad_alloc();
+                }
+                
+                if( Tracking )
+                {
+                    Count++;
+                }
+                
+                return p;
+            }
+        }
+    }
+}
+
+void * operator new( size_t size )
+{
+    return VBox::Benchmark::Allocations::allocate( size );
+}
+
+void * operator new[]( size_t size )
+{
+    return VBox::Benchmark::Allocations::allocate( size );
+}
+
+void operator delete( void * p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete[]( void * p ) noexcept
+{
+    std::free( p );
+}
+
+void operator delete( void * p, size_t size ) noexcept
+{
+    ( void )size;
+    
+    std::free( p );
+}
+
+void operator delete[]( void * p, size_t size ) noexcept
+{
+    ( void )size;
+    
+    std::free( p );
+}
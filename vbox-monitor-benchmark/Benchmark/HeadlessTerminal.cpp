@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Benchmark/HeadlessTerminal.hpp"
+#include "VBox/Casts.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <cstdlib>
+#include <cstdio>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+
+namespace VBox
+{
+    namespace Benchmark
+    {
+        class HeadlessTerminal::IMPL
+        {
+            public:
+                
+                IMPL( size_t width, size_t height );
+                ~IMPL( void );
+                
+                void _drain( void );
+                
+                int                 _master;
+                int                 _slave;
+                int                 _stdin;
+                int                 _stdout;
+                std::atomic< bool > _stop;
+                std::thread         _thread;
+        };
+        
+        static const int DrainTimeout = 50;
+        
+        HeadlessTerminal::HeadlessTerminal( size_t width, size_t height ):
+            impl( std::make_unique< IMPL >( width, height ) )
+        {}
+        
+        HeadlessTerminal::~HeadlessTerminal( void )
+        {}
+        
+        void HeadlessTerminal::send( const std::string & keys )
+        {
+            if( write( this->impl->_master, keys.data(), keys.size() ) != numeric_cast< ssize_t >( keys.size() ) )
+            {
+                throw std::runtime_error( "Cannot write to the headless terminal" );
+            }
+        }
+        
+        HeadlessTerminal::IMPL::IMPL( size_t width, size_t height ):
+            _master( posix_openpt( O_RDWR | O_NOCTTY ) ),
+            _slave(  -1 ),
+            _stdin(  -1 ),
+            _stdout( -1 ),
+            _stop(   false )
+        {
+            struct winsize size {};
+            
+            if( this->_master == -1 || grantpt( this->_master ) != 0 || unlockpt( this->_master ) != 0 )
+            {
+                throw std::runtime_error( "Cannot create the headless terminal" );
+            }
+            
+            this->_slave = open( ptsname( this->_master ), O_RDWR | O_NOCTTY );
+            
+            if( this->_slave == -1 )
+            {
+                close( this->_master );
+                
+                throw std::runtime_error( "Cannot create the headless terminal" );
+            }
+            
+            size.ws_col = numeric_cast< unsigned short >( width );
+            size.ws_row = numeric_cast< unsigned short >( height );
+            
+            ioctl( this->_slave, TIOCSWINSZ, &size );
+            setenv( "TERM", "xterm-256color", 1 );
+            
+            fflush( stdout );
+            
+            this->_stdin  = dup( STDIN_FILENO );
+            this->_stdout = dup( STDOUT_FILENO );
+            
+            dup2( this->_slave, STDIN_FILENO );
+            dup2( this->_slave, STDOUT_FILENO );
+            
+            this->_thread = std::thread( [ this ] { this->_drain(); } );
+        }
+        
+        HeadlessTerminal::IMPL::~IMPL( void )
+        {
+            fflush( stdout );
+            
+            dup2( this->_stdin,  STDIN_FILENO );
+            dup2( this->_stdout, STDOUT_FILENO );
+            
+            this->_stop = true;
+            
+            this->_thread.join();
+            
+            close( this->_stdin );
+            close( this->_stdout );
+            close( this->_slave );
+            close( this->_master );
+        }
+        
+        void HeadlessTerminal::IMPL::_drain( void )
+        {
+            char buffer[ 4096 ];
+            
+            while( this->_stop == false )
+            {
+                struct pollfd fd {};
+                
+                fd.fd     = this->_master;
+                fd.events = POLLIN;
+                
+                if( poll( &fd, 1, DrainTimeout ) > 0 && read( this->_master, buffer, sizeof( buffer ) ) <= 0 )
+                {
+                    break;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Benchmark/Suites.hpp"
+#include "Benchmark/HeadlessTerminal.hpp"
+#include "Benchmark/SyntheticBackend.hpp"
+#include "Benchmark/Allocations.hpp"
+#include "VBox/UI.hpp"
+#include "VBox/Screen.hpp"
+#include "VBox/Stats.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace VBox
+{
+    namespace Benchmark
+    {
+        namespace Suites
+        {
+            static const size_t                     TerminalWidth  = 240;
+            static const size_t                     TerminalHeight = 60;
+            static const std::string                Keys           = "ssssffffaaaaddddg";
+            static const std::string                ScrollKeys     = "ssssffffaaaadddd";
+            static const std::string                RedrawKey      = "\x0C";
+            static const std::vector< std::string > PassKeys       = { "p", "v" };
+            static const std::string                AllocationName = "UI::allocations";
+            static const size_t                     SteadyFrames   = 64;
+            static const std::chrono::milliseconds  StartupDelay( 500 );
+            static const std::chrono::milliseconds  KeyInterval( 2 );
+            static const std::chrono::milliseconds  SteadyInterval( 20 );
+            
+            static const std::vector< std::string > Timers =
+            {
+                "Screen::frame",
+                "UI::drawTitle",
+                "UI::drawRegisters",
+                "UI::drawStack",
+                "UI::drawDisassembly",
+                "UI::drawMemory",
+                "UI::drawCPUs"
+            };
+            
+            void rendering( Runner & runner, const SyntheticCore & core, size_t frames )
+            {
+                std::map< std::string, Histogram > histograms;
+                Histogram                          allocations;
+                std::atomic< bool >                steady( false );
+                bool                               tracked( false );
+                uint64_t                           start( 0 );
+                
+                if( std::none_of( Timers.begin(), Timers.end(), [ & ]( const std::string & name ) { return runner.enabled( name ); } ) && runner.enabled( AllocationName ) == false )
+                {
+                    return;
+                }
+                
+                {
+                    HeadlessTerminal terminal( TerminalWidth, TerminalHeight );
+                    UI               ui( std::vector< std::shared_ptr< Manage::Backend > > { std::make_shared< SyntheticBackend >( core ) } );
+                    std::thread      keys
+                    (
+                        [ & ]
+                        {
+                            std::this_thread::sleep_for( StartupDelay );
+                            
+                            for( size_t i = 0; i < frames; i++ )
+                            {
+                                terminal.send( Keys.substr( i % Keys.size(), 1 ) );
+                                std::this_thread::sleep_for( KeyInterval );
+                            }
+                            
+                            histograms = Stats::shared().histograms();
+                            
+                            if( runner.enabled( AllocationName ) )
+                            {
+                                std::cerr << "Running " << AllocationName << "..." << std::endl;
+                                
+                                for( const auto & key: PassKeys )
+                                {
+                                    terminal.send( key );
+                                    
+                                    for( size_t i = 0; i < SteadyFrames * 2; i++ )
+                                    {
+                                        steady = ( i >= SteadyFrames );
+                                        
+                                        terminal.send( ScrollKeys.substr( i % ScrollKeys.size(), 1 ) + RedrawKey );
+                                        std::this_thread::sleep_for( SteadyInterval );
+                                    }
+                                    
+                                    steady = false;
+                                }
+                            }
+                            
+                            terminal.send( "q" );
+                        }
+                    );
+                    
+                    Screen::shared().onKeyPress
+                    (
+                        [ & ]( int key )
+                        {
+                            ( void )key;
+                            
+                            if( steady && tracked == false )
+                            {
+                                tracked = true;
+                                start   = Allocations::count();
+                                
+                                Allocations::track( true );
+                            }
+                        }
+                    );
+                    
+                    Screen::shared().onUpdate
+                    (
+                        [ & ]( void )
+                        {
+                            if( tracked )
+                            {
+                                Allocations::track( false );
+                                allocations.record( Allocations::count() - start );
+                                
+                                tracked = false;
+                            }
+                        }
+                    );
+                    
+                    ui.run();
+                    keys.join();
+                }
+                
+                for( const auto & name: Timers )
+                {
+                    runner.add( name, histograms[ name ] );
+                }
+                
+                if( allocations.max() > 0 )
+                {
+                    throw std::runtime_error( AllocationName + ": " + std::to_string( allocations.sum() ) + " heap allocations in " + std::to_string( allocations.count() ) + " steady-state frames" );
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,151 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Benchmark/Result.hpp"
+#include <cstdio>
+
+namespace VBox
+{
+    namespace Benchmark
+    {
+        Result::Result( void ):
+            _iterations( 0 ),
+            _bytes(      0 ),
+            _elapsed(    0 )
+        {}
+        
+        Result::Result( const std::string & name, uint64_t iterations, uint64_t bytes, std::chrono::nanoseconds elapsed, const Histogram & latencies ):
+            _name(       name ),
+            _iterations( iterations ),
+            _bytes(      bytes ),
+            _elapsed(    elapsed ),
+            _latencies(  latencies )
+        {}
+        
+        Result::Result( const Result & o ):
+            _name(       o._name ),
+            _iterations( o._iterations ),
+            _bytes(      o._bytes ),
+            _elapsed(    o._elapsed ),
+            _latencies(  o._latencies )
+        {}
+        
+        Result::Result( Result && o ) noexcept:
+            _name(       std::move( o._name ) ),
+            _iterations( o._iterations ),
+            _bytes(      o._bytes ),
+            _elapsed(    o._elapsed ),
+            _latencies(  std::move( o._latencies ) )
+        {}
+        
+        Result::~Result( void )
+        {}
+        
+        Result & Result::operator =( Result o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        std::string Result::name( void ) const
+        {
+            return this->_name;
+        }
+        
+        uint64_t Result::iterations( void ) const
+        {
+            return this->_iterations;
+        }
+        
+        uint64_t Result::bytes( void ) const
+        {
+            return this->_bytes;
+        }
+        
+        std::chrono::nanoseconds Result::elapsed( void ) const
+        {
+            return this->_elapsed;
+        }
+        
+        const Histogram & Result::latencies( void ) const
+        {
+            return this->_latencies;
+        }
+        
+        double Result::opsPerSecond( void ) const
+        {
+            if( this->_elapsed.count() <= 0 )
+            {
+                return 0;
+            }
+            
+            return static_cast< double >( this->_iterations ) * 1e9 / static_cast< double >( this->_elapsed.count() );
+        }
+        
+        double Result::bytesPerSecond( void ) const
+        {
+            if( this->_elapsed.count() <= 0 )
+            {
+                return 0;
+            }
+            
+            return static_cast< double >( this->_bytes ) * 1e9 / static_cast< double >( this->_elapsed.count() );
+        }
+        
+        std::string Result::json( void ) const
+        {
+            char buffer[ 512 ];
+            
+            snprintf
+            (
+                buffer,
+                sizeof( buffer ),
+                "{ \"name\": \"%s\", \"iterations\": %llu, \"ops_per_sec\": %.1f, \"bytes_per_sec\": %.1f, \"mean_ns\": %.1f, \"p50_ns\": %llu, \"p90_ns\": %llu, \"p99_ns\": %llu, \"max_ns\": %llu }",
+                this->_name.c_str(),
+                static_cast< unsigned long long >( this->_iterations ),
+                this->opsPerSecond(),
+                this->bytesPerSecond(),
+                this->_latencies.mean(),
+                static_cast< unsigned long long >( this->_latencies.percentile( 50 ) ),
+                static_cast< unsigned long long >( this->_latencies.percentile( 90 ) ),
+                static_cast< unsigned long long >( this->_latencies.percentile( 99 ) ),
+                static_cast< unsigned long long >( this->_latencies.max() )
+            );
+            
+            return buffer;
+        }
+        
+        void swap( Result & o1, Result & o2 )
+        {
+            using std::swap;
+            
+            swap( o1._name,       o2._name );
+            swap( o1._iterations, o2._iterations );
+            swap( o1._bytes,      o2._bytes );
+            swap( o1._elapsed,    o2._elapsed );
+            swap( o1._latencies,  o2._latencies );
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_BENCHMARK_RESULT_HPP
+#define VBOX_BENCHMARK_RESULT_HPP
+
+#include "VBox/Histogram.hpp"
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+namespace VBox
+{
+    namespace Benchmark
+    {
+        class Result
+        {
+            public:
+                
+                Result( void );
+                Result( const std::string & name, uint64_t iterations, uint64_t bytes, std::chrono::nanoseconds elapsed, const Histogram & latencies );
+                Result( const Result & o );
+                Result( Result && o ) noexcept;
+                ~Result( void );
+                
+                Result & operator =( Result o );
+                
+                std::string              name( void )           const;
+                uint64_t                 iterations( void )     const;
+                uint64_t                 bytes( void )          const;
+                std::chrono::nanoseconds elapsed( void )        const;
+                const Histogram        & latencies( void )      const;
+                double                   opsPerSecond( void )   const;
+                double                   bytesPerSecond( void ) const;
+                std::string              json( void )           const;
+                
+                friend void swap( Result & o1, Result & o2 );
+                
+            private:
+                
+                std::string              _name;
+                uint64_t                 _iterations;
+                uint64_t                 _bytes;
+                std::chrono::nanoseconds _elapsed;
+                Histogram                _latencies;
+        };
+    }
+}
+
+#endif /* VBOX_BENCHMARK_RESULT_HPP */
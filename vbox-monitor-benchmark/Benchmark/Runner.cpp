@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Benchmark/Runner.hpp"
+#include <iostream>
+
+namespace VBox
+{
+    namespace Benchmark
+    {
+        class Runner::IMPL
+        {
+            public:
+                
+                IMPL( std::chrono::milliseconds minimum, const std::string & filter );
+                
+                std::chrono::milliseconds _minimum;
+                std::string               _filter;
+                std::vector< Result >     _results;
+        };
+        
+        static const std::chrono::microseconds MinimumBatchDuration( 10 );
+        static const uint64_t                  MaximumBatchSize     = 1 << 20;
+        static const uint64_t                  MinimumBatches       = 10;
+        
+        Runner::Runner( std::chrono::milliseconds minimum, const std::string & filter ):
+            impl( std::make_unique< IMPL >( minimum, filter ) )
+        {}
+        
+        Runner::~Runner( void )
+        {}
+        
+        bool Runner::enabled( const std::string & name ) const
+        {
+            return this->impl->_filter.empty() || name.find( this->impl->_filter ) != std::string::npos;
+        }
+        
+        void Runner::run( const std::string & name, const std::function< uint64_t( void ) > & f )
+        {
+            Histogram                latencies;
+            std::chrono::nanoseconds elapsed( 0 );
+            uint64_t                 batch( 1 );
+            uint64_t                 batches( 0 );
+            uint64_t                 iterations( 0 );
+            uint64_t                 bytes( 0 );
+            
+            if( this->enabled( name ) == false )
+            {
+                return;
+            }
+            
+            std::cerr << "Running " << name << "..." << std::endl;
+            
+            while( batch < MaximumBatchSize )
+            {
+                std::chrono::steady_clock::time_point start( std::chrono::steady_clock::now() );
+                
+                for( uint64_t i = 0; i < batch; i++ )
+                {
+                    f();
+                }
+                
+                if( std::chrono::steady_clock::now() - start >= MinimumBatchDuration )
+                {
+                    break;
+                }
+                
+                batch *= 2;
+            }
+            
+            while( elapsed < this->impl->_minimum || batches < MinimumBatches )
+            {
+                std::chrono::steady_clock::time_point start( std::chrono::steady_clock::now() );
+                std::chrono::nanoseconds              duration;
+                
+                for( uint64_t i = 0; i < batch; i++ )
+                {
+                    bytes += f();
+                }
+                
+                duration = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - start );
+                
+                latencies.record( static_cast< uint64_t >( duration.count() ) / batch );
+                
+                elapsed    += duration;
+                iterations += batch;
+                
+                batches++;
+            }
+            
+            this->impl->_results.emplace_back( name, iterations, bytes, elapsed, latencies );
+        }
+        
+        void Runner::add( const std::string & name, const Histogram & latencies )
+        {
+            if( this->enabled( name ) == false || latencies.count() == 0 )
+            {
+                return;
+            }
+            
+            this->impl->_results.emplace_back( name, latencies.count(), 0, std::chrono::nanoseconds( latencies.sum() ), latencies );
+        }
+        
+        std::vector< Result > Runner::results( void ) const
+        {
+            return this->impl->_results;
+        }
+        
+        std::string Runner::json( void ) const
+        {
+            std::string json( "{\n    \"benchmarks\":\n    [" );
+            
+            for( size_t i = 0; i < this->impl->_results.size(); i++ )
+            {
+                json += ( i == 0 ) ? "\n" : ",\n";
+                json += "        " + this->impl->_results[ i ].json();
+            }
+            
+            json += "\n    ]\n}\n";
+            
+            return json;
+        }
+        
+        Runner::IMPL::IMPL( std::chrono::milliseconds minimum, const std::string & filter ):
+            _minimum( minimum ),
+            _filter(  filter )
+        {}
+    }
+}
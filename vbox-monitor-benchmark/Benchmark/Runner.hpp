@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_BENCHMARK_RUNNER_HPP
+#define VBOX_BENCHMARK_RUNNER_HPP
+
+#include "Benchmark/Result.hpp"
+#include "VBox/Histogram.hpp"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace VBox
+{
+    namespace Benchmark
+    {
+        class Runner
+        {
+            public:
+                
+                Runner( std::chrono::milliseconds minimum, const std::string & filter );
+                Runner( const Runner & o )      = delete;
+                Runner( Runner && o ) noexcept  = delete;
+                Runner & operator =( Runner o ) = delete;
+                ~Runner( void );
+                
+                bool enabled( const std::string & name ) const;
+                
+                void run( const std::string & name, const std::function< uint64_t( void ) > & f );
+                void add( const std::string & name, const Histogram & latencies );
+                
+                std::vector< Result > results( void ) const;
+                std::string           json( void )    const;
+                
+            private:
+                
+                class IMPL;
+                
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_BENCHMARK_RUNNER_HPP */
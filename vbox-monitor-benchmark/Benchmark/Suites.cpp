@@ -0,0 +1,333 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Benchmark/Suites.hpp"
+#include "Benchmark/Transcripts.hpp"
+#include "VBox/Manage.hpp"
+#include "VBox/ELF/File.hpp"
+#include "VBox/BinaryMappedStream.hpp"
+#include "VBox/VM/CoreDump.hpp"
+#include "VBox/VM/MemoryCache.hpp"
+#include "VBox/VM/Snapshot.hpp"
+#include "VBox/VM/Trigger.hpp"
+#include "VBox/VM/TriggerProgram.hpp"
+#include "VBox/Capstone/Disassembler.hpp"
+#include "VBox/String.hpp"
+#include "VBox/Stats.hpp"
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace VBox
+{
+    namespace Benchmark
+    {
+        namespace Suites
+        {
+            static const size_t ReadSize     = 1024 * 1024;
+            static const size_t PageSize     = 4096;
+            static const size_t BlockSize    = 4096;
+            static const size_t HexdumpBytes = 32;
+            static const size_t CacheSize    = 64 * 1024 * 1024;
+            static const size_t DirtyPage    = 0x180;
+            
+            static const std::string PatternTrigger = "find \"vbox-monitor\" in [0x100000, 0x200000)";
+            static const std::string ScanTimer      = "VM::TriggerProgram::scan";
+            static const std::string EvaluateName   = "VM::TriggerProgram::evaluate (1 dirty page)";
+            
+            void parsing( Runner & runner )
+            {
+                std::string registers( Transcripts::registers() );
+                std::string stack( Transcripts::stack( 64 ) );
+                std::string runningVMs( Transcripts::runningVMs( 16 ) );
+                std::string vmInfo( Transcripts::vmInfo( 4 ) );
+                
+                runner.run
+                (
+                    "Manage::Debug::parseRegisters",
+                    [ & ]( void ) -> uint64_t
+                    {
+                        Manage::Debug::parseRegisters( registers );
+                        
+                        return registers.size();
+                    }
+                );
+                
+                runner.run
+                (
+                    "Manage::Debug::parseStack",
+                    [ & ]( void ) -> uint64_t
+                    {
+                        Manage::Debug::parseStack( stack );
+                        
+                        return stack.size();
+                    }
+                );
+                
+                runner.run
+                (
+                    "Manage::parseRunningVMs",
+                    [ & ]( void ) -> uint64_t
+                    {
+                        Manage::parseRunningVMs( runningVMs );
+                        
+                        return runningVMs.size();
+                    }
+                );
+                
+                runner.run
+                (
+                    "Manage::parseCPUCount",
+                    [ & ]( void ) -> uint64_t
+                    {
+                        Manage::parseCPUCount( vmInfo );
+                        
+                        return vmInfo.size();
+                    }
+                );
+            }
+            
+            void coreDump( Runner & runner, const SyntheticCore & core )
+            {
+                runner.run
+                (
+                    "ELF::File",
+                    [ & ]( void ) -> uint64_t
+                    {
+                        BinaryMappedStream stream( core.path() );
+                        ELF::File          elf( stream );
+                        
+                        return elf.programHeader().size();
+                    }
+                );
+                
+                runner.run
+                (
+                    "VM::CoreDump",
+                    [ & ]( void ) -> uint64_t
+                    {
+                        VM::CoreDump dump( core.path() );
+                        
+                        return dump.segments().size();
+                    }
+                );
+                
+                {
+                    VM::CoreDump           dump( core.path() );
+                    std::vector< uint8_t > buffer( ReadSize );
+                    size_t                 offset( 0 );
+                    uint64_t               seed( 0x9E3779B97F4A7C15 );
+                    
+                    runner.run
+                    (
+                        "VM::CoreDump::readMemory (1 MiB sequential)",
+                        [ & ]( void ) -> uint64_t
+                        {
+                            size_t n( dump.readMemory( offset, buffer.data(), ReadSize ) );
+                            
+                            offset = ( offset + ReadSize + ReadSize > dump.memorySize() ) ? 0 : offset + ReadSize;
+                            
+                            return n;
+                        }
+                    );
+                    
+                    runner.run
+                    (
+                        "VM::CoreDump::readMemory (4 KiB random)",
+                        [ & ]( void ) -> uint64_t
+                        {
+                            seed ^= seed << 13;
+                            seed ^= seed >> 7;
+                            seed ^= seed << 17;
+                            
+                            return dump.readMemory( static_cast< size_t >( seed % ( dump.memorySize() / PageSize ) ) * PageSize, buffer.data(), PageSize );
+                        }
+                    );
+                }
+            }
+            
+            void disassembly( Runner & runner, const SyntheticCore & core )
+            {
+                VM::CoreDump           dump( core.path() );
+                std::vector< uint8_t > code( dump.readMemory( core.codeAddress(), core.codeSize() ) );
+                Capstone::Disassembler cold( 0 );
+                Capstone::Disassembler cached;
+                size_t                 offset( 0 );
+                
+                runner.run
+                (
+                    "Capstone::Disassembler::disassemble (4 KiB block)",
+                    [ & ]( void ) -> uint64_t
+                    {
+                        cold.disassemble( code.data() + offset, BlockSize, core.codeAddress() + offset );
+                        
+                        offset = ( offset + BlockSize + BlockSize > code.size() ) ? 0 : offset + 1;
+                        
+                        return BlockSize;
+                    }
+                );
+                
+                runner.run
+                (
+                    "Capstone::Disassembler::disassemble (cached)",
+                    [ & ]( void ) -> uint64_t
+                    {
+                        cached.disassemble( code.data(), BlockSize, core.codeAddress() );
+                        
+                        return BlockSize;
+                    }
+                );
+            }
+            
+            void formatting( Runner & runner )
+            {
+                std::vector< uint8_t > bytes( HexdumpBytes );
+                std::vector< char >    line( HexdumpBytes * 4 + 2 );
+                char                   hex[ 16 ];
+                uint64_t               value( 0 );
+                
+                for( size_t i = 0; i < bytes.size(); i++ )
+                {
+                    bytes[ i ] = static_cast< uint8_t >( i * 7 );
+                }
+                
+                runner.run
+                (
+                    "String::toHex",
+                    [ & ]( void ) -> uint64_t
+                    {
+                        String::toHex( value++, hex );
+                        
+                        return sizeof( uint64_t );
+                    }
+                );
+                
+                runner.run
+                (
+                    "String::toHex (std::string)",
+                    [ & ]( void ) -> uint64_t
+                    {
+                        return String::toHex( value++ ).size();
+                    }
+                );
+                
+                runner.run
+                (
+                    "String::hexdumpLine",
+                    [ & ]( void ) -> uint64_t
+                    {
+                        String::hexdumpLine( bytes.data(), bytes.size(), HexdumpBytes, line.data() );
+                        
+                        return HexdumpBytes;
+                    }
+                );
+            }
+            
+            void triggers( Runner & runner, const SyntheticCore & core )
+            {
+                std::optional< VM::Trigger >       trigger( VM::Trigger::parse( PatternTrigger ) );
+                std::shared_ptr< VM::CoreDump >    dump( std::make_shared< VM::CoreDump >( core.path() ) );
+                std::shared_ptr< VM::MemoryCache > cache( std::make_shared< VM::MemoryCache >( CacheSize ) );
+                VM::Snapshot                       snapshot;
+                std::vector< uint8_t >             page;
+                uint64_t                           scanned;
+                
+                if( runner.enabled( ScanTimer ) == false && runner.enabled( EvaluateName ) == false )
+                {
+                    return;
+                }
+                
+                if( trigger.has_value() == false )
+                {
+                    throw std::runtime_error( "Invalid trigger: " + PatternTrigger );
+                }
+                
+                {
+                    VM::TriggerProgram program( { trigger.value() } );
+                    auto               publish
+                    (
+                        [ & ]( void )
+                        {
+                            snapshot = snapshot.withDump( std::make_shared< VM::CoreDump >( dump->withCache( std::make_shared< VM::MemoryCache >( cache->snapshot() ) ) ) );
+                            
+                            program.evaluate( snapshot );
+                        }
+                    );
+                    auto refresh
+                    (
+                        [ & ]( void )
+                        {
+                            cache->advance();
+                            
+                            for( uint64_t i = trigger->begin() / PageSize; i < trigger->end() / PageSize; i++ )
+                            {
+                                cache->store( i, ( i == DirtyPage ) ? page : dump->readMemory( i * PageSize, PageSize ) );
+                            }
+                        }
+                    );
+                    
+                    page = dump->readMemory( DirtyPage * PageSize, PageSize );
+                    
+                    refresh();
+                    publish();
+                    
+                    scanned    = Stats::shared().histograms()[ ScanTimer ].count();
+                    page[ 0 ] ^= 0xFF;
+                    
+                    refresh();
+                    publish();
+                    
+                    scanned = Stats::shared().histograms()[ ScanTimer ].count() - scanned;
+                    
+                    if( scanned > 2 )
+                    {
+                        throw std::runtime_error( ScanTimer + ": " + std::to_string( scanned ) + " pages rescanned after a single page changed" );
+                    }
+                }
+                
+                {
+                    VM::TriggerProgram program( { trigger.value() } );
+                    
+                    runner.run
+                    (
+                        EvaluateName,
+                        [ & ]( void ) -> uint64_t
+                        {
+                            page[ 0 ] ^= 0xFF;
+                            
+                            cache->advance();
+                            cache->store( DirtyPage, page );
+                            
+                            snapshot = snapshot.withDump( std::make_shared< VM::CoreDump >( dump->withCache( std::make_shared< VM::MemoryCache >( cache->snapshot() ) ) ) );
+                            
+                            program.evaluate( snapshot );
+                            
+                            return PageSize;
+                        }
+                    );
+                }
+            }
+        }
+    }
+}
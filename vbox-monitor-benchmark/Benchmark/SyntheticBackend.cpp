@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Benchmark/SyntheticBackend.hpp"
+#include "VBox/Casts.hpp"
+
+namespace VBox
+{
+    namespace Benchmark
+    {
+        class SyntheticBackend::IMPL
+        {
+            public:
+                
+                IMPL( const SyntheticCore & core );
+                
+                std::string                     _path;
+                std::shared_ptr< VM::CoreDump > _dump;
+                VM::Registers                   _registers;
+                std::vector< VM::StackEntry >   _stack;
+                size_t                          _reads;
+        };
+        
+        static const size_t StackFrames = 16;
+        static const size_t DirtyReads  = 2;
+        
+        SyntheticBackend::SyntheticBackend( const SyntheticCore & core ):
+            impl( std::make_unique< IMPL >( core ) )
+        {}
+        
+        SyntheticBackend::~SyntheticBackend( void )
+        {}
+        
+        std::string SyntheticBackend::name( void ) const
+        {
+            return "Synthetic";
+        }
+        
+        std::string SyntheticBackend::vmName( void ) const
+        {
+            return "benchmark";
+        }
+        
+        bool SyntheticBackend::live( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            ( void )deadline;
+            ( void )cancellation;
+            
+            return true;
+        }
+        
+        std::optional< VM::Registers > SyntheticBackend::registers( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            ( void )deadline;
+            ( void )cancellation;
+            
+            return this->impl->_registers;
+        }
+        
+        std::vector< VM::StackEntry > SyntheticBackend::stack( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            ( void )deadline;
+            ( void )cancellation;
+            
+            return this->impl->_stack;
+        }
+        
+        std::shared_ptr< VM::CoreDump > SyntheticBackend::dump( const std::string & path, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            ( void )path;
+            ( void )deadline;
+            ( void )cancellation;
+            
+            return std::make_shared< VM::CoreDump >( this->impl->_path );
+        }
+        
+        std::optional< std::vector< uint8_t > > SyntheticBackend::readMemory( uint64_t address, size_t size, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::vector< uint8_t > data( size, 0 );
+            
+            ( void )deadline;
+            ( void )cancellation;
+            
+            if( this->impl->_dump->contains( address ) == false )
+            {
+                return {};
+            }
+            
+            data.resize( this->impl->_dump->readMemory( numeric_cast< size_t >( address ), data.data(), size ) );
+            
+            if( this->impl->_reads < DirtyReads && data.empty() == false )
+            {
+                data[ 0 ] ^= numeric_cast< uint8_t >( ++( this->impl->_reads ) );
+            }
+            
+            return data;
+        }
+        
+        SyntheticBackend::IMPL::IMPL( const SyntheticCore & core ):
+            _path(  core.path() ),
+            _dump(  std::make_shared< VM::CoreDump >( core.path() ) ),
+            _reads( 0 )
+        {
+            if( this->_dump->cpus().empty() == false )
+            {
+                this->_registers = this->_dump->cpus().front();
+            }
+            
+            for( size_t i = 0; i < StackFrames; i++ )
+            {
+                VM::StackEntry entry;
+                uint32_t       bp( numeric_cast< uint32_t >( core.codeAddress() + core.codeSize() - 0x100 + i * 0x10 ) );
+                
+                entry.bp(    { 0x10, bp } );
+                entry.retBP( { 0x10, bp + 0x10 } );
+                entry.retIP( { 0x08, numeric_cast< uint32_t >( core.codeAddress() + i * 0x23 ) } );
+                entry.ip(    { 0x08, numeric_cast< uint32_t >( core.codeAddress() + i * 0x17 ) } );
+                
+                this->_stack.push_back( entry );
+            }
+        }
+    }
+}
@@ -0,0 +1,238 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Benchmark/SyntheticCore.hpp"
+#include "VBox/Casts.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include <unistd.h>
+#include <fcntl.h>
+
+namespace VBox
+{
+    namespace Benchmark
+    {
+        class SyntheticCore::IMPL
+        {
+            public:
+                
+                IMPL( uint64_t memorySize, size_t cpus );
+                ~IMPL( void );
+                
+                static void _put( std::vector< uint8_t > & data, size_t offset, uint64_t value, size_t size );
+                
+                void _write( int fd, const std::vector< uint8_t > & data, uint64_t offset );
+                
+                std::string _path;
+                uint64_t    _memorySize;
+                size_t      _segments;
+                uint64_t    _dataOffset;
+        };
+        
+        static const uint64_t SegmentSize     = 256 * 1024 * 1024;
+        static const uint64_t DataAlignment   = 0x10000;
+        static const uint64_t CodeAddress     = 0x1000;
+        static const size_t   CodeSize        = 64 * 1024;
+        static const size_t   HeaderSize      = 64;
+        static const size_t   EntrySize       = 56;
+        static const size_t   CPUNoteSize     = 496;
+        static const size_t   CPUNoteDataSize = 12 + 8 + CPUNoteSize;
+        
+        static const std::vector< uint8_t > CodePattern =
+        {
+            0x55,
+            0x48, 0x89, 0xE5,
+            0x48, 0x83, 0xEC, 0x20,
+            0x89, 0x7D, 0xFC,
+            0x8B, 0x45, 0xFC,
+            0x0F, 0xAF, 0xC0,
+            0x48, 0x8D, 0x05, 0x00, 0x10, 0x00, 0x00,
+            0xE8, 0x00, 0x00, 0x00, 0x00,
+            0x48, 0x83, 0xC4, 0x20,
+            0x5D,
+            0xC3
+        };
+        
+        SyntheticCore::SyntheticCore( uint64_t memorySize, size_t cpus ):
+            impl( std::make_unique< IMPL >( memorySize, cpus ) )
+        {}
+        
+        SyntheticCore::~SyntheticCore( void )
+        {}
+        
+        std::string SyntheticCore::path( void ) const
+        {
+            return this->impl->_path;
+        }
+        
+        uint64_t SyntheticCore::memorySize( void ) const
+        {
+            return this->impl->_memorySize;
+        }
+        
+        size_t SyntheticCore::segments( void ) const
+        {
+            return this->impl->_segments;
+        }
+        
+        uint64_t SyntheticCore::codeAddress( void ) const
+        {
+            return CodeAddress;
+        }
+        
+        size_t SyntheticCore::codeSize( void ) const
+        {
+            return CodeSize;
+        }
+        
+        SyntheticCore::IMPL::IMPL( uint64_t memorySize, size_t cpus ):
+            _memorySize( std::max< uint64_t >( memorySize, CodeAddress + CodeSize ) ),
+            _segments(   numeric_cast< size_t >( ( this->_memorySize + SegmentSize - 1 ) / SegmentSize ) ),
+            _dataOffset( 0 )
+        {
+            std::string            path( "/tmp/vbox-monitor-benchmark-XXXXXX" );
+            int                    fd( mkstemp( &( path[ 0 ] ) ) );
+            std::vector< uint8_t > header( HeaderSize + EntrySize * ( this->_segments + 1 ), 0 );
+            std::vector< uint8_t > notes( CPUNoteDataSize * cpus, 0 );
+            std::vector< uint8_t > code( CodeSize, 0 );
+            uint64_t               notesOffset( header.size() );
+            
+            if( fd == -1 )
+            {
+                throw std::runtime_error( "Cannot create synthetic core dump" );
+            }
+            
+            this->_path       = path;
+            this->_dataOffset = ( notesOffset + notes.size() + DataAlignment - 1 ) & ~( DataAlignment - 1 );
+            
+            header[ 0 ] = 0x7F;
+            header[ 1 ] = 'E';
+            header[ 2 ] = 'L';
+            header[ 3 ] = 'F';
+            header[ 4 ] = 2;
+            header[ 5 ] = 1;
+            header[ 6 ] = 1;
+            
+            _put( header, 16, 4,                    2 );
+            _put( header, 18, 62,                   2 );
+            _put( header, 20, 1,                    4 );
+            _put( header, 32, HeaderSize,           8 );
+            _put( header, 52, HeaderSize,           2 );
+            _put( header, 54, EntrySize,            2 );
+            _put( header, 56, this->_segments + 1,  2 );
+            
+            {
+                size_t entry( HeaderSize );
+                
+                _put( header, entry +  0, 4,            4 );
+                _put( header, entry +  8, notesOffset,  8 );
+                _put( header, entry + 32, notes.size(), 8 );
+                _put( header, entry + 40, notes.size(), 8 );
+                _put( header, entry + 48, 8,            8 );
+            }
+            
+            for( size_t i = 0; i < this->_segments; i++ )
+            {
+                size_t   entry( HeaderSize + EntrySize * ( i + 1 ) );
+                uint64_t address( i * SegmentSize );
+                uint64_t size( std::min( SegmentSize, this->_memorySize - address ) );
+                
+                _put( header, entry +  0, 1,                           4 );
+                _put( header, entry +  4, 7,                           4 );
+                _put( header, entry +  8, this->_dataOffset + address, 8 );
+                _put( header, entry + 16, address,                     8 );
+                _put( header, entry + 24, address,                     8 );
+                _put( header, entry + 32, size,                        8 );
+                _put( header, entry + 40, size,                        8 );
+                _put( header, entry + 48, 0x1000,                      8 );
+            }
+            
+            for( size_t i = 0; i < cpus; i++ )
+            {
+                size_t note( i * CPUNoteDataSize );
+                size_t desc( note + 20 );
+                
+                _put( notes, note + 0, 6,           4 );
+                _put( notes, note + 4, CPUNoteSize, 4 );
+                _put( notes, note + 8, 0x0B00,      4 );
+                
+                std::copy_n( "VBCPU", 6, notes.begin() + numeric_cast< std::ptrdiff_t >( note + 12 ) );
+                
+                _put( notes, desc + 112, CodeAddress + i * CodePattern.size(), 8 );
+                _put( notes, desc + 120, CodeAddress + CodeSize - 0x100,       8 );
+                _put( notes, desc + 128, CodeAddress + CodeSize - 0x80,        8 );
+                _put( notes, desc + 136, 0x202,                                8 );
+                _put( notes, desc + 288, 0x11,                                 8 );
+            }
+            
+            for( size_t i = 0; i < code.size(); i++ )
+            {
+                code[ i ] = CodePattern[ i % CodePattern.size() ];
+            }
+            
+            try
+            {
+                this->_write( fd, header, 0 );
+                this->_write( fd, notes,  notesOffset );
+                this->_write( fd, code,   this->_dataOffset + CodeAddress );
+                
+                if( ftruncate( fd, numeric_cast< off_t >( this->_dataOffset + this->_memorySize ) ) != 0 )
+                {
+                    throw std::runtime_error( "Cannot create synthetic core dump" );
+                }
+            }
+            catch( ... )
+            {
+                close( fd );
+                unlink( this->_path.c_str() );
+                
+                throw;
+            }
+            
+            close( fd );
+        }
+        
+        SyntheticCore::IMPL::~IMPL( void )
+        {
+            unlink( this->_path.c_str() );
+        }
+        
+        void SyntheticCore::IMPL::_put( std::vector< uint8_t > & data, size_t offset, uint64_t value, size_t size )
+        {
+            for( size_t i = 0; i < size; i++ )
+            {
+                data[ offset + i ] = static_cast< uint8_t >( value >> ( i * 8 ) );
+            }
+        }
+        
+        void SyntheticCore::IMPL::_write( int fd, const std::vector< uint8_t > & data, uint64_t offset )
+        {
+            if( pwrite( fd, data.data(), data.size(), numeric_cast< off_t >( offset ) ) != numeric_cast< ssize_t >( data.size() ) )
+            {
+                throw std::runtime_error( "Cannot write synthetic core dump" );
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_BENCHMARK_SYNTHETIC_CORE_HPP
+#define VBOX_BENCHMARK_SYNTHETIC_CORE_HPP
+
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+
+namespace VBox
+{
+    namespace Benchmark
+    {
+        class SyntheticCore
+        {
+            public:
+                
+                SyntheticCore( uint64_t memorySize, size_t cpus );
+                SyntheticCore( const SyntheticCore & o )      = delete;
+                SyntheticCore( SyntheticCore && o ) noexcept  = delete;
+                SyntheticCore & operator =( SyntheticCore o ) = delete;
+                ~SyntheticCore( void );
+                
+                std::string path( void )        const;
+                uint64_t    memorySize( void )  const;
+                size_t      segments( void )    const;
+                uint64_t    codeAddress( void ) const;
+                size_t      codeSize( void )    const;
+                
+            private:
+                
+                class IMPL;
+                
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_BENCHMARK_SYNTHETIC_CORE_HPP */
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Benchmark/Transcripts.hpp"
+#include "VBox/VM/Registers.hpp"
+#include "VBox/String.hpp"
+
+namespace VBox
+{
+    namespace Benchmark
+    {
+        namespace Transcripts
+        {
+            std::string registers( void )
+            {
+                std::string out;
+                uint64_t    value( 0xFFFFF80012345678 );
+                
+                for( const auto & name: VM::Registers::names() )
+                {
+                    out   += name + " = " + String::toHex( value ) + "\n";
+                    value  = value * 6364136223846793005 + 1442695040888963407;
+                }
+                
+                return out;
+            }
+            
+            std::string stack( size_t frames )
+            {
+                std::string out( "SS:EBP            Ret SS:EBP        Ret CS:EIP        Arg0     Arg1     Arg2     Arg3     CS:EIP / Symbol [line]\n" );
+                
+                for( size_t i = 0; i < frames; i++ )
+                {
+                    uint32_t bp( static_cast< uint32_t >( 0x7FF00 - i * 0x40 ) );
+                    
+                    out += "0010:" + String::toHex( bp ).substr( 2 )
+                        +  " 0010:" + String::toHex( bp - 0x40 ).substr( 2 )
+                        +  " 0008:" + String::toHex( static_cast< uint32_t >( 0x1000 + i * 0x23 ) ).substr( 2 )
+                        +  " 00000000 00000001 00000002 00000003"
+                        +  " 0008:" + String::toHex( static_cast< uint32_t >( 0x1000 + i * 0x17 ) ).substr( 2 )
+                        +  "\n";
+                }
+                
+                return out;
+            }
+            
+            std::string runningVMs( size_t count )
+            {
+                std::string out;
+                
+                for( size_t i = 0; i < count; i++ )
+                {
+                    out += "\"vm-" + std::to_string( i ) + "\" {7c9e6679-7425-40de-944b-e07fc1f9" + String::toHex( static_cast< uint16_t >( i ) ).substr( 2 ) + "}\n";
+                }
+                
+                return out;
+            }
+            
+            std::string vmInfo( size_t cpus )
+            {
+                return "name=\"vm-0\"\n"
+                       "groups=\"/\"\n"
+                       "ostype=\"Other/Unknown (64-bit)\"\n"
+                       "UUID=\"7c9e6679-7425-40de-944b-e07fc1f90ae7\"\n"
+                       "CfgFile=\"/Users/Shared/VMs/vm-0/vm-0.vbox\"\n"
+                       "memory=4096\n"
+                       "vram=16\n"
+                       "cpuexecutioncap=100\n"
+                       "hpet=\"off\"\n"
+                       "chipset=\"piix3\"\n"
+                       "firmware=\"BIOS\"\n"
+                       "cpus=" + std::to_string( cpus ) + "\n"
+                       "pae=\"on\"\n"
+                       "longmode=\"on\"\n"
+                       "VMState=\"running\"\n"
+                       "VMStateChangeTime=\"2019-08-01T12:00:00.000000000\"\n";
+            }
+        }
+    }
+}
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "Benchmark/Runner.hpp"
+#include "Benchmark/Suites.hpp"
+#include "Benchmark/SyntheticCore.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+void ShowHelp( void );
+
+static const uint64_t GiB = 1024 * 1024 * 1024;
+static const uint64_t MiB = 1024 * 1024;
+
+int main( int argc, const char * argv[] )
+{
+    std::vector< std::string > args( argv + 1, argv + argc );
+    std::string                filter;
+    uint64_t                   coreSize( 4 );
+    uint64_t                   minimum( 1000 );
+    uint64_t                   frames( 200 );
+    
+    for( size_t i = 0; i < args.size(); i++ )
+    {
+        try
+        {
+            if( args[ i ] == "--help" || args[ i ] == "-h" )
+            {
+                ShowHelp();
+                
+                return EXIT_SUCCESS;
+            }
+            else if( i + 1 == args.size() )
+            {
+                ShowHelp();
+                
+                return EXIT_FAILURE;
+            }
+            else if( args[ i ] == "--filter" )
+            {
+                filter = args[ ++i ];
+            }
+            else if( args[ i ] == "--core-size" )
+            {
+                coreSize = std::stoull( args[ ++i ] );
+            }
+            else if( args[ i ] == "--time" )
+            {
+                minimum = std::stoull( args[ ++i ] );
+            }
+            else if( args[ i ] == "--frames" )
+            {
+                frames = std::stoull( args[ ++i ] );
+            }
+            else
+            {
+                ShowHelp();
+                
+                return EXIT_FAILURE;
+            }
+        }
+        catch( const std::exception & )
+        {
+            ShowHelp();
+            
+            return EXIT_FAILURE;
+        }
+    }
+    
+    try
+    {
+        VBox::Benchmark::Runner        runner( std::chrono::milliseconds( minimum ), filter );
+        VBox::Benchmark::SyntheticCore core( coreSize * GiB, 2 );
+        VBox::Benchmark::SyntheticCore small( 64 * MiB, 2 );
+        
+        VBox::Benchmark::Suites::parsing( runner );
+        VBox::Benchmark::Suites::coreDump( runner, core );
+        VBox::Benchmark::Suites::disassembly( runner, core );
+        VBox::Benchmark::Suites::formatting( runner );
+        VBox::Benchmark::Suites::triggers( runner, small );
+        VBox::Benchmark::Suites::rendering( runner, small, frames );
+        
+        std::cout << runner.json();
+    }
+    catch( const std::exception & e )
+    {
+        std::cerr << e.what() << std::endl;
+        
+        return EXIT_FAILURE;
+    }
+    
+    return EXIT_SUCCESS;
+}
+
+void ShowHelp( void )
+{
+    std::cout << "Usage: vbox-monitor-benchmark [--filter NAME] [--core-size GB] [--time MS] [--frames N]"
+              << std::endl
+              << std::endl
+              << "Options:"
+              << std::endl
+              << "    --filter NAME:    Only run benchmarks whose name contains NAME"
+              << std::endl
+              << "    --core-size GB:   Size of the synthetic core dump (default: 4)"
+              << std::endl
+              << "    --time MS:        Minimum run time of each benchmark (default: 1000)"
+              << std::endl
+              << "    --frames N:       Frames rendered by the UI benchmark (default: 200)"
+              << std::endl
+              << std::endl
+              << "Results are written to stdout as JSON."
+              << std::endl;
+}
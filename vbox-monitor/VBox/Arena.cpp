@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Arena.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace VBox
+{
+    class Arena::IMPL
+    {
+        public:
+            
+            IMPL( size_t capacity );
+            ~IMPL( void );
+            
+            uint8_t * _block( size_t capacity );
+            
+            std::unique_ptr< uint8_t[] >                _buffer;
+            size_t                                      _capacity;
+            size_t                                      _used;
+            std::vector< std::unique_ptr< uint8_t[] > > _overflow;
+            size_t                                      _overflowSize;
+            uint8_t                                   * _cursor;
+            uint8_t                                   * _end;
+    };
+    
+    static const size_t MinimumBlockSize = 4096;
+    
+    Arena::Arena( size_t capacity ):
+        impl( std::make_unique< IMPL >( capacity ) )
+    {}
+    
+    Arena::~Arena( void )
+    {}
+    
+    size_t Arena::capacity( void ) const
+    {
+        return this->impl->_capacity + this->impl->_overflowSize;
+    }
+    
+    size_t Arena::used( void ) const
+    {
+        return this->impl->_used;
+    }
+    
+    void * Arena::allocate( size_t size, size_t alignment )
+    {
+        uintptr_t cursor;
+        uintptr_t aligned;
+        
+        if( alignment == 0 || ( alignment & ( alignment - 1 ) ) != 0 )
+        {
+            throw std::runtime_error( "Invalid arena alignment" );
+        }
+        
+        cursor  = reinterpret_cast< uintptr_t >( this->impl->_cursor );
+        aligned = ( cursor + alignment - 1 ) & ~( static_cast< uintptr_t >( alignment ) - 1 );
+        
+        if( this->impl->_cursor == nullptr || aligned + size > reinterpret_cast< uintptr_t >( this->impl->_end ) )
+        {
+            size_t    capacity( std::max( { MinimumBlockSize, size + alignment, this->capacity() } ) );
+            uint8_t * block( this->impl->_block( capacity ) );
+            
+            this->impl->_overflowSize += capacity;
+            this->impl->_cursor        = block;
+            this->impl->_end           = block + capacity;
+            cursor                     = reinterpret_cast< uintptr_t >( block );
+            aligned                    = ( cursor + alignment - 1 ) & ~( static_cast< uintptr_t >( alignment ) - 1 );
+        }
+        
+        this->impl->_used  += ( aligned - cursor ) + size;
+        this->impl->_cursor = reinterpret_cast< uint8_t * >( aligned + size );
+        
+        return reinterpret_cast< void * >( aligned );
+    }
+    
+    void Arena::reset( void )
+    {
+        if( this->impl->_overflow.empty() == false )
+        {
+            this->impl->_capacity     = this->impl->_capacity + this->impl->_overflowSize;
+            this->impl->_buffer       = std::make_unique< uint8_t[] >( this->impl->_capacity );
+            this->impl->_overflowSize = 0;
+            
+            this->impl->_overflow.clear();
+        }
+        
+        this->impl->_used   = 0;
+        this->impl->_cursor = this->impl->_buffer.get();
+        this->impl->_end    = this->impl->_buffer.get() + this->impl->_capacity;
+    }
+    
+    Arena::IMPL::IMPL( size_t capacity ):
+        _buffer(       ( capacity > 0 ) ? std::make_unique< uint8_t[] >( capacity ) : nullptr ),
+        _capacity(     capacity ),
+        _used(         0 ),
+        _overflowSize( 0 ),
+        _cursor(       _buffer.get() ),
+        _end(          _buffer.get() + capacity )
+    {}
+    
+    Arena::IMPL::~IMPL( void )
+    {}
+    
+    uint8_t * Arena::IMPL::_block( size_t capacity )
+    {
+        this->_overflow.push_back( std::make_unique< uint8_t[] >( capacity ) );
+        
+        return this->_overflow.back().get();
+    }
+}
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_ARENA_HPP
+#define VBOX_ARENA_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <set>
+#include <functional>
+
+namespace VBox
+{
+    class Arena
+    {
+        public:
+            
+            template< typename _T_ >
+            class Allocator
+            {
+                public:
+                    
+                    using value_type = _T_;
+                    
+                    Allocator( Arena & arena ):
+                        _arena( &arena )
+                    {}
+                    
+                    template< typename _U_ >
+                    Allocator( const Allocator< _U_ > & o ):
+                        _arena( o._arena )
+                    {}
+                    
+                    _T_ * allocate( size_t n )
+                    {
+                        return static_cast< _T_ * >( this->_arena->allocate( n * sizeof( _T_ ), alignof( _T_ ) ) );
+                    }
+                    
+                    void deallocate( _T_ * p, size_t n )
+                    {
+                        ( void )p;
+                        ( void )n;
+                    }
+                    
+                    template< typename _U_ >
+                    bool operator ==( const Allocator< _U_ > & o ) const
+                    {
+                        return this->_arena == o._arena;
+                    }
+                    
+                    template< typename _U_ >
+                    bool operator !=( const Allocator< _U_ > & o ) const
+                    {
+                        return this->_arena != o._arena;
+                    }
+                    
+                private:
+                    
+                    template< typename _U_ >
+                    friend class Allocator;
+                    
+                    Arena * _arena;
+            };
+            
+            template< typename _T_ >
+            using Vector = std::vector< _T_, Allocator< _T_ > >;
+            
+            template< typename _T_, typename _C_ = std::less< _T_ > >
+            using Set = std::set< _T_, _C_, Allocator< _T_ > >;
+            
+            Arena( size_t capacity = 0 );
+            Arena( const Arena & o )      = delete;
+            Arena( Arena && o ) noexcept  = delete;
+            Arena & operator =( Arena o ) = delete;
+            ~Arena( void );
+            
+            size_t capacity( void ) const;
+            size_t used( void )     const;
+            
+            void * allocate( size_t size, size_t alignment );
+            void   reset( void );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* VBOX_ARENA_HPP */
@@ -35,10 +35,28 @@ namespace VBox
             IMPL( int argc, const char * argv[] );
             IMPL( const IMPL & o );
             
-            std::vector< std::string > _args;
-            bool                       _showHelp;
-            std::string                _vmName;
-            std::string                _vmPath;
+            std::vector< std::string >   _args;
+            bool                         _showHelp;
+            std::vector< std::string >   _vmNames;
+            std::vector< std::string >   _vmPaths;
+            std::optional< size_t >      _historyCapacity;
+            std::optional< std::string > _recordDirectory;
+            std::optional< std::string > _statsPath;
+            bool                         _headless;
+            std::optional< std::string > _socketPath;
+            std::optional< double >      _rate;
+            std::optional< size_t >      _batch;
+            std::vector< std::string >   _triggers;
+            bool                         _replay;
+            std::vector< std::string >   _tracePaths;
+            std::optional< uint16_t >    _agentPort;
+            std::optional< std::string > _agentAddress;
+            std::optional< std::string > _token;
+            std::optional< std::string > _remoteHost;
+            std::optional< uint16_t >    _remotePort;
+            std::vector< std::string >   _remoteVMs;
+            
+            static std::optional< uint16_t > _port( const std::string & s );
     };
     
     Arguments::Arguments( int argc, const char * argv[] ):
@@ -70,12 +88,102 @@ namespace VBox
     
     std::string Arguments::vmName( void ) const
     {
-        return this->impl->_vmName;
+        return ( this->impl->_vmNames.empty() ) ? "" : this->impl->_vmNames.front();
     }
     
     std::string Arguments::vmPath( void ) const
     {
-        return this->impl->_vmPath;
+        return ( this->impl->_vmPaths.empty() ) ? "" : this->impl->_vmPaths.front();
+    }
+    
+    std::vector< std::string > Arguments::vmNames( void ) const
+    {
+        return this->impl->_vmNames;
+    }
+    
+    std::vector< std::string > Arguments::vmPaths( void ) const
+    {
+        return this->impl->_vmPaths;
+    }
+    
+    std::optional< size_t > Arguments::historyCapacity( void ) const
+    {
+        return this->impl->_historyCapacity;
+    }
+    
+    std::optional< std::string > Arguments::recordDirectory( void ) const
+    {
+        return this->impl->_recordDirectory;
+    }
+    
+    std::optional< std::string > Arguments::statsPath( void ) const
+    {
+        return this->impl->_statsPath;
+    }
+    
+    bool Arguments::headless( void ) const
+    {
+        return this->impl->_headless;
+    }
+    
+    std::optional< std::string > Arguments::socketPath( void ) const
+    {
+        return this->impl->_socketPath;
+    }
+    
+    std::optional< double > Arguments::rate( void ) const
+    {
+        return this->impl->_rate;
+    }
+    
+    std::optional< size_t > Arguments::batch( void ) const
+    {
+        return this->impl->_batch;
+    }
+    
+    std::vector< std::string > Arguments::triggers( void ) const
+    {
+        return this->impl->_triggers;
+    }
+    
+    bool Arguments::replay( void ) const
+    {
+        return this->impl->_replay;
+    }
+    
+    std::vector< std::string > Arguments::tracePaths( void ) const
+    {
+        return this->impl->_tracePaths;
+    }
+    
+    std::optional< uint16_t > Arguments::agentPort( void ) const
+    {
+        return this->impl->_agentPort;
+    }
+    
+    std::optional< std::string > Arguments::agentAddress( void ) const
+    {
+        return this->impl->_agentAddress;
+    }
+    
+    std::optional< std::string > Arguments::token( void ) const
+    {
+        return this->impl->_token;
+    }
+    
+    std::optional< std::string > Arguments::remoteHost( void ) const
+    {
+        return this->impl->_remoteHost;
+    }
+    
+    std::optional< uint16_t > Arguments::remotePort( void ) const
+    {
+        return this->impl->_remotePort;
+    }
+    
+    std::vector< std::string > Arguments::remoteVMs( void ) const
+    {
+        return this->impl->_remoteVMs;
     }
     
     void swap( Arguments & o1, Arguments & o2 )
@@ -86,7 +194,9 @@ namespace VBox
     }
     
     Arguments::IMPL::IMPL( int argc, const char * argv[] ):
-        _showHelp( false )
+        _showHelp( false ),
+        _headless( false ),
+        _replay(   false )
     {
         if( argc < 1 )
         {
@@ -100,27 +210,213 @@ namespace VBox
             this->_args.push_back( argv[ i ] );
         }
         
-        for( const auto & arg: this->_args )
+        for( size_t i = 0; i < this->_args.size(); i++ )
         {
+            const std::string & arg( this->_args[ i ] );
+            
             if( arg == "--help" || arg == "-h" )
             {
                 this->_showHelp = true;
             }
-            else if( this->_vmName.length() == 0 )
+            else if( arg == "--history" )
+            {
+                if( i + 1 == this->_args.size() || this->_args[ i + 1 ].empty() || this->_args[ i + 1 ].length() > 18 || this->_args[ i + 1 ].find_first_not_of( "0123456789" ) != std::string::npos )
+                {
+                    this->_showHelp = true;
+                    
+                    break;
+                }
+                
+                this->_historyCapacity = numeric_cast< size_t >( std::stoull( this->_args[ ++i ] ) );
+            }
+            else if( arg == "--record" )
+            {
+                if( i + 1 == this->_args.size() || this->_args[ i + 1 ].empty() )
+                {
+                    this->_showHelp = true;
+                    
+                    break;
+                }
+                
+                this->_recordDirectory = this->_args[ ++i ];
+            }
+            else if( arg == "--stats" )
+            {
+                if( i + 1 == this->_args.size() || this->_args[ i + 1 ].empty() )
+                {
+                    this->_showHelp = true;
+                    
+                    break;
+                }
+                
+                this->_statsPath = this->_args[ ++i ];
+            }
+            else if( arg == "--headless" )
+            {
+                this->_headless = true;
+            }
+            else if( arg == "--socket" )
+            {
+                if( i + 1 == this->_args.size() || this->_args[ i + 1 ].empty() )
+                {
+                    this->_showHelp = true;
+                    
+                    break;
+                }
+                
+                this->_socketPath = this->_args[ ++i ];
+            }
+            else if( arg == "--rate" )
+            {
+                if( i + 1 == this->_args.size() || this->_args[ i + 1 ].empty() || this->_args[ i + 1 ].length() > 18 || this->_args[ i + 1 ].find_first_not_of( "0123456789." ) != std::string::npos || this->_args[ i + 1 ].find_first_of( "0123456789" ) == std::string::npos || std::stod( this->_args[ i + 1 ] ) <= 0 )
+                {
+                    this->_showHelp = true;
+                    
+                    break;
+                }
+                
+                this->_rate = std::stod( this->_args[ ++i ] );
+            }
+            else if( arg == "--batch" )
+            {
+                if( i + 1 == this->_args.size() || this->_args[ i + 1 ].empty() || this->_args[ i + 1 ].length() > 18 || this->_args[ i + 1 ].find_first_not_of( "0123456789" ) != std::string::npos || std::stoull( this->_args[ i + 1 ] ) == 0 )
+                {
+                    this->_showHelp = true;
+                    
+                    break;
+                }
+                
+                this->_batch = numeric_cast< size_t >( std::stoull( this->_args[ ++i ] ) );
+            }
+            else if( arg == "--trigger" )
+            {
+                if( i + 1 == this->_args.size() || this->_args[ i + 1 ].empty() )
+                {
+                    this->_showHelp = true;
+                    
+                    break;
+                }
+                
+                this->_triggers.push_back( this->_args[ ++i ] );
+            }
+            else if( arg == "--replay" )
+            {
+                this->_replay = true;
+            }
+            else if( arg == "--agent" )
+            {
+                if( i + 1 == this->_args.size() || _port( this->_args[ i + 1 ] ).has_value() == false )
+                {
+                    this->_showHelp = true;
+                    
+                    break;
+                }
+                
+                this->_agentPort = _port( this->_args[ ++i ] );
+            }
+            else if( arg == "--bind" )
+            {
+                if( i + 1 == this->_args.size() || this->_args[ i + 1 ].empty() )
+                {
+                    this->_showHelp = true;
+                    
+                    break;
+                }
+                
+                this->_agentAddress = this->_args[ ++i ];
+            }
+            else if( arg == "--token" )
             {
-                this->_vmName = arg;
+                if( i + 1 == this->_args.size() || this->_args[ i + 1 ].empty() )
+                {
+                    this->_showHelp = true;
+                    
+                    break;
+                }
+                
+                this->_token = this->_args[ ++i ];
             }
-            else if( this->_vmPath.length() == 0 )
+            else if( arg == "--remote" )
             {
-                this->_vmPath = arg;
+                std::string address( ( i + 1 == this->_args.size() ) ? "" : this->_args[ i + 1 ] );
+                size_t      colon( address.rfind( ':' ) );
+                
+                if( address.empty() == false && address.front() == '[' )
+                {
+                    size_t bracket( address.find( ']' ) );
+                    
+                    colon = ( bracket != std::string::npos && bracket + 1 < address.size() && address[ bracket + 1 ] == ':' ) ? bracket + 1 : std::string::npos;
+                    
+                    this->_remoteHost = address.substr( 1, ( bracket == std::string::npos ) ? 0 : bracket - 1 );
+                }
+                else
+                {
+                    this->_remoteHost = address.substr( 0, colon );
+                }
+                
+                if( colon != std::string::npos )
+                {
+                    this->_remotePort = _port( address.substr( colon + 1 ) );
+                }
+                
+                if( this->_remoteHost.value().empty() || ( colon != std::string::npos && this->_remotePort.value_or( 0 ) == 0 ) )
+                {
+                    this->_showHelp = true;
+                    
+                    break;
+                }
+                
+                i++;
+            }
+            else if( this->_replay )
+            {
+                this->_tracePaths.push_back( arg );
+            }
+            else if( this->_remoteHost.has_value() )
+            {
+                this->_remoteVMs.push_back( arg );
+            }
+            else if( this->_vmNames.size() == this->_vmPaths.size() )
+            {
+                this->_vmNames.push_back( arg );
+            }
+            else
+            {
+                this->_vmPaths.push_back( arg );
             }
         }
     }
     
     Arguments::IMPL::IMPL( const IMPL & o ):
-        _args(     o._args ),
-        _showHelp( o._showHelp ),
-        _vmName(   o._vmName ),
-        _vmPath(   o._vmPath )
+        _args(            o._args ),
+        _showHelp(        o._showHelp ),
+        _vmNames(         o._vmNames ),
+        _vmPaths(         o._vmPaths ),
+        _historyCapacity( o._historyCapacity ),
+        _recordDirectory( o._recordDirectory ),
+        _statsPath(       o._statsPath ),
+        _headless(        o._headless ),
+        _socketPath(      o._socketPath ),
+        _rate(            o._rate ),
+        _batch(           o._batch ),
+        _triggers(        o._triggers ),
+        _replay(          o._replay ),
+        _tracePaths(      o._tracePaths ),
+        _agentPort(       o._agentPort ),
+        _agentAddress(    o._agentAddress ),
+        _token(           o._token ),
+        _remoteHost(      o._remoteHost ),
+        _remotePort(      o._remotePort ),
+        _remoteVMs(       o._remoteVMs )
     {}
+    
+    std::optional< uint16_t > Arguments::IMPL::_port( const std::string & s )
+    {
+        if( s.empty() || s.length() > 5 || s.find_first_not_of( "0123456789" ) != std::string::npos || std::stoul( s ) > UINT16_MAX )
+        {
+            return {};
+        }
+        
+        return numeric_cast< uint16_t >( std::stoul( s ) );
+    }
 }
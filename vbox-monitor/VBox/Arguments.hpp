@@ -28,6 +28,8 @@
 #include <memory>
 #include <algorithm>
 #include <string>
+#include <vector>
+#include <optional>
 
 namespace VBox
 {
@@ -42,9 +44,27 @@ namespace VBox
             
             Arguments & operator =( Arguments o );
             
-            bool        showHelp( void ) const;
-            std::string vmName( void )   const;
-            std::string vmPath( void )   const;
+            bool                         showHelp( void )        const;
+            std::string                  vmName( void )          const;
+            std::string                  vmPath( void )          const;
+            std::vector< std::string >   vmNames( void )         const;
+            std::vector< std::string >   vmPaths( void )         const;
+            std::optional< size_t >      historyCapacity( void ) const;
+            std::optional< std::string > recordDirectory( void ) const;
+            std::optional< std::string > statsPath( void )       const;
+            bool                         headless( void )        const;
+            std::optional< std::string > socketPath( void )      const;
+            std::optional< double >      rate( void )            const;
+            std::optional< size_t >      batch( void )           const;
+            std::vector< std::string >   triggers( void )        const;
+            bool                         replay( void )          const;
+            std::vector< std::string >   tracePaths( void )      const;
+            std::optional< uint16_t >    agentPort( void )       const;
+            std::optional< std::string > agentAddress( void )    const;
+            std::optional< std::string > token( void )           const;
+            std::optional< std::string > remoteHost( void )      const;
+            std::optional< uint16_t >    remotePort( void )      const;
+            std::vector< std::string >   remoteVMs( void )       const;
             
             friend void swap( Arguments & o1, Arguments & o2 );
             
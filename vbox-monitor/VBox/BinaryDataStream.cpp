@@ -125,6 +125,11 @@ namespace VBox
         return this->impl->_pos;
     }
     
+    size_t BinaryDataStream::AvailableBytes( void )
+    {
+        return this->impl->_data.size() - this->impl->_pos;
+    }
+    
     BinaryDataStream & BinaryDataStream::operator +=( const BinaryDataStream & stream )
     {
         this->Append( stream );
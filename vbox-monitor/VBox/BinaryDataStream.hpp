@@ -52,6 +52,7 @@ namespace VBox
             void   Read( uint8_t * buf, size_t size )        override;
             void   Seek( ssize_t offset, SeekDirection dir ) override;
             size_t Tell( void )                        const override;
+            size_t AvailableBytes( void )                    override;
             
             BinaryDataStream & operator +=( const BinaryDataStream & stream );
             BinaryDataStream & operator +=( const std::vector< uint8_t > & data );
@@ -103,6 +103,11 @@ namespace VBox
             throw std::runtime_error( "Invalid seek offset" );
         }
         
+        if( pos == this->impl->_pos )
+        {
+            return;
+        }
+        
         this->impl->_pos = pos;
         
         this->impl->_stream.seekg( numeric_cast< std::streamsize >( pos ), std::ios_base::beg );
@@ -118,6 +123,11 @@ namespace VBox
         return this->impl->_pos;
     }
     
+    size_t BinaryFileStream::AvailableBytes( void )
+    {
+        return this->impl->_size - this->impl->_pos;
+    }
+    
     BinaryFileStream::IMPL::IMPL( const std::string & path ):
         _path( path ),
         _size( 0 ),
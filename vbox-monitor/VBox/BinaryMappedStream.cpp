@@ -0,0 +1,275 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cmath>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "VBox/BinaryMappedStream.hpp"
+#include "VBox/Casts.hpp"
+
+namespace VBox
+{
+    class BinaryMappedStream::IMPL
+    {
+        public:
+            
+            IMPL( const std::string & path );
+            IMPL( size_t size );
+            ~IMPL( void );
+            
+            static size_t _chunkSize( void );
+            
+            void _prefetch( size_t offset, size_t end ) const;
+            
+            std::string _path;
+            int         _fd;
+            uint8_t   * _data;
+            size_t      _size;
+            size_t      _pos;
+    };
+    
+    BinaryMappedStream::BinaryMappedStream( const std::string & path ):
+        impl( std::make_unique< IMPL >( path ) )
+    {}
+    
+    BinaryMappedStream::BinaryMappedStream( size_t size ):
+        impl( std::make_unique< IMPL >( size ) )
+    {}
+    
+    BinaryMappedStream::~BinaryMappedStream( void )
+    {}
+    
+    void BinaryMappedStream::Read( uint8_t * buf, size_t size )
+    {
+        if( this->impl->_data == nullptr )
+        {
+            throw std::runtime_error( "Invalid mapped stream" );
+        }
+        
+        if( size > this->impl->_size - this->impl->_pos )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        memcpy( buf, this->impl->_data + this->impl->_pos, size );
+        
+        this->impl->_pos += size;
+    }
+    
+    void BinaryMappedStream::Seek( ssize_t offset, SeekDirection dir )
+    {
+        size_t pos;
+        
+        if( dir == SeekDirection::Begin )
+        {
+            if( offset < 0 )
+            {
+                throw std::runtime_error( "Invalid seek offset" );
+            }
+            
+            pos = numeric_cast< size_t >( offset );
+        }
+        else if( dir == SeekDirection::End )
+        {
+            if( offset > 0 )
+            {
+                throw std::runtime_error( "Invalid seek offset" );
+            }
+            
+            pos = this->impl->_size - numeric_cast< size_t >( abs( offset ) );
+        }
+        else if( offset < 0 )
+        {
+            pos = this->impl->_pos - numeric_cast< size_t >( abs( offset ) );
+        }
+        else
+        {
+            pos = this->impl->_pos + numeric_cast< size_t >( offset );
+        }
+        
+        if( pos > this->impl->_size )
+        {
+            throw std::runtime_error( "Invalid seek offset" );
+        }
+        
+        this->impl->_pos = pos;
+    }
+    
+    size_t BinaryMappedStream::Tell( void ) const
+    {
+        if( this->impl->_data == nullptr )
+        {
+            throw std::runtime_error( "Invalid mapped stream" );
+        }
+        
+        return this->impl->_pos;
+    }
+    
+    size_t BinaryMappedStream::AvailableBytes( void )
+    {
+        return this->impl->_size - this->impl->_pos;
+    }
+    
+    const uint8_t * BinaryMappedStream::Data( void ) const
+    {
+        return this->impl->_data;
+    }
+    
+    size_t BinaryMappedStream::Size( void ) const
+    {
+        return this->impl->_size;
+    }
+    
+    void BinaryMappedStream::Prefetch( size_t offset, size_t size ) const
+    {
+        size_t page( numeric_cast< size_t >( sysconf( _SC_PAGESIZE ) ) );
+        
+        if( this->impl->_data == nullptr || this->impl->_fd == -1 || offset >= this->impl->_size )
+        {
+            return;
+        }
+        
+        size = std::min( size, this->impl->_size - offset );
+        
+        madvise( this->impl->_data + offset - ( offset % page ), size + ( offset % page ), MADV_WILLNEED );
+        
+        this->impl->_prefetch( offset, offset + size );
+    }
+    
+    void BinaryMappedStream::Fill( BinaryStream & source, size_t offset, size_t size )
+    {
+        if( this->impl->_data == nullptr || this->impl->_fd != -1 )
+        {
+            throw std::runtime_error( "Invalid mapped stream" );
+        }
+        
+        if( offset > this->impl->_size || size > this->impl->_size - offset )
+        {
+            throw std::runtime_error( "Invalid write - Not enough space available" );
+        }
+        
+        source.Read( this->impl->_data + offset, size );
+    }
+    
+    BinaryMappedStream::IMPL::IMPL( const std::string & path ):
+        _path( path ),
+        _fd( -1 ),
+        _data( nullptr ),
+        _size( 0 ),
+        _pos( 0 )
+    {
+        struct stat st;
+        
+        this->_fd = open( this->_path.c_str(), O_RDONLY | O_CLOEXEC );
+        
+        if( this->_fd == -1 )
+        {
+            return;
+        }
+        
+        if( fstat( this->_fd, &st ) == 0 && st.st_size > 0 )
+        {
+            void * p( mmap( nullptr, numeric_cast< size_t >( st.st_size ), PROT_READ, MAP_PRIVATE, this->_fd, 0 ) );
+            
+            if( p != MAP_FAILED )
+            {
+                this->_data = static_cast< uint8_t * >( p );
+                this->_size = numeric_cast< size_t >( st.st_size );
+            }
+        }
+    }
+    
+    BinaryMappedStream::IMPL::IMPL( size_t size ):
+        _fd( -1 ),
+        _data( nullptr ),
+        _size( 0 ),
+        _pos( 0 )
+    {
+        void * p( ( size > 0 ) ? mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0 ) : MAP_FAILED );
+        
+        if( p != MAP_FAILED )
+        {
+            this->_data = static_cast< uint8_t * >( p );
+            this->_size = size;
+        }
+    }
+    
+    BinaryMappedStream::IMPL::~IMPL( void )
+    {
+        if( this->_data != nullptr )
+        {
+            munmap( this->_data, this->_size );
+        }
+        
+        if( this->_fd != -1 )
+        {
+            close( this->_fd );
+        }
+    }
+    
+    size_t BinaryMappedStream::IMPL::_chunkSize( void )
+    {
+        return 8 * 1024 * 1024;
+    }
+    
+    void BinaryMappedStream::IMPL::_prefetch( size_t offset, size_t end ) const
+    {
+        void * buffer( nullptr );
+        
+        if( posix_memalign( &buffer, 4096, _chunkSize() ) != 0 )
+        {
+            return;
+        }
+        
+        for( ; offset < end; offset += _chunkSize() )
+        {
+            size_t done( 0 );
+            size_t size( std::min( _chunkSize(), end - offset ) );
+            
+            while( done < size )
+            {
+                ssize_t n( pread( this->_fd, static_cast< uint8_t * >( buffer ) + done, size - done, numeric_cast< off_t >( offset + done ) ) );
+                
+                if( n < 0 && errno == EINTR )
+                {
+                    continue;
+                }
+                
+                if( n <= 0 )
+                {
+                    break;
+                }
+                
+                done += numeric_cast< size_t >( n );
+            }
+        }
+        
+        free( buffer );
+    }
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_BINARY_MAPPED_STREAM_HPP
+#define VBOX_BINARY_MAPPED_STREAM_HPP
+
+#include "VBox/BinaryStream.hpp"
+#include <string>
+#include <cstdint>
+#include <memory>
+#include <algorithm>
+
+namespace VBox
+{
+    class BinaryMappedStream: public BinaryStream
+    {
+        public:
+            
+            BinaryMappedStream( const std::string & path );
+            BinaryMappedStream( size_t size );
+            
+            virtual ~BinaryMappedStream( void );
+            
+            BinaryMappedStream( const BinaryMappedStream & o )              = delete;
+            BinaryMappedStream( BinaryMappedStream && o )                   = delete;
+            BinaryMappedStream & operator =( const BinaryMappedStream & o ) = delete;
+            BinaryMappedStream & operator =( BinaryMappedStream && o )      = delete;
+            
+            using BinaryStream::Read;
+            
+            void   Read( uint8_t * buf, size_t size )        override;
+            void   Seek( ssize_t offset, SeekDirection dir ) override;
+            size_t Tell( void )                        const override;
+            size_t AvailableBytes( void )                    override;
+            
+            const uint8_t * Data( void ) const;
+            size_t          Size( void ) const;
+            
+            void Prefetch( size_t offset, size_t size ) const;
+            void Fill( BinaryStream & source, size_t offset, size_t size );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* VBOX_BINARY_MAPPED_STREAM_HPP */
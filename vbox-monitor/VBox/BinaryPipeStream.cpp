@@ -0,0 +1,176 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cerrno>
+#include <stdexcept>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include "VBox/BinaryPipeStream.hpp"
+#include "VBox/Casts.hpp"
+
+namespace VBox
+{
+    class BinaryPipeStream::IMPL
+    {
+        public:
+            
+            IMPL( int fd, const std::atomic< bool > & closed );
+            
+            void _wait( void ) const;
+            
+            int                         _fd;
+            const std::atomic< bool > & _closed;
+            bool                        _connected;
+            size_t                      _pos;
+    };
+    
+    static const int PollInterval = 10;
+    
+    BinaryPipeStream::BinaryPipeStream( int fd, const std::atomic< bool > & closed ):
+        impl( std::make_unique< IMPL >( fd, closed ) )
+    {}
+    
+    BinaryPipeStream::~BinaryPipeStream( void )
+    {}
+    
+    void BinaryPipeStream::Read( uint8_t * buf, size_t size )
+    {
+        size_t done( 0 );
+        
+        if( this->impl->_fd == -1 )
+        {
+            throw std::runtime_error( "Invalid pipe stream" );
+        }
+        
+        while( done < size )
+        {
+            bool    closed( this->impl->_closed.load() );
+            ssize_t n( read( this->impl->_fd, buf + done, size - done ) );
+            
+            if( n > 0 )
+            {
+                done             += numeric_cast< size_t >( n );
+                this->impl->_pos += numeric_cast< size_t >( n );
+                
+                this->impl->_connected = true;
+                
+                continue;
+            }
+            
+            if( n < 0 && errno == EINTR )
+            {
+                continue;
+            }
+            
+            if( n < 0 && errno != EAGAIN && errno != EWOULDBLOCK )
+            {
+                throw std::runtime_error( "Invalid read - Pipe error" );
+            }
+            
+            if( closed || ( n == 0 && this->impl->_connected ) )
+            {
+                throw std::runtime_error( "Invalid read - Not enough data available" );
+            }
+            
+            this->impl->_wait();
+        }
+    }
+    
+    void BinaryPipeStream::Seek( ssize_t offset, SeekDirection dir )
+    {
+        size_t skip;
+        
+        if( dir == SeekDirection::Begin && offset >= 0 && numeric_cast< size_t >( offset ) >= this->impl->_pos )
+        {
+            skip = numeric_cast< size_t >( offset ) - this->impl->_pos;
+        }
+        else if( dir == SeekDirection::Current && offset >= 0 )
+        {
+            skip = numeric_cast< size_t >( offset );
+        }
+        else
+        {
+            throw std::runtime_error( "Invalid seek offset" );
+        }
+        
+        {
+            std::vector< uint8_t > buffer( std::min< size_t >( skip, 64 * 1024 ) );
+            
+            while( skip > 0 )
+            {
+                size_t n( std::min( skip, buffer.size() ) );
+                
+                this->Read( buffer.data(), n );
+                
+                skip -= n;
+            }
+        }
+    }
+    
+    size_t BinaryPipeStream::Tell( void ) const
+    {
+        return this->impl->_pos;
+    }
+    
+    size_t BinaryPipeStream::AvailableBytes( void )
+    {
+        int n( 0 );
+        
+        if( this->impl->_fd == -1 || ioctl( this->impl->_fd, FIONREAD, &n ) != 0 || n < 0 )
+        {
+            return 0;
+        }
+        
+        return numeric_cast< size_t >( n );
+    }
+    
+    BinaryPipeStream::IMPL::IMPL( int fd, const std::atomic< bool > & closed ):
+        _fd(        fd ),
+        _closed(    closed ),
+        _connected( false ),
+        _pos(       0 )
+    {}
+    
+    void BinaryPipeStream::IMPL::_wait( void ) const
+    {
+        struct pollfd fds;
+        
+        if( this->_connected == false )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( PollInterval ) );
+            
+            return;
+        }
+        
+        fds.fd      = this->_fd;
+        fds.events  = POLLIN;
+        fds.revents = 0;
+        
+        poll( &fds, 1, PollInterval );
+    }
+}
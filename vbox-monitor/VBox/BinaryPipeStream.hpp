@@ -0,0 +1,64 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_BINARY_PIPE_STREAM_HPP
+#define VBOX_BINARY_PIPE_STREAM_HPP
+
+#include "VBox/BinaryStream.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <algorithm>
+
+namespace VBox
+{
+    class BinaryPipeStream: public BinaryStream
+    {
+        public:
+            
+            BinaryPipeStream( int fd, const std::atomic< bool > & closed );
+            
+            virtual ~BinaryPipeStream( void );
+            
+            BinaryPipeStream( const BinaryPipeStream & o )              = delete;
+            BinaryPipeStream( BinaryPipeStream && o )                   = delete;
+            BinaryPipeStream & operator =( const BinaryPipeStream & o ) = delete;
+            BinaryPipeStream & operator =( BinaryPipeStream && o )      = delete;
+            
+            using BinaryStream::Read;
+            
+            void   Read( uint8_t * buf, size_t size )        override;
+            void   Seek( ssize_t offset, SeekDirection dir ) override;
+            size_t Tell( void )                        const override;
+            size_t AvailableBytes( void )                    override;
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* VBOX_BINARY_PIPE_STREAM_HPP */
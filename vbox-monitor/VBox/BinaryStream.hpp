@@ -48,8 +48,9 @@ namespace VBox
             virtual void   Seek( ssize_t offset, SeekDirection dir ) = 0;
             virtual size_t Tell( void )                        const = 0;
             
-            bool   HasBytesAvailable( void );
-            size_t AvailableBytes( void );
+            virtual size_t AvailableBytes( void );
+            
+            bool HasBytesAvailable( void );
             
             void Seek( ssize_t offset );
             
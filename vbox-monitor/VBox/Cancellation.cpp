@@ -0,0 +1,168 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Cancellation.hpp"
+#include "VBox/Descriptors.hpp"
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace VBox
+{
+    class Cancellation::IMPL
+    {
+        public:
+            
+            IMPL( void );
+            ~IMPL( void );
+            
+            void _signal( void );
+            void _drain( void );
+            
+            std::atomic< bool > _cancelled;
+            mutable std::mutex  _mtx;
+            int                 _pipe[ 2 ];
+    };
+    
+    Cancellation::Cancellation( void ):
+        impl( std::make_shared< IMPL >() )
+    {}
+    
+    Cancellation::Cancellation( const Cancellation & o ):
+        impl( o.impl )
+    {}
+    
+    Cancellation::Cancellation( Cancellation && o ):
+        impl( std::move( o.impl ) )
+    {}
+    
+    Cancellation::~Cancellation( void )
+    {}
+    
+    Cancellation & Cancellation::operator =( Cancellation o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    const Cancellation & Cancellation::none( void )
+    {
+        static Cancellation * none( nullptr );
+        static std::once_flag once;
+        
+        std::call_once( once, [ & ]{ none = new Cancellation(); } );
+        
+        return *( none );
+    }
+    
+    bool Cancellation::cancelled( void ) const
+    {
+        return this->impl->_cancelled;
+    }
+    
+    int Cancellation::fd( void ) const
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        if( this->impl->_pipe[ 0 ] == -1 )
+        {
+            if( Descriptors::pipe( this->impl->_pipe, true ) == false )
+            {
+                throw std::runtime_error( "Cannot create pipe" );
+            }
+            
+            if( this->impl->_cancelled )
+            {
+                this->impl->_signal();
+            }
+        }
+        
+        return this->impl->_pipe[ 0 ];
+    }
+    
+    void Cancellation::cancel( void )
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        if( this->impl->_cancelled.exchange( true ) == false )
+        {
+            this->impl->_signal();
+        }
+    }
+    
+    void Cancellation::reset( void )
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        this->impl->_cancelled = false;
+        
+        this->impl->_drain();
+    }
+    
+    void swap( Cancellation & o1, Cancellation & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    Cancellation::IMPL::IMPL( void ):
+        _cancelled( false ),
+        _pipe{ -1, -1 }
+    {}
+    
+    Cancellation::IMPL::~IMPL( void )
+    {
+        for( int fd: this->_pipe )
+        {
+            if( fd != -1 )
+            {
+                close( fd );
+            }
+        }
+    }
+    
+    void Cancellation::IMPL::_signal( void )
+    {
+        char c( 0 );
+        
+        if( this->_pipe[ 1 ] != -1 )
+        {
+            ( void )write( this->_pipe[ 1 ], &c, 1 );
+        }
+    }
+    
+    void Cancellation::IMPL::_drain( void )
+    {
+        char buf[ 64 ];
+        
+        if( this->_pipe[ 0 ] != -1 )
+        {
+            while( read( this->_pipe[ 0 ], buf, sizeof( buf ) ) > 0 )
+            {}
+        }
+    }
+}
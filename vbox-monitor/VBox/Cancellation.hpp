@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_CANCELLATION_HPP
+#define VBOX_CANCELLATION_HPP
+
+#include <memory>
+#include <algorithm>
+
+namespace VBox
+{
+    class Cancellation
+    {
+        public:
+            
+            static const Cancellation & none( void );
+            
+            Cancellation( void );
+            Cancellation( const Cancellation & o );
+            Cancellation( Cancellation && o );
+            ~Cancellation( void );
+            
+            Cancellation & operator =( Cancellation o );
+            
+            bool cancelled( void ) const;
+            int  fd( void )        const;
+            
+            void cancel( void );
+            void reset( void );
+            
+            friend void swap( Cancellation & o1, Cancellation & o2 );
+            
+        private:
+            
+            class IMPL;
+            std::shared_ptr< IMPL > impl;
+    };
+}
+
+#endif /* VBOX_CANCELLATION_HPP */
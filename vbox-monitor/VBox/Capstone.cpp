@@ -33,6 +33,11 @@ namespace VBox
     namespace Capstone
     {
         std::vector< std::pair< std::string, std::string > > disassemble( const std::vector< uint8_t > & data, uint64_t org )
+        {
+            return disassemble( data.data(), data.size(), org );
+        }
+        
+        std::vector< std::pair< std::string, std::string > > disassemble( const uint8_t * data, size_t size, uint64_t org )
         {
             csh       handle;
             cs_insn * instruction;
@@ -40,12 +45,17 @@ namespace VBox
             
             std::vector< std::pair< std::string, std::string > > v;
             
+            if( data == nullptr || size == 0 )
+            {
+                return {};
+            }
+            
             if( cs_open( CS_ARCH_X86, CS_MODE_64, &handle ) != CS_ERR_OK )
             {
                 return {};
             }
             
-            count = cs_disasm( handle, &( data[ 0 ] ), data.size(), org, 0, &instruction );
+            count = cs_disasm( handle, data, size, org, 0, &instruction );
             
             if( count == 0 )
             {
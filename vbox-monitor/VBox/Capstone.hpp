@@ -34,6 +34,7 @@ namespace VBox
     namespace Capstone
     {
         std::vector< std::pair< std::string, std::string > > disassemble( const std::vector< uint8_t > & data, uint64_t org );
+        std::vector< std::pair< std::string, std::string > > disassemble( const uint8_t * data, size_t size, uint64_t org );
     }
 }
 
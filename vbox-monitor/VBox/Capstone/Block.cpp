@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Capstone/Block.hpp"
+
+namespace VBox
+{
+    namespace Capstone
+    {
+        Block::Block( void )
+        {}
+        
+        Block::Block( const Block & o ):
+            _text(         o._text ),
+            _instructions( o._instructions )
+        {
+            this->_rebase( o._text.data() );
+        }
+        
+        Block::Block( Block && o ):
+            _instructions( std::move( o._instructions ) )
+        {
+            const char * from( o._text.data() );
+            
+            this->_text = std::move( o._text );
+            
+            this->_rebase( from );
+        }
+        
+        Block::~Block( void )
+        {}
+        
+        Block & Block::operator =( Block o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        const Instruction & Block::operator []( size_t index ) const
+        {
+            return this->_instructions[ index ];
+        }
+        
+        size_t Block::size( void ) const
+        {
+            return this->_instructions.size();
+        }
+        
+        bool Block::empty( void ) const
+        {
+            return this->_instructions.empty();
+        }
+        
+        size_t Block::find( uint64_t address ) const
+        {
+            for( size_t i = 0; i < this->_instructions.size(); i++ )
+            {
+                if( this->_instructions[ i ].address() == address )
+                {
+                    return i;
+                }
+            }
+            
+            return this->_instructions.size();
+        }
+        
+        std::vector< Instruction >::const_iterator Block::begin( void ) const
+        {
+            return this->_instructions.begin();
+        }
+        
+        std::vector< Instruction >::const_iterator Block::end( void ) const
+        {
+            return this->_instructions.end();
+        }
+        
+        void Block::append( const Instruction & instruction )
+        {
+            const char * from( this->_text.data() );
+            size_t       mnemonic( this->_text.length() );
+            size_t       operands( mnemonic + instruction.mnemonic().length() );
+            
+            this->_text.append( instruction.mnemonic() );
+            this->_text.append( instruction.operands() );
+            
+            if( this->_text.data() != from )
+            {
+                this->_rebase( from );
+            }
+            
+            this->_instructions.push_back
+            (
+                Instruction
+                (
+                    instruction.address(),
+                    instruction.size(),
+                    std::string_view( this->_text.data() + mnemonic, instruction.mnemonic().length() ),
+                    std::string_view( this->_text.data() + operands, instruction.operands().length() )
+                )
+            );
+        }
+        
+        void swap( Block & o1, Block & o2 )
+        {
+            using std::swap;
+            
+            const char * from1( o1._text.data() );
+            const char * from2( o2._text.data() );
+            
+            swap( o1._text,         o2._text );
+            swap( o1._instructions, o2._instructions );
+            
+            o1._rebase( from2 );
+            o2._rebase( from1 );
+        }
+        
+        void Block::_rebase( const char * from )
+        {
+            for( auto & i: this->_instructions )
+            {
+                i = Instruction
+                (
+                    i.address(),
+                    i.size(),
+                    std::string_view( this->_text.data() + ( i.mnemonic().data() - from ), i.mnemonic().length() ),
+                    std::string_view( this->_text.data() + ( i.operands().data() - from ), i.operands().length() )
+                );
+            }
+        }
+    }
+}
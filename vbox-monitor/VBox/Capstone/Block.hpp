@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_CAPSTONE_BLOCK_HPP
+#define VBOX_CAPSTONE_BLOCK_HPP
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "VBox/Capstone/Instruction.hpp"
+
+namespace VBox
+{
+    namespace Capstone
+    {
+        class Block
+        {
+            public:
+                
+                Block( void );
+                Block( const Block & o );
+                Block( Block && o );
+                ~Block( void );
+                
+                Block & operator =( Block o );
+                
+                const Instruction & operator []( size_t index ) const;
+                
+                size_t size( void )  const;
+                bool   empty( void ) const;
+                size_t find( uint64_t address ) const;
+                
+                std::vector< Instruction >::const_iterator begin( void ) const;
+                std::vector< Instruction >::const_iterator end( void )   const;
+                
+                void append( const Instruction & instruction );
+                
+                friend void swap( Block & o1, Block & o2 );
+                
+            private:
+                
+                void _rebase( const char * from );
+                
+                std::string                _text;
+                std::vector< Instruction > _instructions;
+        };
+    }
+}
+
+#endif /* VBOX_CAPSTONE_BLOCK_HPP */
@@ -0,0 +1,341 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Capstone/Disassembler.hpp"
+#include "VBox/Hash.hpp"
+#include <list>
+#include <array>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstring>
+#include <capstone.h>
+
+namespace VBox
+{
+    namespace Capstone
+    {
+        class Disassembler::IMPL
+        {
+            public:
+                
+                typedef std::array< uint64_t, 4 > Key;
+                
+                class Entry
+                {
+                    public:
+                        
+                        Key                             _key;
+                        std::vector< uint8_t >          _bytes;
+                        std::shared_ptr< const Block >  _block;
+                        std::list< uint64_t >::iterator _lru;
+                };
+                
+                IMPL( size_t cacheSize );
+                IMPL( const IMPL & o );
+                ~IMPL( void );
+                
+                static uint64_t _hash( const uint8_t * data, size_t size, const Key & key );
+                
+                void                           _open( void );
+                std::shared_ptr< const Block > _find( const uint8_t * data, size_t size, const Key & key );
+                void                           _store( const uint8_t * data, size_t size, const Key & key, const std::shared_ptr< const Block > & block );
+                
+                csh                                                      _handle;
+                cs_insn                                                * _instruction;
+                size_t                                                   _cacheSize;
+                std::list< uint64_t >                                    _lru;
+                std::unordered_map< uint64_t, std::unique_ptr< Entry > > _cache;
+        };
+        
+        Disassembler::Disassembler( size_t cacheSize ):
+            impl( std::make_unique< IMPL >( cacheSize ) )
+        {}
+        
+        Disassembler::Disassembler( const Disassembler & o ):
+            impl( std::make_unique< IMPL >( *( o.impl ) ) )
+        {}
+        
+        Disassembler::Disassembler( Disassembler && o ):
+            impl( std::move( o.impl ) )
+        {}
+        
+        Disassembler::~Disassembler( void )
+        {}
+        
+        Disassembler & Disassembler::operator =( Disassembler o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        size_t Disassembler::cacheSize( void ) const
+        {
+            return this->impl->_cacheSize;
+        }
+        
+        size_t Disassembler::cached( void ) const
+        {
+            return this->impl->_cache.size();
+        }
+        
+        size_t Disassembler::iterate( const uint8_t * data, size_t size, uint64_t org, size_t maximum, const std::function< bool( const Instruction & ) > & f )
+        {
+            size_t count( 0 );
+            
+            if( data == nullptr )
+            {
+                return 0;
+            }
+            
+            while( maximum == 0 || count < maximum )
+            {
+                if( cs_disasm_iter( this->impl->_handle, &data, &size, &org, this->impl->_instruction ) == false )
+                {
+                    break;
+                }
+                
+                count++;
+                
+                if
+                (
+                    f
+                    (
+                        Instruction
+                        (
+                            this->impl->_instruction->address,
+                            this->impl->_instruction->size,
+                            this->impl->_instruction->mnemonic,
+                            this->impl->_instruction->op_str
+                        )
+                    )
+                    == false
+                )
+                {
+                    break;
+                }
+            }
+            
+            return count;
+        }
+        
+        std::shared_ptr< const Block > Disassembler::disassemble( const uint8_t * data, size_t size, uint64_t org, size_t maximum )
+        {
+            IMPL::Key                      key( { org, UINT64_MAX, 0, maximum } );
+            std::shared_ptr< const Block > cached( this->impl->_find( data, size, key ) );
+            std::shared_ptr< Block >       block;
+            
+            if( cached != nullptr )
+            {
+                return cached;
+            }
+            
+            block = std::make_shared< Block >();
+            
+            this->iterate( data, size, org, maximum, [ & ]( const Instruction & i ) { block->append( i ); return true; } );
+            this->impl->_store( data, size, key, block );
+            
+            return block;
+        }
+        
+        std::shared_ptr< const Block > Disassembler::disassembleAround( const uint8_t * data, size_t size, uint64_t org, uint64_t address, size_t before, size_t after )
+        {
+            IMPL::Key                      key( { org, address, before, after } );
+            std::shared_ptr< const Block > cached( this->impl->_find( data, size, key ) );
+            std::shared_ptr< Block >       block;
+            
+            if( cached != nullptr )
+            {
+                return cached;
+            }
+            
+            block = std::make_shared< Block >();
+            
+            if( data == nullptr || address < org || address - org >= size )
+            {
+                return block;
+            }
+            
+            {
+                size_t offset( static_cast< size_t >( address - org ) );
+                
+                for( size_t start = 0; before > 0 && start < std::min< size_t >( offset, 16 ); start++ )
+                {
+                    bool  synced( false );
+                    Block context;
+                    
+                    this->iterate
+                    (
+                        data   + start,
+                        offset - start,
+                        org    + start,
+                        0,
+                        [ & ]( const Instruction & i )
+                        {
+                            synced = i.address() + i.size() == address;
+                            
+                            context.append( i );
+                            
+                            return true;
+                        }
+                    );
+                    
+                    if( synced )
+                    {
+                        for( size_t i = context.size() - std::min( before, context.size() ); i < context.size(); i++ )
+                        {
+                            block->append( context[ i ] );
+                        }
+                        
+                        break;
+                    }
+                }
+                
+                this->iterate( data + offset, size - offset, address, after, [ & ]( const Instruction & i ) { block->append( i ); return true; } );
+            }
+            
+            this->impl->_store( data, size, key, block );
+            
+            return block;
+        }
+        
+        void swap( Disassembler & o1, Disassembler & o2 )
+        {
+            using std::swap;
+            
+            swap( o1.impl, o2.impl );
+        }
+        
+        Disassembler::IMPL::IMPL( size_t cacheSize ):
+            _handle(      0 ),
+            _instruction( nullptr ),
+            _cacheSize(   cacheSize )
+        {
+            this->_open();
+        }
+        
+        Disassembler::IMPL::IMPL( const IMPL & o ):
+            _handle(      0 ),
+            _instruction( nullptr ),
+            _cacheSize(   o._cacheSize )
+        {
+            this->_open();
+        }
+        
+        Disassembler::IMPL::~IMPL( void )
+        {
+            cs_free( this->_instruction, 1 );
+            cs_close( &( this->_handle ) );
+        }
+        
+        uint64_t Disassembler::IMPL::_hash( const uint8_t * data, size_t size, const Key & key )
+        {
+            uint64_t hash( Hash::Basis );
+            
+            for( uint64_t k: key )
+            {
+                hash = Hash::combine( hash, k );
+            }
+            
+            return Hash::bytes( data, size, hash );
+        }
+        
+        void Disassembler::IMPL::_open( void )
+        {
+            if( cs_open( CS_ARCH_X86, CS_MODE_64, &( this->_handle ) ) != CS_ERR_OK )
+            {
+                throw std::runtime_error( "Cannot initialize the disassembler" );
+            }
+            
+            this->_instruction = cs_malloc( this->_handle );
+            
+            if( this->_instruction == nullptr )
+            {
+                cs_close( &( this->_handle ) );
+                
+                throw std::runtime_error( "Cannot initialize the disassembler" );
+            }
+        }
+        
+        std::shared_ptr< const Block > Disassembler::IMPL::_find( const uint8_t * data, size_t size, const Key & key )
+        {
+            if( data == nullptr || size == 0 )
+            {
+                return std::make_shared< const Block >();
+            }
+            
+            {
+                uint64_t hash( _hash( data, size, key ) );
+                auto     it( this->_cache.find( hash ) );
+                
+                if( it == this->_cache.end() )
+                {
+                    return nullptr;
+                }
+                
+                {
+                    Entry & entry( *( it->second ) );
+                    
+                    if( entry._key == key && entry._bytes.size() == size && memcmp( entry._bytes.data(), data, size ) == 0 )
+                    {
+                        this->_lru.splice( this->_lru.begin(), this->_lru, entry._lru );
+                        
+                        return entry._block;
+                    }
+                    
+                    this->_lru.erase( entry._lru );
+                    this->_cache.erase( it );
+                }
+            }
+            
+            return nullptr;
+        }
+        
+        void Disassembler::IMPL::_store( const uint8_t * data, size_t size, const Key & key, const std::shared_ptr< const Block > & block )
+        {
+            std::unique_ptr< Entry > entry( std::make_unique< Entry >() );
+            uint64_t                 hash( _hash( data, size, key ) );
+            
+            if( this->_cacheSize == 0 || data == nullptr || size == 0 )
+            {
+                return;
+            }
+            
+            while( this->_cache.size() >= this->_cacheSize )
+            {
+                this->_cache.erase( this->_lru.back() );
+                this->_lru.pop_back();
+            }
+            
+            this->_lru.push_front( hash );
+            
+            entry->_key   = key;
+            entry->_bytes = std::vector< uint8_t >( data, data + size );
+            entry->_block = block;
+            entry->_lru   = this->_lru.begin();
+            
+            this->_cache[ hash ] = std::move( entry );
+        }
+    }
+}
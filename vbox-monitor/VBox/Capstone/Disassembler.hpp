@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_CAPSTONE_DISASSEMBLER_HPP
+#define VBOX_CAPSTONE_DISASSEMBLER_HPP
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include "VBox/Capstone/Instruction.hpp"
+#include "VBox/Capstone/Block.hpp"
+
+namespace VBox
+{
+    namespace Capstone
+    {
+        class Disassembler
+        {
+            public:
+                
+                Disassembler( size_t cacheSize = 64 );
+                Disassembler( const Disassembler & o );
+                Disassembler( Disassembler && o );
+                ~Disassembler( void );
+                
+                Disassembler & operator =( Disassembler o );
+                
+                size_t cacheSize( void ) const;
+                size_t cached( void )    const;
+                
+                size_t iterate( const uint8_t * data, size_t size, uint64_t org, size_t maximum, const std::function< bool( const Instruction & ) > & f );
+                
+                std::shared_ptr< const Block > disassemble( const uint8_t * data, size_t size, uint64_t org, size_t maximum = 0 );
+                std::shared_ptr< const Block > disassembleAround( const uint8_t * data, size_t size, uint64_t org, uint64_t address, size_t before, size_t after );
+                
+                friend void swap( Disassembler & o1, Disassembler & o2 );
+                
+            private:
+                
+                class IMPL;
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_CAPSTONE_DISASSEMBLER_HPP */
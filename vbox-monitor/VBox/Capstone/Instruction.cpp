@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Capstone/Instruction.hpp"
+
+namespace VBox
+{
+    namespace Capstone
+    {
+        Instruction::Instruction( void ):
+            _address( 0 ),
+            _size(    0 )
+        {}
+        
+        Instruction::Instruction( uint64_t address, size_t size, std::string_view mnemonic, std::string_view operands ):
+            _address(  address ),
+            _size(     size ),
+            _mnemonic( mnemonic ),
+            _operands( operands )
+        {}
+        
+        Instruction::Instruction( const Instruction & o ):
+            _address(  o._address ),
+            _size(     o._size ),
+            _mnemonic( o._mnemonic ),
+            _operands( o._operands )
+        {}
+        
+        Instruction::~Instruction( void )
+        {}
+        
+        Instruction & Instruction::operator =( Instruction o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        uint64_t Instruction::address( void ) const
+        {
+            return this->_address;
+        }
+        
+        size_t Instruction::size( void ) const
+        {
+            return this->_size;
+        }
+        
+        std::string_view Instruction::mnemonic( void ) const
+        {
+            return this->_mnemonic;
+        }
+        
+        std::string_view Instruction::operands( void ) const
+        {
+            return this->_operands;
+        }
+        
+        void swap( Instruction & o1, Instruction & o2 )
+        {
+            using std::swap;
+            
+            swap( o1._address,  o2._address );
+            swap( o1._size,     o2._size );
+            swap( o1._mnemonic, o2._mnemonic );
+            swap( o1._operands, o2._operands );
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_CAPSTONE_INSTRUCTION_HPP
+#define VBOX_CAPSTONE_INSTRUCTION_HPP
+
+#include <algorithm>
+#include <string_view>
+#include <cstdint>
+#include <cstdlib>
+
+namespace VBox
+{
+    namespace Capstone
+    {
+        class Instruction
+        {
+            public:
+                
+                Instruction( void );
+                Instruction( uint64_t address, size_t size, std::string_view mnemonic, std::string_view operands );
+                Instruction( const Instruction & o );
+                ~Instruction( void );
+                
+                Instruction & operator =( Instruction o );
+                
+                uint64_t         address( void )  const;
+                size_t           size( void )     const;
+                std::string_view mnemonic( void ) const;
+                std::string_view operands( void ) const;
+                
+                friend void swap( Instruction & o1, Instruction & o2 );
+                
+            private:
+                
+                uint64_t         _address;
+                size_t           _size;
+                std::string_view _mnemonic;
+                std::string_view _operands;
+        };
+    }
+}
+
+#endif /* VBOX_CAPSTONE_INSTRUCTION_HPP */
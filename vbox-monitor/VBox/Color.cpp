@@ -39,49 +39,67 @@ namespace VBox
             int _index;
     };
 
-    Color Color::clear( void )
+    const Color & Color::clear( void )
     {
-        return Color( 1 );
+        static const Color color( 1 );
+        
+        return color;
     }
     
-    Color Color::black( void )
+    const Color & Color::black( void )
     {
-        return Color( 2 );
+        static const Color color( 2 );
+        
+        return color;
     }
     
-    Color Color::red( void )
+    const Color & Color::red( void )
     {
-        return Color( 3 );
+        static const Color color( 3 );
+        
+        return color;
     }
     
-    Color Color::green( void )
+    const Color & Color::green( void )
     {
-        return Color( 4 );
+        static const Color color( 4 );
+        
+        return color;
     }
     
-    Color Color::yellow( void )
+    const Color & Color::yellow( void )
     {
-        return Color( 5 );
+        static const Color color( 5 );
+        
+        return color;
     }
     
-    Color Color::blue( void )
+    const Color & Color::blue( void )
     {
-        return Color( 6 );
+        static const Color color( 6 );
+        
+        return color;
     }
     
-    Color Color::magenta( void )
+    const Color & Color::magenta( void )
     {
-        return Color( 7 );
+        static const Color color( 7 );
+        
+        return color;
     }
     
-    Color Color::cyan( void )
+    const Color & Color::cyan( void )
     {
-        return Color( 8 );
+        static const Color color( 8 );
+        
+        return color;
     }
     
-    Color Color::white( void )
+    const Color & Color::white( void )
     {
-        return Color( 9 );
+        static const Color color( 9 );
+        
+        return color;
     }
 
     Color::Color( int index ):
@@ -34,15 +34,15 @@ namespace VBox
     {
         public:
             
-            static Color clear( void );
-            static Color black( void );
-            static Color red( void );
-            static Color green( void );
-            static Color yellow( void );
-            static Color blue( void );
-            static Color magenta( void );
-            static Color cyan( void );
-            static Color white( void );
+            static const Color & clear( void );
+            static const Color & black( void );
+            static const Color & red( void );
+            static const Color & green( void );
+            static const Color & yellow( void );
+            static const Color & blue( void );
+            static const Color & magenta( void );
+            static const Color & cyan( void );
+            static const Color & white( void );
             
             Color( const Color & o );
             Color( Color && o ) noexcept;
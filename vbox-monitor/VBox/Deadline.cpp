@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Deadline.hpp"
+#include "VBox/Casts.hpp"
+#include <type_traits>
+
+namespace VBox
+{
+    static_assert( std::is_trivially_copyable_v< Deadline > );
+    
+    Deadline Deadline::never( void )
+    {
+        return {};
+    }
+    
+    Deadline Deadline::after( std::chrono::steady_clock::duration duration )
+    {
+        std::chrono::steady_clock::time_point now( std::chrono::steady_clock::now() );
+        
+        if( duration >= std::chrono::steady_clock::time_point::max() - now )
+        {
+            return {};
+        }
+        
+        return { now + duration };
+    }
+    
+    Deadline::Deadline( void ):
+        Deadline( std::chrono::steady_clock::time_point::max() )
+    {}
+    
+    Deadline::Deadline( std::chrono::steady_clock::time_point time ):
+        _time( time )
+    {}
+    
+    bool Deadline::infinite( void ) const
+    {
+        return this->_time == std::chrono::steady_clock::time_point::max();
+    }
+    
+    bool Deadline::expired( void ) const
+    {
+        return this->infinite() == false && std::chrono::steady_clock::now() >= this->_time;
+    }
+    
+    std::chrono::steady_clock::time_point Deadline::time( void ) const
+    {
+        return this->_time;
+    }
+    
+    std::chrono::steady_clock::duration Deadline::remaining( void ) const
+    {
+        std::chrono::steady_clock::time_point now( std::chrono::steady_clock::now() );
+        
+        if( this->infinite() )
+        {
+            return std::chrono::steady_clock::duration::max();
+        }
+        
+        if( now >= this->_time )
+        {
+            return std::chrono::steady_clock::duration::zero();
+        }
+        
+        return this->_time - now;
+    }
+    
+    int Deadline::timeout( int maximum ) const
+    {
+        std::chrono::steady_clock::duration remaining( this->remaining() );
+        
+        if( this->infinite() || remaining >= std::chrono::milliseconds( maximum ) )
+        {
+            return maximum;
+        }
+        
+        return numeric_cast< int >( std::chrono::ceil< std::chrono::milliseconds >( remaining ).count() );
+    }
+    
+    void swap( Deadline & o1, Deadline & o2 )
+    {
+        using std::swap;
+        
+        swap( o1._time, o2._time );
+    }
+}
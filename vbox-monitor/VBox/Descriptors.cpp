@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Descriptors.hpp"
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+
+namespace VBox
+{
+    namespace Descriptors
+    {
+        #if !defined( __linux__ ) || !defined( SOCK_CLOEXEC )
+        static void closeOnExec( int fd )
+        {
+            if( fd != -1 )
+            {
+                fcntl( fd, F_SETFD, fcntl( fd, F_GETFD ) | FD_CLOEXEC );
+            }
+        }
+        #endif
+        
+        std::unique_lock< std::mutex > spawnLock( void )
+        {
+            #ifdef __linux__
+            return {};
+            #else
+            static std::mutex mtx;
+            
+            return std::unique_lock< std::mutex >( mtx );
+            #endif
+        }
+        
+        bool pipe( int fds[ 2 ], bool nonBlocking )
+        {
+            #ifdef __linux__
+            return pipe2( fds, O_CLOEXEC | ( ( nonBlocking ) ? O_NONBLOCK : 0 ) ) == 0;
+            #else
+            std::unique_lock< std::mutex > l( spawnLock() );
+            
+            if( ::pipe( fds ) == -1 )
+            {
+                return false;
+            }
+            
+            for( int i = 0; i < 2; i++ )
+            {
+                closeOnExec( fds[ i ] );
+                
+                if( nonBlocking )
+                {
+                    fcntl( fds[ i ], F_SETFL, fcntl( fds[ i ], F_GETFL ) | O_NONBLOCK );
+                }
+            }
+            
+            return true;
+            #endif
+        }
+        
+        int socket( int domain, int type, int protocol )
+        {
+            #ifdef SOCK_CLOEXEC
+            return ::socket( domain, type | SOCK_CLOEXEC, protocol );
+            #else
+            std::unique_lock< std::mutex > l( spawnLock() );
+            int                            fd( ::socket( domain, type, protocol ) );
+            
+            closeOnExec( fd );
+            
+            return fd;
+            #endif
+        }
+        
+        int accept( int socket )
+        {
+            #ifdef SOCK_CLOEXEC
+            return ::accept4( socket, nullptr, nullptr, SOCK_CLOEXEC );
+            #else
+            std::unique_lock< std::mutex > l( spawnLock() );
+            int                            fd( ::accept( socket, nullptr, nullptr ) );
+            
+            closeOnExec( fd );
+            
+            return fd;
+            #endif
+        }
+    }
+}
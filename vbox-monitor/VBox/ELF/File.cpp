@@ -25,6 +25,8 @@
 #include "VBox/ELF/File.hpp"
 #include "VBox/Casts.hpp"
 #include "VBox/BinaryDataStream.hpp"
+#include <array>
+#include <stdexcept>
 
 namespace VBox
 {
@@ -38,10 +40,16 @@ namespace VBox
                 IMPL( BinaryStream & stream );
                 IMPL( const IMPL & o );
                 
+                void _readProgramHeader( BinaryStream & stream );
+                void _readNotes( BinaryStream & stream );
+                
                 Header                            _header;
                 std::vector< ProgramHeaderEntry > _programHeader;
+                std::vector< Note >               _notes;
         };
         
+        static const uint32_t ProgramHeaderTypeNote = 4;
+        
         File::File( void ):
             impl( std::make_unique< IMPL >() )
         {}
@@ -78,6 +86,11 @@ namespace VBox
             return this->impl->_programHeader;
         }
         
+        std::vector< Note > File::notes( void ) const
+        {
+            return this->impl->_notes;
+        }
+        
         void swap( File & o1, File & o2 )
         {
             using std::swap;
@@ -104,6 +117,19 @@ namespace VBox
                 os << "    }" << std::endl;
             }
             
+            if( o.impl->_notes.size() > 0 )
+            {
+                os << "    Notes:" << std::endl
+                   << "    {"      << std::endl;
+                
+                for( const auto & note: o.impl->_notes )
+                {
+                    os << note << std::endl;
+                }
+                
+                os << "    }" << std::endl;
+            }
+            
             os << "}";
                
             return os;
@@ -122,18 +148,95 @@ namespace VBox
                 && this->_header.programHeaderEntryCount() != 0
             )
             {
-                stream.Seek( numeric_cast< ssize_t >( this->_header.programHeaderOffset() ), BinaryStream::SeekDirection::Begin );
-                
-                for( size_t i = 0; i < this->_header.programHeaderEntryCount(); i++ )
-                {
-                    this->_programHeader.push_back( ProgramHeaderEntry( stream ) );
-                }
+                this->_readProgramHeader( stream );
+                this->_readNotes( stream );
             }
         }
         
         File::IMPL::IMPL( const IMPL & o ):
             _header(        o._header ),
-            _programHeader( o._programHeader )
+            _programHeader( o._programHeader ),
+            _notes(         o._notes )
         {}
+        
+        void File::IMPL::_readProgramHeader( BinaryStream & stream )
+        {
+            std::array< uint8_t, 64 * ProgramHeaderEntry::Size > buffer;
+            size_t                                               size( this->_header.programHeaderEntrySize() );
+            size_t                                               count( this->_header.programHeaderEntryCount() );
+            
+            if( size < ProgramHeaderEntry::Size )
+            {
+                throw std::runtime_error( "Invalid ELF program header" );
+            }
+            
+            stream.Seek( numeric_cast< ssize_t >( this->_header.programHeaderOffset() ), BinaryStream::SeekDirection::Begin );
+            
+            if( size * count > stream.AvailableBytes() )
+            {
+                throw std::runtime_error( "Invalid ELF program header" );
+            }
+            
+            this->_programHeader.reserve( count );
+            
+            for( size_t i = 0; i < count; )
+            {
+                size_t n( std::min( count - i, buffer.size() / size ) );
+                
+                if( n == 0 )
+                {
+                    stream.Read( buffer.data(), ProgramHeaderEntry::Size );
+                    stream.Seek( numeric_cast< ssize_t >( size - ProgramHeaderEntry::Size ) );
+                    
+                    n = 1;
+                }
+                else
+                {
+                    stream.Read( buffer.data(), n * size );
+                }
+                
+                for( size_t j = 0; j < n; j++ )
+                {
+                    this->_programHeader.push_back( ProgramHeaderEntry( buffer.data() + j * size, this->_header.bigEndian() ) );
+                }
+                
+                i += n;
+            }
+        }
+        
+        void File::IMPL::_readNotes( BinaryStream & stream )
+        {
+            for( const auto & entry: this->_programHeader )
+            {
+                if( entry.type() != ProgramHeaderTypeNote || entry.fileSize() == 0 )
+                {
+                    continue;
+                }
+                
+                stream.Seek( numeric_cast< ssize_t >( entry.offset() ), BinaryStream::SeekDirection::Begin );
+                
+                if( entry.fileSize() > stream.AvailableBytes() )
+                {
+                    throw std::runtime_error( "Invalid ELF note segment" );
+                }
+                
+                {
+                    std::vector< uint8_t > data( stream.Read( numeric_cast< size_t >( entry.fileSize() ) ) );
+                    size_t                 alignment( ( entry.alignment() == 8 ) ? 8 : 4 );
+                    std::vector< Note >    notes;
+                    
+                    try
+                    {
+                        notes = Note::parse( data.data(), data.size(), alignment, this->_header.bigEndian() );
+                    }
+                    catch( const std::runtime_error & )
+                    {
+                        notes = Note::parse( data.data(), data.size(), ( alignment == 8 ) ? 4 : 8, this->_header.bigEndian() );
+                    }
+                    
+                    this->_notes.insert( this->_notes.end(), notes.begin(), notes.end() );
+                }
+            }
+        }
     }
 }
@@ -31,6 +31,7 @@
 #include <ostream>
 #include "VBox/ELF/Header.hpp"
 #include "VBox/ELF/ProgramHeaderEntry.hpp"
+#include "VBox/ELF/Note.hpp"
 #include "VBox/BinaryStream.hpp"
 
 namespace VBox
@@ -51,6 +52,7 @@ namespace VBox
                 
                 Header                            header( void )        const;
                 std::vector< ProgramHeaderEntry > programHeader( void ) const;
+                std::vector< Note >               notes( void )         const;
                 
                 friend void swap( File & o1, File & o2 );
                 
@@ -24,210 +24,186 @@
 
 #include "VBox/ELF/Header.hpp"
 #include "VBox/String.hpp"
+#include "VBox/Endian.hpp"
+#include <cstring>
+#include <type_traits>
 
 namespace VBox
 {
     namespace ELF
     {
-        class Header::IMPL
-        {
-            public:
-                
-                IMPL( void );
-                IMPL( BinaryStream & stream );
-                IMPL( const IMPL & o );
-                
-                std::vector< uint8_t > _ident;
-                uint16_t               _type;
-                uint16_t               _machine;
-                uint32_t               _version;
-                uint64_t               _entry;
-                uint64_t               _programHeaderOffset;
-                uint64_t               _sectionHeaderOffset;
-                uint32_t               _flags;
-                uint16_t               _elfHeaderSize;
-                uint16_t               _programHeaderEntrySize;
-                uint16_t               _programHeaderEntryCount;
-                uint16_t               _sectionHeaderEntrySize;
-                uint16_t               _sectionHeaderEntryCount;
-                uint16_t               _sectionNameStringTableIndex;
-        };
+        static_assert( std::is_trivially_copyable_v< Header > );
         
         Header::Header( void ):
-            impl( std::make_unique< IMPL >() )
+            _ident(                       {} ),
+            _type(                        0 ),
+            _machine(                     0 ),
+            _version(                     0 ),
+            _entry(                       0 ),
+            _programHeaderOffset(         0 ),
+            _sectionHeaderOffset(         0 ),
+            _flags(                       0 ),
+            _elfHeaderSize(               0 ),
+            _programHeaderEntrySize(      0 ),
+            _programHeaderEntryCount(     0 ),
+            _sectionHeaderEntrySize(      0 ),
+            _sectionHeaderEntryCount(     0 ),
+            _sectionNameStringTableIndex( 0 )
         {}
         
         Header::Header( BinaryStream & stream ):
-            impl( std::make_unique< IMPL >( stream ) )
-        {}
-        
-        Header::Header( const Header & o ):
-            impl( std::make_unique< IMPL >( *( o.impl ) ) )
-        {}
-        
-        Header::Header( Header && o ):
-            impl( std::move( o.impl ) )
-        {}
-        
-        Header::~Header( void )
-        {}
+            Header()
+        {
+            std::array< uint8_t, Size > data;
+            
+            stream.Read( data.data(), data.size() );
+            
+            *( this ) = Header( data.data() );
+        }
         
-        Header & Header::operator =( Header o )
+        Header::Header( const uint8_t * data ):
+            Header()
         {
-            swap( *( this ), o );
+            bool big;
+            
+            memcpy( this->_ident.data(), data, this->_ident.size() );
+            
+            big = this->bigEndian();
             
-            return *( this );
+            this->_type                        = Endian::load< uint16_t >( data + 16, big );
+            this->_machine                     = Endian::load< uint16_t >( data + 18, big );
+            this->_version                     = Endian::load< uint32_t >( data + 20, big );
+            this->_entry                       = Endian::load< uint64_t >( data + 24, big );
+            this->_programHeaderOffset         = Endian::load< uint64_t >( data + 32, big );
+            this->_sectionHeaderOffset         = Endian::load< uint64_t >( data + 40, big );
+            this->_flags                       = Endian::load< uint32_t >( data + 48, big );
+            this->_elfHeaderSize               = Endian::load< uint16_t >( data + 52, big );
+            this->_programHeaderEntrySize      = Endian::load< uint16_t >( data + 54, big );
+            this->_programHeaderEntryCount     = Endian::load< uint16_t >( data + 56, big );
+            this->_sectionHeaderEntrySize      = Endian::load< uint16_t >( data + 58, big );
+            this->_sectionHeaderEntryCount     = Endian::load< uint16_t >( data + 60, big );
+            this->_sectionNameStringTableIndex = Endian::load< uint16_t >( data + 62, big );
         }
         
         std::vector< uint8_t > Header::ident( void ) const
         {
-            return this->impl->_ident;
+            return std::vector< uint8_t >( this->_ident.begin(), this->_ident.end() );
+        }
+        
+        bool Header::is64Bit( void ) const
+        {
+            return this->_ident[ 4 ] == 2;
+        }
+        
+        bool Header::bigEndian( void ) const
+        {
+            return this->_ident[ 5 ] == 2;
         }
         
         uint16_t Header::type( void ) const
         {
-            return this->impl->_type;
+            return this->_type;
         }
         
         uint16_t Header::machine( void ) const
         {
-            return this->impl->_machine;
+            return this->_machine;
         }
         
         uint32_t Header::version( void ) const
         {
-            return this->impl->_version;
+            return this->_version;
         }
         
         uint64_t Header::entry( void ) const
         {
-            return this->impl->_entry;
+            return this->_entry;
         }
         
         uint64_t Header::programHeaderOffset( void ) const
         {
-            return this->impl->_programHeaderOffset;
+            return this->_programHeaderOffset;
         }
         
         uint64_t Header::sectionHeaderOffset( void ) const
         {
-            return this->impl->_sectionHeaderOffset;
+            return this->_sectionHeaderOffset;
         }
         
         uint32_t Header::flags( void ) const
         {
-            return this->impl->_flags;
+            return this->_flags;
         }
         
         uint16_t Header::elfHeaderSize( void ) const
         {
-            return this->impl->_elfHeaderSize;
+            return this->_elfHeaderSize;
         }
         
         uint16_t Header::programHeaderEntrySize( void ) const
         {
-            return this->impl->_programHeaderEntrySize;
+            return this->_programHeaderEntrySize;
         }
         
         uint16_t Header::programHeaderEntryCount( void ) const
         {
-            return this->impl->_programHeaderEntryCount;
+            return this->_programHeaderEntryCount;
         }
         
         uint16_t Header::sectionHeaderEntrySize( void ) const
         {
-            return this->impl->_sectionHeaderEntrySize;
+            return this->_sectionHeaderEntrySize;
         }
         
         uint16_t Header::sectionHeaderEntryCount( void ) const
         {
-            return this->impl->_sectionHeaderEntryCount;
+            return this->_sectionHeaderEntryCount;
         }
         
         uint16_t Header::sectionNameStringTableIndex( void ) const
         {
-            return this->impl->_sectionNameStringTableIndex;
+            return this->_sectionNameStringTableIndex;
         }
         
         void swap( Header & o1, Header & o2 )
         {
             using std::swap;
             
-            swap( o1.impl, o2.impl );
+            swap( o1._ident,                       o2._ident );
+            swap( o1._type,                        o2._type );
+            swap( o1._machine,                     o2._machine );
+            swap( o1._version,                     o2._version );
+            swap( o1._entry,                       o2._entry );
+            swap( o1._programHeaderOffset,         o2._programHeaderOffset );
+            swap( o1._sectionHeaderOffset,         o2._sectionHeaderOffset );
+            swap( o1._flags,                       o2._flags );
+            swap( o1._elfHeaderSize,               o2._elfHeaderSize );
+            swap( o1._programHeaderEntrySize,      o2._programHeaderEntrySize );
+            swap( o1._programHeaderEntryCount,     o2._programHeaderEntryCount );
+            swap( o1._sectionHeaderEntrySize,      o2._sectionHeaderEntrySize );
+            swap( o1._sectionHeaderEntryCount,     o2._sectionHeaderEntryCount );
+            swap( o1._sectionNameStringTableIndex, o2._sectionNameStringTableIndex );
         }
         
         std::ostream & operator <<( std::ostream & os, const Header & o )
         {
             os << "    {" << std::endl
-               << "        Type:                            " << String::toHex( o.impl->_type )                << std::endl
-               << "        Machine:                         " << String::toHex( o.impl->_machine )             << std::endl
-               << "        Version:                         " << String::toHex( o.impl->_version )             << std::endl
-               << "        Entry:                           " << String::toHex( o.impl->_entry )               << std::endl
-               << "        Program header offset:           " << String::toHex( o.impl->_programHeaderOffset ) << std::endl
-               << "        Section header offset:           " << String::toHex( o.impl->_sectionHeaderOffset ) << std::endl
-               << "        Flags:                           " << String::toHex( o.impl->_flags )               << std::endl
-               << "        ELF header size:                 " << o.impl->_elfHeaderSize                        << std::endl
-               << "        Program header entry size:       " << o.impl->_programHeaderEntrySize               << std::endl
-               << "        Program header entry count:      " << o.impl->_programHeaderEntryCount              << std::endl
-               << "        Section header entry size:       " << o.impl->_sectionHeaderEntrySize               << std::endl
-               << "        Section header entry count:      " << o.impl->_sectionHeaderEntryCount              << std::endl
-               << "        Section name string table index: " << o.impl->_sectionNameStringTableIndex          << std::endl
+               << "        Type:                            " << String::toHex( o._type )                << std::endl
+               << "        Machine:                         " << String::toHex( o._machine )             << std::endl
+               << "        Version:                         " << String::toHex( o._version )             << std::endl
+               << "        Entry:                           " << String::toHex( o._entry )               << std::endl
+               << "        Program header offset:           " << String::toHex( o._programHeaderOffset ) << std::endl
+               << "        Section header offset:           " << String::toHex( o._sectionHeaderOffset ) << std::endl
+               << "        Flags:                           " << String::toHex( o._flags )               << std::endl
+               << "        ELF header size:                 " << o._elfHeaderSize                        << std::endl
+               << "        Program header entry size:       " << o._programHeaderEntrySize               << std::endl
+               << "        Program header entry count:      " << o._programHeaderEntryCount              << std::endl
+               << "        Section header entry size:       " << o._sectionHeaderEntrySize               << std::endl
+               << "        Section header entry count:      " << o._sectionHeaderEntryCount              << std::endl
+               << "        Section name string table index: " << o._sectionNameStringTableIndex          << std::endl
                << "    }";
             
             return os;
         }
-        
-        Header::IMPL::IMPL( void ):
-            _type(                        0 ),
-            _machine(                     0 ),
-            _version(                     0 ),
-            _entry(                       0 ),
-            _programHeaderOffset(         0 ),
-            _sectionHeaderOffset(         0 ),
-            _flags(                       0 ),
-            _elfHeaderSize(               0 ),
-            _programHeaderEntrySize(      0 ),
-            _programHeaderEntryCount(     0 ),
-            _sectionHeaderEntrySize(      0 ),
-            _sectionHeaderEntryCount(     0 ),
-            _sectionNameStringTableIndex( 0 )
-        {}
-        
-        Header::IMPL::IMPL( BinaryStream & stream ):
-            IMPL()
-        {
-            this->_ident.resize( 16 );
-            stream.Read( &( this->_ident[ 0 ] ), 16 );
-            
-            this->_type                        = stream.ReadLittleEndianUInt16();
-            this->_machine                     = stream.ReadLittleEndianUInt16();
-            this->_version                     = stream.ReadLittleEndianUInt32();
-            this->_entry                       = stream.ReadLittleEndianUInt64();
-            this->_programHeaderOffset         = stream.ReadLittleEndianUInt64();
-            this->_sectionHeaderOffset         = stream.ReadLittleEndianUInt64();
-            this->_flags                       = stream.ReadLittleEndianUInt32();
-            this->_elfHeaderSize               = stream.ReadLittleEndianUInt16();
-            this->_programHeaderEntrySize      = stream.ReadLittleEndianUInt16();
-            this->_programHeaderEntryCount     = stream.ReadLittleEndianUInt16();
-            this->_sectionHeaderEntrySize      = stream.ReadLittleEndianUInt16();
-            this->_sectionHeaderEntryCount     = stream.ReadLittleEndianUInt16();
-            this->_sectionNameStringTableIndex = stream.ReadLittleEndianUInt16();
-        }
-        
-        Header::IMPL::IMPL( const IMPL & o ):
-            _type(                        o._type ),
-            _machine(                     o._machine ),
-            _version(                     o._version ),
-            _entry(                       o._entry ),
-            _programHeaderOffset(         o._programHeaderOffset ),
-            _sectionHeaderOffset(         o._sectionHeaderOffset ),
-            _flags(                       o._flags ),
-            _elfHeaderSize(               o._elfHeaderSize ),
-            _programHeaderEntrySize(      o._programHeaderEntrySize ),
-            _programHeaderEntryCount(     o._programHeaderEntryCount ),
-            _sectionHeaderEntrySize(      o._sectionHeaderEntrySize ),
-            _sectionHeaderEntryCount(     o._sectionHeaderEntryCount ),
-            _sectionNameStringTableIndex( o._sectionNameStringTableIndex )
-        {}
     }
 }
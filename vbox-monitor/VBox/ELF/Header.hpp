@@ -26,7 +26,7 @@
 #define VBOX_ELF_HEADER_HPP
 
 #include <algorithm>
-#include <memory>
+#include <array>
 #include <cstdint>
 #include <vector>
 #include <ostream>
@@ -40,15 +40,15 @@ namespace VBox
         {
             public:
                 
+                static constexpr size_t Size = 64;
+                
                 Header( void );
                 Header( BinaryStream & stream );
-                Header( const Header & o );
-                Header( Header && o );
-                ~Header( void );
-                
-                Header & operator =( Header o );
+                Header( const uint8_t * data );
                 
-                std::vector< uint8_t > ident( void ) const;
+                std::vector< uint8_t > ident( void )                       const;
+                bool                   is64Bit( void )                     const;
+                bool                   bigEndian( void )                   const;
                 uint16_t               type( void )                        const;
                 uint16_t               machine( void )                     const;
                 uint32_t               version( void )                     const;
@@ -69,8 +69,20 @@ namespace VBox
                 
             private:
                 
-                class IMPL;
-                std::unique_ptr< IMPL > impl;
+                std::array< uint8_t, 16 > _ident;
+                uint16_t                  _type;
+                uint16_t                  _machine;
+                uint32_t                  _version;
+                uint64_t                  _entry;
+                uint64_t                  _programHeaderOffset;
+                uint64_t                  _sectionHeaderOffset;
+                uint32_t                  _flags;
+                uint16_t                  _elfHeaderSize;
+                uint16_t                  _programHeaderEntrySize;
+                uint16_t                  _programHeaderEntryCount;
+                uint16_t                  _sectionHeaderEntrySize;
+                uint16_t                  _sectionHeaderEntryCount;
+                uint16_t                  _sectionNameStringTableIndex;
         };
     }
 }
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/ELF/Note.hpp"
+#include "VBox/String.hpp"
+#include "VBox/Endian.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace VBox
+{
+    namespace ELF
+    {
+        static size_t align( size_t size, size_t alignment )
+        {
+            return ( size + alignment - 1 ) & ~( alignment - 1 );
+        }
+        
+        Note::Note( void ):
+            _type( 0 )
+        {}
+        
+        Note::Note( const std::string & name, uint32_t type, const std::vector< uint8_t > & description ):
+            _name(        name ),
+            _type(        type ),
+            _description( description )
+        {}
+        
+        std::string Note::name( void ) const
+        {
+            return this->_name;
+        }
+        
+        uint32_t Note::type( void ) const
+        {
+            return this->_type;
+        }
+        
+        const std::vector< uint8_t > & Note::description( void ) const
+        {
+            return this->_description;
+        }
+        
+        std::vector< Note > Note::parse( const uint8_t * data, size_t size, size_t alignment, bool bigEndian )
+        {
+            std::vector< Note > notes;
+            size_t              offset( 0 );
+            
+            if( alignment != 8 )
+            {
+                alignment = 4;
+            }
+            
+            while( size - offset >= 12 )
+            {
+                size_t   nameSize( Endian::load< uint32_t >( data + offset,     bigEndian ) );
+                size_t   descSize( Endian::load< uint32_t >( data + offset + 4, bigEndian ) );
+                uint32_t type(     Endian::load< uint32_t >( data + offset + 8, bigEndian ) );
+                size_t   name(     offset + 12 );
+                size_t   desc;
+                
+                if( align( nameSize, alignment ) > size - name )
+                {
+                    throw std::runtime_error( "Invalid ELF note" );
+                }
+                
+                desc = name + align( nameSize, alignment );
+                
+                if( descSize > size - desc )
+                {
+                    throw std::runtime_error( "Invalid ELF note" );
+                }
+                
+                notes.emplace_back
+                (
+                    std::string( reinterpret_cast< const char * >( data + name ), strnlen( reinterpret_cast< const char * >( data + name ), nameSize ) ),
+                    type,
+                    std::vector< uint8_t >( data + desc, data + desc + descSize )
+                );
+                
+                offset = desc + std::min( align( descSize, alignment ), size - desc );
+            }
+            
+            return notes;
+        }
+        
+        void swap( Note & o1, Note & o2 )
+        {
+            using std::swap;
+            
+            swap( o1._name,        o2._name );
+            swap( o1._type,        o2._type );
+            swap( o1._description, o2._description );
+        }
+        
+        std::ostream & operator <<( std::ostream & os, const Note & o )
+        {
+            os << "        {" << std::endl
+               << "            Name:        " << o._name                   << std::endl
+               << "            Type:        " << String::toHex( o._type )  << std::endl
+               << "            Size:        " << o._description.size()     << std::endl
+               << "        }";
+            
+            return os;
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_ELF_NOTE_HPP
+#define VBOX_ELF_NOTE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace VBox
+{
+    namespace ELF
+    {
+        class Note
+        {
+            public:
+                
+                Note( void );
+                Note( const std::string & name, uint32_t type, const std::vector< uint8_t > & description );
+                std::string                    name( void )        const;
+                uint32_t                       type( void )        const;
+                const std::vector< uint8_t > & description( void ) const;
+                
+                static std::vector< Note > parse( const uint8_t * data, size_t size, size_t alignment, bool bigEndian );
+                
+                friend void swap( Note & o1, Note & o2 );
+                
+                friend std::ostream & operator <<( std::ostream & os, const Note & o );
+                
+            private:
+                
+                std::string            _name;
+                uint32_t               _type;
+                std::vector< uint8_t > _description;
+        };
+    }
+}
+
+#endif /* VBOX_ELF_NOTE_HPP */
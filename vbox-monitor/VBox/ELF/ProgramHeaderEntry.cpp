@@ -24,100 +24,100 @@
 
 #include "VBox/ELF/ProgramHeaderEntry.hpp"
 #include "VBox/String.hpp"
+#include "VBox/Endian.hpp"
+#include <array>
+#include <type_traits>
 
 namespace VBox
 {
     namespace ELF
     {
-        class ProgramHeaderEntry::IMPL
-        {
-            public:
-                
-                IMPL( void );
-                IMPL( BinaryStream & stream );
-                IMPL( const IMPL & o );
-                
-                uint32_t _type;
-                uint32_t _flags;
-                uint64_t _offset;
-                uint64_t _vaddress;
-                uint64_t _paddress;
-                uint64_t _fileSize;
-                uint64_t _memorySize;
-                uint64_t _alignment;
-        };
+        static_assert( std::is_trivially_copyable_v< ProgramHeaderEntry > );
         
         ProgramHeaderEntry::ProgramHeaderEntry( void ):
-            impl( std::make_unique< IMPL >() )
-        {}
-        
-        ProgramHeaderEntry::ProgramHeaderEntry( BinaryStream & stream ):
-            impl( std::make_unique< IMPL >( stream ) )
-        {}
-        
-        ProgramHeaderEntry::ProgramHeaderEntry( const ProgramHeaderEntry & o ):
-            impl( std::make_unique< IMPL >( *( o.impl ) ) )
-        {}
-        
-        ProgramHeaderEntry::ProgramHeaderEntry( ProgramHeaderEntry && o ):
-            impl( std::move( o.impl ) )
-        {}
-        
-        ProgramHeaderEntry::~ProgramHeaderEntry( void )
+            _type(       0 ),
+            _flags(      0 ),
+            _offset(     0 ),
+            _vaddress(   0 ),
+            _paddress(   0 ),
+            _fileSize(   0 ),
+            _memorySize( 0 ),
+            _alignment(  0 )
         {}
         
-        ProgramHeaderEntry & ProgramHeaderEntry::operator =( ProgramHeaderEntry o )
+        ProgramHeaderEntry::ProgramHeaderEntry( BinaryStream & stream, bool bigEndian ):
+            ProgramHeaderEntry()
         {
-            swap( *( this ), o );
+            std::array< uint8_t, Size > data;
             
-            return *( this );
+            stream.Read( data.data(), data.size() );
+            
+            *( this ) = ProgramHeaderEntry( data.data(), bigEndian );
         }
         
+        ProgramHeaderEntry::ProgramHeaderEntry( const uint8_t * data, bool bigEndian ):
+            _type(       Endian::load< uint32_t >( data,      bigEndian ) ),
+            _flags(      Endian::load< uint32_t >( data +  4, bigEndian ) ),
+            _offset(     Endian::load< uint64_t >( data +  8, bigEndian ) ),
+            _vaddress(   Endian::load< uint64_t >( data + 16, bigEndian ) ),
+            _paddress(   Endian::load< uint64_t >( data + 24, bigEndian ) ),
+            _fileSize(   Endian::load< uint64_t >( data + 32, bigEndian ) ),
+            _memorySize( Endian::load< uint64_t >( data + 40, bigEndian ) ),
+            _alignment(  Endian::load< uint64_t >( data + 48, bigEndian ) )
+        {}
+        
         uint32_t ProgramHeaderEntry::type( void ) const
         {
-            return this->impl->_type;
+            return this->_type;
         }
         
         uint32_t ProgramHeaderEntry::flags( void ) const
         {
-            return this->impl->_flags;
+            return this->_flags;
         }
         
         uint64_t ProgramHeaderEntry::offset( void ) const
         {
-            return this->impl->_offset;
+            return this->_offset;
         }
         
         uint64_t ProgramHeaderEntry::vaddress( void ) const
         {
-            return this->impl->_vaddress;
+            return this->_vaddress;
         }
         
         uint64_t ProgramHeaderEntry::paddress( void ) const
         {
-            return this->impl->_paddress;
+            return this->_paddress;
         }
         
         uint64_t ProgramHeaderEntry::fileSize( void ) const
         {
-            return this->impl->_fileSize;
+            return this->_fileSize;
         }
         
         uint64_t ProgramHeaderEntry::memorySize( void ) const
         {
-            return this->impl->_memorySize;
+            return this->_memorySize;
         }
         
         uint64_t ProgramHeaderEntry::alignment( void ) const
         {
-            return this->impl->_alignment;
+            return this->_alignment;
         }
         
         void swap( ProgramHeaderEntry & o1, ProgramHeaderEntry & o2 )
         {
             using std::swap;
             
-            swap( o1.impl, o2.impl );
+            swap( o1._type,       o2._type );
+            swap( o1._flags,      o2._flags );
+            swap( o1._offset,     o2._offset );
+            swap( o1._vaddress,   o2._vaddress );
+            swap( o1._paddress,   o2._paddress );
+            swap( o1._fileSize,   o2._fileSize );
+            swap( o1._memorySize, o2._memorySize );
+            swap( o1._alignment,  o2._alignment );
         }
         
         std::ostream & operator <<( std::ostream & os, const ProgramHeaderEntry & o )
@@ -125,50 +125,17 @@ namespace VBox
             ( void )o;
             
             os << "        {" << std::endl
-               << "            Type:        " << String::toHex( o.impl->_type )       << std::endl
-               << "            Flags:       " << String::toHex( o.impl->_flags )      << std::endl
-               << "            Offset:      " << String::toHex( o.impl->_offset )     << std::endl
-               << "            VAddress:    " << String::toHex( o.impl->_vaddress )   << std::endl
-               << "            PAddress:    " << String::toHex( o.impl->_paddress )   << std::endl
-               << "            File size:   " << o.impl->_fileSize                    << std::endl
-               << "            Memory size: " << o.impl->_memorySize                  << std::endl
-               << "            Alignment:   " << o.impl->_alignment                   << std::endl
+               << "            Type:        " << String::toHex( o._type )     << std::endl
+               << "            Flags:       " << String::toHex( o._flags )    << std::endl
+               << "            Offset:      " << String::toHex( o._offset )   << std::endl
+               << "            VAddress:    " << String::toHex( o._vaddress ) << std::endl
+               << "            PAddress:    " << String::toHex( o._paddress ) << std::endl
+               << "            File size:   " << o._fileSize                  << std::endl
+               << "            Memory size: " << o._memorySize                << std::endl
+               << "            Alignment:   " << o._alignment                 << std::endl
                << "        }";
             
             return os;
         }
-        
-        ProgramHeaderEntry::IMPL::IMPL( void ):
-            _type(       0 ),
-            _flags(      0 ),
-            _offset(     0 ),
-            _vaddress(   0 ),
-            _paddress(   0 ),
-            _fileSize(   0 ),
-            _memorySize( 0 ),
-            _alignment(  0 )
-        {}
-        
-        ProgramHeaderEntry::IMPL::IMPL( BinaryStream & stream ):
-            _type(       stream.ReadLittleEndianUInt32() ),
-            _flags(      stream.ReadLittleEndianUInt32() ),
-            _offset(     stream.ReadLittleEndianUInt64() ),
-            _vaddress(   stream.ReadLittleEndianUInt64() ),
-            _paddress(   stream.ReadLittleEndianUInt64() ),
-            _fileSize(   stream.ReadLittleEndianUInt64() ),
-            _memorySize( stream.ReadLittleEndianUInt64() ),
-            _alignment(  stream.ReadLittleEndianUInt64() )
-        {}
-        
-        ProgramHeaderEntry::IMPL::IMPL( const IMPL & o ):
-            _type(       o._type ),
-            _flags(      o._flags ),
-            _offset(     o._offset ),
-            _vaddress(   o._vaddress ),
-            _paddress(   o._paddress ),
-            _fileSize(   o._fileSize ),
-            _memorySize( o._memorySize ),
-            _alignment(  o._alignment )
-        {}
     }
 }
@@ -26,7 +26,6 @@
 #define VBOX_ELF_PROGRAM_HEADER_ENTRY_HPP
 
 #include <algorithm>
-#include <memory>
 #include <cstdint>
 #include <ostream>
 #include "VBox/BinaryStream.hpp"
@@ -39,13 +38,11 @@ namespace VBox
         {
             public:
                 
-                ProgramHeaderEntry( void );
-                ProgramHeaderEntry( BinaryStream & stream );
-                ProgramHeaderEntry( const ProgramHeaderEntry & o );
-                ProgramHeaderEntry( ProgramHeaderEntry && o );
-                ~ProgramHeaderEntry( void );
+                static constexpr size_t Size = 56;
                 
-                ProgramHeaderEntry & operator =( ProgramHeaderEntry o );
+                ProgramHeaderEntry( void );
+                ProgramHeaderEntry( BinaryStream & stream, bool bigEndian = false );
+                ProgramHeaderEntry( const uint8_t * data, bool bigEndian = false );
                 
                 uint32_t type( void )       const;
                 uint32_t flags( void )      const;
@@ -62,8 +59,14 @@ namespace VBox
                 
             private:
                 
-                class IMPL;
-                std::unique_ptr< IMPL > impl;
+                uint32_t _type;
+                uint32_t _flags;
+                uint64_t _offset;
+                uint64_t _vaddress;
+                uint64_t _paddress;
+                uint64_t _fileSize;
+                uint64_t _memorySize;
+                uint64_t _alignment;
         };
     }
 }
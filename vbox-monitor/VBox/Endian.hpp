@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_ENDIAN_HPP
+#define VBOX_ENDIAN_HPP
+
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+namespace VBox
+{
+    namespace Endian
+    {
+        template< typename _T_ >
+        constexpr _T_ littleEndian( const uint8_t * data, typename std::enable_if< std::is_unsigned< _T_ >::value >::type * = 0 )
+        {
+            _T_ v( 0 );
+            
+            for( size_t i = sizeof( _T_ ); i > 0; i-- )
+            {
+                v = static_cast< _T_ >( ( static_cast< uint64_t >( v ) << 8 ) | data[ i - 1 ] );
+            }
+            
+            return v;
+        }
+        
+        template< typename _T_ >
+        constexpr _T_ bigEndian( const uint8_t * data, typename std::enable_if< std::is_unsigned< _T_ >::value >::type * = 0 )
+        {
+            _T_ v( 0 );
+            
+            for( size_t i = 0; i < sizeof( _T_ ); i++ )
+            {
+                v = static_cast< _T_ >( ( static_cast< uint64_t >( v ) << 8 ) | data[ i ] );
+            }
+            
+            return v;
+        }
+        
+        template< typename _T_ >
+        constexpr _T_ load( const uint8_t * data, bool big, typename std::enable_if< std::is_unsigned< _T_ >::value >::type * = 0 )
+        {
+            return ( big ) ? bigEndian< _T_ >( data ) : littleEndian< _T_ >( data );
+        }
+    }
+}
+
+#endif /* VBOX_ENDIAN_HPP */
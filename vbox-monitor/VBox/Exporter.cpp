@@ -0,0 +1,501 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Exporter.hpp"
+#include "VBox/Monitor.hpp"
+#include "VBox/Descriptors.hpp"
+#include "VBox/Stats.hpp"
+#include "VBox/String.hpp"
+#include "VBox/Casts.hpp"
+#include "VBox/SignalHandler.hpp"
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace VBox
+{
+    class Exporter::IMPL
+    {
+        public:
+            
+            IMPL( Fleet & fleet, const std::optional< std::string > & socketPath );
+            ~IMPL( void );
+            
+            std::string _sample( size_t index, const Monitor & monitor, std::chrono::system_clock::time_point now );
+            std::string _stats( std::chrono::system_clock::time_point now );
+            bool        _flush( void );
+            
+            static std::string _address( const VM::SegmentAddress & address );
+            static uint64_t    _microseconds( std::chrono::system_clock::time_point time );
+            
+            Fleet                 & _fleet;
+            int                     _fd;
+            double                  _rate;
+            size_t                  _batch;
+            uint64_t                _samples;
+            uint64_t                _bytes;
+            mutable std::mutex      _mtx;
+            std::condition_variable _cv;
+            bool                    _running;
+            bool                    _stop;
+            std::vector< uint64_t > _sequences;
+            std::vector< uint64_t > _generations;
+            std::vector< bool >     _live;
+            std::string             _pending;
+            size_t                  _pendingSamples;
+            std::string             _triggered;
+    };
+    
+    static const std::chrono::seconds StatsInterval( 1 );
+    
+    static const std::pair< const char *, Monitor::Source > SampledSources[] =
+    {
+        { "registers", Monitor::Source::Registers },
+        { "stack",     Monitor::Source::Stack },
+        { "memory",    Monitor::Source::Memory }
+    };
+    
+    Exporter::Exporter( Fleet & fleet, const std::optional< std::string > & socketPath ):
+        impl( std::make_unique< IMPL >( fleet, socketPath ) )
+    {}
+    
+    Exporter::~Exporter( void )
+    {
+        this->stop();
+    }
+    
+    double Exporter::rate( void ) const
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        return this->impl->_rate;
+    }
+    
+    void Exporter::rate( double hz )
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        if( hz <= 0 )
+        {
+            throw std::runtime_error( "Invalid export rate" );
+        }
+        
+        this->impl->_rate = hz;
+    }
+    
+    size_t Exporter::batch( void ) const
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        return this->impl->_batch;
+    }
+    
+    void Exporter::batch( size_t samples )
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        if( samples == 0 )
+        {
+            throw std::runtime_error( "Invalid export batch size" );
+        }
+        
+        this->impl->_batch = samples;
+    }
+    
+    uint64_t Exporter::samples( void ) const
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        return this->impl->_samples;
+    }
+    
+    uint64_t Exporter::bytes( void ) const
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        return this->impl->_bytes;
+    }
+    
+    void Exporter::run( void )
+    {
+        std::optional< SignalHandler >        signals;
+        std::chrono::system_clock::time_point lastStats;
+        bool                                  failed( false );
+        
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            if( this->impl->_running )
+            {
+                return;
+            }
+            
+            this->impl->_running = true;
+            this->impl->_stop    = false;
+        }
+        
+        signals.emplace();
+        
+        this->impl->_fleet.start();
+        
+        while( signals->interrupted() == false )
+        {
+            std::chrono::system_clock::time_point now( std::chrono::system_clock::now() );
+            double                                rate;
+            size_t                                batch;
+            
+            {
+                std::lock_guard< std::mutex > l( this->impl->_mtx );
+                
+                if( this->impl->_stop )
+                {
+                    break;
+                }
+                
+                rate  = this->impl->_rate;
+                batch = this->impl->_batch;
+                
+                if( this->impl->_triggered.empty() == false )
+                {
+                    this->impl->_pending        += this->impl->_triggered;
+                    this->impl->_pendingSamples  = batch;
+                    
+                    this->impl->_triggered.clear();
+                }
+            }
+            
+            for( size_t i = 0; i < this->impl->_fleet.size(); i++ )
+            {
+                const Monitor & monitor( this->impl->_fleet.monitor( i ) );
+                uint64_t        generation( monitor.generation() );
+                
+                if( generation == this->impl->_generations[ i ] )
+                {
+                    continue;
+                }
+                
+                this->impl->_generations[ i ] = generation;
+                
+                if( monitor.snapshot()->sequence() != this->impl->_sequences[ i ] || monitor.live() != this->impl->_live[ i ] )
+                {
+                    this->impl->_pending += this->impl->_sample( i, monitor, now );
+                    this->impl->_pendingSamples++;
+                }
+            }
+            
+            if( now - lastStats >= StatsInterval )
+            {
+                this->impl->_pending += this->impl->_stats( now );
+                lastStats             = now;
+            }
+            
+            if( this->impl->_pendingSamples >= batch && this->impl->_flush() == false )
+            {
+                failed = true;
+                
+                break;
+            }
+            
+            if( this->impl->_fleet.live() == false )
+            {
+                break;
+            }
+            
+            {
+                std::unique_lock< std::mutex > l( this->impl->_mtx );
+                
+                this->impl->_cv.wait_for( l, std::chrono::duration< double >( 1.0 / rate ), [ & ] { return this->impl->_stop; } );
+            }
+        }
+        
+        if( failed == false && this->impl->_pending.empty() == false )
+        {
+            failed = this->impl->_flush() == false;
+        }
+        
+        this->impl->_fleet.stop();
+        
+        signals.reset();
+        
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_running = false;
+        }
+        
+        if( failed )
+        {
+            throw std::runtime_error( std::string( "Cannot write samples: " ) + strerror( errno ) );
+        }
+    }
+    
+    void Exporter::stop( void )
+    {
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_stop = true;
+        }
+        
+        this->impl->_cv.notify_all();
+    }
+    
+    Exporter::IMPL::IMPL( Fleet & fleet, const std::optional< std::string > & socketPath ):
+        _fleet(          fleet ),
+        _fd(             STDOUT_FILENO ),
+        _rate(           10 ),
+        _batch(          1 ),
+        _samples(        0 ),
+        _bytes(          0 ),
+        _running(        false ),
+        _stop(           false ),
+        _sequences(      fleet.size(), 0 ),
+        _generations(    fleet.size(), UINT64_MAX ),
+        _live(           fleet.size(), false ),
+        _pendingSamples( 0 )
+    {
+        struct sockaddr_un address;
+        
+        for( size_t i = 0; i < fleet.size(); i++ )
+        {
+            fleet.monitor( i ).onTrigger
+            (
+                [ this, i ]( const VM::Trigger & trigger )
+                {
+                    std::lock_guard< std::mutex > l( this->_mtx );
+                    
+                    this->_triggered += "{\"type\":\"trigger\"";
+                    this->_triggered += ",\"vm\":\""        + String::jsonEscape( this->_fleet.vmNames()[ i ] ) + "\"";
+                    this->_triggered += ",\"timestamp\":"   + std::to_string( IMPL::_microseconds( std::chrono::system_clock::now() ) );
+                    this->_triggered += ",\"trigger\":\""   + String::jsonEscape( trigger.description() ) + "\"}\n";
+                }
+            );
+        }
+        
+        if( socketPath.has_value() == false )
+        {
+            return;
+        }
+        
+        memset( &address, 0, sizeof( address ) );
+        
+        if( socketPath.value().empty() || socketPath.value().length() >= sizeof( address.sun_path ) )
+        {
+            throw std::runtime_error( "Invalid socket path: " + socketPath.value() );
+        }
+        
+        address.sun_family = AF_UNIX;
+        
+        memcpy( address.sun_path, socketPath.value().c_str(), socketPath.value().length() );
+        
+        this->_fd = Descriptors::socket( AF_UNIX, SOCK_STREAM, 0 );
+        
+        if( this->_fd == -1 )
+        {
+            throw std::runtime_error( std::string( "Cannot create socket: " ) + strerror( errno ) );
+        }
+        
+        if( ::connect( this->_fd, reinterpret_cast< struct sockaddr * >( &address ), sizeof( address ) ) != 0 )
+        {
+            std::string error( strerror( errno ) );
+            
+            ::close( this->_fd );
+            
+            throw std::runtime_error( "Cannot connect to socket: " + socketPath.value() + " (" + error + ")" );
+        }
+    }
+    
+    Exporter::IMPL::~IMPL( void )
+    {
+        if( this->_fd != STDOUT_FILENO )
+        {
+            ::close( this->_fd );
+        }
+    }
+    
+    std::string Exporter::IMPL::_sample( size_t index, const Monitor & monitor, std::chrono::system_clock::time_point now )
+    {
+        std::shared_ptr< const VM::Snapshot > snapshot( monitor.snapshot() );
+        std::string                           line;
+        bool                                  first( true );
+        
+        this->_sequences[ index ] = snapshot->sequence();
+        this->_live[ index ]      = monitor.live();
+        
+        line += "{\"type\":\"sample\"";
+        line += ",\"vm\":\""       + String::jsonEscape( this->_fleet.vmNames()[ index ] ) + "\"";
+        line += ",\"sequence\":"   + std::to_string( snapshot->sequence() );
+        line += ",\"timestamp\":"  + std::to_string( IMPL::_microseconds( snapshot->timestamp() ) );
+        line += ",\"age_us\":"     + std::to_string( ( now > snapshot->timestamp() ) ? IMPL::_microseconds( now ) - IMPL::_microseconds( snapshot->timestamp() ) : 0 );
+        line += ",\"timeouts\":"   + std::to_string( snapshot->timeouts() );
+        line += ",\"live\":"       + std::string( ( this->_live[ index ] ) ? "true" : "false" );
+        line += ",\"cpu\":"        + std::to_string( monitor.cpu() );
+        line += ",\"cpus\":"       + std::to_string( monitor.cpuCount() );
+        line += ",\"registers\":";
+        
+        if( snapshot->registers().has_value() )
+        {
+            line += "{";
+            
+            for( size_t i = 0; i < VM::Registers::GeneralCount; i++ )
+            {
+                line += ( first ) ? "\"" : ",\"";
+                line += VM::Registers::nameAt( i );
+                line += "\":\"" + String::toHex( snapshot->registers()->valueAt( i ) ) + "\"";
+                first = false;
+            }
+            
+            line += "}";
+        }
+        else
+        {
+            line += "null";
+        }
+        
+        line += ",\"stack\":[";
+        first = true;
+        
+        for( const auto & entry: snapshot->stack() )
+        {
+            line += ( first ) ? "{" : ",{";
+            line += "\"ip\":\""     + IMPL::_address( entry.ip() )    + "\"";
+            line += ",\"bp\":\""    + IMPL::_address( entry.bp() )    + "\"";
+            line += ",\"retBP\":\"" + IMPL::_address( entry.retBP() ) + "\"";
+            line += ",\"retIP\":\"" + IMPL::_address( entry.retIP() ) + "\"";
+            line += ",\"args\":[\"" + String::toHex( entry.arg0() ) + "\",\"" + String::toHex( entry.arg1() ) + "\",\"" + String::toHex( entry.arg2() ) + "\",\"" + String::toHex( entry.arg3() ) + "\"]";
+            line += "}";
+            first = false;
+        }
+        
+        line += "]}\n";
+        
+        {
+            std::lock_guard< std::mutex > l( this->_mtx );
+            
+            this->_samples++;
+        }
+        
+        return line;
+    }
+    
+    std::string Exporter::IMPL::_stats( std::chrono::system_clock::time_point now )
+    {
+        std::string line;
+        bool        first( true );
+        
+        line += "{\"type\":\"stats\"";
+        line += ",\"timestamp\":" + std::to_string( IMPL::_microseconds( now ) );
+        line += ",\"unit\":\"ns\",\"timers\":{";
+        
+        for( const auto & p: Stats::shared().histograms() )
+        {
+            line += ( first ) ? "\"" : ",\"";
+            line += String::jsonEscape( p.first ) + "\":{";
+            line += "\"count\":"  + std::to_string( p.second.count() );
+            line += ",\"p50\":"   + std::to_string( p.second.percentile( 50 ) );
+            line += ",\"p99\":"   + std::to_string( p.second.percentile( 99 ) );
+            line += ",\"max\":"   + std::to_string( p.second.max() );
+            line += "}";
+            first = false;
+        }
+        
+        line += "},\"sampling\":[";
+        
+        for( size_t i = 0; i < this->_fleet.size(); i++ )
+        {
+            const Monitor & monitor( this->_fleet.monitor( i ) );
+            
+            line += ( i == 0 ) ? "{" : ",{";
+            line += "\"vm\":\"" + String::jsonEscape( this->_fleet.vmNames()[ i ] ) + "\"";
+            
+            for( const auto & p: SampledSources )
+            {
+                line += ",\"" + std::string( p.first ) + "\":{";
+                line += "\"hz\":"       + std::to_string( monitor.effectiveFrequency( p.second ) );
+                line += ",\"changes\":" + std::to_string( monitor.changeRate( p.second ) );
+                line += "}";
+            }
+            
+            line += "}";
+        }
+        
+        line += "]}\n";
+        
+        return line;
+    }
+    
+    bool Exporter::IMPL::_flush( void )
+    {
+        Stats::Timer timer( "Exporter::flush" );
+        const char * p( this->_pending.data() );
+        size_t       size( this->_pending.size() );
+        
+        while( size > 0 )
+        {
+            ssize_t n( ::write( this->_fd, p, size ) );
+            
+            if( n < 0 && errno == EINTR )
+            {
+                continue;
+            }
+            
+            if( n <= 0 )
+            {
+                return false;
+            }
+            
+            p    += n;
+            size -= numeric_cast< size_t >( n );
+        }
+        
+        {
+            std::lock_guard< std::mutex > l( this->_mtx );
+            
+            this->_bytes += this->_pending.size();
+        }
+        
+        this->_pending.clear();
+        
+        this->_pendingSamples = 0;
+        
+        return true;
+    }
+    
+    std::string Exporter::IMPL::_address( const VM::SegmentAddress & address )
+    {
+        return String::toHex( address.segment() ) + ":" + String::toHex( address.address() );
+    }
+    
+    uint64_t Exporter::IMPL::_microseconds( std::chrono::system_clock::time_point time )
+    {
+        return numeric_cast< uint64_t >( std::chrono::duration_cast< std::chrono::microseconds >( time.time_since_epoch() ).count() );
+    }
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_EXPORTER_HPP
+#define VBOX_EXPORTER_HPP
+
+#include <string>
+#include <memory>
+#include <optional>
+#include "VBox/Fleet.hpp"
+
+namespace VBox
+{
+    class Exporter
+    {
+        public:
+            
+            Exporter( Fleet & fleet, const std::optional< std::string > & socketPath );
+            ~Exporter( void );
+            
+            Exporter( const Exporter & o )              = delete;
+            Exporter( Exporter && o )                   = delete;
+            Exporter & operator =( const Exporter & o ) = delete;
+            Exporter & operator =( Exporter && o )      = delete;
+            
+            double rate( void ) const;
+            void   rate( double hz );
+            
+            size_t batch( void ) const;
+            void   batch( size_t samples );
+            
+            uint64_t samples( void ) const;
+            uint64_t bytes( void )   const;
+            
+            void run( void );
+            void stop( void );
+            
+        private:
+            
+            class IMPL;
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* VBOX_EXPORTER_HPP */
@@ -0,0 +1,364 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Fleet.hpp"
+#include "VBox/Manage.hpp"
+#include "VBox/Manage/Backend.hpp"
+#include "VBox/ThreadPool.hpp"
+#include "VBox/Deadline.hpp"
+#include "VBox/Cancellation.hpp"
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <set>
+
+namespace VBox
+{
+    class Fleet::IMPL
+    {
+        public:
+            
+            IMPL( const std::vector< std::string > & vmNames );
+            IMPL( const std::vector< std::shared_ptr< Manage::Backend > > & backends );
+            IMPL( const IMPL & o );
+            
+            void _schedule( std::chrono::steady_clock::time_point when );
+            void _poll( void );
+            void _notify( void );
+            
+            std::vector< std::string >                   _vmNames;
+            std::vector< Monitor >                       _monitors;
+            bool                                         _managed;
+            double                                       _frequency;
+            mutable std::mutex                           _mtx;
+            std::condition_variable                      _cv;
+            bool                                         _running;
+            bool                                         _stop;
+            uint64_t                                     _group;
+            size_t                                       _pending;
+            Cancellation                                 _cancellation;
+            std::vector< std::function< void( void ) > > _onChange;
+    };
+    
+    static const std::chrono::seconds PollTimeout( 2 );
+    
+    Fleet::Fleet( const std::vector< std::string > & vmNames ):
+        impl( std::make_unique< IMPL >( vmNames ) )
+    {}
+    
+    Fleet::Fleet( const std::vector< std::shared_ptr< Manage::Backend > > & backends ):
+        impl( std::make_unique< IMPL >( backends ) )
+    {}
+    
+    Fleet::Fleet( const Fleet & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    Fleet::Fleet( Fleet && o ):
+        impl( std::move( o.impl ) )
+    {}
+    
+    Fleet::~Fleet( void )
+    {
+        if( this->impl != nullptr )
+        {
+            this->stop();
+        }
+    }
+    
+    Fleet & Fleet::operator =( Fleet o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    size_t Fleet::size( void ) const
+    {
+        return this->impl->_monitors.size();
+    }
+    
+    const std::vector< std::string > & Fleet::vmNames( void ) const
+    {
+        return this->impl->_vmNames;
+    }
+    
+    bool Fleet::live( void ) const
+    {
+        for( const auto & monitor: this->impl->_monitors )
+        {
+            if( monitor.live() )
+            {
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    Monitor & Fleet::monitor( size_t index )
+    {
+        return this->impl->_monitors.at( index );
+    }
+    
+    const Monitor & Fleet::monitor( size_t index ) const
+    {
+        return this->impl->_monitors.at( index );
+    }
+    
+    double Fleet::frequency( void ) const
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        return this->impl->_frequency;
+    }
+    
+    void Fleet::frequency( double hz )
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        if( hz <= 0 )
+        {
+            throw std::runtime_error( "Invalid polling frequency" );
+        }
+        
+        this->impl->_frequency = hz;
+    }
+    
+    size_t Fleet::historyCapacity( void ) const
+    {
+        return ( this->impl->_monitors.empty() ) ? 0 : this->impl->_monitors.front().historyCapacity();
+    }
+    
+    void Fleet::historyCapacity( size_t samples )
+    {
+        for( auto & monitor: this->impl->_monitors )
+        {
+            monitor.historyCapacity( samples );
+        }
+    }
+    
+    void Fleet::triggers( const std::vector< VM::Trigger > & triggers )
+    {
+        for( auto & monitor: this->impl->_monitors )
+        {
+            monitor.triggers( triggers );
+        }
+    }
+    
+    void Fleet::record( const std::string & directory )
+    {
+        for( size_t i = 0; i < this->impl->_monitors.size(); i++ )
+        {
+            this->impl->_monitors[ i ].record( directory + "/" + this->impl->_vmNames[ i ] + ".vbtrace" );
+        }
+    }
+    
+    void Fleet::start( void )
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        if( this->impl->_running )
+        {
+            return;
+        }
+        
+        this->impl->_stop    = false;
+        this->impl->_running = true;
+        
+        for( auto & monitor: this->impl->_monitors )
+        {
+            if( this->impl->_managed )
+            {
+                monitor.frequency( Monitor::Source::LiveStatus, 0 );
+            }
+            
+            monitor.start();
+        }
+        
+        if( this->impl->_managed )
+        {
+            this->impl->_schedule( std::chrono::steady_clock::now() );
+        }
+    }
+    
+    void Fleet::stop( void )
+    {
+        {
+            std::unique_lock< std::mutex > l( this->impl->_mtx );
+            
+            if( this->impl->_running == false )
+            {
+                return;
+            }
+            
+            this->impl->_stop     = true;
+            this->impl->_pending -= ThreadPool::shared().cancel( this->impl->_group );
+            
+            this->impl->_cancellation.cancel();
+            this->impl->_cv.wait( l, [ & ] { return this->impl->_pending == 0; } );
+            this->impl->_cancellation.reset();
+        }
+        
+        for( auto & monitor: this->impl->_monitors )
+        {
+            monitor.stop();
+        }
+        
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_running = false;
+        }
+    }
+    
+    void Fleet::onChange( const std::function< void( void ) > & f )
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        this->impl->_onChange.push_back( f );
+    }
+    
+    void swap( Fleet & o1, Fleet & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    Fleet::IMPL::IMPL( const std::vector< std::string > & vmNames ):
+        _vmNames(   vmNames ),
+        _managed(   true ),
+        _frequency( 1 ),
+        _running(   false ),
+        _stop(      false ),
+        _group(     ThreadPool::shared().group() ),
+        _pending(   0 )
+    {
+        this->_monitors.reserve( vmNames.size() );
+        
+        for( size_t i = 0; i < vmNames.size(); i++ )
+        {
+            this->_monitors.emplace_back( Manage::Backend::forVM( vmNames[ i ] ) );
+        }
+    }
+    
+    Fleet::IMPL::IMPL( const std::vector< std::shared_ptr< Manage::Backend > > & backends ):
+        _managed(   false ),
+        _frequency( 1 ),
+        _running(   false ),
+        _stop(      false ),
+        _group(     ThreadPool::shared().group() ),
+        _pending(   0 )
+    {
+        this->_monitors.reserve( backends.size() );
+        
+        for( const auto & backend: backends )
+        {
+            this->_vmNames.push_back( backend->vmName() );
+            this->_monitors.emplace_back( backend );
+        }
+    }
+    
+    Fleet::IMPL::IMPL( const IMPL & o ):
+        _vmNames(   o._vmNames ),
+        _monitors(  o._monitors ),
+        _managed(   o._managed ),
+        _frequency( o._frequency ),
+        _running(   false ),
+        _stop(      false ),
+        _group(     ThreadPool::shared().group() ),
+        _pending(   0 )
+    {}
+    
+    void Fleet::IMPL::_schedule( std::chrono::steady_clock::time_point when )
+    {
+        if( this->_stop )
+        {
+            return;
+        }
+        
+        this->_pending++;
+        ThreadPool::shared().submit( this->_group, ThreadPool::Priority::Normal, when, [ this ] { this->_poll(); } );
+    }
+    
+    void Fleet::IMPL::_poll( void )
+    {
+        std::chrono::steady_clock::time_point start( std::chrono::steady_clock::now() );
+        Deadline                              deadline( Deadline::after( PollTimeout ) );
+        std::set< std::string >               running;
+        bool                                  changed( false );
+        
+        for( const auto & info: Manage::runningVMs( deadline, this->_cancellation ) )
+        {
+            running.insert( info.name() );
+        }
+        
+        if( running.empty() == false || ( deadline.expired() == false && this->_cancellation.cancelled() == false ) )
+        {
+            for( size_t i = 0; i < this->_monitors.size(); i++ )
+            {
+                bool live( running.count( this->_vmNames[ i ] ) > 0 );
+                
+                if( this->_monitors[ i ].live() != live )
+                {
+                    this->_monitors[ i ].live( live );
+                
+                    changed = true;
+                }
+            }
+        }
+        
+        if( changed )
+        {
+            this->_notify();
+        }
+        
+        {
+            std::lock_guard< std::mutex > l( this->_mtx );
+            
+            this->_schedule( start + std::chrono::duration_cast< std::chrono::steady_clock::duration >( std::chrono::duration< double >( 1.0 / this->_frequency ) ) );
+            
+            this->_pending--;
+        }
+        
+        this->_cv.notify_all();
+    }
+    
+    void Fleet::IMPL::_notify( void )
+    {
+        std::vector< std::function< void( void ) > > onChange;
+        
+        {
+            std::lock_guard< std::mutex > l( this->_mtx );
+            
+            onChange = this->_onChange;
+        }
+        
+        for( const auto & f: onChange )
+        {
+            f();
+        }
+    }
+}
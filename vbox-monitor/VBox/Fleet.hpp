@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_FLEET_HPP
+#define VBOX_FLEET_HPP
+
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <vector>
+#include <functional>
+#include "VBox/Monitor.hpp"
+
+namespace VBox
+{
+    class Fleet
+    {
+        public:
+            
+            Fleet( const std::vector< std::string > & vmNames );
+            Fleet( const std::vector< std::shared_ptr< Manage::Backend > > & backends );
+            Fleet( const Fleet & o );
+            Fleet( Fleet && o );
+            ~Fleet( void );
+            
+            Fleet & operator =( Fleet o );
+            
+            size_t                             size( void )    const;
+            const std::vector< std::string > & vmNames( void ) const;
+            bool                               live( void )    const;
+            
+            Monitor       & monitor( size_t index );
+            const Monitor & monitor( size_t index ) const;
+            
+            double frequency( void ) const;
+            void   frequency( double hz );
+            
+            size_t historyCapacity( void ) const;
+            void   historyCapacity( size_t samples );
+            
+            void triggers( const std::vector< VM::Trigger > & triggers );
+            
+            void record( const std::string & directory );
+            
+            void start( void );
+            void stop( void );
+            
+            void onChange( const std::function< void( void ) > & f );
+            
+            friend void swap( Fleet & o1, Fleet & o2 );
+            
+        private:
+            
+            class IMPL;
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* VBOX_FLEET_HPP */
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_HASH_HPP
+#define VBOX_HASH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace VBox
+{
+    namespace Hash
+    {
+        constexpr uint64_t Basis = 0xCBF29CE484222325;
+        constexpr uint64_t Prime = 0x100000001B3;
+        
+        constexpr uint64_t combine( uint64_t hash, uint64_t value )
+        {
+            return ( hash ^ value ) * Prime;
+        }
+        
+        inline uint64_t bytes( const uint8_t * data, size_t size, uint64_t hash = Basis )
+        {
+            size_t i( 0 );
+            
+            for( ; i + sizeof( uint64_t ) <= size; i += sizeof( uint64_t ) )
+            {
+                uint64_t word;
+                
+                memcpy( &word, data + i, sizeof( uint64_t ) );
+                
+                hash = combine( hash, word );
+            }
+            
+            for( ; i < size; i++ )
+            {
+                hash = combine( hash, data[ i ] );
+            }
+            
+            return hash;
+        }
+    }
+}
+
+#endif /* VBOX_HASH_HPP */
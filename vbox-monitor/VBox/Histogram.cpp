@@ -0,0 +1,202 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Histogram.hpp"
+#include <limits>
+#include <cmath>
+
+namespace VBox
+{
+    size_t Histogram::bucket( uint64_t value )
+    {
+        size_t exponent( 63 );
+        
+        if( value < SubBuckets )
+        {
+            return static_cast< size_t >( value );
+        }
+        
+        while( ( value & ( uint64_t( 1 ) << exponent ) ) == 0 )
+        {
+            exponent--;
+        }
+        
+        return ( exponent - SubBucketBits + 1 ) * SubBuckets + static_cast< size_t >( ( value >> ( exponent - SubBucketBits ) ) & ( SubBuckets - 1 ) );
+    }
+    
+    uint64_t Histogram::lowerBound( size_t bucket )
+    {
+        if( bucket < SubBuckets )
+        {
+            return bucket;
+        }
+        
+        return ( SubBuckets + ( bucket % SubBuckets ) ) << ( bucket / SubBuckets - 1 );
+    }
+    
+    uint64_t Histogram::upperBound( size_t bucket )
+    {
+        if( bucket + 1 >= Buckets )
+        {
+            return std::numeric_limits< uint64_t >::max();
+        }
+        
+        return lowerBound( bucket + 1 ) - 1;
+    }
+    
+    Histogram::Histogram( void ):
+        _counts( Buckets, 0 ),
+        _count(  0 ),
+        _sum(    0 ),
+        _min(    std::numeric_limits< uint64_t >::max() ),
+        _max(    0 )
+    {}
+    
+    Histogram::Histogram( const std::vector< uint64_t > & counts, uint64_t sum, uint64_t min, uint64_t max ):
+        _counts( counts ),
+        _count(  0 ),
+        _sum(    sum ),
+        _min(    min ),
+        _max(    max )
+    {
+        this->_counts.resize( Buckets, 0 );
+        
+        for( uint64_t n: this->_counts )
+        {
+            this->_count += n;
+        }
+    }
+    
+    Histogram::Histogram( const Histogram & o ):
+        _counts( o._counts ),
+        _count(  o._count ),
+        _sum(    o._sum ),
+        _min(    o._min ),
+        _max(    o._max )
+    {}
+    
+    Histogram::Histogram( Histogram && o ) noexcept:
+        _counts( std::move( o._counts ) ),
+        _count(  o._count ),
+        _sum(    o._sum ),
+        _min(    o._min ),
+        _max(    o._max )
+    {}
+    
+    Histogram::~Histogram( void )
+    {}
+    
+    Histogram & Histogram::operator =( Histogram o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    uint64_t Histogram::count( void ) const
+    {
+        return this->_count;
+    }
+    
+    uint64_t Histogram::sum( void ) const
+    {
+        return this->_sum;
+    }
+    
+    uint64_t Histogram::min( void ) const
+    {
+        return ( this->_count == 0 ) ? 0 : this->_min;
+    }
+    
+    uint64_t Histogram::max( void ) const
+    {
+        return this->_max;
+    }
+    
+    double Histogram::mean( void ) const
+    {
+        return ( this->_count == 0 ) ? 0 : static_cast< double >( this->_sum ) / static_cast< double >( this->_count );
+    }
+    
+    uint64_t Histogram::percentile( double p ) const
+    {
+        uint64_t rank( 0 );
+        uint64_t seen( 0 );
+        
+        if( this->_count == 0 )
+        {
+            return 0;
+        }
+        
+        rank = static_cast< uint64_t >( std::ceil( std::clamp( p, 0.0, 100.0 ) / 100.0 * static_cast< double >( this->_count ) ) );
+        rank = std::max< uint64_t >( rank, 1 );
+        
+        for( size_t i = 0; i < this->_counts.size(); i++ )
+        {
+            seen += this->_counts[ i ];
+            
+            if( seen >= rank )
+            {
+                return std::clamp( upperBound( i ), this->min(), this->_max );
+            }
+        }
+        
+        return this->_max;
+    }
+    
+    void Histogram::record( uint64_t value )
+    {
+        this->_counts[ bucket( value ) ]++;
+        
+        this->_count++;
+        
+        this->_sum += value;
+        this->_min  = std::min( this->_min, value );
+        this->_max  = std::max( this->_max, value );
+    }
+    
+    void Histogram::merge( const Histogram & o )
+    {
+        for( size_t i = 0; i < Buckets; i++ )
+        {
+            this->_counts[ i ] += o._counts[ i ];
+        }
+        
+        this->_count += o._count;
+        this->_sum   += o._sum;
+        this->_min    = std::min( this->_min, o._min );
+        this->_max    = std::max( this->_max, o._max );
+    }
+    
+    void swap( Histogram & o1, Histogram & o2 )
+    {
+        using std::swap;
+        
+        swap( o1._counts, o2._counts );
+        swap( o1._count,  o2._count );
+        swap( o1._sum,    o2._sum );
+        swap( o1._min,    o2._min );
+        swap( o1._max,    o2._max );
+    }
+}
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_HISTOGRAM_HPP
+#define VBOX_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace VBox
+{
+    class Histogram
+    {
+        public:
+            
+            static constexpr size_t SubBucketBits = 3;
+            static constexpr size_t SubBuckets    = size_t( 1 ) << SubBucketBits;
+            static constexpr size_t Buckets       = ( 64 - SubBucketBits + 1 ) * SubBuckets;
+            
+            static size_t   bucket( uint64_t value );
+            static uint64_t lowerBound( size_t bucket );
+            static uint64_t upperBound( size_t bucket );
+            
+            Histogram( void );
+            Histogram( const std::vector< uint64_t > & counts, uint64_t sum, uint64_t min, uint64_t max );
+            Histogram( const Histogram & o );
+            Histogram( Histogram && o ) noexcept;
+            ~Histogram( void );
+            
+            Histogram & operator =( Histogram o );
+            
+            uint64_t count( void )          const;
+            uint64_t sum( void )            const;
+            uint64_t min( void )            const;
+            uint64_t max( void )            const;
+            double   mean( void )           const;
+            uint64_t percentile( double p ) const;
+            
+            void record( uint64_t value );
+            void merge( const Histogram & o );
+            
+            friend void swap( Histogram & o1, Histogram & o2 );
+            
+        private:
+            
+            std::vector< uint64_t > _counts;
+            uint64_t                _count;
+            uint64_t                _sum;
+            uint64_t                _min;
+            uint64_t                _max;
+    };
+}
+
+#endif /* VBOX_HISTOGRAM_HPP */
@@ -0,0 +1,227 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/LZ.hpp"
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace VBox
+{
+    namespace LZ
+    {
+        static const size_t       MinMatch     = 4;
+        static const size_t       LastLiterals = 5;
+        static const size_t       MaxOffset    = 65535;
+        static const unsigned int HashBits     = 12;
+        
+        static uint32_t read32( const uint8_t * p )
+        {
+            uint32_t v;
+            
+            memcpy( &v, p, sizeof( v ) );
+            
+            return v;
+        }
+        
+        static void writeLength( std::vector< uint8_t > & out, size_t length )
+        {
+            for( ; length >= 255; length -= 255 )
+            {
+                out.push_back( 255 );
+            }
+            
+            out.push_back( static_cast< uint8_t >( length ) );
+        }
+        
+        static size_t readLength( const uint8_t * data, size_t size, size_t & p )
+        {
+            size_t  length( 0 );
+            uint8_t byte;
+            
+            do
+            {
+                if( p >= size )
+                {
+                    throw std::runtime_error( "Invalid LZ data: truncated length" );
+                }
+                
+                byte    = data[ p++ ];
+                length += byte;
+            }
+            while( byte == 255 );
+            
+            return length;
+        }
+        
+        static void emit( std::vector< uint8_t > & out, const uint8_t * literals, size_t literalLength, size_t offset, size_t matchLength )
+        {
+            size_t  match( ( matchLength >= MinMatch ) ? matchLength - MinMatch : 0 );
+            uint8_t token( static_cast< uint8_t >( ( std::min< size_t >( literalLength, 15 ) << 4 ) | std::min< size_t >( match, 15 ) ) );
+            
+            out.push_back( token );
+            
+            if( literalLength >= 15 )
+            {
+                writeLength( out, literalLength - 15 );
+            }
+            
+            out.insert( out.end(), literals, literals + literalLength );
+            
+            if( matchLength == 0 )
+            {
+                return;
+            }
+            
+            out.push_back( static_cast< uint8_t >( offset ) );
+            out.push_back( static_cast< uint8_t >( offset >> 8 ) );
+            
+            if( match >= 15 )
+            {
+                writeLength( out, match - 15 );
+            }
+        }
+        
+        std::vector< uint8_t > compress( const uint8_t * data, size_t size )
+        {
+            std::vector< uint8_t >                out;
+            std::array< uint32_t, 1 << HashBits > table {};
+            size_t                                anchor( 0 );
+            size_t                                i( 0 );
+            size_t                                misses( 0 );
+            size_t                                limit( ( size > LastLiterals + MinMatch ) ? size - LastLiterals : 0 );
+            
+            out.reserve( size + size / 255 + 16 );
+            
+            while( i + MinMatch <= limit )
+            {
+                uint32_t sequence( read32( data + i ) );
+                uint32_t hash( ( sequence * 2654435761u ) >> ( 32 - HashBits ) );
+                size_t   candidate( table[ hash ] );
+                
+                table[ hash ] = static_cast< uint32_t >( i );
+                
+                if( candidate < i && i - candidate <= MaxOffset && read32( data + candidate ) == sequence )
+                {
+                    size_t length( MinMatch );
+                    
+                    while( i + length < limit && data[ candidate + length ] == data[ i + length ] )
+                    {
+                        length++;
+                    }
+                    
+                    emit( out, data + anchor, i - anchor, i - candidate, length );
+                    
+                    i     += length;
+                    anchor = i;
+                    misses = 0;
+                }
+                else
+                {
+                    i += 1 + ( misses++ >> 6 );
+                }
+            }
+            
+            emit( out, data + anchor, size - anchor, 0, 0 );
+            
+            return out;
+        }
+        
+        std::vector< uint8_t > compress( const std::vector< uint8_t > & data )
+        {
+            return compress( data.data(), data.size() );
+        }
+        
+        std::vector< uint8_t > decompress( const uint8_t * data, size_t size, size_t originalSize )
+        {
+            std::vector< uint8_t > out;
+            size_t                 p( 0 );
+            
+            out.reserve( originalSize );
+            
+            while( p < size )
+            {
+                uint8_t token( data[ p++ ] );
+                size_t  literals( token >> 4 );
+                size_t  length( ( token & 15u ) + MinMatch );
+                size_t  offset;
+                
+                if( literals == 15 )
+                {
+                    literals += readLength( data, size, p );
+                }
+                
+                if( literals > size - p || literals > originalSize - out.size() )
+                {
+                    throw std::runtime_error( "Invalid LZ data: bad literal length" );
+                }
+                
+                out.insert( out.end(), data + p, data + p + literals );
+                
+                p += literals;
+                
+                if( p == size )
+                {
+                    break;
+                }
+                
+                if( size - p < 2 )
+                {
+                    throw std::runtime_error( "Invalid LZ data: truncated offset" );
+                }
+                
+                offset = static_cast< size_t >( data[ p ] ) | ( static_cast< size_t >( data[ p + 1 ] ) << 8 );
+                p     += 2;
+                
+                if( ( token & 15u ) == 15 )
+                {
+                    length += readLength( data, size, p );
+                }
+                
+                if( offset == 0 || offset > out.size() || length > originalSize - out.size() )
+                {
+                    throw std::runtime_error( "Invalid LZ data: bad match" );
+                }
+                
+                for( size_t i = out.size() - offset, n = out.size() + length; out.size() < n; i++ )
+                {
+                    out.push_back( out[ i ] );
+                }
+            }
+            
+            if( out.size() != originalSize )
+            {
+                throw std::runtime_error( "Invalid LZ data: size mismatch" );
+            }
+            
+            return out;
+        }
+        
+        std::vector< uint8_t > decompress( const std::vector< uint8_t > & data, size_t originalSize )
+        {
+            return decompress( data.data(), data.size(), originalSize );
+        }
+    }
+}
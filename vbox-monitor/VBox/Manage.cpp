@@ -23,18 +23,78 @@
  ******************************************************************************/
 
 #include "VBox/Manage.hpp"
+#include "VBox/Manage/RunningVMs.hpp"
 #include "VBox/Process.hpp"
 #include "VBox/String.hpp"
+#include "VBox/Tokenizer.hpp"
+#include "VBox/Casts.hpp"
+#include "VBox/Stats.hpp"
+#include "VBox/BinaryPipeStream.hpp"
 #include <optional>
-#include <regex>
 #include <iostream>
+#include <atomic>
+#include <thread>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 
 namespace VBox
 {
     namespace Manage
     {
-        bool registerVM( const std::string & path )
+        static std::atomic< bool > FIFOUnsupported( false );
+        
+        static bool execute( Process & proc, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            if( cancellation.cancelled() )
+            {
+                return false;
+            }
+            
+            proc.start();
+            
+            if( proc.waitUntilExit( deadline, cancellation ) == false )
+            {
+                proc.kill();
+                proc.waitUntilExit();
+                
+                return false;
+            }
+            
+            return true;
+        }
+        
+        static bool executeAll( const std::vector< std::unique_ptr< Process > > & procs, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            bool success( true );
+            
+            if( cancellation.cancelled() )
+            {
+                return false;
+            }
+            
+            for( const auto & proc: procs )
+            {
+                proc->start();
+            }
+            
+            for( const auto & proc: procs )
+            {
+                if( success && proc->waitUntilExit( deadline, cancellation ) )
+                {
+                    continue;
+                }
+                
+                success = false;
+                
+                proc->kill();
+                proc->waitUntilExit();
+            }
+            
+            return success;
+        }
+        
+        bool registerVM( const std::string & path, const Deadline & deadline, const Cancellation & cancellation )
         {
             Process proc( "/usr/local/bin/VBoxManage" );
             
@@ -45,13 +105,10 @@ namespace VBox
                 }
             );
             
-            proc.start();
-            proc.waitUntilExit();
-            
-            return proc.terminationStatus().value_or( -1 ) == 0;
+            return execute( proc, deadline, cancellation ) && proc.terminationStatus().value_or( -1 ) == 0;
         }
         
-        bool unregisterVM( const std::string & vmName )
+        bool unregisterVM( const std::string & vmName, const Deadline & deadline, const Cancellation & cancellation )
         {
             Process proc( "/usr/local/bin/VBoxManage" );
             
@@ -62,15 +119,13 @@ namespace VBox
                 }
             );
             
-            proc.start();
-            proc.waitUntilExit();
-            
-            return proc.terminationStatus().value_or( -1 ) == 0;
+            return execute( proc, deadline, cancellation ) && proc.terminationStatus().value_or( -1 ) == 0;
         }
         
-        bool startVM( const std::string & vmName )
+        bool startVM( const std::string & vmName, const Deadline & deadline, const Cancellation & cancellation )
         {
             Process proc( "/usr/local/bin/VBoxManage" );
+            bool    success;
             
             proc.arguments
             (
@@ -79,15 +134,17 @@ namespace VBox
                 }
             );
             
-            proc.start();
-            proc.waitUntilExit();
+            success = execute( proc, deadline, cancellation ) && proc.terminationStatus().value_or( -1 ) == 0;
+            
+            RunningVMs::shared().invalidate();
             
-            return proc.terminationStatus().value_or( -1 ) == 0;
+            return success;
         }
         
-        bool powerOffVM( const std::string & vmName )
+        bool powerOffVM( const std::string & vmName, const Deadline & deadline, const Cancellation & cancellation )
         {
             Process proc( "/usr/local/bin/VBoxManage" );
+            bool    success;
             
             proc.arguments
             (
@@ -96,15 +153,99 @@ namespace VBox
                 }
             );
             
-            proc.start();
-            proc.waitUntilExit();
+            success = execute( proc, deadline, cancellation ) && proc.terminationStatus().value_or( -1 ) == 0;
+            
+            RunningVMs::shared().invalidate();
+            
+            return success;
+        }
+        
+        bool pauseVM( const std::string & vmName, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            Process proc( "/usr/local/bin/VBoxManage" );
+            
+            proc.arguments
+            (
+                {
+                    "controlvm", vmName, "pause"
+                }
+            );
+            
+            return execute( proc, deadline, cancellation ) && proc.terminationStatus().value_or( -1 ) == 0;
+        }
+        
+        bool setExtraData( const std::string & vmName, const std::string & key, const std::string & value, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            Process                    proc( "/usr/local/bin/VBoxManage" );
+            std::vector< std::string > arguments( { "setextradata", vmName, key } );
+            
+            if( value.empty() == false )
+            {
+                arguments.push_back( value );
+            }
+            
+            proc.arguments( arguments );
+            
+            return execute( proc, deadline, cancellation ) && proc.terminationStatus().value_or( -1 ) == 0;
+        }
+        
+        std::optional< std::string > getExtraData( const std::string & vmName, const std::string & key, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            Process                      proc( "/usr/local/bin/VBoxManage" );
+            std::optional< std::string > out;
+            
+            proc.arguments
+            (
+                {
+                    "getextradata", vmName, key
+                }
+            );
+            
+            if( execute( proc, deadline, cancellation ) == false || proc.terminationStatus().value_or( -1 ) != 0 )
+            {
+                return {};
+            }
+            
+            out = proc.output();
+            
+            if( out.has_value() == false )
+            {
+                return {};
+            }
+            
+            return parseExtraData( out.value() );
+        }
+        
+        std::optional< std::string > parseExtraData( std::string_view output )
+        {
+            Tokenizer        lines( output );
+            std::string_view line;
+            
+            while( lines.line( line ) )
+            {
+                Tokenizer t( line );
+                
+                if( t.expect( "No value set!" ) )
+                {
+                    return std::string();
+                }
+                
+                if( t.expect( "Value: " ) )
+                {
+                    return std::string( t.rest() );
+                }
+            }
             
-            return proc.terminationStatus().value_or( -1 ) == 0;
+            return {};
         }
         
-        std::vector< VM::Info > runningVMs( void )
+        std::vector< VM::Info > runningVMs( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return RunningVMs::shared().get( deadline, cancellation );
+        }
+        
+        std::optional< std::vector< VM::Info > > queryRunningVMs( const Deadline & deadline, const Cancellation & cancellation )
         {
-            std::vector< VM::Info >      running;
             Process                      proc( "/usr/local/bin/VBoxManage" );
             std::optional< std::string > out;
             
@@ -115,8 +256,10 @@ namespace VBox
                 }
             );
             
-            proc.start();
-            proc.waitUntilExit();
+            if( execute( proc, deadline, cancellation ) == false || proc.terminationStatus().value_or( -1 ) != 0 )
+            {
+                return {};
+            }
             
             out = proc.output();
             
@@ -125,42 +268,158 @@ namespace VBox
                 return {};
             }
             
+            return parseRunningVMs( out.value() );
+        }
+        
+        bool waitUntilRunning( const std::vector< std::string > & vmNames, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return RunningVMs::shared().waitUntilRunning( vmNames, deadline, cancellation );
+        }
+        
+        std::vector< VM::Info > parseRunningVMs( std::string_view output )
+        {
+            std::vector< VM::Info > running;
+            Tokenizer               lines( output );
+            std::string_view        line;
+            
+            while( lines.line( line ) )
             {
-                std::regex  regex( "\"([^\"]+)\" \\{([^}]+)\\}" );
-                std::smatch match;
+                Tokenizer        t( line );
+                std::string_view name;
+                std::string_view uid;
                 
-                for( const auto & line: String::lines( out.value() ) )
+                if( t.expect( '"' ) == false )
                 {
-                    if( std::regex_match( line, match, regex ) )
-                    {
-                        running.push_back( { match[ 1 ], match[ 2 ] } );
-                    }
+                    continue;
+                }
+                
+                name = t.until( '"' );
+                
+                if( name.empty() || t.expect( "\" {" ) == false )
+                {
+                    continue;
+                }
+                
+                uid = t.until( '}' );
+                
+                if( uid.empty() || t.expect( '}' ) == false || t.atEnd() == false )
+                {
+                    continue;
                 }
+                
+                running.push_back( { std::string( name ), std::string( uid ) } );
             }
             
             return running;
         }
         
+        std::optional< size_t > cpuCount( const std::string & vmName, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            Process                      proc( "/usr/local/bin/VBoxManage" );
+            std::optional< std::string > out;
+            
+            proc.arguments
+            (
+                {
+                    "showvminfo", vmName, "--machinereadable"
+                }
+            );
+            
+            if( execute( proc, deadline, cancellation ) == false || proc.terminationStatus().value_or( -1 ) != 0 )
+            {
+                return {};
+            }
+            
+            out = proc.output();
+            
+            if( out.has_value() == false )
+            {
+                return {};
+            }
+            
+            return parseCPUCount( out.value() );
+        }
+        
+        std::optional< size_t > parseCPUCount( std::string_view output )
+        {
+            Tokenizer        lines( output );
+            std::string_view line;
+            
+            while( lines.line( line ) )
+            {
+                Tokenizer        t( line );
+                std::string_view n;
+                unsigned long    count;
+                
+                if( t.expect( "cpus=" ) == false )
+                {
+                    continue;
+                }
+                
+                n = t.rest();
+                
+                if( n.empty() || n.length() > 9 || n.find_first_not_of( "0123456789" ) != std::string_view::npos )
+                {
+                    continue;
+                }
+                
+                count = std::stoul( std::string( n ) );
+                
+                if( count > 0 )
+                {
+                    return numeric_cast< size_t >( count );
+                }
+            }
+            
+            return {};
+        }
+        
         namespace Debug
         {
-            std::optional< VM::Registers > registers( const std::string & vmName )
+            std::optional< VM::Registers > registers( const std::string & vmName, const Deadline & deadline, const Cancellation & cancellation )
             {
-                VM::Registers                reg;
+                Stats::Timer timer( "Manage::Debug::registers" );
+                
+                Process                      proc( "/usr/local/bin/VBoxManage" );
+                std::optional< std::string > out;
+                std::vector< std::string >   arguments( { "debugvm", vmName, "getregisters" } );
+                
+                arguments.insert( arguments.end(), VM::Registers::names().begin(), VM::Registers::names().end() );
+                proc.arguments( arguments );
+                
+                if( execute( proc, deadline, cancellation ) == false )
+                {
+                    return {};
+                }
+                
+                out = proc.output();
+                
+                if( out.has_value() == false )
+                {
+                    return {};
+                }
+                
+                return parseRegisters( out.value() );
+            }
+            
+            std::vector< VM::StackEntry > stack( const std::string & vmName, const Deadline & deadline, const Cancellation & cancellation )
+            {
+                Stats::Timer timer( "Manage::Debug::stack" );
+                
                 Process                      proc( "/usr/local/bin/VBoxManage" );
                 std::optional< std::string > out;
                 
                 proc.arguments
                 (
                     {
-                        "debugvm", vmName, "getregisters",
-                        "rax", "rbx", "rcx", "rdx", "rdi", "rsi",
-                        "r8",  "r9",  "r10", "r11", "r12", "r13",
-                        "r14", "r15", "rbp", "rsp", "rip", "eflags"
+                        "debugvm", vmName, "stack",
                     }
                 );
                 
-                proc.start();
-                proc.waitUntilExit();
+                if( execute( proc, deadline, cancellation ) == false )
+                {
+                    return {};
+                }
                 
                 out = proc.output();
                 
@@ -169,151 +428,273 @@ namespace VBox
                     return {};
                 }
                 
+                return parseStack( out.value() );
+            }
+            
+            std::shared_ptr< VM::CoreDump > dump( const std::string & vmName, const std::string & path, const Deadline & deadline, const Cancellation & cancellation )
+            {
+                Stats::Timer timer( "Manage::Debug::dump" );
+                
+                try
                 {
-                    std::regex  regex( "([^ ]+) = (0x[0-9a-f]+)" );
-                    std::smatch match;
-                    bool        matched( false );
-                    
-                    for( const auto & line: String::lines( out.value() ) )
-                    {
-                        if( std::regex_match( line, match, regex ) )
+                    return fileDump
+                    (
+                        path,
+                        [ & ]
                         {
-                            matched = true;
+                            Process proc( "/usr/local/bin/VBoxManage" );
                             
+                            proc.arguments
+                            (
+                                {
+                                    "debugvm", vmName, "dumpvmcore",
+                                    "--filename=" + path,
+                                }
+                            );
+                            
+                            return execute( proc, deadline, cancellation ) && proc.terminationStatus().value_or( -1 ) == 0;
+                        }
+                    );
+                }
+                catch( ... )
+                {
+                    return {};
+                }
+            }
+            
+            std::shared_ptr< VM::CoreDump > streamDump( const std::string & path, const std::function< bool( void ) > & write )
+            {
+                bool fallback( false );
+                
+                if( FIFOUnsupported == false && mkfifo( path.c_str(), 0600 ) == 0 )
+                {
+                    int                             fd( open( path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC ) );
+                    std::atomic< bool >             closed( false );
+                    std::shared_ptr< VM::CoreDump > dump;
+                    size_t                          received( 0 );
+                    bool                            written( false );
+                    
+                    if( fd != -1 )
+                    {
+                        std::thread reader
+                        (
+                            [ & ]
                             {
-                                std::string name(  match[ 1 ] );
-                                std::string value( match[ 2 ] );
+                                BinaryPipeStream stream( fd, closed );
                                 
-                                if( name == "rax"    ) { reg.rax(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "rbx"    ) { reg.rbx(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "rcx"    ) { reg.rcx(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "rdx"    ) { reg.rdx(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "rdi"    ) { reg.rdi(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "rsi"    ) { reg.rsi(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "r8"     ) { reg.r8(     String::fromHex< uint64_t >( value ) ); };
-                                if( name == "r9"     ) { reg.r9(     String::fromHex< uint64_t >( value ) ); };
-                                if( name == "r10"    ) { reg.r10(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "r11"    ) { reg.r11(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "r12"    ) { reg.r12(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "r13"    ) { reg.r13(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "r14"    ) { reg.r14(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "r15"    ) { reg.r15(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "rbp"    ) { reg.rbp(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "rsp"    ) { reg.rsp(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "rip"    ) { reg.rip(    String::fromHex< uint64_t >( value ) ); };
-                                if( name == "eflags" ) { reg.eflags( String::fromHex< uint64_t >( value ) ); };
+                                try
+                                {
+                                    dump = std::make_shared< VM::CoreDump >( stream );
+                                }
+                                catch( ... )
+                                {}
+                                
+                                received = stream.Tell();
                             }
-                        }
+                        );
+                        
+                        written = write();
+                        closed  = true;
+                        
+                        reader.join();
+                        close( fd );
                     }
                     
-                    if( matched == false )
+                    unlink( path.c_str() );
+                    
+                    if( written == false )
                     {
                         return {};
                     }
+                    
+                    if( received > 0 )
+                    {
+                        return dump;
+                    }
+                    
+                    fallback = true;
                 }
                 
-                return reg;
+                {
+                    std::shared_ptr< VM::CoreDump > dump( fileDump( path, write ) );
+                    
+                    if( fallback && dump != nullptr )
+                    {
+                        FIFOUnsupported = true;
+                    }
+                    
+                    return dump;
+                }
             }
             
-            std::vector< VM::StackEntry > stack( const std::string & vmName )
+            std::shared_ptr< VM::CoreDump > fileDump( const std::string & path, const std::function< bool( void ) > & write )
             {
-                std::vector< VM::StackEntry > entries;
-                Process                       proc( "/usr/local/bin/VBoxManage" );
-                std::optional< std::string >  out;
+                if( write() == false )
+                {
+                    unlink( path.c_str() );
+                    
+                    return {};
+                }
                 
-                proc.arguments
-                (
+                try
+                {
+                    std::shared_ptr< VM::CoreDump > dump( std::make_shared< VM::CoreDump >( path ) );
+                    
+                    unlink( path.c_str() );
+                    
+                    return dump;
+                }
+                catch( ... )
+                {
+                    unlink( path.c_str() );
+                    
+                    return {};
+                }
+            }
+            
+            std::vector< VM::Registers > allRegisters( const std::string & vmName, size_t cpus, const Deadline & deadline, const Cancellation & cancellation )
+            {
+                Stats::Timer timer( "Manage::Debug::allRegisters" );
+                
+                std::vector< std::unique_ptr< Process > > procs;
+                std::vector< VM::Registers >              all;
+                
+                for( size_t i = 0; i < cpus; i++ )
+                {
+                    std::vector< std::string > arguments( { "debugvm", vmName, "getregisters", "--cpu=" + std::to_string( i ) } );
+                    
+                    arguments.insert( arguments.end(), VM::Registers::names().begin(), VM::Registers::names().end() );
+                    procs.push_back( std::make_unique< Process >( "/usr/local/bin/VBoxManage", arguments ) );
+                }
+                
+                if( executeAll( procs, deadline, cancellation ) == false )
+                {
+                    return {};
+                }
+                
+                for( const auto & proc: procs )
+                {
+                    std::optional< std::string >   out( proc->output() );
+                    std::optional< VM::Registers > regs( parseRegisters( out.value_or( "" ) ) );
+                    
+                    if( regs.has_value() == false )
                     {
-                        "debugvm", vmName, "stack",
+                        return {};
                     }
-                );
+                    
+                    all.push_back( regs.value() );
+                }
                 
-                proc.start();
-                proc.waitUntilExit();
+                return all;
+            }
+            
+            std::vector< std::vector< VM::StackEntry > > allStacks( const std::string & vmName, size_t cpus, const Deadline & deadline, const Cancellation & cancellation )
+            {
+                Stats::Timer timer( "Manage::Debug::allStacks" );
                 
-                out = proc.output();
+                std::vector< std::unique_ptr< Process > >    procs;
+                std::vector< std::vector< VM::StackEntry > > all;
                 
-                if( out.has_value() == false )
+                for( size_t i = 0; i < cpus; i++ )
                 {
-                    return entries;
+                    procs.push_back( std::make_unique< Process >( "/usr/local/bin/VBoxManage", std::vector< std::string > { "debugvm", vmName, "stack", "--cpu=" + std::to_string( i ) } ) );
+                }
+                
+                if( executeAll( procs, deadline, cancellation ) == false )
+                {
+                    return {};
                 }
                 
+                for( const auto & proc: procs )
                 {
-                    std::vector< std::string > lines( String::lines( out.value() ) );
-                    std::regex                 regex( "([0-9a-f]+):([0-9a-f]+) ([0-9a-f]+):([0-9a-f]+) ([0-9a-f]+):([0-9a-f]+) ([0-9a-f]+) ([0-9a-f]+) ([0-9a-f]+) ([0-9a-f]+) ([0-9a-f]+):([0-9a-f]+)" );
-                    std::smatch                match;
+                    std::optional< std::string > out( proc->output() );
                     
-                    if( lines.size() < 2 )
+                    all.push_back( parseStack( out.value_or( "" ) ) );
+                }
+                
+                return all;
+            }
+            
+            std::optional< VM::Registers > parseRegisters( std::string_view output )
+            {
+                VM::Registers    reg;
+                Tokenizer        lines( output );
+                std::string_view line;
+                bool             matched( false );
+                
+                while( lines.line( line ) )
+                {
+                    Tokenizer        t( line );
+                    std::string_view name( t.until( ' ' ) );
+                    
+                    if( name.empty() || t.expect( " = 0x" ) == false || t.atEnd() )
                     {
-                        return entries;
+                        continue;
                     }
                     
-                    lines.erase( lines.begin() );
-                    
-                    for( const auto & line: lines )
+                    if( reg.set( name, t.rest() ) )
                     {
-                        if( std::regex_match( line, match, regex ) )
-                        {
-                            uint32_t       u1(  String::fromHex< uint32_t >( match[  1 ] ) );
-                            uint32_t       u2(  String::fromHex< uint32_t >( match[  2 ] ) );
-                            uint32_t       u3(  String::fromHex< uint32_t >( match[  3 ] ) );
-                            uint32_t       u4(  String::fromHex< uint32_t >( match[  4 ] ) );
-                            uint32_t       u5(  String::fromHex< uint32_t >( match[  5 ] ) );
-                            uint32_t       u6(  String::fromHex< uint32_t >( match[  6 ] ) );
-                            uint32_t       u7(  String::fromHex< uint32_t >( match[  7 ] ) );
-                            uint32_t       u8(  String::fromHex< uint32_t >( match[  8 ] ) );
-                            uint32_t       u9(  String::fromHex< uint32_t >( match[  9 ] ) );
-                            uint32_t       u10( String::fromHex< uint32_t >( match[ 10 ] ) );
-                            uint32_t       u11( String::fromHex< uint32_t >( match[ 11 ] ) );
-                            uint32_t       u12( String::fromHex< uint32_t >( match[ 12 ] ) );
-                            VM::StackEntry entry;
-                            
-                            entry.bp(    { u1, u2 } );
-                            entry.retBP( { u3, u4 } );
-                            entry.retIP( { u5, u6 } );
-                            entry.arg0(  u7 );
-                            entry.arg1(  u8 );
-                            entry.arg2(  u9 );
-                            entry.arg3(  u10 );
-                            entry.ip(   { u11, u12 } );
-                            
-                            entries.push_back( entry );
-                        }
+                        matched = true;
                     }
                 }
                 
-                return entries;
+                if( matched == false )
+                {
+                    return {};
+                }
+                
+                return reg;
             }
             
-            std::shared_ptr< VM::CoreDump > dump( const std::string & vmName, const std::string & path )
+            std::vector< VM::StackEntry > parseStack( std::string_view output )
             {
-                try
+                std::vector< VM::StackEntry > entries;
+                Tokenizer                     lines( output );
+                std::string_view              line;
+                
+                if( lines.line( line ) == false || lines.atEnd() )
+                {
+                    return entries;
+                }
+                
+                while( lines.line( line ) )
                 {
-                    Process proc( "/usr/local/bin/VBoxManage" );
+                    Tokenizer t( line );
+                    uint64_t  u[ 12 ];
                     
-                    proc.arguments
+                    if
                     (
-                        {
-                            "debugvm", vmName, "dumpvmcore",
-                            "--filename=" + path,
-                        }
-                    );
-                    
-                    proc.start();
-                    proc.waitUntilExit();
+                           t.hex( u[  0 ] ) == false || t.expect( ':' ) == false || t.hex( u[  1 ] ) == false || t.expect( ' ' ) == false
+                        || t.hex( u[  2 ] ) == false || t.expect( ':' ) == false || t.hex( u[  3 ] ) == false || t.expect( ' ' ) == false
+                        || t.hex( u[  4 ] ) == false || t.expect( ':' ) == false || t.hex( u[  5 ] ) == false || t.expect( ' ' ) == false
+                        || t.hex( u[  6 ] ) == false || t.expect( ' ' ) == false
+                        || t.hex( u[  7 ] ) == false || t.expect( ' ' ) == false
+                        || t.hex( u[  8 ] ) == false || t.expect( ' ' ) == false
+                        || t.hex( u[  9 ] ) == false || t.expect( ' ' ) == false
+                        || t.hex( u[ 10 ] ) == false || t.expect( ':' ) == false || t.hex( u[ 11 ] ) == false
+                        || t.atEnd() == false
+                    )
+                    {
+                        continue;
+                    }
                     
                     {
-                        std::shared_ptr< VM::CoreDump > dump( std::make_shared< VM::CoreDump >( path ) );
+                        VM::StackEntry entry;
                         
-                        unlink( path.c_str() );
+                        entry.bp(    { static_cast< uint32_t >( u[  0 ] ), u[  1 ] } );
+                        entry.retBP( { static_cast< uint32_t >( u[  2 ] ), u[  3 ] } );
+                        entry.retIP( { static_cast< uint32_t >( u[  4 ] ), u[  5 ] } );
+                        entry.arg0(  u[ 6 ] );
+                        entry.arg1(  u[ 7 ] );
+                        entry.arg2(  u[ 8 ] );
+                        entry.arg3(  u[ 9 ] );
+                        entry.ip(    { static_cast< uint32_t >( u[ 10 ] ), u[ 11 ] } );
                         
-                        return dump;
+                        entries.push_back( entry );
                     }
                 }
-                catch( ... )
-                {
-                    return {};
-                }
+                
+                return entries;
             }
         }
     }
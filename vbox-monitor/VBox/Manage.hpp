@@ -29,26 +29,49 @@
 #include "VBox/VM/StackEntry.hpp"
 #include "VBox/VM/CoreDump.hpp"
 #include "VBox/VM/Info.hpp"
+#include "VBox/Deadline.hpp"
+#include "VBox/Cancellation.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
+#include <functional>
+#include <memory>
 
 namespace VBox
 {
     namespace Manage
     {
-        bool registerVM( const std::string & path );
-        bool unregisterVM( const std::string & vmName );
-        bool startVM( const std::string & vmName );
-        bool powerOffVM( const std::string & vmName );
+        bool registerVM( const std::string & path, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+        bool unregisterVM( const std::string & vmName, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+        bool startVM( const std::string & vmName, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+        bool powerOffVM( const std::string & vmName, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+        bool pauseVM( const std::string & vmName, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+        bool setExtraData( const std::string & vmName, const std::string & key, const std::string & value, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
         
-        std::vector< VM::Info > runningVMs( void );
+        std::optional< std::string > getExtraData( const std::string & vmName, const std::string & key, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+        std::optional< std::string > parseExtraData( std::string_view output );
+        
+        std::vector< VM::Info >                  runningVMs( const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+        std::optional< std::vector< VM::Info > > queryRunningVMs( const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+        std::vector< VM::Info >                  parseRunningVMs( std::string_view output );
+        bool                                     waitUntilRunning( const std::vector< std::string > & vmNames, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+        std::optional< size_t >                  cpuCount( const std::string & vmName, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+        std::optional< size_t >                  parseCPUCount( std::string_view output );
         
         namespace Debug
         {
-            std::optional< VM::Registers >  registers( const std::string & vmName );
-            std::vector< VM::StackEntry >   stack( const std::string & vmName );
-            std::shared_ptr< VM::CoreDump > dump( const std::string & vmName, const std::string & path );
+            std::optional< VM::Registers >  registers( const std::string & vmName, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+            std::vector< VM::StackEntry >   stack( const std::string & vmName, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+            std::shared_ptr< VM::CoreDump > dump( const std::string & vmName, const std::string & path, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+            std::shared_ptr< VM::CoreDump > streamDump( const std::string & path, const std::function< bool( void ) > & write );
+            std::shared_ptr< VM::CoreDump > fileDump( const std::string & path, const std::function< bool( void ) > & write );
+            
+            std::vector< VM::Registers >                 allRegisters( const std::string & vmName, size_t cpus, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+            std::vector< std::vector< VM::StackEntry > > allStacks( const std::string & vmName, size_t cpus, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+            
+            std::optional< VM::Registers > parseRegisters( std::string_view output );
+            std::vector< VM::StackEntry >  parseStack( std::string_view output );
         }
     };
 }
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Manage/Backend.hpp"
+#include "VBox/Manage/CLIBackend.hpp"
+#include "VBox/Manage/ConsoleBackend.hpp"
+#include "VBox/Manage/FallbackBackend.hpp"
+
+namespace VBox
+{
+    namespace Manage
+    {
+        std::shared_ptr< Backend > Backend::forVM( const std::string & vmName )
+        {
+            return forVM( vmName, ConsoleBackend::configuredPort( vmName ) );
+        }
+        
+        std::shared_ptr< Backend > Backend::forVM( const std::string & vmName, uint16_t port )
+        {
+            return std::make_shared< FallbackBackend >( std::make_shared< ConsoleBackend >( vmName, port ), std::make_shared< CLIBackend >( vmName ) );
+        }
+        
+        std::vector< VM::Registers > Backend::allRegisters( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::optional< VM::Registers > regs( this->registers( deadline, cancellation ) );
+            
+            if( regs.has_value() == false )
+            {
+                return {};
+            }
+            
+            return { regs.value() };
+        }
+        
+        std::vector< std::vector< VM::StackEntry > > Backend::allStacks( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::vector< VM::StackEntry > stack( this->stack( deadline, cancellation ) );
+            
+            if( stack.empty() )
+            {
+                return {};
+            }
+            
+            return { stack };
+        }
+        
+        bool Backend::pause( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            ( void )deadline;
+            ( void )cancellation;
+            
+            return false;
+        }
+        
+        bool Backend::seek( double seconds )
+        {
+            ( void )seconds;
+            
+            return false;
+        }
+    }
+}
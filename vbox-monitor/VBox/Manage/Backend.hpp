@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_MANAGE_BACKEND_HPP
+#define VBOX_MANAGE_BACKEND_HPP
+
+#include "VBox/VM/Registers.hpp"
+#include "VBox/VM/StackEntry.hpp"
+#include "VBox/VM/CoreDump.hpp"
+#include "VBox/Deadline.hpp"
+#include "VBox/Cancellation.hpp"
+#include <string>
+#include <vector>
+#include <optional>
+#include <memory>
+#include <cstdint>
+
+namespace VBox
+{
+    namespace Manage
+    {
+        class Backend
+        {
+            public:
+                
+                static std::shared_ptr< Backend > forVM( const std::string & vmName );
+                static std::shared_ptr< Backend > forVM( const std::string & vmName, uint16_t port );
+                
+                virtual ~Backend( void ) = default;
+                
+                virtual std::string name( void )   const = 0;
+                virtual std::string vmName( void ) const = 0;
+                
+                virtual bool                                    live( const Deadline & deadline, const Cancellation & cancellation )                                      = 0;
+                virtual std::optional< VM::Registers >          registers( const Deadline & deadline, const Cancellation & cancellation )                                 = 0;
+                virtual std::vector< VM::StackEntry >           stack( const Deadline & deadline, const Cancellation & cancellation )                                     = 0;
+                virtual std::shared_ptr< VM::CoreDump >         dump( const std::string & path, const Deadline & deadline, const Cancellation & cancellation )            = 0;
+                virtual std::optional< std::vector< uint8_t > > readMemory( uint64_t address, size_t size, const Deadline & deadline, const Cancellation & cancellation ) = 0;
+                
+                virtual std::vector< VM::Registers >                 allRegisters( const Deadline & deadline, const Cancellation & cancellation );
+                virtual std::vector< std::vector< VM::StackEntry > > allStacks( const Deadline & deadline, const Cancellation & cancellation );
+                
+                virtual bool pause( const Deadline & deadline, const Cancellation & cancellation );
+                virtual bool seek( double seconds );
+        };
+    }
+}
+
+#endif /* VBOX_MANAGE_BACKEND_HPP */
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Manage/CLIBackend.hpp"
+#include "VBox/Manage.hpp"
+#include <mutex>
+#include <chrono>
+
+namespace VBox
+{
+    namespace Manage
+    {
+        class CLIBackend::IMPL
+        {
+            public:
+                
+                IMPL( const std::string & vmName );
+                
+                size_t _cpuCount( const Deadline & deadline, const Cancellation & cancellation );
+                
+                std::string                           _vmName;
+                std::optional< size_t >               _cpus;
+                std::chrono::steady_clock::time_point _cpuRetry;
+                std::mutex                            _mtx;
+        };
+        
+        static const std::chrono::seconds CPUCountRetryInterval( 1 );
+        
+        CLIBackend::CLIBackend( const std::string & vmName ):
+            impl( std::make_unique< IMPL >( vmName ) )
+        {}
+        
+        CLIBackend::~CLIBackend( void )
+        {}
+        
+        std::string CLIBackend::name( void ) const
+        {
+            return "VBoxManage";
+        }
+        
+        std::string CLIBackend::vmName( void ) const
+        {
+            return this->impl->_vmName;
+        }
+        
+        bool CLIBackend::live( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            for( const auto & info: runningVMs( deadline, cancellation ) )
+            {
+                if( info.name() == this->impl->_vmName )
+                {
+                    return true;
+                }
+            }
+            
+            return false;
+        }
+        
+        std::optional< VM::Registers > CLIBackend::registers( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return Debug::registers( this->impl->_vmName, deadline, cancellation );
+        }
+        
+        std::vector< VM::StackEntry > CLIBackend::stack( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return Debug::stack( this->impl->_vmName, deadline, cancellation );
+        }
+        
+        std::shared_ptr< VM::CoreDump > CLIBackend::dump( const std::string & path, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return Debug::dump( this->impl->_vmName, path, deadline, cancellation );
+        }
+        
+        std::optional< std::vector< uint8_t > > CLIBackend::readMemory( uint64_t address, size_t size, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            ( void )address;
+            ( void )size;
+            ( void )deadline;
+            ( void )cancellation;
+            
+            return {};
+        }
+        
+        std::vector< VM::Registers > CLIBackend::allRegisters( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return Debug::allRegisters( this->impl->_vmName, this->impl->_cpuCount( deadline, cancellation ), deadline, cancellation );
+        }
+        
+        std::vector< std::vector< VM::StackEntry > > CLIBackend::allStacks( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return Debug::allStacks( this->impl->_vmName, this->impl->_cpuCount( deadline, cancellation ), deadline, cancellation );
+        }
+        
+        bool CLIBackend::pause( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return Manage::pauseVM( this->impl->_vmName, deadline, cancellation );
+        }
+        
+        CLIBackend::IMPL::IMPL( const std::string & vmName ):
+            _vmName( vmName )
+        {}
+        
+        size_t CLIBackend::IMPL::_cpuCount( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::lock_guard< std::mutex > l( this->_mtx );
+            
+            if( this->_cpus.has_value() == false && std::chrono::steady_clock::now() >= this->_cpuRetry )
+            {
+                this->_cpus     = cpuCount( this->_vmName, deadline, cancellation );
+                this->_cpuRetry = std::chrono::steady_clock::now() + CPUCountRetryInterval;
+            }
+            
+            return this->_cpus.value_or( 1 );
+        }
+    }
+}
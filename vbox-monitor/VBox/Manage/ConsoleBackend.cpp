@@ -0,0 +1,809 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Manage/ConsoleBackend.hpp"
+#include "VBox/Manage.hpp"
+#include "VBox/Descriptors.hpp"
+#include "VBox/String.hpp"
+#include "VBox/Tokenizer.hpp"
+#include "VBox/Casts.hpp"
+#include "VBox/Stats.hpp"
+#include <mutex>
+#include <map>
+#include <chrono>
+#include <cctype>
+#include <cstring>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+namespace VBox
+{
+    namespace Manage
+    {
+        class ConsoleBackend::IMPL
+        {
+            public:
+                
+                IMPL( const std::string & vmName, uint16_t port );
+                ~IMPL( void );
+                
+                bool                                        _connect( const Deadline & deadline, const Cancellation & cancellation );
+                void                                        _disconnect( void );
+                bool                                        _send( const std::string & s );
+                std::optional< std::vector< std::string > > _receive( size_t count, const Deadline & deadline, const Cancellation & cancellation );
+                std::optional< std::string >                _command( const std::string & command, const Deadline & deadline, const Cancellation & cancellation );
+                std::optional< std::string >                _commands( const std::vector< std::string > & commands, const Deadline & deadline, const Cancellation & cancellation );
+                std::optional< std::vector< std::string > > _batch( const std::vector< std::string > & commands, const Deadline & deadline, const Cancellation & cancellation );
+                std::optional< std::vector< std::string > > _perCPU( const std::vector< std::string > & commands, const Deadline & deadline, const Cancellation & cancellation );
+                size_t                                      _cpuCount( const Deadline & deadline, const Cancellation & cancellation );
+                
+                static const std::vector< std::string > & _registerCommands( void );
+                
+                static std::string                             _join( std::vector< std::string >::const_iterator begin, std::vector< std::string >::const_iterator end );
+                static std::optional< VM::Registers >          _parseRegisters( std::string_view output );
+                static std::optional< std::vector< uint8_t > > _parseMemory( std::string_view output, size_t size );
+                
+                std::string                           _vmName;
+                uint16_t                              _port;
+                int                                   _socket;
+                std::mutex                            _mtx;
+                std::optional< size_t >               _cpus;
+                std::chrono::steady_clock::time_point _cpuRetry;
+                std::mutex                            _cpuMtx;
+        };
+        
+        static const char * const ConsolePrompt  = "VBoxDbg> ";
+        static const int          ConsoleTimeout = 5000;
+        
+        static const std::chrono::seconds CPUCountRetryInterval( 1 );
+        
+        static const std::vector< std::string > ConsoleKeys =
+        {
+            "VBoxInternal/DBGC/Enabled",
+            "VBoxInternal/DBGC/Port",
+            "VBoxInternal/DBGC/Address"
+        };
+        
+        static std::mutex & savedMutex( void )
+        {
+            static std::mutex mtx;
+            
+            return mtx;
+        }
+        
+        static std::map< std::string, std::vector< std::string > > & savedExtraData( void )
+        {
+            static std::map< std::string, std::vector< std::string > > saved;
+            
+            return saved;
+        }
+        
+        uint16_t ConsoleBackend::defaultPort( void )
+        {
+            return 5000;
+        }
+        
+        std::optional< uint16_t > ConsoleBackend::availablePort( void )
+        {
+            struct sockaddr_in        addr;
+            socklen_t                 length( sizeof( addr ) );
+            int                       fd( Descriptors::socket( AF_INET, SOCK_STREAM, 0 ) );
+            std::optional< uint16_t > port;
+            
+            if( fd == -1 )
+            {
+                return {};
+            }
+            
+            memset( &addr, 0, sizeof( addr ) );
+            
+            addr.sin_family      = AF_INET;
+            addr.sin_port        = 0;
+            addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+            
+            if
+            (
+                   bind( fd, reinterpret_cast< struct sockaddr * >( &addr ), sizeof( addr ) ) == 0
+                && getsockname( fd, reinterpret_cast< struct sockaddr * >( &addr ), &length ) == 0
+                && ntohs( addr.sin_port ) != 0
+            )
+            {
+                port = ntohs( addr.sin_port );
+            }
+            
+            ::close( fd );
+            
+            return port;
+        }
+        
+        uint16_t ConsoleBackend::configuredPort( const std::string & vmName )
+        {
+            std::string port( getExtraData( vmName, ConsoleKeys[ 1 ] ).value_or( "" ) );
+            
+            if( port.empty() || port.length() > 5 || port.find_first_not_of( "0123456789" ) != std::string::npos || std::stoul( port ) == 0 || std::stoul( port ) > UINT16_MAX )
+            {
+                return defaultPort();
+            }
+            
+            return numeric_cast< uint16_t >( std::stoul( port ) );
+        }
+        
+        bool ConsoleBackend::enable( const std::string & vmName, uint16_t port )
+        {
+            std::vector< std::string > previous;
+            
+            for( const auto & key: ConsoleKeys )
+            {
+                std::optional< std::string > value( getExtraData( vmName, key ) );
+                
+                if( value.has_value() == false )
+                {
+                    return false;
+                }
+                
+                previous.push_back( value.value() );
+            }
+            
+            {
+                std::lock_guard< std::mutex > l( savedMutex() );
+                
+                savedExtraData().emplace( vmName, previous );
+            }
+            
+            return setExtraData( vmName, ConsoleKeys[ 0 ], "1" )
+                && setExtraData( vmName, ConsoleKeys[ 1 ], std::to_string( port ) )
+                && setExtraData( vmName, ConsoleKeys[ 2 ], "127.0.0.1" );
+        }
+        
+        bool ConsoleBackend::restore( const std::string & vmName )
+        {
+            std::vector< std::string > previous;
+            bool                       success( true );
+            
+            {
+                std::lock_guard< std::mutex > l( savedMutex() );
+                auto                          it( savedExtraData().find( vmName ) );
+                
+                if( it == savedExtraData().end() )
+                {
+                    return true;
+                }
+                
+                previous = it->second;
+                
+                savedExtraData().erase( it );
+            }
+            
+            for( size_t i = 0; i < ConsoleKeys.size(); i++ )
+            {
+                success = setExtraData( vmName, ConsoleKeys[ i ], previous[ i ] ) && success;
+            }
+            
+            return success;
+        }
+        
+        ConsoleBackend::ConsoleBackend( const std::string & vmName, uint16_t port ):
+            impl( std::make_unique< IMPL >( vmName, port ) )
+        {}
+        
+        ConsoleBackend::~ConsoleBackend( void )
+        {}
+        
+        bool ConsoleBackend::connected( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_socket != -1;
+        }
+        
+        uint16_t ConsoleBackend::port( void ) const
+        {
+            return this->impl->_port;
+        }
+        
+        std::string ConsoleBackend::name( void ) const
+        {
+            return "VBoxDbg";
+        }
+        
+        std::string ConsoleBackend::vmName( void ) const
+        {
+            return this->impl->_vmName;
+        }
+        
+        bool ConsoleBackend::live( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            if( this->impl->_socket == -1 )
+            {
+                return this->impl->_connect( deadline, cancellation );
+            }
+            
+            {
+                struct pollfd p;
+                char          c;
+                
+                memset( &p, 0, sizeof( p ) );
+                
+                p.fd     = this->impl->_socket;
+                p.events = POLLIN;
+                
+                if( poll( &p, 1, 0 ) > 0 )
+                {
+                    if( ( p.revents & ( POLLHUP | POLLERR ) ) != 0 || recv( this->impl->_socket, &c, 1, MSG_PEEK ) <= 0 )
+                    {
+                        this->impl->_disconnect();
+                        
+                        return false;
+                    }
+                }
+            }
+            
+            return true;
+        }
+        
+        std::optional< VM::Registers > ConsoleBackend::registers( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::optional< std::string > out( this->impl->_commands( IMPL::_registerCommands(), deadline, cancellation ) );
+            
+            if( out.has_value() == false )
+            {
+                return {};
+            }
+            
+            return IMPL::_parseRegisters( out.value() );
+        }
+        
+        std::vector< VM::StackEntry > ConsoleBackend::stack( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::optional< std::string > out( this->impl->_command( "k", deadline, cancellation ) );
+            
+            if( out.has_value() == false )
+            {
+                return {};
+            }
+            
+            return Debug::parseStack( out.value() );
+        }
+        
+        std::shared_ptr< VM::CoreDump > ConsoleBackend::dump( const std::string & path, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            try
+            {
+                return Debug::streamDump( path, [ & ] { return this->impl->_command( "writecore " + path, deadline, cancellation ).has_value(); } );
+            }
+            catch( ... )
+            {
+                return {};
+            }
+        }
+        
+        std::optional< std::vector< uint8_t > > ConsoleBackend::readMemory( uint64_t address, size_t size, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::optional< std::string > out;
+            
+            if( size == 0 )
+            {
+                return std::vector< uint8_t >();
+            }
+            
+            out = this->impl->_command( "db %%" + String::toHex( address ).substr( 2 ) + " L " + String::toHex( size ).substr( 2 ), deadline, cancellation );
+            
+            if( out.has_value() == false )
+            {
+                return {};
+            }
+            
+            return IMPL::_parseMemory( out.value(), size );
+        }
+        
+        std::vector< VM::Registers > ConsoleBackend::allRegisters( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::optional< std::vector< std::string > > out( this->impl->_perCPU( IMPL::_registerCommands(), deadline, cancellation ) );
+            std::vector< VM::Registers >                all;
+            
+            if( out.has_value() == false )
+            {
+                return {};
+            }
+            
+            for( const auto & cpu: out.value() )
+            {
+                std::optional< VM::Registers > regs( IMPL::_parseRegisters( cpu ) );
+                
+                if( regs.has_value() == false )
+                {
+                    return {};
+                }
+                
+                all.push_back( regs.value() );
+            }
+            
+            return all;
+        }
+        
+        std::vector< std::vector< VM::StackEntry > > ConsoleBackend::allStacks( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::optional< std::vector< std::string > >  out( this->impl->_perCPU( { "k" }, deadline, cancellation ) );
+            std::vector< std::vector< VM::StackEntry > > all;
+            
+            if( out.has_value() == false )
+            {
+                return {};
+            }
+            
+            for( const auto & cpu: out.value() )
+            {
+                all.push_back( Debug::parseStack( cpu ) );
+            }
+            
+            return all;
+        }
+        
+        bool ConsoleBackend::pause( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_command( "stop", deadline, cancellation ).has_value();
+        }
+        
+        ConsoleBackend::IMPL::IMPL( const std::string & vmName, uint16_t port ):
+            _vmName( vmName ),
+            _port(   port ),
+            _socket( -1 )
+        {
+            this->_connect( Deadline::after( std::chrono::milliseconds( ConsoleTimeout ) ), {} );
+        }
+        
+        ConsoleBackend::IMPL::~IMPL( void )
+        {
+            this->_disconnect();
+        }
+        
+        bool ConsoleBackend::IMPL::_connect( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            struct sockaddr_in addr;
+            int                one( 1 );
+            
+            memset( &addr, 0, sizeof( addr ) );
+            
+            addr.sin_family      = AF_INET;
+            addr.sin_port        = htons( this->_port );
+            addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+            
+            this->_socket = Descriptors::socket( AF_INET, SOCK_STREAM, 0 );
+            
+            if( this->_socket == -1 )
+            {
+                return false;
+            }
+            
+            if( connect( this->_socket, reinterpret_cast< struct sockaddr * >( &addr ), sizeof( addr ) ) == -1 )
+            {
+                this->_disconnect();
+                
+                return false;
+            }
+            
+            setsockopt( this->_socket, IPPROTO_TCP, TCP_NODELAY, &one, sizeof( one ) );
+            
+            #ifdef SO_NOSIGPIPE
+            setsockopt( this->_socket, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof( one ) );
+            #endif
+            
+            if( this->_receive( 1, deadline, cancellation ).has_value() == false )
+            {
+                this->_disconnect();
+                
+                return false;
+            }
+            
+            return true;
+        }
+        
+        void ConsoleBackend::IMPL::_disconnect( void )
+        {
+            if( this->_socket != -1 )
+            {
+                close( this->_socket );
+            }
+            
+            this->_socket = -1;
+        }
+        
+        bool ConsoleBackend::IMPL::_send( const std::string & s )
+        {
+            size_t sent( 0 );
+            
+            while( sent < s.size() )
+            {
+                #ifdef MSG_NOSIGNAL
+                ssize_t n( ::send( this->_socket, s.data() + sent, s.size() - sent, MSG_NOSIGNAL ) );
+                #else
+                ssize_t n( ::send( this->_socket, s.data() + sent, s.size() - sent, 0 ) );
+                #endif
+                
+                if( n <= 0 )
+                {
+                    return false;
+                }
+                
+                sent += numeric_cast< size_t >( n );
+            }
+            
+            return true;
+        }
+        
+        std::optional< std::vector< std::string > > ConsoleBackend::IMPL::_receive( size_t count, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::string                out;
+            std::vector< std::string > outputs;
+            size_t                     promptLength( strlen( ConsolePrompt ) );
+            size_t                     prompts( 0 );
+            size_t                     scanned( 0 );
+            char                       buf[ 4096 ];
+            int                        cancel( cancellation.fd() );
+            
+            while( prompts < count || out.size() < promptLength || out.compare( out.size() - promptLength, promptLength, ConsolePrompt ) != 0 )
+            {
+                struct pollfd p[ 2 ];
+                ssize_t       n;
+                
+                memset( p, 0, sizeof( p ) );
+                
+                p[ 0 ].fd     = this->_socket;
+                p[ 0 ].events = POLLIN;
+                p[ 1 ].fd     = cancel;
+                p[ 1 ].events = POLLIN;
+                
+                if( cancellation.cancelled() || deadline.expired() || poll( p, 2, deadline.timeout( ConsoleTimeout ) ) <= 0 || p[ 1 ].revents != 0 )
+                {
+                    return {};
+                }
+                
+                n = recv( this->_socket, buf, sizeof( buf ), 0 );
+                
+                if( n <= 0 )
+                {
+                    return {};
+                }
+                
+                out.append( buf, numeric_cast< size_t >( n ) );
+                
+                for( size_t pos = out.find( ConsolePrompt, scanned ); pos != std::string::npos; pos = out.find( ConsolePrompt, scanned ) )
+                {
+                    prompts++;
+                    scanned = pos + promptLength;
+                }
+            }
+            
+            for( size_t start = 0, pos = out.find( ConsolePrompt ); pos != std::string::npos; start = pos + promptLength, pos = out.find( ConsolePrompt, start ) )
+            {
+                outputs.push_back( out.substr( start, pos - start ) );
+            }
+            
+            return outputs;
+        }
+        
+        std::optional< std::string > ConsoleBackend::IMPL::_command( const std::string & command, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::lock_guard< std::mutex >               l( this->_mtx );
+            std::optional< std::vector< std::string > > out;
+            
+            if( this->_socket == -1 && this->_connect( deadline, cancellation ) == false )
+            {
+                return {};
+            }
+            
+            if( this->_send( command + "\n" ) == false )
+            {
+                this->_disconnect();
+                
+                return {};
+            }
+            
+            out = this->_receive( 1, deadline, cancellation );
+            
+            if( out.has_value() == false )
+            {
+                this->_disconnect();
+                
+                return {};
+            }
+            
+            return _join( out->begin(), out->end() );
+        }
+        
+        std::optional< std::string > ConsoleBackend::IMPL::_commands( const std::vector< std::string > & commands, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::optional< std::vector< std::string > > out( this->_batch( commands, deadline, cancellation ) );
+            
+            if( out.has_value() == false )
+            {
+                return {};
+            }
+            
+            return _join( out->begin(), out->end() );
+        }
+        
+        std::optional< std::vector< std::string > > ConsoleBackend::IMPL::_batch( const std::vector< std::string > & commands, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::lock_guard< std::mutex >               l( this->_mtx );
+            Stats::Timer                                timer( "Manage::ConsoleBackend::batch" );
+            std::optional< std::vector< std::string > > out;
+            std::string                                 batch;
+            
+            if( commands.empty() || ( this->_socket == -1 && this->_connect( deadline, cancellation ) == false ) )
+            {
+                return {};
+            }
+            
+            for( const auto & command: commands )
+            {
+                batch += command + "\n";
+            }
+            
+            if( this->_send( batch ) == false )
+            {
+                this->_disconnect();
+                
+                return {};
+            }
+            
+            out = this->_receive( commands.size(), deadline, cancellation );
+            
+            if( out.has_value() == false )
+            {
+                this->_disconnect();
+                
+                return {};
+            }
+            
+            out->erase( out->begin(), out->end() - numeric_cast< std::ptrdiff_t >( commands.size() ) );
+            
+            return out;
+        }
+        
+        std::optional< std::vector< std::string > > ConsoleBackend::IMPL::_perCPU( const std::vector< std::string > & commands, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            size_t                                      cpus( this->_cpuCount( deadline, cancellation ) );
+            size_t                                      stride( commands.size() + ( ( cpus > 1 ) ? 1 : 0 ) );
+            std::vector< std::string >                  batch;
+            std::optional< std::vector< std::string > > out;
+            std::vector< std::string >                  all;
+            
+            for( size_t i = 0; i < cpus; i++ )
+            {
+                if( cpus > 1 )
+                {
+                    batch.push_back( "cpu " + std::to_string( i ) );
+                }
+                
+                batch.insert( batch.end(), commands.begin(), commands.end() );
+            }
+            
+            if( cpus > 1 )
+            {
+                batch.push_back( "cpu 0" );
+            }
+            
+            out = this->_batch( batch, deadline, cancellation );
+            
+            if( out.has_value() == false )
+            {
+                return {};
+            }
+            
+            for( size_t i = 0; i < cpus; i++ )
+            {
+                auto end( out->begin() + numeric_cast< std::ptrdiff_t >( ( i + 1 ) * stride ) );
+                
+                all.push_back( _join( end - numeric_cast< std::ptrdiff_t >( commands.size() ), end ) );
+            }
+            
+            return all;
+        }
+        
+        size_t ConsoleBackend::IMPL::_cpuCount( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::lock_guard< std::mutex > l( this->_cpuMtx );
+            
+            if( this->_cpus.has_value() == false && std::chrono::steady_clock::now() >= this->_cpuRetry )
+            {
+                this->_cpus     = cpuCount( this->_vmName, deadline, cancellation );
+                this->_cpuRetry = std::chrono::steady_clock::now() + CPUCountRetryInterval;
+            }
+            
+            return this->_cpus.value_or( 1 );
+        }
+        
+        const std::vector< std::string > & ConsoleBackend::IMPL::_registerCommands( void )
+        {
+            static const std::vector< std::string > commands
+            (
+                []( void )
+                {
+                    std::vector< std::string > v( { "r" } );
+                    
+                    for( const auto & name: VM::Registers::names() )
+                    {
+                        if( name.substr( 0, 2 ) == "cr" || name == "efer" || ( name.length() == 2 && name[ 1 ] == 's' ) || name.find( "_base" ) != std::string::npos || name.substr( 0, 3 ) == "ymm" )
+                        {
+                            v.push_back( "r " + name );
+                        }
+                    }
+                    
+                    return v;
+                }
+                ()
+            );
+            
+            return commands;
+        }
+        
+        std::string ConsoleBackend::IMPL::_join( std::vector< std::string >::const_iterator begin, std::vector< std::string >::const_iterator end )
+        {
+            std::string out;
+            
+            for( auto it = begin; it != end; ++it )
+            {
+                out += ( it == begin ) ? *( it ) : "\n" + *( it );
+            }
+            
+            return out;
+        }
+        
+        std::optional< VM::Registers > ConsoleBackend::IMPL::_parseRegisters( std::string_view output )
+        {
+            VM::Registers    reg;
+            size_t           matched( 0 );
+            std::string_view group;
+            size_t           close( 0 );
+            
+            for( size_t i = 0; i < output.size(); i++ )
+            {
+                size_t           end;
+                size_t           start;
+                size_t           value;
+                std::string_view name;
+                
+                if( output[ i ] != '=' )
+                {
+                    continue;
+                }
+                
+                end = i;
+                
+                while( end > 0 && output[ end - 1 ] == ' ' )
+                {
+                    end--;
+                }
+                
+                start = end;
+                
+                while( start > 0 && ( isalnum( static_cast< unsigned char >( output[ start - 1 ] ) ) || output[ start - 1 ] == '_' ) )
+                {
+                    start--;
+                }
+                
+                if( start == end )
+                {
+                    continue;
+                }
+                
+                value = output.find_first_not_of( ' ', i + 1 );
+                
+                if( value == std::string_view::npos )
+                {
+                    continue;
+                }
+                
+                name = output.substr( start, end - start );
+                
+                if( group.empty() == false && i < close && name == "base" )
+                {
+                    if( reg.set( std::string( group ) + "_base", output.substr( value ) ) )
+                    {
+                        matched++;
+                    }
+                    
+                    continue;
+                }
+                
+                if( output[ value ] == '{' )
+                {
+                    group = name;
+                    close = std::min( output.find( '}', value ), output.size() );
+                }
+                
+                if( reg.set( name, output.substr( value ) ) )
+                {
+                    matched++;
+                }
+            }
+            
+            if( matched == 0 )
+            {
+                return {};
+            }
+            
+            return reg;
+        }
+        
+        std::optional< std::vector< uint8_t > > ConsoleBackend::IMPL::_parseMemory( std::string_view output, size_t size )
+        {
+            std::vector< uint8_t > data;
+            Tokenizer              lines( output );
+            std::string_view       line;
+            
+            data.reserve( size );
+            
+            while( lines.line( line ) )
+            {
+                Tokenizer t( line );
+                size_t    count( 0 );
+                
+                if( t.expect( '%' ) == false )
+                {
+                    continue;
+                }
+                
+                t.until( ':' );
+                
+                if( t.expect( ':' ) == false )
+                {
+                    continue;
+                }
+                
+                while( count < 16 && ( t.expect( ' ' ) || t.expect( '-' ) ) )
+                {
+                    std::string_view byte( t.rest().substr( 0, 2 ) );
+                    uint8_t          b( 0 );
+                    
+                    if( byte.length() < 2 || String::fromHex( byte.data(), byte.data() + 2, b ) != byte.data() + 2 )
+                    {
+                        break;
+                    }
+                    
+                    t.expect( byte );
+                    data.push_back( b );
+                    
+                    count++;
+                }
+            }
+            
+            if( data.size() < size )
+            {
+                return {};
+            }
+            
+            data.resize( size );
+            
+            return data;
+        }
+    }
+}
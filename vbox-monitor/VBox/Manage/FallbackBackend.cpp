@@ -0,0 +1,143 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Manage/FallbackBackend.hpp"
+#include <mutex>
+#include <chrono>
+#include <optional>
+
+namespace VBox
+{
+    namespace Manage
+    {
+        class FallbackBackend::IMPL
+        {
+            public:
+                
+                IMPL( const std::shared_ptr< Backend > & preferred, const std::shared_ptr< Backend > & fallback );
+                
+                Backend & _select( const Deadline & deadline, const Cancellation & cancellation );
+                
+                std::shared_ptr< Backend >                             _preferred;
+                std::shared_ptr< Backend >                             _fallback;
+                bool                                                   _active;
+                std::optional< std::chrono::steady_clock::time_point > _attempt;
+                mutable std::mutex                                     _mtx;
+        };
+        
+        static const std::chrono::seconds RetryInterval( 5 );
+        
+        FallbackBackend::FallbackBackend( const std::shared_ptr< Backend > & preferred, const std::shared_ptr< Backend > & fallback ):
+            impl( std::make_unique< IMPL >( preferred, fallback ) )
+        {}
+        
+        FallbackBackend::~FallbackBackend( void )
+        {}
+        
+        std::string FallbackBackend::name( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return ( this->impl->_active ) ? this->impl->_preferred->name() : this->impl->_fallback->name();
+        }
+        
+        std::string FallbackBackend::vmName( void ) const
+        {
+            return this->impl->_preferred->vmName();
+        }
+        
+        bool FallbackBackend::live( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_select( deadline, cancellation ).live( deadline, cancellation );
+        }
+        
+        std::optional< VM::Registers > FallbackBackend::registers( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_select( deadline, cancellation ).registers( deadline, cancellation );
+        }
+        
+        std::vector< VM::StackEntry > FallbackBackend::stack( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_select( deadline, cancellation ).stack( deadline, cancellation );
+        }
+        
+        std::shared_ptr< VM::CoreDump > FallbackBackend::dump( const std::string & path, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_select( deadline, cancellation ).dump( path, deadline, cancellation );
+        }
+        
+        std::optional< std::vector< uint8_t > > FallbackBackend::readMemory( uint64_t address, size_t size, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_select( deadline, cancellation ).readMemory( address, size, deadline, cancellation );
+        }
+        
+        std::vector< VM::Registers > FallbackBackend::allRegisters( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_select( deadline, cancellation ).allRegisters( deadline, cancellation );
+        }
+        
+        std::vector< std::vector< VM::StackEntry > > FallbackBackend::allStacks( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_select( deadline, cancellation ).allStacks( deadline, cancellation );
+        }
+        
+        bool FallbackBackend::pause( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_select( deadline, cancellation ).pause( deadline, cancellation );
+        }
+        
+        FallbackBackend::IMPL::IMPL( const std::shared_ptr< Backend > & preferred, const std::shared_ptr< Backend > & fallback ):
+            _preferred( preferred ),
+            _fallback(  fallback ),
+            _active(    false )
+        {}
+        
+        Backend & FallbackBackend::IMPL::_select( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::chrono::steady_clock::time_point now( std::chrono::steady_clock::now() );
+            bool                                  active;
+            
+            {
+                std::lock_guard< std::mutex > l( this->_mtx );
+                
+                if( this->_attempt.has_value() && now - this->_attempt.value() < RetryInterval )
+                {
+                    return ( this->_active ) ? *( this->_preferred ) : *( this->_fallback );
+                }
+                
+                this->_attempt = now;
+            }
+            
+            active = this->_preferred->live( deadline, cancellation );
+            
+            {
+                std::lock_guard< std::mutex > l( this->_mtx );
+                
+                this->_active = active;
+            }
+            
+            return ( active ) ? *( this->_preferred ) : *( this->_fallback );
+        }
+    }
+}
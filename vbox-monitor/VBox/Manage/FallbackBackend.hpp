@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_MANAGE_FALLBACK_BACKEND_HPP
+#define VBOX_MANAGE_FALLBACK_BACKEND_HPP
+
+#include "VBox/Manage/Backend.hpp"
+#include <memory>
+#include <algorithm>
+
+namespace VBox
+{
+    namespace Manage
+    {
+        class FallbackBackend: public Backend
+        {
+            public:
+                
+                FallbackBackend( const std::shared_ptr< Backend > & preferred, const std::shared_ptr< Backend > & fallback );
+                
+                virtual ~FallbackBackend( void );
+                
+                FallbackBackend( const FallbackBackend & o )              = delete;
+                FallbackBackend( FallbackBackend && o )                   = delete;
+                FallbackBackend & operator =( const FallbackBackend & o ) = delete;
+                FallbackBackend & operator =( FallbackBackend && o )      = delete;
+                
+                std::string name( void )   const override;
+                std::string vmName( void ) const override;
+                
+                bool                                    live( const Deadline & deadline, const Cancellation & cancellation )                                      override;
+                std::optional< VM::Registers >          registers( const Deadline & deadline, const Cancellation & cancellation )                                 override;
+                std::vector< VM::StackEntry >           stack( const Deadline & deadline, const Cancellation & cancellation )                                     override;
+                std::shared_ptr< VM::CoreDump >         dump( const std::string & path, const Deadline & deadline, const Cancellation & cancellation )            override;
+                std::optional< std::vector< uint8_t > > readMemory( uint64_t address, size_t size, const Deadline & deadline, const Cancellation & cancellation ) override;
+                
+                std::vector< VM::Registers >                 allRegisters( const Deadline & deadline, const Cancellation & cancellation ) override;
+                std::vector< std::vector< VM::StackEntry > > allStacks( const Deadline & deadline, const Cancellation & cancellation )    override;
+                
+                bool pause( const Deadline & deadline, const Cancellation & cancellation ) override;
+                
+            private:
+                
+                class IMPL;
+                
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_MANAGE_FALLBACK_BACKEND_HPP */
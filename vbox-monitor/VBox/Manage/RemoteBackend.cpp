@@ -0,0 +1,782 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Manage/RemoteBackend.hpp"
+#include "VBox/Remote/Protocol.hpp"
+#include "VBox/Trace/Format.hpp"
+#include "VBox/VM/MemoryCache.hpp"
+#include "VBox/BinaryDataStream.hpp"
+#include "VBox/Descriptors.hpp"
+#include "VBox/Casts.hpp"
+#include "VBox/Stats.hpp"
+#include "VBox/SHA256.hpp"
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+namespace VBox
+{
+    namespace Manage
+    {
+        class RemoteBackend::IMPL
+        {
+            public:
+                
+                class Stream: public BinaryStream
+                {
+                    public:
+                        
+                        Stream( IMPL & backend, size_t size, const Deadline & deadline, const Cancellation & cancellation );
+                        
+                        using BinaryStream::Read;
+                        
+                        void   Read( uint8_t * buf, size_t size )        override;
+                        void   Seek( ssize_t offset, SeekDirection dir ) override;
+                        size_t Tell( void )                        const override;
+                        size_t AvailableBytes( void )                    override;
+                        
+                        bool finish( void );
+                        
+                    private:
+                        
+                        bool _next( void );
+                        
+                        IMPL                 & _backend;
+                        size_t                 _size;
+                        size_t                 _position;
+                        std::vector< uint8_t > _chunk;
+                        size_t                 _chunkOffset;
+                        bool                   _ended;
+                        const Deadline       & _deadline;
+                        const Cancellation   & _cancellation;
+                };
+                
+                IMPL( const std::string & host, uint16_t port, const std::string & vmName, const std::string & token );
+                ~IMPL( void );
+                
+                bool _connect( const Deadline & deadline, const Cancellation & cancellation );
+                void _disconnect( void );
+                bool _send( Remote::Protocol::Message type, const std::vector< uint8_t > & arguments, const Deadline & deadline, const Cancellation & cancellation );
+                
+                template< typename _T_ >
+                _T_ _call( Remote::Protocol::Message type, const std::vector< uint8_t > & arguments, const Deadline & deadline, const Cancellation & cancellation, _T_ fallback, const std::function< _T_( BinaryStream & ) > & parse );
+                
+                std::string                                            _host;
+                uint16_t                                               _port;
+                std::string                                            _vmName;
+                std::string                                            _token;
+                int                                                    _socket;
+                std::mutex                                             _mtx;
+                std::chrono::steady_clock::time_point                  _retry;
+                Remote::Protocol::Deltas                               _deltas;
+                std::unordered_map< uint64_t, std::vector< uint8_t > > _pages;
+                Remote::Protocol::PageOrder                            _order;
+                mutable std::mutex                                     _infoMtx;
+                std::string                                            _remoteName;
+                bool                                                   _connected;
+        };
+        
+        static const int                       ConnectTimeout = 5000;
+        static const std::chrono::milliseconds RetryInterval( 1000 );
+        static const uint64_t                  MaxCPUs        = 1024;
+        
+        RemoteBackend::RemoteBackend( const std::string & host, uint16_t port, const std::string & vmName, const std::string & token ):
+            impl( std::make_unique< IMPL >( host, port, vmName, token ) )
+        {}
+        
+        RemoteBackend::~RemoteBackend( void )
+        {}
+        
+        bool RemoteBackend::connected( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_infoMtx );
+            
+            return this->impl->_connected;
+        }
+        
+        std::string RemoteBackend::host( void ) const
+        {
+            return this->impl->_host;
+        }
+        
+        uint16_t RemoteBackend::port( void ) const
+        {
+            return this->impl->_port;
+        }
+        
+        std::string RemoteBackend::name( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_infoMtx );
+            
+            if( this->impl->_remoteName.empty() )
+            {
+                return "Remote";
+            }
+            
+            return "Remote " + this->impl->_remoteName;
+        }
+        
+        std::string RemoteBackend::vmName( void ) const
+        {
+            return this->impl->_vmName;
+        }
+        
+        bool RemoteBackend::live( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_call< bool >
+            (
+                Remote::Protocol::Message::Live, {}, deadline, cancellation, false,
+                []( BinaryStream & stream )
+                {
+                    return stream.ReadUInt8() != 0;
+                }
+            );
+        }
+        
+        std::optional< VM::Registers > RemoteBackend::registers( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_call< std::optional< VM::Registers > >
+            (
+                Remote::Protocol::Message::Registers, {}, deadline, cancellation, {},
+                [ this ]( BinaryStream & stream ) -> std::optional< VM::Registers >
+                {
+                    if( stream.ReadUInt8() == 0 )
+                    {
+                        return {};
+                    }
+                    
+                    return Remote::Protocol::registers( this->impl->_deltas.read( stream, Remote::Protocol::Message::Registers, 0 ) );
+                }
+            );
+        }
+        
+        std::vector< VM::StackEntry > RemoteBackend::stack( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_call< std::vector< VM::StackEntry > >
+            (
+                Remote::Protocol::Message::Stack, {}, deadline, cancellation, {},
+                [ this ]( BinaryStream & stream )
+                {
+                    return Remote::Protocol::stack( this->impl->_deltas.read( stream, Remote::Protocol::Message::Stack, 0 ) );
+                }
+            );
+        }
+        
+        std::shared_ptr< VM::CoreDump > RemoteBackend::dump( const std::string & path, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::lock_guard< std::mutex >            l( this->impl->_mtx );
+            Stats::Timer                             timer( "Manage::RemoteBackend::dump" );
+            std::optional< Remote::Protocol::Frame > frame;
+            std::shared_ptr< VM::CoreDump >          dump;
+            uint64_t                                 size;
+            
+            ( void )path;
+            
+            if( this->impl->_send( Remote::Protocol::Message::Dump, {}, deadline, cancellation ) == false )
+            {
+                return {};
+            }
+            
+            frame = Remote::Protocol::receive( this->impl->_socket, deadline, cancellation );
+            
+            if( frame.has_value() == false || frame->first != Remote::Protocol::Message::Dump )
+            {
+                this->impl->_disconnect();
+                
+                return {};
+            }
+            
+            try
+            {
+                BinaryDataStream stream( frame->second );
+                
+                size = Trace::Format::readVarint( stream );
+            }
+            catch( const std::runtime_error & )
+            {
+                this->impl->_disconnect();
+                
+                return {};
+            }
+            
+            {
+                IMPL::Stream stream( *( this->impl ), numeric_cast< size_t >( size ), deadline, cancellation );
+                
+                if( size > 0 )
+                {
+                    try
+                    {
+                        dump = std::make_shared< VM::CoreDump >( stream, true );
+                    }
+                    catch( const std::runtime_error & )
+                    {}
+                }
+                
+                if( stream.finish() == false )
+                {
+                    this->impl->_disconnect();
+                    
+                    return {};
+                }
+            }
+            
+            return dump;
+        }
+        
+        std::optional< std::vector< uint8_t > > RemoteBackend::readMemory( uint64_t address, size_t size, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::vector< uint8_t > arguments;
+            
+            if( size == 0 || size > Remote::Protocol::MaxMessageSize / 2 || address > UINT64_MAX - size )
+            {
+                return {};
+            }
+            
+            Trace::Format::writeVarint( arguments, address );
+            Trace::Format::writeVarint( arguments, size );
+            
+            return this->impl->_call< std::optional< std::vector< uint8_t > > >
+            (
+                Remote::Protocol::Message::Memory, arguments, deadline, cancellation, {},
+                [ & ]( BinaryStream & stream ) -> std::optional< std::vector< uint8_t > >
+                {
+                    uint64_t               pageSize( VM::MemoryCache::pageSize() );
+                    std::vector< uint8_t > data;
+                    
+                    if( stream.ReadUInt8() == 0 )
+                    {
+                        return {};
+                    }
+                    
+                    data.reserve( size );
+                    
+                    for( uint64_t start = address; start < address + size; )
+                    {
+                        uint64_t end( std::min( ( start / pageSize + 1 ) * pageSize, address + size ) );
+                        
+                        if( stream.ReadUInt8() != 0 )
+                        {
+                            std::vector< uint8_t > & page( this->impl->_pages[ start ] );
+                            
+                            page = stream.Read( numeric_cast< size_t >( end - start ) );
+                            
+                            data.insert( data.end(), page.begin(), page.end() );
+                        }
+                        else
+                        {
+                            auto it( this->impl->_pages.find( start ) );
+                            
+                            if( it == this->impl->_pages.end() || it->second.size() != end - start )
+                            {
+                                throw std::runtime_error( "Invalid remote memory reply" );
+                            }
+                            
+                            data.insert( data.end(), it->second.begin(), it->second.end() );
+                        }
+                        
+                        {
+                            std::optional< uint64_t > evicted( this->impl->_order.touch( start ) );
+                            
+                            if( evicted.has_value() )
+                            {
+                                this->impl->_pages.erase( evicted.value() );
+                            }
+                        }
+                        
+                        start = end;
+                    }
+                    
+                    return data;
+                }
+            );
+        }
+        
+        std::vector< VM::Registers > RemoteBackend::allRegisters( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_call< std::vector< VM::Registers > >
+            (
+                Remote::Protocol::Message::AllRegisters, {}, deadline, cancellation, {},
+                [ this ]( BinaryStream & stream )
+                {
+                    uint64_t                     count( Trace::Format::readVarint( stream ) );
+                    std::vector< VM::Registers > all;
+                    
+                    if( count > MaxCPUs )
+                    {
+                        throw std::runtime_error( "Invalid remote CPU count" );
+                    }
+                    
+                    for( size_t i = 0; i < count; i++ )
+                    {
+                        all.push_back( Remote::Protocol::registers( this->impl->_deltas.read( stream, Remote::Protocol::Message::AllRegisters, i ) ) );
+                    }
+                    
+                    return all;
+                }
+            );
+        }
+        
+        std::vector< std::vector< VM::StackEntry > > RemoteBackend::allStacks( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_call< std::vector< std::vector< VM::StackEntry > > >
+            (
+                Remote::Protocol::Message::AllStacks, {}, deadline, cancellation, {},
+                [ this ]( BinaryStream & stream )
+                {
+                    uint64_t                                     count( Trace::Format::readVarint( stream ) );
+                    std::vector< std::vector< VM::StackEntry > > all;
+                    
+                    if( count > MaxCPUs )
+                    {
+                        throw std::runtime_error( "Invalid remote CPU count" );
+                    }
+                    
+                    for( size_t i = 0; i < count; i++ )
+                    {
+                        all.push_back( Remote::Protocol::stack( this->impl->_deltas.read( stream, Remote::Protocol::Message::AllStacks, i ) ) );
+                    }
+                    
+                    return all;
+                }
+            );
+        }
+        
+        bool RemoteBackend::pause( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            return this->impl->_call< bool >
+            (
+                Remote::Protocol::Message::Pause, {}, deadline, cancellation, false,
+                []( BinaryStream & stream )
+                {
+                    return stream.ReadUInt8() != 0;
+                }
+            );
+        }
+        
+        RemoteBackend::IMPL::IMPL( const std::string & host, uint16_t port, const std::string & vmName, const std::string & token ):
+            _host(      host ),
+            _port(      port ),
+            _vmName(    vmName ),
+            _token(     token ),
+            _socket(    -1 ),
+            _connected( false )
+        {}
+        
+        RemoteBackend::IMPL::~IMPL( void )
+        {
+            this->_disconnect();
+        }
+        
+        bool RemoteBackend::IMPL::_connect( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            struct addrinfo                          hints;
+            struct addrinfo                        * result( nullptr );
+            std::vector< uint8_t >                   hello;
+            std::vector< uint8_t >                   nonce;
+            std::optional< Remote::Protocol::Frame > frame;
+            int                                      one( 1 );
+            
+            if( std::chrono::steady_clock::now() < this->_retry )
+            {
+                return false;
+            }
+            
+            this->_retry = std::chrono::steady_clock::now() + RetryInterval;
+            
+            memset( &hints, 0, sizeof( hints ) );
+            
+            hints.ai_family   = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            
+            if( getaddrinfo( this->_host.c_str(), std::to_string( this->_port ).c_str(), &hints, &result ) != 0 )
+            {
+                return false;
+            }
+            
+            for( struct addrinfo * info = result; info != nullptr && this->_socket == -1; info = info->ai_next )
+            {
+                int           socket( Descriptors::socket( info->ai_family, info->ai_socktype, info->ai_protocol ) );
+                int           flags;
+                int           error( 0 );
+                socklen_t     length( sizeof( error ) );
+                struct pollfd p[ 2 ];
+                
+                if( socket == -1 )
+                {
+                    continue;
+                }
+                
+                flags = fcntl( socket, F_GETFL, 0 );
+                
+                fcntl( socket, F_SETFL, flags | O_NONBLOCK );
+                
+                if( ::connect( socket, info->ai_addr, info->ai_addrlen ) != 0 )
+                {
+                    memset( p, 0, sizeof( p ) );
+                    
+                    p[ 0 ].fd     = socket;
+                    p[ 0 ].events = POLLOUT;
+                    p[ 1 ].fd     = cancellation.fd();
+                    p[ 1 ].events = POLLIN;
+                    
+                    if( errno != EINPROGRESS || poll( p, 2, deadline.timeout( ConnectTimeout ) ) <= 0 || p[ 1 ].revents != 0 || getsockopt( socket, SOL_SOCKET, SO_ERROR, &error, &length ) != 0 || error != 0 )
+                    {
+                        ::close( socket );
+                        
+                        continue;
+                    }
+                }
+                
+                fcntl( socket, F_SETFL, flags );
+                
+                this->_socket = socket;
+            }
+            
+            freeaddrinfo( result );
+            
+            if( this->_socket == -1 )
+            {
+                return false;
+            }
+            
+            setsockopt( this->_socket, IPPROTO_TCP, TCP_NODELAY, &one, sizeof( one ) );
+            
+            #ifdef SO_NOSIGPIPE
+            setsockopt( this->_socket, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof( one ) );
+            #endif
+            
+            try
+            {
+                nonce = Remote::Protocol::nonce();
+            }
+            catch( const std::runtime_error & )
+            {
+                this->_disconnect();
+                
+                return false;
+            }
+            
+            hello.insert( hello.end(), Remote::Protocol::Magic.begin(), Remote::Protocol::Magic.end() );
+            hello.push_back( Remote::Protocol::Version );
+            
+            Remote::Protocol::writeString( hello, this->_vmName );
+            
+            hello.insert( hello.end(), nonce.begin(), nonce.end() );
+            
+            if( Remote::Protocol::send( this->_socket, Remote::Protocol::Message::Hello, hello ) )
+            {
+                frame = Remote::Protocol::receive( this->_socket, deadline, cancellation );
+            }
+            
+            if( frame.has_value() == false || frame->first != Remote::Protocol::Message::Challenge )
+            {
+                this->_disconnect();
+                
+                return false;
+            }
+            
+            try
+            {
+                BinaryDataStream       challenge( frame->second );
+                std::vector< uint8_t > agentNonce( Remote::Protocol::readNonce( challenge ) );
+                SHA256::Digest         proof( Remote::Protocol::proof( this->_token, Remote::Protocol::ClientRole, this->_vmName, nonce, agentNonce ) );
+                
+                frame = {};
+                
+                if( Remote::Protocol::send( this->_socket, Remote::Protocol::Message::Authenticate, std::vector< uint8_t >( proof.begin(), proof.end() ) ) )
+                {
+                    frame = Remote::Protocol::receive( this->_socket, deadline, cancellation );
+                }
+                
+                if( frame.has_value() == false || frame->first != Remote::Protocol::Message::Hello )
+                {
+                    this->_disconnect();
+                    
+                    return false;
+                }
+                
+                BinaryDataStream stream( frame->second );
+                std::string      name( Remote::Protocol::readString( stream ) );
+                
+                proof = Remote::Protocol::proof( this->_token, Remote::Protocol::AgentRole, this->_vmName, nonce, agentNonce );
+                
+                if( SHA256::equal( Remote::Protocol::readProof( stream ), proof ) == false )
+                {
+                    this->_disconnect();
+                    
+                    return false;
+                }
+                
+                std::lock_guard< std::mutex > l( this->_infoMtx );
+                
+                this->_remoteName = name;
+                this->_connected  = true;
+            }
+            catch( const std::runtime_error & )
+            {
+                this->_disconnect();
+                
+                return false;
+            }
+            
+            this->_deltas = {};
+            this->_order  = {};
+            
+            this->_pages.clear();
+            
+            return true;
+        }
+        
+        void RemoteBackend::IMPL::_disconnect( void )
+        {
+            if( this->_socket != -1 )
+            {
+                ::close( this->_socket );
+            }
+            
+            this->_socket = -1;
+            
+            {
+                std::lock_guard< std::mutex > l( this->_infoMtx );
+                
+                this->_connected = false;
+            }
+        }
+        
+        bool RemoteBackend::IMPL::_send( Remote::Protocol::Message type, const std::vector< uint8_t > & arguments, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::vector< uint8_t > payload;
+            
+            if( this->_socket == -1 && this->_connect( deadline, cancellation ) == false )
+            {
+                return false;
+            }
+            
+            Remote::Protocol::writeTimeout( payload, deadline );
+            
+            payload.insert( payload.end(), arguments.begin(), arguments.end() );
+            
+            if( Remote::Protocol::send( this->_socket, type, payload ) == false )
+            {
+                this->_disconnect();
+                
+                return false;
+            }
+            
+            return true;
+        }
+        
+        template< typename _T_ >
+        _T_ RemoteBackend::IMPL::_call( Remote::Protocol::Message type, const std::vector< uint8_t > & arguments, const Deadline & deadline, const Cancellation & cancellation, _T_ fallback, const std::function< _T_( BinaryStream & ) > & parse )
+        {
+            std::lock_guard< std::mutex >            l( this->_mtx );
+            Stats::Timer                             timer( "Manage::RemoteBackend::request" );
+            std::optional< Remote::Protocol::Frame > frame;
+            
+            if( this->_send( type, arguments, deadline, cancellation ) == false )
+            {
+                return fallback;
+            }
+            
+            frame = Remote::Protocol::receive( this->_socket, deadline, cancellation );
+            
+            if( frame.has_value() == false || frame->first != type )
+            {
+                this->_disconnect();
+                
+                return fallback;
+            }
+            
+            try
+            {
+                BinaryDataStream stream( frame->second );
+                
+                return parse( stream );
+            }
+            catch( const std::runtime_error & )
+            {
+                this->_disconnect();
+                
+                return fallback;
+            }
+        }
+        
+        RemoteBackend::IMPL::Stream::Stream( IMPL & backend, size_t size, const Deadline & deadline, const Cancellation & cancellation ):
+            _backend(      backend ),
+            _size(         size ),
+            _position(     0 ),
+            _chunkOffset(  0 ),
+            _ended(        false ),
+            _deadline(     deadline ),
+            _cancellation( cancellation )
+        {}
+        
+        void RemoteBackend::IMPL::Stream::Read( uint8_t * buf, size_t size )
+        {
+            if( size > this->_size - this->_position )
+            {
+                throw std::runtime_error( "Unexpected end of remote dump" );
+            }
+            
+            while( size > 0 )
+            {
+                size_t n;
+                
+                if( this->_position >= this->_chunkOffset + this->_chunk.size() && this->_ended == false )
+                {
+                    if( this->_next() == false )
+                    {
+                        throw std::runtime_error( "Cannot receive remote dump" );
+                    }
+                    
+                    continue;
+                }
+                
+                if( this->_position < this->_chunkOffset || this->_ended )
+                {
+                    n = std::min( size, ( this->_ended ) ? size : this->_chunkOffset - this->_position );
+                    
+                    memset( buf, 0, n );
+                }
+                else
+                {
+                    n = std::min( size, this->_chunkOffset + this->_chunk.size() - this->_position );
+                    
+                    memcpy( buf, this->_chunk.data() + ( this->_position - this->_chunkOffset ), n );
+                }
+                
+                buf             += n;
+                size            -= n;
+                this->_position += n;
+            }
+        }
+        
+        void RemoteBackend::IMPL::Stream::Seek( ssize_t offset, SeekDirection dir )
+        {
+            size_t position;
+            
+            if( dir == SeekDirection::Begin && offset >= 0 )
+            {
+                position = numeric_cast< size_t >( offset );
+            }
+            else if( dir == SeekDirection::Current && offset >= 0 )
+            {
+                position = this->_position + numeric_cast< size_t >( offset );
+            }
+            else
+            {
+                throw std::runtime_error( "Invalid seek offset" );
+            }
+            
+            if( position < this->_position || position > this->_size )
+            {
+                throw std::runtime_error( "Invalid seek offset" );
+            }
+            
+            while( this->_ended == false && position > this->_chunkOffset + this->_chunk.size() )
+            {
+                if( this->_next() == false )
+                {
+                    throw std::runtime_error( "Cannot receive remote dump" );
+                }
+            }
+            
+            this->_position = position;
+        }
+        
+        size_t RemoteBackend::IMPL::Stream::Tell( void ) const
+        {
+            return this->_position;
+        }
+        
+        size_t RemoteBackend::IMPL::Stream::AvailableBytes( void )
+        {
+            return this->_size - this->_position;
+        }
+        
+        bool RemoteBackend::IMPL::Stream::finish( void )
+        {
+            while( this->_ended == false )
+            {
+                if( this->_next() == false )
+                {
+                    return false;
+                }
+            }
+            
+            return true;
+        }
+        
+        bool RemoteBackend::IMPL::Stream::_next( void )
+        {
+            std::optional< Remote::Protocol::Frame > frame( Remote::Protocol::receive( this->_backend._socket, this->_deadline, this->_cancellation ) );
+            
+            if( frame.has_value() && frame->first == Remote::Protocol::Message::DumpEnd )
+            {
+                this->_ended = true;
+                
+                this->_chunk.clear();
+                
+                return true;
+            }
+            
+            if( frame.has_value() == false || frame->first != Remote::Protocol::Message::DumpChunk )
+            {
+                return false;
+            }
+            
+            try
+            {
+                BinaryDataStream stream( frame->second );
+                uint64_t         offset( Trace::Format::readVarint( stream ) );
+                size_t           size( stream.AvailableBytes() );
+                
+                if( offset < this->_chunkOffset + this->_chunk.size() || offset > this->_size || size > this->_size - offset )
+                {
+                    return false;
+                }
+                
+                this->_chunkOffset = numeric_cast< size_t >( offset );
+                this->_chunk       = stream.Read( size );
+            }
+            catch( const std::runtime_error & )
+            {
+                return false;
+            }
+            
+            return true;
+        }
+    }
+}
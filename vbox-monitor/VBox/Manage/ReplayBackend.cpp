@@ -0,0 +1,188 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Manage/ReplayBackend.hpp"
+#include "VBox/Trace/Reader.hpp"
+#include "VBox/VM/MemoryCache.hpp"
+#include "VBox/Casts.hpp"
+#include <mutex>
+#include <chrono>
+
+namespace VBox
+{
+    namespace Manage
+    {
+        class ReplayBackend::IMPL
+        {
+            public:
+                
+                IMPL( const std::string & path );
+                
+                std::chrono::system_clock::time_point _time( void );
+                VM::Sample                            _sample( void );
+                
+                Trace::Reader                         _reader;
+                std::mutex                            _mtx;
+                std::chrono::steady_clock::time_point _origin;
+        };
+        
+        ReplayBackend::ReplayBackend( const std::string & path ):
+            impl( std::make_unique< IMPL >( path ) )
+        {}
+        
+        ReplayBackend::~ReplayBackend( void )
+        {}
+        
+        std::string ReplayBackend::name( void ) const
+        {
+            return "Replay";
+        }
+        
+        std::string ReplayBackend::vmName( void ) const
+        {
+            return this->impl->_reader.vmName();
+        }
+        
+        std::string ReplayBackend::path( void ) const
+        {
+            return this->impl->_reader.path();
+        }
+        
+        bool ReplayBackend::live( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            ( void )deadline;
+            ( void )cancellation;
+            
+            return this->impl->_reader.size() > 0;
+        }
+        
+        std::optional< VM::Registers > ReplayBackend::registers( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            ( void )deadline;
+            ( void )cancellation;
+            
+            if( this->impl->_reader.size() == 0 )
+            {
+                return {};
+            }
+            
+            return this->impl->_sample().registers();
+        }
+        
+        std::vector< VM::StackEntry > ReplayBackend::stack( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            ( void )deadline;
+            ( void )cancellation;
+            
+            if( this->impl->_reader.size() == 0 )
+            {
+                return {};
+            }
+            
+            return this->impl->_sample().stack();
+        }
+        
+        std::shared_ptr< VM::CoreDump > ReplayBackend::dump( const std::string & path, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            ( void )path;
+            ( void )deadline;
+            ( void )cancellation;
+            
+            return nullptr;
+        }
+        
+        std::optional< std::vector< uint8_t > > ReplayBackend::readMemory( uint64_t address, size_t size, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            uint64_t                      pageSize( VM::MemoryCache::pageSize() );
+            std::vector< uint8_t >        data;
+            uint64_t                      index;
+            
+            ( void )deadline;
+            ( void )cancellation;
+            
+            if( this->impl->_reader.size() == 0 || size == 0 )
+            {
+                return {};
+            }
+            
+            index = this->impl->_reader.find( this->impl->_time() );
+            
+            for( uint64_t page = address / pageSize; page <= ( address + size - 1 ) / pageSize; page++ )
+            {
+                std::optional< std::vector< uint8_t > > contents( this->impl->_reader.page( page * pageSize, index ) );
+                
+                if( contents.has_value() == false )
+                {
+                    return {};
+                }
+                
+                data.insert( data.end(), contents->begin(), contents->end() );
+            }
+            
+            {
+                size_t offset( numeric_cast< size_t >( address % pageSize ) );
+                
+                if( offset + size > data.size() )
+                {
+                    return {};
+                }
+                
+                return std::vector< uint8_t >( data.begin() + numeric_cast< std::ptrdiff_t >( offset ), data.begin() + numeric_cast< std::ptrdiff_t >( offset + size ) );
+            }
+        }
+        
+        bool ReplayBackend::seek( double seconds )
+        {
+            std::lock_guard< std::mutex >         l( this->impl->_mtx );
+            std::chrono::system_clock::time_point time( this->impl->_time() );
+            std::chrono::system_clock::duration   offset( std::chrono::duration_cast< std::chrono::system_clock::duration >( std::chrono::duration< double >( seconds ) ) );
+            
+            time = std::clamp( time + offset, this->impl->_reader.startTime(), this->impl->_reader.endTime() );
+            
+            this->impl->_origin = std::chrono::steady_clock::now() - std::chrono::duration_cast< std::chrono::steady_clock::duration >( time - this->impl->_reader.startTime() );
+            
+            return true;
+        }
+        
+        ReplayBackend::IMPL::IMPL( const std::string & path ):
+            _reader( path ),
+            _origin( std::chrono::steady_clock::now() )
+        {}
+        
+        std::chrono::system_clock::time_point ReplayBackend::IMPL::_time( void )
+        {
+            std::chrono::steady_clock::duration elapsed( std::chrono::steady_clock::now() - this->_origin );
+            
+            return std::clamp( this->_reader.startTime() + std::chrono::duration_cast< std::chrono::system_clock::duration >( elapsed ), this->_reader.startTime(), this->_reader.endTime() );
+        }
+        
+        VM::Sample ReplayBackend::IMPL::_sample( void )
+        {
+            std::lock_guard< std::mutex > l( this->_mtx );
+            
+            return this->_reader.sample( this->_reader.find( this->_time() ) );
+        }
+    }
+}
@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Manage/RunningVMs.hpp"
+#include "VBox/Manage.hpp"
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <set>
+
+namespace VBox
+{
+    namespace Manage
+    {
+        class RunningVMs::IMPL
+        {
+            public:
+                
+                IMPL( const Query & query, std::chrono::steady_clock::duration ttl );
+                
+                bool                    _fresh( void ) const;
+                std::vector< VM::Info > _fetch( std::unique_lock< std::mutex > & l, const Deadline & deadline, const Cancellation & cancellation );
+                
+                Query                                    _query;
+                std::chrono::steady_clock::duration      _ttl;
+                mutable std::mutex                       _mtx;
+                std::condition_variable                  _cv;
+                std::optional< std::vector< VM::Info > > _vms;
+                std::chrono::steady_clock::time_point    _fetched;
+                bool                                     _fetching;
+                bool                                     _failed;
+                uint64_t                                 _generation;
+                uint64_t                                 _queries;
+        };
+        
+        static const std::chrono::milliseconds DefaultTTL( 500 );
+        static const std::chrono::milliseconds FailureTTL( 200 );
+        static const std::chrono::milliseconds WaitSlice( 20 );
+        
+        RunningVMs & RunningVMs::shared( void )
+        {
+            static RunningVMs   * vms( nullptr );
+            static std::once_flag once;
+            
+            std::call_once
+            (
+                once,
+                [ & ]
+                {
+                    vms = new RunningVMs
+                    (
+                        []( const Deadline & deadline, const Cancellation & cancellation )
+                        {
+                            return queryRunningVMs( deadline, cancellation );
+                        },
+                        DefaultTTL
+                    );
+                }
+            );
+            
+            return *( vms );
+        }
+        
+        RunningVMs::RunningVMs( const Query & query, std::chrono::steady_clock::duration ttl ):
+            impl( std::make_unique< IMPL >( query, ttl ) )
+        {}
+        
+        RunningVMs::~RunningVMs( void )
+        {}
+        
+        std::chrono::steady_clock::duration RunningVMs::ttl( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_ttl;
+        }
+        
+        void RunningVMs::ttl( std::chrono::steady_clock::duration value )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_ttl = value;
+        }
+        
+        uint64_t RunningVMs::queries( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_queries;
+        }
+        
+        std::vector< VM::Info > RunningVMs::get( const Deadline & deadline, const Cancellation & cancellation )
+        {
+            std::unique_lock< std::mutex > l( this->impl->_mtx );
+            
+            while( this->impl->_fresh() == false )
+            {
+                if( cancellation.cancelled() || deadline.expired() )
+                {
+                    return {};
+                }
+                
+                if( this->impl->_fetching == false )
+                {
+                    return this->impl->_fetch( l, deadline, cancellation );
+                }
+                
+                this->impl->_cv.wait_until( l, std::min( deadline.time(), std::chrono::steady_clock::now() + WaitSlice ) );
+            }
+            
+            return this->impl->_vms.value();
+        }
+        
+        bool RunningVMs::waitUntilRunning( const std::vector< std::string > & vmNames, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            while( true )
+            {
+                std::set< std::string > waiting( vmNames.begin(), vmNames.end() );
+                
+                for( const auto & vm: this->get( deadline, cancellation ) )
+                {
+                    waiting.erase( vm.name() );
+                }
+                
+                if( waiting.empty() )
+                {
+                    return true;
+                }
+                
+                {
+                    std::unique_lock< std::mutex >        l( this->impl->_mtx );
+                    uint64_t                              generation( this->impl->_generation );
+                    std::chrono::steady_clock::time_point next( this->impl->_fetched + this->impl->_ttl );
+                    
+                    while( generation == this->impl->_generation && std::chrono::steady_clock::now() < next )
+                    {
+                        if( cancellation.cancelled() || deadline.expired() )
+                        {
+                            return false;
+                        }
+                        
+                        this->impl->_cv.wait_until( l, std::min( { next, deadline.time(), std::chrono::steady_clock::now() + WaitSlice } ) );
+                    }
+                }
+                
+                if( cancellation.cancelled() || deadline.expired() )
+                {
+                    return false;
+                }
+            }
+        }
+        
+        void RunningVMs::invalidate( void )
+        {
+            {
+                std::lock_guard< std::mutex > l( this->impl->_mtx );
+                
+                this->impl->_generation++;
+                this->impl->_vms.reset();
+            }
+            
+            this->impl->_cv.notify_all();
+        }
+        
+        RunningVMs::IMPL::IMPL( const Query & query, std::chrono::steady_clock::duration ttl ):
+            _query(      query ),
+            _ttl(        ttl ),
+            _fetching(   false ),
+            _failed(     false ),
+            _generation( 0 ),
+            _queries(    0 )
+        {}
+        
+        bool RunningVMs::IMPL::_fresh( void ) const
+        {
+            std::chrono::steady_clock::duration ttl( ( this->_failed ) ? std::min< std::chrono::steady_clock::duration >( this->_ttl, FailureTTL ) : this->_ttl );
+            
+            return this->_vms.has_value() && std::chrono::steady_clock::now() - this->_fetched < ttl;
+        }
+        
+        std::vector< VM::Info > RunningVMs::IMPL::_fetch( std::unique_lock< std::mutex > & l, const Deadline & deadline, const Cancellation & cancellation )
+        {
+            uint64_t                                 generation( this->_generation );
+            std::optional< std::vector< VM::Info > > vms;
+            
+            this->_fetching = true;
+            
+            this->_queries++;
+            l.unlock();
+            
+            try
+            {
+                vms = this->_query( deadline, cancellation );
+            }
+            catch( ... )
+            {
+                l.lock();
+                
+                this->_fetching = false;
+                
+                this->_cv.notify_all();
+                
+                throw;
+            }
+            
+            l.lock();
+            
+            this->_fetching = false;
+            this->_fetched  = std::chrono::steady_clock::now();
+            
+            if( generation == this->_generation && ( vms.has_value() || ( cancellation.cancelled() == false && deadline.expired() == false ) ) )
+            {
+                this->_vms    = vms.value_or( std::vector< VM::Info >() );
+                this->_failed = vms.has_value() == false;
+            }
+            
+            this->_cv.notify_all();
+            
+            return vms.value_or( std::vector< VM::Info >() );
+        }
+    }
+}
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_MANAGE_RUNNING_VMS_HPP
+#define VBOX_MANAGE_RUNNING_VMS_HPP
+
+#include "VBox/VM/Info.hpp"
+#include "VBox/Deadline.hpp"
+#include "VBox/Cancellation.hpp"
+#include <string>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <chrono>
+#include <memory>
+
+namespace VBox
+{
+    namespace Manage
+    {
+        class RunningVMs
+        {
+            public:
+                
+                using Query = std::function< std::optional< std::vector< VM::Info > >( const Deadline &, const Cancellation & ) >;
+                
+                static RunningVMs & shared( void );
+                
+                RunningVMs( const Query & query, std::chrono::steady_clock::duration ttl );
+                RunningVMs( const RunningVMs & o )      = delete;
+                RunningVMs( RunningVMs && o ) noexcept  = delete;
+                RunningVMs & operator =( RunningVMs o ) = delete;
+                ~RunningVMs( void );
+                
+                std::chrono::steady_clock::duration ttl( void ) const;
+                void                                ttl( std::chrono::steady_clock::duration value );
+                uint64_t                            queries( void ) const;
+                
+                std::vector< VM::Info > get( const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+                bool                    waitUntilRunning( const std::vector< std::string > & vmNames, const Deadline & deadline = {}, const Cancellation & cancellation = Cancellation::none() );
+                void                    invalidate( void );
+                
+            private:
+                
+                class IMPL;
+                
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_MANAGE_RUNNING_VMS_HPP */
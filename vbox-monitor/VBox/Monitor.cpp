@@ -23,10 +23,32 @@
  ******************************************************************************/
 
 #include "VBox/Monitor.hpp"
-#include "VBox/Manage.hpp"
+#include "VBox/Manage/Backend.hpp"
+#include "VBox/VM/Indexer.hpp"
+#include "VBox/ThreadPool.hpp"
+#include "VBox/Casts.hpp"
+#include "VBox/Deadline.hpp"
+#include "VBox/Cancellation.hpp"
+#include "VBox/RingBuffer.hpp"
+#include "VBox/Trace/Writer.hpp"
+#include "VBox/VM/MemoryHistory.hpp"
+#include "VBox/VM/TriggerProgram.hpp"
+#include "VBox/VM/Unwinder.hpp"
+#include "VBox/VM/AddressSpace.hpp"
+#include "VBox/Stats.hpp"
+#include "VBox/TemporaryDirectory.hpp"
 #include <mutex>
-#include <thread>
 #include <optional>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <set>
+#include <deque>
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <stdexcept>
 
 namespace VBox
 {
@@ -35,29 +57,107 @@ namespace VBox
         public:
             
             IMPL( const std::string & vmName );
+            IMPL( const std::shared_ptr< Manage::Backend > & backend );
             IMPL( const IMPL & o );
             IMPL( const IMPL & o, const std::lock_guard< std::recursive_mutex > & l );
             
-            void _updateRegisters( void );
-            void _updateStack( void );
-            void _updateMemory( void );
-            void _updateLiveStatus( void );
-            
-            std::string                     _vmName;
-            std::optional< VM::Registers >  _registers;
-            std::vector< VM::StackEntry >   _stack;
-            std::shared_ptr< VM::CoreDump > _dump;
-            mutable std::recursive_mutex    _rmtx;
-            bool                            _running;
-            bool                            _stop;
-            bool                            _live;
-            std::vector< std::thread >      _threads;
+            static ThreadPool::Priority _priority( Source source );
+            static VM::Registers        _withVectors( VM::Registers registers, const std::optional< VM::Registers > & previous );
+            static bool                 _sameRegisters( const std::optional< VM::Registers > & r1, const std::optional< VM::Registers > & r2 );
+            static bool                 _sameStack( const std::vector< VM::StackEntry > & s1, const std::vector< VM::StackEntry > & s2 );
+            static bool                 _reset( const VM::Registers & previous, const VM::Registers & current );
+            
+            void        _schedule( Source source, std::chrono::steady_clock::time_point when );
+            void        _execute( Source source, uint64_t epoch );
+            void        _update( Source source );
+            bool        _changed( Source source, const VM::Snapshot & before );
+            void        _wake( void );
+            Deadline    _deadline( Source source );
+            bool        _expired( const Deadline & deadline );
+            size_t      _currentCPU( void ) const;
+            void        _updateRegisters( void );
+            void        _updateStack( void );
+            void        _updateMemory( void );
+            bool        _updateMemoryPages( const std::shared_ptr< VM::CoreDump > & dump, const Deadline & deadline );
+            void        _updateLiveStatus( void );
+            std::string _dumpPath( void );
+            void        _updateSymbols( void );
+            void        _ingest( const std::function< void( void ) > & job );
+            void        _drainHistory( void );
+            void        _record( const VM::Snapshot & snapshot );
+            void        _evaluate( void );
+            void        _notify( void );
+            
+            std::shared_ptr< const VM::Snapshot > _publish( const std::function< VM::Snapshot( const VM::Snapshot & ) > & update );
+            const VM::AddressSpace &              _addressSpace( size_t cpu, const VM::Snapshot & snapshot, const VM::Registers & registers );
+            
+            std::string                                                 _vmName;
+            std::unique_ptr< TemporaryDirectory >                       _dumpDirectory;
+            std::shared_ptr< Manage::Backend >                          _backend;
+            std::shared_ptr< const VM::Snapshot >                       _snapshot;
+            std::shared_ptr< const VM::SymbolIndex >                    _symbols;
+            VM::Indexer                                                 _indexer;
+            bool                                                        _reindex;
+            std::set< uint64_t >                                        _dirty;
+            mutable std::recursive_mutex                                _rmtx;
+            std::condition_variable_any                                 _cv;
+            std::map< Source, double >                                  _frequencies;
+            std::map< Source, double >                                  _timeouts;
+            std::shared_ptr< VM::MemoryCache >                          _cache;
+            std::atomic< bool >                                         _fullDump;
+            std::shared_ptr< VM::MemoryHistory >                        _memoryHistory;
+            std::deque< std::function< void( void ) > >                 _ingestQueue;
+            bool                                                        _ingesting;
+            bool                                                        _running;
+            bool                                                        _stop;
+            std::atomic< bool >                                         _live;
+            uint64_t                                                    _group;
+            size_t                                                      _pending;
+            std::map< Source, bool >                                    _scheduled;
+            std::map< Source, double >                                  _backoff;
+            std::map< Source, double >                                  _idle;
+            std::map< Source, double >                                  _changeRates;
+            std::map< Source, uint64_t >                                _epochs;
+            std::map< Source, bool >                                    _executing;
+            bool                                                        _adaptive;
+            size_t                                                      _cpu;
+            std::vector< VM::Registers >                                _cpuRegisters;
+            std::vector< std::vector< VM::StackEntry > >                _cpuStacks;
+            bool                                                        _unwound;
+            std::vector< VM::AddressSpace >                             _spaces;
+            std::vector< std::array< uint64_t, 5 > >                    _spaceKeys;
+            Cancellation                                                _cancellation;
+            RingBuffer< VM::Sample >                                    _history;
+            std::shared_ptr< Trace::Writer >                            _writer;
+            VM::TriggerProgram                                          _program;
+            std::mutex                                                  _tmtx;
+            uint64_t                                                    _evaluated;
+            std::atomic< uint64_t >                                     _generation;
+            std::mutex                                                  _gmtx;
+            std::condition_variable                                     _gcv;
+            std::vector< std::function< void( void ) > >                _onChange;
+            std::vector< std::function< void( const VM::Trigger & ) > > _onTrigger;
     };
     
+    static const size_t DefaultHistoryCapacity       = 10000;
+    static const size_t DefaultMemoryHistoryCapacity = 16;
+    static const size_t DefaultMemoryHistoryPages    = 256;
+    static const double IdleGrowth                   = 1.5;
+    static const double MaxIdle                      = 32;
+    static const double ChangeRateWeight             = 0.1;
+    
+    static const uint64_t CR0Paging = uint64_t( 1 ) << 31;
+    static const uint64_t ResetIP   = 0xFFF0;
+    static const uint64_t ResetCS   = 0xF000;
+    
     Monitor::Monitor( const std::string & vmName ):
         impl( std::make_unique< IMPL >( vmName ) )
     {}
     
+    Monitor::Monitor( const std::shared_ptr< Manage::Backend > & backend ):
+        impl( std::make_unique< IMPL >( backend ) )
+    {}
+    
     Monitor::Monitor( const Monitor & o ):
         impl( std::make_unique< IMPL >( *( o.impl ) ) )
     {}
@@ -70,7 +170,12 @@ namespace VBox
     }
     
     Monitor::~Monitor( void )
-    {}
+    {
+        if( this->impl != nullptr )
+        {
+            this->stop();
+        }
+    }
     
     Monitor & Monitor::operator =( Monitor o )
     {
@@ -88,30 +193,327 @@ namespace VBox
     
     bool Monitor::live( void ) const
     {
-        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        return this->impl->_live.load();
+    }
+    
+    void Monitor::live( bool value )
+    {
+        if( this->impl->_live.exchange( value ) != value )
+        {
+            this->impl->_notify();
+        }
+    }
+    
+    std::shared_ptr< const VM::Snapshot > Monitor::snapshot( void ) const
+    {
+        return std::atomic_load( &( this->impl->_snapshot ) );
+    }
+    
+    uint64_t Monitor::generation( void ) const
+    {
+        return this->impl->_generation.load();
+    }
+    
+    uint64_t Monitor::waitForChange( uint64_t generation, std::chrono::milliseconds timeout ) const
+    {
+        std::unique_lock< std::mutex > l( this->impl->_gmtx );
+        
+        this->impl->_gcv.wait_for( l, timeout, [ & ] { return this->impl->_generation.load() != generation; } );
         
-        return this->impl->_live;
+        return this->impl->_generation.load();
     }
     
     std::optional< VM::Registers > Monitor::registers( void ) const
+    {
+        return this->snapshot()->registers();
+    }
+    
+    std::vector< VM::StackEntry > Monitor::stack( void ) const
+    {
+        return this->snapshot()->stack();
+    }
+    
+    size_t Monitor::cpu( void ) const
     {
         std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
         
-        return this->impl->_registers;
+        return this->impl->_cpu;
     }
     
-    std::vector< VM::StackEntry > Monitor::stack( void ) const
+    void Monitor::cpu( size_t index )
+    {
+        std::optional< VM::Registers > regs;
+        std::vector< VM::StackEntry >  stack;
+        
+        {
+            std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+            
+            if( index == this->impl->_cpu || index >= this->impl->_cpuRegisters.size() )
+            {
+                return;
+            }
+            
+            this->impl->_cpu = index;
+            regs             = this->impl->_cpuRegisters[ index ];
+            
+            if( index < this->impl->_cpuStacks.size() )
+            {
+                stack = this->impl->_cpuStacks[ index ];
+            }
+        }
+        
+        this->impl->_publish( [ & ]( const VM::Snapshot & s ) { return s.withRegisters( regs ).withStack( stack ); } );
+    }
+    
+    size_t Monitor::cpuCount( void ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        return this->impl->_cpuRegisters.size();
+    }
+    
+    std::vector< VM::Registers > Monitor::cpuRegisters( void ) const
     {
         std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
         
-        return this->impl->_stack;
+        return this->impl->_cpuRegisters;
+    }
+    
+    size_t Monitor::cpuRegisters( VM::Registers * registers, size_t count ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        count = std::min( count, this->impl->_cpuRegisters.size() );
+        
+        std::copy( this->impl->_cpuRegisters.begin(), this->impl->_cpuRegisters.begin() + numeric_cast< std::ptrdiff_t >( count ), registers );
+        
+        return count;
     }
     
     std::shared_ptr< VM::CoreDump > Monitor::dump( void ) const
+    {
+        return this->snapshot()->dump();
+    }
+    
+    std::shared_ptr< const VM::SymbolIndex > Monitor::symbols( void ) const
+    {
+        return std::atomic_load( &( this->impl->_symbols ) );
+    }
+    
+    double Monitor::frequency( Source source ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        return this->impl->_frequencies[ source ];
+    }
+    
+    void Monitor::frequency( Source source, double hz )
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        if( hz < 0 )
+        {
+            throw std::runtime_error( "Invalid sampling frequency" );
+        }
+        
+        this->impl->_frequencies[ source ] = hz;
+        
+        if( this->impl->_running && this->impl->_scheduled[ source ] == false )
+        {
+            this->impl->_schedule( source, std::chrono::steady_clock::now() );
+        }
+    }
+    
+    double Monitor::timeout( Source source ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        return this->impl->_timeouts[ source ];
+    }
+    
+    void Monitor::timeout( Source source, double seconds )
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        if( seconds < 0 )
+        {
+            throw std::runtime_error( "Invalid query timeout" );
+        }
+        
+        this->impl->_timeouts[ source ] = seconds;
+    }
+    
+    double Monitor::changeRate( Source source ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        return this->impl->_changeRates[ source ];
+    }
+    
+    double Monitor::effectiveFrequency( Source source ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        double                                  hz( this->impl->_frequencies[ source ] );
+        
+        if( hz <= 0 || this->impl->_scheduled[ source ] == false )
+        {
+            return 0;
+        }
+        
+        return hz / ( std::max( this->impl->_backoff[ source ], 1.0 ) * std::max( this->impl->_idle[ source ], 1.0 ) );
+    }
+    
+    bool Monitor::adaptive( void ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        return this->impl->_adaptive;
+    }
+    
+    void Monitor::adaptive( bool value )
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        this->impl->_adaptive = value;
+        
+        if( value == false )
+        {
+            this->impl->_wake();
+        }
+    }
+    
+    void Monitor::wakeUp( void )
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        this->impl->_wake();
+    }
+    
+    void Monitor::refreshMemory( void )
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        this->impl->_fullDump = true;
+        
+        this->impl->_wake();
+    }
+    
+    size_t Monitor::memoryCacheCapacity( void ) const
+    {
+        return this->impl->_cache->capacity();
+    }
+    
+    void Monitor::memoryCacheCapacity( size_t bytes )
+    {
+        this->impl->_cache->capacity( bytes );
+    }
+    
+    size_t Monitor::historyCapacity( void ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        return this->impl->_history.capacity();
+    }
+    
+    void Monitor::historyCapacity( size_t samples )
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        this->impl->_history.capacity( samples );
+    }
+    
+    uint64_t Monitor::historyBegin( void ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        return this->impl->_history.begin();
+    }
+    
+    uint64_t Monitor::historyEnd( void ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        return this->impl->_history.end();
+    }
+    
+    std::shared_ptr< const VM::MemoryHistory > Monitor::memoryHistory( void ) const
+    {
+        return this->impl->_memoryHistory;
+    }
+    
+    size_t Monitor::memoryHistoryCapacity( void ) const
+    {
+        return this->impl->_memoryHistory->capacity();
+    }
+    
+    void Monitor::memoryHistoryCapacity( size_t generations )
+    {
+        this->impl->_memoryHistory->capacity( generations );
+    }
+    
+    std::optional< VM::Sample > Monitor::sample( uint64_t index ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        if( this->impl->_history.contains( index ) == false )
+        {
+            return {};
+        }
+        
+        return this->impl->_history[ index ];
+    }
+    
+    std::vector< VM::Trigger > Monitor::triggers( void ) const
+    {
+        std::lock_guard< std::mutex > l( this->impl->_tmtx );
+        
+        return this->impl->_program.triggers();
+    }
+    
+    void Monitor::triggers( const std::vector< VM::Trigger > & triggers )
+    {
+        std::lock_guard< std::mutex > l( this->impl->_tmtx );
+        
+        this->impl->_program   = VM::TriggerProgram( triggers );
+        this->impl->_evaluated = 0;
+    }
+    
+    void Monitor::record( const std::string & path )
+    {
+        std::shared_ptr< Trace::Writer > writer( std::make_shared< Trace::Writer >( path, this->impl->_vmName ) );
+        
+        {
+            std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+            
+            this->impl->_writer = writer;
+        }
+    }
+    
+    bool Monitor::recording( void ) const
     {
         std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
         
-        return this->impl->_dump;
+        return this->impl->_writer != nullptr;
+    }
+    
+    bool Monitor::seek( double seconds )
+    {
+        if( this->impl->_backend->seek( seconds ) == false )
+        {
+            return false;
+        }
+        
+        {
+            std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+            
+            this->impl->_history.clear();
+        }
+        
+        this->impl->_memoryHistory->clear();
+        
+        this->impl->_notify();
+        
+        return true;
     }
     
     void Monitor::start( void )
@@ -126,42 +528,59 @@ namespace VBox
         this->impl->_stop    = false;
         this->impl->_running = true;
         
+        for( Source source: { Source::Registers, Source::Stack, Source::Memory, Source::LiveStatus, Source::Symbols } )
         {
-            std::thread t1( [ this ] { this->impl->_updateRegisters();  } );
-            std::thread t2( [ this ] { this->impl->_updateStack(); } );
-            std::thread t3( [ this ] { this->impl->_updateMemory(); } );
-            std::thread t4( [ this ] { this->impl->_updateLiveStatus(); } );
+            this->impl->_backoff[ source ] = 1;
+            this->impl->_idle[ source ]    = 1;
             
-            this->impl->_threads.push_back( std::move( t1 ) );
-            this->impl->_threads.push_back( std::move( t2 ) );
-            this->impl->_threads.push_back( std::move( t3 ) );
-            this->impl->_threads.push_back( std::move( t4 ) );
+            this->impl->_schedule( source, std::chrono::steady_clock::now() );
         }
     }
     
     void Monitor::stop( void )
     {
-        std::vector< std::thread > threads;
+        std::unique_lock< std::recursive_mutex > l( this->impl->_rmtx );
         
+        if( this->impl->_running == false )
         {
-            std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
-            
-            threads           = std::move( this->impl->_threads );
-            this->impl->_stop = true;
+            return;
         }
         
-        for( auto & t: threads )
-        {
-            t.join();
-        }
+        this->impl->_stop     = true;
+        this->impl->_pending -= ThreadPool::shared().cancel( this->impl->_group );
+        
+        this->impl->_cancellation.cancel();
+        this->impl->_cv.wait( l, [ & ] { return this->impl->_pending == 0; } );
+        this->impl->_cancellation.reset();
+        
+        this->impl->_ingestQueue.clear();
+        
+        this->impl->_ingesting = false;
+        
+        this->impl->_scheduled.clear();
         
+        this->impl->_running = false;
+        
+        if( this->impl->_writer != nullptr )
         {
-            std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
-            
-            this->impl->_running = false;
+            this->impl->_writer->flush();
         }
     }
     
+    void Monitor::onChange( const std::function< void( void ) > & f )
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        this->impl->_onChange.push_back( f );
+    }
+    
+    void Monitor::onTrigger( const std::function< void( const VM::Trigger & ) > & f )
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        this->impl->_onTrigger.push_back( f );
+    }
+    
     void swap( Monitor & o1, Monitor & o2 )
     {
         using std::swap;
@@ -177,18 +596,44 @@ namespace VBox
     }
     
     Monitor::IMPL::IMPL( const std::string & vmName ):
-        _vmName(         vmName ),
+        IMPL( Manage::Backend::forVM( vmName ) )
+    {}
+    
+    Monitor::IMPL::IMPL( const std::shared_ptr< Manage::Backend > & backend ):
+        _vmName(         backend->vmName() ),
+        _backend(        backend ),
+        _snapshot(       std::make_shared< const VM::Snapshot >() ),
+        _symbols(        std::make_shared< const VM::SymbolIndex >() ),
+        _reindex(        true ),
+        _cache(          std::make_shared< VM::MemoryCache >( 64 * 1024 * 1024 ) ),
+        _fullDump(       false ),
+        _memoryHistory(  std::make_shared< VM::MemoryHistory >( DefaultMemoryHistoryCapacity, DefaultMemoryHistoryPages ) ),
+        _ingesting(      false ),
         _running(        false ),
         _stop(           false ),
-        _live(           false )
+        _live(           false ),
+        _group(          ThreadPool::shared().group() ),
+        _pending(        0 ),
+        _adaptive(       true ),
+        _cpu(            0 ),
+        _unwound(        false ),
+        _history(        DefaultHistoryCapacity ),
+        _evaluated(      0 ),
+        _generation(     0 )
     {
-        for( const auto & info: Manage::runningVMs() )
-        {
-            if( info.name() == vmName )
-            {
-                this->_live = true;
-            }
-        }
+        this->_frequencies[ Source::Registers ]  = 100;
+        this->_frequencies[ Source::Stack ]      = 20;
+        this->_frequencies[ Source::Memory ]     = 1;
+        this->_frequencies[ Source::LiveStatus ] = 1;
+        this->_frequencies[ Source::Symbols ]    = 0.5;
+        
+        this->_timeouts[ Source::Registers ]  = 1;
+        this->_timeouts[ Source::Stack ]      = 2;
+        this->_timeouts[ Source::Memory ]     = 30;
+        this->_timeouts[ Source::LiveStatus ] = 2;
+        this->_timeouts[ Source::Symbols ]    = 0;
+        
+        this->_live = this->_backend->live( this->_deadline( Source::LiveStatus ), this->_cancellation );
     }
     
     Monitor::IMPL::IMPL( const IMPL & o ):
@@ -197,130 +642,813 @@ namespace VBox
     
     Monitor::IMPL::IMPL( const IMPL & o, const std::lock_guard< std::recursive_mutex > & l ):
         _vmName(         o._vmName ),
-        _registers(      o._registers ),
-        _stack(          o._stack ),
-        _dump(           o._dump ),
+        _backend(        o._backend ),
+        _snapshot(       std::atomic_load( &( o._snapshot ) ) ),
+        _symbols(        std::atomic_load( &( o._symbols ) ) ),
+        _reindex(        true ),
+        _frequencies(    o._frequencies ),
+        _timeouts(       o._timeouts ),
+        _cache(          std::make_shared< VM::MemoryCache >( *( o._cache ) ) ),
+        _fullDump(       false ),
+        _memoryHistory(  std::make_shared< VM::MemoryHistory >( o._memoryHistory->capacity(), DefaultMemoryHistoryPages ) ),
+        _ingesting(      false ),
         _running(        false ),
         _stop(           false ),
-        _live(           false )
+        _live(           false ),
+        _group(          ThreadPool::shared().group() ),
+        _pending(        0 ),
+        _adaptive(       o._adaptive ),
+        _cpu(            o._cpu ),
+        _cpuRegisters(   o._cpuRegisters ),
+        _cpuStacks(      o._cpuStacks ),
+        _unwound(        o._unwound ),
+        _history(        o._history ),
+        _program(        o._program.triggers() ),
+        _evaluated(      0 ),
+        _generation(     0 )
     {
         ( void )l;
     }
     
-    void Monitor::IMPL::_updateRegisters( void )
+    ThreadPool::Priority Monitor::IMPL::_priority( Source source )
     {
-        while( 1 )
+        switch( source )
         {
-            {
-                std::lock_guard< std::recursive_mutex > l( this->_rmtx );
-                
-                if( this->_stop )
-                {
-                    return;
-                }
-            }
-            
-            {
-                std::optional< VM::Registers > regs( Manage::Debug::registers( this->_vmName ) );
-                
-                {
-                    std::lock_guard< std::recursive_mutex > l( this->_rmtx );
-                    
-                    this->_registers = regs;
-                }
-            }
+            case Source::Registers:  return ThreadPool::Priority::High;
+            case Source::Stack:      return ThreadPool::Priority::Normal;
+            case Source::LiveStatus: return ThreadPool::Priority::Normal;
+            case Source::Memory:     return ThreadPool::Priority::Low;
+            case Source::Symbols:    return ThreadPool::Priority::Low;
         }
+        
+        return ThreadPool::Priority::Normal;
     }
     
-    void Monitor::IMPL::_updateStack( void )
+    size_t Monitor::IMPL::_currentCPU( void ) const
     {
-        while( 1 )
-        {
+        std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+        
+        return this->_cpu;
+    }
+    
+    VM::Registers Monitor::IMPL::_withVectors( VM::Registers registers, const std::optional< VM::Registers > & previous )
+    {
+        if( previous.has_value() )
+        {
+            for( size_t i = 0; i < 16; i++ )
             {
-                std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+                registers.ymm( i, previous->ymm( i ) );
+            }
+        }
+        
+        return registers;
+    }
+    
+    void Monitor::IMPL::_schedule( Source source, std::chrono::steady_clock::time_point when )
+    {
+        std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+        
+        if( this->_stop || this->_frequencies[ source ] <= 0 )
+        {
+            this->_scheduled[ source ] = false;
+            
+            return;
+        }
+        
+        this->_scheduled[ source ] = true;
+        
+        this->_pending++;
+        ThreadPool::shared().submit( this->_group, _priority( source ), when, [ this, source, epoch = this->_epochs[ source ] ] { this->_execute( source, epoch ); } );
+    }
+    
+    void Monitor::IMPL::_execute( Source source, uint64_t epoch )
+    {
+        std::chrono::steady_clock::time_point start( std::chrono::steady_clock::now() );
+        std::shared_ptr< const VM::Snapshot > before( std::atomic_load( &( this->_snapshot ) ) );
+        bool                                  stop;
+        bool                                  changed( true );
+        
+        {
+            std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+            
+            if( epoch != this->_epochs[ source ] )
+            {
+                this->_pending--;
+                
+                this->_cv.notify_all();
+                
+                return;
+            }
+            
+            stop                       = this->_stop;
+            this->_executing[ source ] = true;
+        }
+        
+        if( stop == false )
+        {
+            this->_update( source );
+            
+            changed = this->_changed( source, *( before ) );
+        }
+        
+        {
+            std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+            std::chrono::duration< double >         elapsed( std::chrono::steady_clock::now() - start );
+            double                                  hz( this->_frequencies[ source ] );
+            double                                & backoff( this->_backoff[ source ] );
+            double                                & idle( this->_idle[ source ] );
+            double                                & rate( this->_changeRates[ source ] );
+            
+            this->_executing[ source ] = false;
+            
+            rate += ( ( ( changed ) ? 1.0 : 0.0 ) - rate ) * ChangeRateWeight;
+            
+            if( changed || this->_adaptive == false )
+            {
+                idle = 1;
+            }
+            else
+            {
+                idle = std::min( std::max( idle, 1.0 ) * IdleGrowth, MaxIdle );
+            }
+            
+            if( changed && source == Source::Registers )
+            {
+                this->_wake();
+            }
+            
+            if( hz > 0 )
+            {
+                std::chrono::duration< double > interval( 1.0 / hz );
                 
-                if( this->_stop )
+                if( elapsed > interval )
                 {
-                    return;
+                    backoff = std::min( backoff * 2, 32.0 );
+                }
+                else
+                {
+                    backoff = std::max( backoff / 2, 1.0 );
                 }
+                
+                this->_schedule( source, start + std::chrono::duration_cast< std::chrono::steady_clock::duration >( interval * backoff * idle ) );
+            }
+            else
+            {
+                this->_scheduled[ source ] = false;
+            }
+            
+            this->_pending--;
+        }
+        
+        this->_cv.notify_all();
+    }
+    
+    bool Monitor::IMPL::_changed( Source source, const VM::Snapshot & before )
+    {
+        std::shared_ptr< const VM::Snapshot > after( std::atomic_load( &( this->_snapshot ) ) );
+        
+        switch( source )
+        {
+            case Source::Registers:  return _sameRegisters( before.registers(), after->registers() ) == false;
+            case Source::Stack:      return _sameStack( before.stack(), after->stack() ) == false;
+            case Source::Memory:     return before.dumpSequence() != after->dumpSequence();
+            case Source::LiveStatus: return true;
+            case Source::Symbols:    return true;
+        }
+        
+        return true;
+    }
+    
+    void Monitor::IMPL::_wake( void )
+    {
+        for( Source source: { Source::Registers, Source::Stack, Source::Memory } )
+        {
+            if( this->_idle[ source ] <= 1 )
+            {
+                continue;
             }
             
+            this->_idle[ source ] = 1;
+            
+            if( this->_running && this->_scheduled[ source ] && this->_executing[ source ] == false )
             {
-                std::vector< VM::StackEntry > stack( Manage::Debug::stack( this->_vmName ) );
+                this->_epochs[ source ]++;
                 
+                this->_schedule( source, std::chrono::steady_clock::now() );
+            }
+        }
+    }
+    
+    bool Monitor::IMPL::_sameRegisters( const std::optional< VM::Registers > & r1, const std::optional< VM::Registers > & r2 )
+    {
+        if( r1.has_value() == false || r2.has_value() == false )
+        {
+            return r1.has_value() == r2.has_value();
+        }
+        
+        if( r1->rip() != r2->rip() )
+        {
+            return false;
+        }
+        
+        for( size_t i = 0; i < VM::Registers::GeneralCount; i++ )
+        {
+            if( r1->valueAt( i ) != r2->valueAt( i ) )
+            {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    bool Monitor::IMPL::_sameStack( const std::vector< VM::StackEntry > & s1, const std::vector< VM::StackEntry > & s2 )
+    {
+        if( s1.size() != s2.size() )
+        {
+            return false;
+        }
+        
+        for( size_t i = 0; i < s1.size(); i++ )
+        {
+            const VM::StackEntry & e1( s1[ i ] );
+            const VM::StackEntry & e2( s2[ i ] );
+            
+            if
+            (
+                   e1.bp().address()    != e2.bp().address()    || e1.bp().segment()    != e2.bp().segment()
+                || e1.retBP().address() != e2.retBP().address() || e1.retBP().segment() != e2.retBP().segment()
+                || e1.retIP().address() != e2.retIP().address() || e1.retIP().segment() != e2.retIP().segment()
+                || e1.ip().address()    != e2.ip().address()    || e1.ip().segment()    != e2.ip().segment()
+                || e1.arg0()            != e2.arg0()            || e1.arg1()            != e2.arg1()
+                || e1.arg2()            != e2.arg2()            || e1.arg3()            != e2.arg3()
+            )
+            {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    bool Monitor::IMPL::_reset( const VM::Registers & previous, const VM::Registers & current )
+    {
+        auto paged(    []( const VM::Registers & r ) { return ( r.cr0() & CR0Paging ) != 0; } );
+        auto atVector( []( const VM::Registers & r ) { return r.rip() == ResetIP && r.selector( VM::Registers::Segment::CS ) == ResetCS; } );
+        
+        return ( paged( previous ) && paged( current ) == false ) || ( atVector( previous ) == false && atVector( current ) );
+    }
+    
+    void Monitor::IMPL::_update( Source source )
+    {
+        switch( source )
+        {
+            case Source::Registers:  this->_updateRegisters();  break;
+            case Source::Stack:      this->_updateStack();      break;
+            case Source::Memory:     this->_updateMemory();     break;
+            case Source::LiveStatus: this->_updateLiveStatus(); break;
+            case Source::Symbols:    this->_updateSymbols();    break;
+        }
+    }
+    
+    Deadline Monitor::IMPL::_deadline( Source source )
+    {
+        std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+        double                                  seconds( this->_timeouts[ source ] );
+        
+        if( seconds <= 0 )
+        {
+            return Deadline::never();
+        }
+        
+        return Deadline::after( std::chrono::duration_cast< std::chrono::steady_clock::duration >( std::chrono::duration< double >( seconds ) ) );
+    }
+    
+    bool Monitor::IMPL::_expired( const Deadline & deadline )
+    {
+        if( this->_cancellation.cancelled() )
+        {
+            return true;
+        }
+        
+        if( deadline.expired() == false )
+        {
+            return false;
+        }
+        
+        this->_publish( [ & ]( const VM::Snapshot & s ) { return s.withTimeout(); } );
+        
+        return true;
+    }
+    
+    void Monitor::IMPL::_updateRegisters( void )
+    {
+        Deadline                                       deadline( this->_deadline( Source::Registers ) );
+        std::vector< VM::Registers >                   all( this->_backend->allRegisters( deadline, this->_cancellation ) );
+        std::shared_ptr< const VM::Snapshot >          snapshot( std::atomic_load( &( this->_snapshot ) ) );
+        std::shared_ptr< VM::CoreDump >                dump( snapshot->dump() );
+        std::vector< std::vector< VM::StackEntry > >   stacks;
+        std::optional< VM::Registers >                 regs;
+        std::optional< std::vector< VM::StackEntry > > stack;
+        
+        if( all.empty() && this->_expired( deadline ) )
+        {
+            return;
+        }
+        
+        if( dump != nullptr )
+        {
+            Stats::Timer timer( "Monitor::unwind" );
+            
+            for( size_t i = 0; i < all.size(); i++ )
+            {
+                stacks.push_back( VM::Unwinder::unwind( this->_addressSpace( i, *( snapshot ), all[ i ] ), all[ i ], VM::Sample::MaxStackDepth ) );
+            }
+        }
+        
+        {
+            std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+            
+            this->_unwound = false;
+            
+            if( all.empty() == false )
+            {
+                if( this->_cpuRegisters.empty() == false && _reset( this->_cpuRegisters.front(), all.front() ) )
                 {
-                    std::lock_guard< std::recursive_mutex > l( this->_rmtx );
-                    
-                    this->_stack = stack;
+                    this->_fullDump = true;
+                }
+                
+                this->_cpu          = std::min( this->_cpu, all.size() - 1 );
+                this->_cpuRegisters = all;
+                regs                = all[ this->_cpu ];
+                
+                if( this->_cpu < stacks.size() && stacks[ this->_cpu ].empty() == false )
+                {
+                    this->_cpuStacks = stacks;
+                    this->_unwound   = true;
+                    stack            = stacks[ this->_cpu ];
                 }
             }
         }
+        
+        if( stack.has_value() )
+        {
+            this->_record( *( this->_publish( [ & ]( const VM::Snapshot & s ) { return s.withRegisters( regs ).withStack( stack.value() ); } ) ) );
+        }
+        else
+        {
+            this->_record( *( this->_publish( [ & ]( const VM::Snapshot & s ) { return s.withRegisters( regs ); } ) ) );
+        }
+    }
+    
+    const VM::AddressSpace & Monitor::IMPL::_addressSpace( size_t cpu, const VM::Snapshot & snapshot, const VM::Registers & registers )
+    {
+        std::array< uint64_t, 5 > key { snapshot.dumpSequence(), registers.cr0(), registers.cr3(), registers.cr4(), registers.efer() };
+        
+        if( cpu >= this->_spaces.size() )
+        {
+            this->_spaces.resize( cpu + 1 );
+            this->_spaceKeys.resize( cpu + 1 );
+        }
+        
+        if( key != this->_spaceKeys[ cpu ] )
+        {
+            this->_spaces[ cpu ]    = VM::AddressSpace( snapshot.dump(), registers );
+            this->_spaceKeys[ cpu ] = key;
+        }
+        
+        return this->_spaces[ cpu ];
+    }
+    
+    void Monitor::IMPL::_updateStack( void )
+    {
+        Deadline                                     deadline( this->_deadline( Source::Stack ) );
+        std::vector< std::vector< VM::StackEntry > > all;
+        std::vector< VM::StackEntry >                stack;
+        
+        {
+            std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+            
+            if( this->_unwound )
+            {
+                return;
+            }
+        }
+        
+        all = this->_backend->allStacks( deadline, this->_cancellation );
+        
+        if( all.empty() && this->_expired( deadline ) )
+        {
+            return;
+        }
+        
+        {
+            std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+            
+            this->_cpuStacks = all;
+            
+            if( this->_cpu < all.size() )
+            {
+                stack = all[ this->_cpu ];
+            }
+        }
+        
+        this->_record( *( this->_publish( [ & ]( const VM::Snapshot & s ) { return s.withStack( stack ); } ) ) );
     }
     
     void Monitor::IMPL::_updateMemory( void )
     {
-        #ifdef __clang__
-        #pragma clang diagnostic push
-        #pragma clang diagnostic ignored "-Wdeprecated-declarations"
-        #endif
-        std::string tmp( std::tmpnam( nullptr ) );
-        #ifdef __clang__
-        #pragma clang diagnostic pop
-        #endif
+        Deadline                        deadline( this->_deadline( Source::Memory ) );
+        std::shared_ptr< VM::CoreDump > previous( std::atomic_load( &( this->_snapshot ) )->dump() );
+        bool                            refresh( this->_fullDump.exchange( false ) );
+        
+        if( previous != nullptr && refresh == false && this->_updateMemoryPages( previous, deadline ) )
+        {
+            return;
+        }
         
-        while( 1 )
+        if( this->_expired( deadline ) )
         {
+            this->_fullDump = this->_fullDump || refresh;
+            
+            return;
+        }
+        
+        {
+            std::string                     path( this->_dumpPath() );
+            std::shared_ptr< VM::CoreDump > dump( ( path.empty() ) ? nullptr : this->_backend->dump( path, deadline, this->_cancellation ) );
+            
+            if( path.empty() || ( dump == nullptr && this->_expired( deadline ) ) )
             {
-                std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+                this->_fullDump = this->_fullDump || refresh;
                 
-                if( this->_stop )
-                {
-                    return;
-                }
+                return;
+            }
+            
+            this->_cache->clear();
+            
+            if( dump != nullptr )
+            {
+                dump = std::make_shared< VM::CoreDump >( dump->withCache( std::make_shared< VM::MemoryCache >( this->_cache->snapshot() ) ) );
             }
             
             {
-                std::shared_ptr< VM::CoreDump > dump( Manage::Debug::dump( this->_vmName, tmp ) );
+                size_t                                cpu( this->_currentCPU() );
+                bool                                  coherent( dump != nullptr && cpu < dump->cpus().size() );
+                std::shared_ptr< const VM::Snapshot > snapshot
+                (
+                    this->_publish
+                    (
+                        [ & ]( const VM::Snapshot & s )
+                        {
+                            if( coherent == false )
+                            {
+                                return s.withDump( dump );
+                            }
+                            
+                            return s.withDump( dump ).withRegisters( _withVectors( dump->cpus()[ cpu ], s.registers() ) );
+                        }
+                    )
+                );
+                
+                if( coherent )
+                {
+                    this->_record( *( snapshot ) );
+                }
                 
+                if( dump != nullptr )
                 {
                     std::lock_guard< std::recursive_mutex > l( this->_rmtx );
                     
-                    this->_dump = dump;
+                    this->_reindex = true;
+                    
+                    this->_dirty.clear();
+                }
+                
+                if( dump != nullptr )
+                {
+                    std::chrono::system_clock::time_point timestamp( snapshot->timestamp() );
+                    
+                    this->_ingest( [ this, dump, timestamp ] { this->_memoryHistory->add( *( dump ), timestamp, this->_cancellation ); } );
                 }
             }
         }
     }
     
-    void Monitor::IMPL::_updateLiveStatus( void )
+    bool Monitor::IMPL::_updateMemoryPages( const std::shared_ptr< VM::CoreDump > & dump, const Deadline & deadline )
     {
-        while( 1 )
+        std::vector< uint64_t >                                      pages;
+        uint64_t                                                     size( VM::MemoryCache::pageSize() );
+        std::shared_ptr< Trace::Writer >                             writer;
+        std::vector< std::pair< uint64_t, std::vector< uint8_t > > > fetched;
+        
         {
+            std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+            
+            writer = this->_writer;
+        }
+        
+        this->_cache->advance();
+        
+        for( uint64_t index: this->_cache->requests() )
+        {
+            if( this->_cache->stale( index ) && index * size < dump->memorySize() && dump->contains( index * size ) )
             {
-                std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+                pages.push_back( index );
+            }
+        }
+        
+        for( size_t i = 0; i < pages.size(); )
+        {
+            size_t n( 1 );
+            
+            while( i + n < pages.size() && pages[ i + n ] == pages[ i ] + n )
+            {
+                n++;
+            }
+            
+            {
+                uint64_t                                start( pages[ i ] * size );
+                uint64_t                                end(   std::min< uint64_t >( ( pages[ i ] + n ) * size, dump->memorySize() ) );
+                std::optional< std::vector< uint8_t > > data(  this->_backend->readMemory( start, numeric_cast< size_t >( end - start ), deadline, this->_cancellation ) );
                 
-                if( this->_stop )
+                if( data.has_value() == false || data.value().size() != end - start )
                 {
-                    return;
+                    return false;
+                }
+                
+                for( size_t j = 0; j < n; j++ )
+                {
+                    auto                   begin( data.value().begin() + numeric_cast< std::ptrdiff_t >( j * size ) );
+                    std::vector< uint8_t > page( begin, begin + numeric_cast< std::ptrdiff_t >( std::min< uint64_t >( size, end - start - j * size ) ) );
+                    
+                    if( writer != nullptr )
+                    {
+                        writer->write( ( pages[ i ] + j ) * size, page );
+                    }
+                    
+                    this->_cache->store( pages[ i ] + j, page );
+                    fetched.emplace_back( pages[ i ] + j, std::move( page ) );
                 }
             }
             
+            i += n;
+        }
+        
+        if( fetched.empty() )
+        {
+            return true;
+        }
+        
+        {
+            std::shared_ptr< VM::CoreDump >       next( std::make_shared< VM::CoreDump >( dump->withCache( std::make_shared< VM::MemoryCache >( this->_cache->snapshot() ) ) ) );
+            std::shared_ptr< const VM::Snapshot > snapshot( this->_publish( [ & ]( const VM::Snapshot & s ) { return s.withDump( next ); } ) );
+            
             {
-                bool live( false );
+                std::lock_guard< std::recursive_mutex > l( this->_rmtx );
                 
-                for( const auto & info: Manage::runningVMs() )
+                for( const auto & page: fetched )
                 {
-                    if( info.name() == this->_vmName )
-                    {
-                        live = true;
-                    }
+                    this->_dirty.insert( page.first );
                 }
+            }
+            
+            {
+                std::chrono::system_clock::time_point timestamp( snapshot->timestamp() );
+                
+                this->_ingest( [ this, pages = std::move( fetched ), timestamp ] { this->_memoryHistory->update( pages, timestamp ); } );
+            }
+        }
+        
+        return true;
+    }
+    
+    std::string Monitor::IMPL::_dumpPath( void )
+    {
+        std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+        
+        if( this->_dumpDirectory == nullptr )
+        {
+            try
+            {
+                this->_dumpDirectory = std::make_unique< TemporaryDirectory >();
+            }
+            catch( const std::runtime_error & )
+            {
+                return {};
+            }
+        }
+        
+        return this->_dumpDirectory->path( "core" );
+    }
+    
+    void Monitor::IMPL::_updateLiveStatus( void )
+    {
+        Deadline deadline( this->_deadline( Source::LiveStatus ) );
+        bool     live( this->_backend->live( deadline, this->_cancellation ) );
+        
+        if( live == false && this->_expired( deadline ) )
+        {
+            return;
+        }
+        
+        if( this->_live.exchange( live ) != live )
+        {
+            this->_fullDump = this->_fullDump || live;
+            
+            this->_notify();
+        }
+    }
+    
+    void Monitor::IMPL::_updateSymbols( void )
+    {
+        bool                                     full;
+        std::vector< uint64_t >                  pages;
+        std::shared_ptr< const VM::Snapshot >    snapshot;
+        std::shared_ptr< const VM::SymbolIndex > symbols;
+        
+        {
+            std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+            
+            snapshot = std::atomic_load( &( this->_snapshot ) );
+            
+            if( snapshot->dump() == nullptr || ( this->_reindex == false && this->_dirty.empty() ) )
+            {
+                return;
+            }
+            
+            full = this->_reindex;
+            
+            pages.assign( this->_dirty.begin(), this->_dirty.end() );
+            
+            this->_reindex = false;
+            
+            this->_dirty.clear();
+        }
+        
+        symbols = ( full ) ? this->_indexer.update( *( snapshot->dump() ), this->_cancellation ) : this->_indexer.update( *( snapshot->dump() ), pages, this->_cancellation );
+        
+        if( symbols == nullptr )
+        {
+            std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+            
+            this->_reindex = this->_reindex || full;
+            
+            this->_dirty.insert( pages.begin(), pages.end() );
+            
+            return;
+        }
+        
+        std::atomic_store( &( this->_symbols ), symbols );
+        
+        this->_notify();
+    }
+    
+    void Monitor::IMPL::_ingest( const std::function< void( void ) > & job )
+    {
+        std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+        
+        this->_ingestQueue.push_back( job );
+        
+        if( this->_ingesting )
+        {
+            return;
+        }
+        
+        this->_ingesting = true;
+        
+        this->_pending++;
+        ThreadPool::shared().submit( this->_group, ThreadPool::Priority::Low, [ this ] { this->_drainHistory(); } );
+    }
+    
+    void Monitor::IMPL::_drainHistory( void )
+    {
+        while( true )
+        {
+            std::function< void( void ) > job;
+            
+            {
+                std::lock_guard< std::recursive_mutex > l( this->_rmtx );
                 
+                if( this->_stop || this->_ingestQueue.empty() )
                 {
-                    std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+                    this->_ingesting = false;
                     
-                    this->_live = live;
+                    this->_pending--;
+                    
+                    this->_cv.notify_all();
+                    
+                    return;
                 }
+                
+                job = std::move( this->_ingestQueue.front() );
+                
+                this->_ingestQueue.pop_front();
+            }
+            
+            job();
+            
+            this->_notify();
+        }
+    }
+    
+    void Monitor::IMPL::_record( const VM::Snapshot & snapshot )
+    {
+        VM::Sample                       sample( snapshot );
+        std::shared_ptr< Trace::Writer > writer;
+        
+        {
+            std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+            
+            this->_history.push( sample );
+            
+            writer = this->_writer;
+        }
+        
+        if( writer != nullptr )
+        {
+            writer->write( sample );
+        }
+    }
+    
+    std::shared_ptr< const VM::Snapshot > Monitor::IMPL::_publish( const std::function< VM::Snapshot( const VM::Snapshot & ) > & update )
+    {
+        std::shared_ptr< const VM::Snapshot > current( std::atomic_load( &( this->_snapshot ) ) );
+        std::shared_ptr< const VM::Snapshot > next;
+        
+        do
+        {
+            next = std::make_shared< const VM::Snapshot >( update( *( current ) ) );
+        }
+        while( std::atomic_compare_exchange_weak( &( this->_snapshot ), &current, next ) == false );
+        
+        this->_notify();
+        this->_evaluate();
+        
+        return next;
+    }
+    
+    void Monitor::IMPL::_evaluate( void )
+    {
+        std::optional< VM::Trigger >                                trigger;
+        std::vector< std::function< void( const VM::Trigger & ) > > onTrigger;
+        
+        {
+            std::lock_guard< std::mutex >         l( this->_tmtx );
+            std::shared_ptr< const VM::Snapshot > snapshot( std::atomic_load( &( this->_snapshot ) ) );
+            std::optional< size_t >               index;
+            
+            if( this->_program.empty() || snapshot->sequence() <= this->_evaluated )
+            {
+                return;
+            }
+            
+            this->_evaluated = snapshot->sequence();
+            index            = this->_program.evaluate( *( snapshot ) );
+            
+            if( index.has_value() == false )
+            {
+                return;
             }
+            
+            trigger = this->_program.triggers()[ index.value() ];
+        }
+        
+        this->_backend->pause( this->_deadline( Source::LiveStatus ), this->_cancellation );
+        
+        {
+            std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+            
+            onTrigger = this->_onTrigger;
+        }
+        
+        for( const auto & f: onTrigger )
+        {
+            f( trigger.value() );
+        }
+    }
+    
+    void Monitor::IMPL::_notify( void )
+    {
+        std::vector< std::function< void( void ) > > onChange;
+        
+        {
+            std::lock_guard< std::mutex > l( this->_gmtx );
+            
+            this->_generation++;
+        }
+        
+        this->_gcv.notify_all();
+        
+        {
+            std::lock_guard< std::recursive_mutex > l( this->_rmtx );
+            
+            onChange = this->_onChange;
+        }
+        
+        for( const auto & f: onChange )
+        {
+            f();
         }
     }
 }
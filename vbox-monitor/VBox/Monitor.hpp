@@ -31,31 +31,101 @@
 #include <chrono>
 #include <vector>
 #include <optional>
+#include <functional>
 #include "VBox/VM/Registers.hpp"
 #include "VBox/VM/StackEntry.hpp"
 #include "VBox/VM/CoreDump.hpp"
+#include "VBox/VM/Snapshot.hpp"
+#include "VBox/VM/SymbolIndex.hpp"
+#include "VBox/VM/Sample.hpp"
+#include "VBox/VM/MemoryHistory.hpp"
+#include "VBox/VM/Trigger.hpp"
 
 namespace VBox
 {
+    namespace Manage
+    {
+        class Backend;
+    }
+    
     class Monitor
     {
         public:
             
+            enum class Source
+            {
+                Registers,
+                Stack,
+                Memory,
+                LiveStatus,
+                Symbols
+            };
+            
             Monitor( const std::string & vmName );
+            Monitor( const std::shared_ptr< Manage::Backend > & backend );
             Monitor( const Monitor & o );
             Monitor( Monitor && o );
             ~Monitor( void );
             
             Monitor & operator =( Monitor o );
             
-            bool                            live( void )      const;
-            std::optional< VM::Registers >  registers( void ) const;
-            std::vector< VM::StackEntry >   stack( void )     const;
-            std::shared_ptr< VM::CoreDump > dump( void )      const;
+            bool                                     live( void )      const;
+            void                                     live( bool value );
+            std::shared_ptr< const VM::Snapshot >    snapshot( void )  const;
+            std::optional< VM::Registers >           registers( void ) const;
+            std::vector< VM::StackEntry >            stack( void )     const;
+            std::shared_ptr< VM::CoreDump >          dump( void )      const;
+            std::shared_ptr< const VM::SymbolIndex > symbols( void )   const;
+            
+            uint64_t generation( void )                                                        const;
+            uint64_t waitForChange( uint64_t generation, std::chrono::milliseconds timeout ) const;
+            
+            size_t                       cpu( void )                                             const;
+            void                         cpu( size_t index );
+            size_t                       cpuCount( void )                                        const;
+            std::vector< VM::Registers > cpuRegisters( void )                                    const;
+            size_t                       cpuRegisters( VM::Registers * registers, size_t count ) const;
+            
+            double frequency( Source source ) const;
+            void   frequency( Source source, double hz );
+            
+            double timeout( Source source ) const;
+            void   timeout( Source source, double seconds );
+            
+            double changeRate( Source source )         const;
+            double effectiveFrequency( Source source ) const;
+            
+            bool adaptive( void ) const;
+            void adaptive( bool value );
+            void wakeUp( void );
+            void refreshMemory( void );
+            
+            size_t memoryCacheCapacity( void ) const;
+            void   memoryCacheCapacity( size_t bytes );
+            
+            size_t                      historyCapacity( void )       const;
+            void                        historyCapacity( size_t samples );
+            uint64_t                    historyBegin( void )          const;
+            uint64_t                    historyEnd( void )            const;
+            std::optional< VM::Sample > sample( uint64_t index )      const;
+            
+            std::shared_ptr< const VM::MemoryHistory > memoryHistory( void )         const;
+            size_t                                     memoryHistoryCapacity( void ) const;
+            void                                       memoryHistoryCapacity( size_t generations );
+            
+            std::vector< VM::Trigger > triggers( void ) const;
+            void                       triggers( const std::vector< VM::Trigger > & triggers );
+            
+            void record( const std::string & path );
+            bool recording( void ) const;
+            bool seek( double seconds );
             
             void start( void );
             void stop( void );
             
+            void onChange( const std::function< void( void ) > & f );
+            void onTrigger( const std::function< void( const VM::Trigger & ) > & f );
+            
             friend void swap( Monitor & o1, Monitor & o2 );
             
         private:
@@ -23,7 +23,18 @@
  ******************************************************************************/
 
 #include "VBox/Process.hpp"
+#include "VBox/Casts.hpp"
+#include "VBox/Stats.hpp"
+#include "VBox/Descriptors.hpp"
 #include <unistd.h>
+#include <spawn.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <mutex>
+#include <sys/wait.h>
+
+extern char ** environ;
 
 namespace VBox
 {
@@ -33,28 +44,35 @@ namespace VBox
             
             IMPL( const std::string & path, const std::vector< std::string > & args, const std::vector< std::string > & env );
             
+            bool _drain( const Deadline & deadline, int cancel );
+            void _read( int & fd, std::string & buffer );
+            bool _reap( int options );
+            void _close( void );
+            
             std::string                  _path;
             std::vector< std::string >   _args;
             std::vector< std::string >   _env;
             std::optional< pid_t >       _pid;
             std::optional< int >         _terminationStatus;
-            std::optional< std::string > _output;
-            std::optional< std::string > _error;
-            int                          _fdOut[ 2 ];
-            int                          _fdErr[ 2 ];
+            std::string                  _output;
+            std::string                  _error;
+            int                          _fdOut;
+            int                          _fdErr;
     };
-
+    
     Process::Process( const std::string & path, const std::vector< std::string > & args, const std::vector< std::string > & env ):
         impl( std::make_unique< IMPL >( path, args, env ) )
     {}
 
     Process::~Process( void )
     {
-        if( this->impl->_terminationStatus.has_value() )
+        if( this->running() )
         {
-            close( this->impl->_fdOut[ 0 ] );
-            close( this->impl->_fdErr[ 0 ] );
+            this->kill();
+            this->impl->_reap( 0 );
         }
+        
+        this->impl->_close();
     }
 
     std::vector< std::string > Process::arguments( void ) const
@@ -87,140 +105,276 @@ namespace VBox
         return this->impl->_terminationStatus;
     }
 
+    std::optional< std::string > Process::output( void ) const
+    {
+        if( this->impl->_terminationStatus.has_value() == false )
+        {
+            return {};
+        }
+        
+        return this->impl->_output;
+    }
+
+    std::optional< std::string > Process::error( void ) const
+    {
+        if( this->impl->_terminationStatus.has_value() == false )
+        {
+            return {};
+        }
+        
+        return this->impl->_error;
+    }
+
+    bool Process::running( void ) const
+    {
+        return this->impl->_pid.has_value() && this->impl->_terminationStatus.has_value() == false;
+    }
+
     void Process::start( void )
     {
+        int                        out[ 2 ];
+        int                        err[ 2 ];
+        std::vector< char * >      args;
+        std::vector< char * >      env;
+        posix_spawn_file_actions_t actions;
+        pid_t                      pid;
+        int                        status;
+        
         if( this->impl->_pid.has_value() )
         {
             throw std::runtime_error( "Process has already been started" );
         }
         
-        if( pipe( this->impl->_fdOut ) == -1 || pipe( this->impl->_fdErr ) == -1 )
+        if( Descriptors::pipe( out ) == false )
         {
             throw std::runtime_error( "Cannot create pipe" );
         }
         
-        this->impl->_pid = fork();
+        if( Descriptors::pipe( err ) == false )
+        {
+            close( out[ 0 ] );
+            close( out[ 1 ] );
+            
+            throw std::runtime_error( "Cannot create pipe" );
+        }
+        
+        fcntl( out[ 0 ], F_SETFL, fcntl( out[ 0 ], F_GETFL ) | O_NONBLOCK );
+        fcntl( err[ 0 ], F_SETFL, fcntl( err[ 0 ], F_GETFL ) | O_NONBLOCK );
         
-        if( this->impl->_pid.value() == -1 )
+        args.push_back( const_cast< char * >( this->impl->_path.c_str() ) );
+        
+        for( const auto & s: this->impl->_args )
         {
-            throw std::runtime_error( "Cannot fork process" );
+            args.push_back( const_cast< char * >( s.c_str() ) );
         }
-        else if( this->impl->_pid.value() > 0 )
+        
+        for( const auto & s: this->impl->_env )
         {
-            close( this->impl->_fdOut[ 1 ] );
-            close( this->impl->_fdErr[ 1 ] );
+            env.push_back( const_cast< char * >( s.c_str() ) );
         }
-        else if( this->impl->_pid.value() == 0 )
+        
+        args.push_back( nullptr );
+        env.push_back( nullptr );
+        
         {
-            std::vector< char * > args;
-            std::vector< char * > env;
+            std::unique_lock< std::mutex > l( Descriptors::spawnLock() );
+            Stats::Timer                   timer( "Process::spawn" );
+            
+            posix_spawn_file_actions_init( &actions );
+            posix_spawn_file_actions_adddup2( &actions, out[ 1 ], STDOUT_FILENO );
+            posix_spawn_file_actions_adddup2( &actions, err[ 1 ], STDERR_FILENO );
             
-            dup2(  this->impl->_fdOut[ 1 ], STDOUT_FILENO );
-            close( this->impl->_fdOut[ 0 ] );
-            close( this->impl->_fdOut[ 1 ] );
+            status = posix_spawn( &pid, this->impl->_path.c_str(), &actions, nullptr, &( args[ 0 ] ), ( this->impl->_env.empty() ) ? environ : &( env[ 0 ] ) );
             
-            dup2(  this->impl->_fdErr[ 1 ], STDERR_FILENO );
-            close( this->impl->_fdErr[ 0 ] );
-            close( this->impl->_fdErr[ 1 ] );
+            posix_spawn_file_actions_destroy( &actions );
+        }
+        
+        close( out[ 1 ] );
+        close( err[ 1 ] );
+        
+        this->impl->_fdOut = out[ 0 ];
+        this->impl->_fdErr = err[ 0 ];
+        
+        if( status != 0 )
+        {
+            this->impl->_close();
             
-            args.push_back( strdup( this->impl->_path.c_str() ) );
+            this->impl->_pid               = -1;
+            this->impl->_terminationStatus = 127 << 8;
             
-            for( const auto & s: this->impl->_args )
+            return;
+        }
+        
+        this->impl->_pid = pid;
+    }
+
+    void Process::waitUntilExit( void )
+    {
+        if( this->impl->_pid.has_value() == false )
+        {
+            throw std::runtime_error( "Process is not running" );
+        }
+        
+        this->impl->_drain( {}, -1 );
+    }
+
+    bool Process::waitUntilExit( const Deadline & deadline, const Cancellation & cancellation )
+    {
+        if( this->impl->_pid.has_value() == false )
+        {
+            throw std::runtime_error( "Process is not running" );
+        }
+        
+        if( cancellation.cancelled() )
+        {
+            return this->impl->_terminationStatus.has_value();
+        }
+        
+        return this->impl->_drain( deadline, cancellation.fd() );
+    }
+
+    void Process::kill( int signal )
+    {
+        if( this->running() )
+        {
+            ::kill( this->impl->_pid.value(), signal );
+        }
+    }
+
+    Process::IMPL::IMPL( const std::string & path, const std::vector< std::string > & args, const std::vector< std::string > & env ):
+        _path(  path ),
+        _args(  args ),
+        _env(   env ),
+        _fdOut( -1 ),
+        _fdErr( -1 )
+    {}
+    
+    bool Process::IMPL::_drain( const Deadline & deadline, int cancel )
+    {
+        while( this->_terminationStatus.has_value() == false )
+        {
+            struct pollfd fds[ 3 ];
+            nfds_t        n( 0 );
+            int           timeout;
+            
+            if( this->_fdOut == -1 && this->_fdErr == -1 && cancel == -1 && deadline.infinite() )
             {
-                args.push_back( strdup( s.c_str() ) );
+                this->_reap( 0 );
+                
+                break;
             }
             
-            for( const auto & s: this->impl->_env )
+            if( this->_fdOut == -1 && this->_fdErr == -1 && this->_reap( WNOHANG ) )
             {
-                args.push_back( strdup( s.c_str() ) );
+                break;
             }
             
-            args.push_back( nullptr );
-            env.push_back( nullptr );
+            if( deadline.expired() )
+            {
+                return false;
+            }
             
-            execve( this->impl->_path.c_str(), &( args[ 0 ] ), &( args[ 0 ] ) );
+            timeout = deadline.timeout( 20 );
+            
+            for( int fd: { this->_fdOut, this->_fdErr, cancel } )
+            {
+                if( fd != -1 )
+                {
+                    fds[ n ].fd      = fd;
+                    fds[ n ].events  = POLLIN;
+                    fds[ n ].revents = 0;
+                    
+                    n++;
+                }
+            }
             
-            for( auto cp: args )
+            if( poll( fds, n, timeout ) < 0 && errno != EINTR )
             {
-                free( cp );
+                this->_close();
+            }
+            else if( cancel != -1 && fds[ n - 1 ].revents != 0 )
+            {
+                return false;
             }
             
-            for( auto cp: env )
+            this->_read( this->_fdOut, this->_output );
+            this->_read( this->_fdErr, this->_error );
+            
+            if( ( this->_fdOut != -1 || this->_fdErr != -1 ) && this->_reap( WNOHANG ) )
             {
-                free( cp );
+                this->_read( this->_fdOut, this->_output );
+                this->_read( this->_fdErr, this->_error );
+                this->_close();
             }
         }
+        
+        return true;
     }
-
-    void Process::waitUntilExit( void )
+    
+    void Process::IMPL::_read( int & fd, std::string & buffer )
     {
-        int status;
+        char    buf[ 4096 ];
+        ssize_t n;
         
-        if( this->impl->_pid.has_value() == false || this->impl->_pid.value() <= 0 )
+        if( fd == -1 )
         {
-            throw std::runtime_error( "Process is not running" );
+            return;
         }
         
-        waitpid( this->impl->_pid.value(), &status, 0 );
-        
-        this->impl->_terminationStatus = status;
-    }
-
-    std::optional< std::string > Process::output( void ) const
-    {
-        if( this->impl->_terminationStatus.has_value() == false )
+        while( ( n = read( fd, buf, sizeof( buf ) ) ) > 0 )
         {
-            return {};
+            buffer.append( buf, numeric_cast< size_t >( n ) );
         }
         
-        if( this->impl->_output.has_value() )
+        if( n == 0 || ( errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR ) )
         {
-            return this->impl->_output.value();
+            close( fd );
+            
+            fd = -1;
         }
+    }
+    
+    bool Process::IMPL::_reap( int options )
+    {
+        int   status;
+        pid_t pid;
         
-        std::string out;
-        char        buf[ 1024 ];
-        ssize_t     n;
-        
-        while( ( n = read( this->impl->_fdOut[ 0 ], buf, sizeof( buf ) ) ) > 0 )
+        if( this->_terminationStatus.has_value() )
         {
-            out += buf;
+            return true;
         }
         
-        this->impl->_output = out;
-        
-        return out;
-    }
-
-    std::optional< std::string > Process::error( void ) const
-    {
-        if( this->impl->_terminationStatus.has_value() == false )
+        if( this->_pid.has_value() == false || this->_pid.value() <= 0 )
         {
-            return {};
+            return false;
         }
         
-        if( this->impl->_error.has_value() )
+        do
         {
-            return this->impl->_error.value();
+            pid = waitpid( this->_pid.value(), &status, options );
         }
+        while( pid == -1 && errno == EINTR );
         
-        std::string out;
-        char        buf[ 1024 ];
-        ssize_t     n;
-        
-        while( ( n = read( this->impl->_fdErr[ 0 ], buf, sizeof( buf ) ) ) > 0 )
+        if( pid == 0 )
         {
-            out += buf;
+            return false;
         }
         
-        this->impl->_error = out;
+        this->_terminationStatus = ( pid == -1 ) ? -1 : status;
         
-        return out;
+        return true;
+    }
+    
+    void Process::IMPL::_close( void )
+    {
+        for( int * fd: { &( this->_fdOut ), &( this->_fdErr ) } )
+        {
+            if( *( fd ) != -1 )
+            {
+                close( *( fd ) );
+                
+                *( fd ) = -1;
+            }
+        }
     }
-
-    Process::IMPL::IMPL( const std::string & path, const std::vector< std::string > & args, const std::vector< std::string > & env ):
-        _path( path ),
-        _args( args ),
-        _env(  env )
-    {}
 }
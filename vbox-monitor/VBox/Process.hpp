@@ -29,6 +29,9 @@
 #include <vector>
 #include <optional>
 #include <memory>
+#include <csignal>
+#include "VBox/Deadline.hpp"
+#include "VBox/Cancellation.hpp"
 
 namespace VBox
 {
@@ -56,8 +59,12 @@ namespace VBox
             std::optional< std::string > output( void )            const;
             std::optional< std::string > error( void )             const;
             
+            bool running( void ) const;
+            
             void start( void );
             void waitUntilExit( void );
+            bool waitUntilExit( const Deadline & deadline, const Cancellation & cancellation = Cancellation::none() );
+            void kill( int signal = SIGKILL );
             
         private:
             
@@ -0,0 +1,741 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Remote/Agent.hpp"
+#include "VBox/Remote/Protocol.hpp"
+#include "VBox/Manage/Backend.hpp"
+#include "VBox/VM/MemoryCache.hpp"
+#include "VBox/BinaryDataStream.hpp"
+#include "VBox/Trace/Format.hpp"
+#include "VBox/Cancellation.hpp"
+#include "VBox/Descriptors.hpp"
+#include "VBox/Stats.hpp"
+#include "VBox/Casts.hpp"
+#include "VBox/Hash.hpp"
+#include "VBox/SHA256.hpp"
+#include "VBox/SignalHandler.hpp"
+#include "VBox/TemporaryDirectory.hpp"
+#include <mutex>
+#include <thread>
+#include <optional>
+#include <chrono>
+#include <map>
+#include <set>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+namespace VBox
+{
+    namespace Remote
+    {
+        class Agent::IMPL
+        {
+            public:
+                
+                class Client
+                {
+                    public:
+                        
+                        int                                      _socket;
+                        std::shared_ptr< Manage::Backend >       _backend;
+                        Protocol::Deltas                         _deltas;
+                        std::unordered_map< uint64_t, uint64_t > _hashes;
+                        Protocol::PageOrder                      _order;
+                        std::unique_ptr< TemporaryDirectory >    _dumpDirectory;
+                        std::string                              _vmName;
+                        std::vector< uint8_t >                   _clientNonce;
+                        std::vector< uint8_t >                   _agentNonce;
+                };
+                
+                IMPL( uint16_t port, const std::string & address, const std::string & token, bool managed );
+                ~IMPL( void );
+                
+                void                               _serve( uint64_t id, int socket );
+                bool                               _handle( Client & client, const Protocol::Frame & frame );
+                bool                               _hello( Client & client, BinaryStream & stream );
+                bool                               _authenticate( Client & client, BinaryStream & stream );
+                bool                               _error( Client & client, const std::string & message );
+                bool                               _dump( Client & client, const Deadline & deadline );
+                std::vector< uint8_t >             _live( Client & client, const Deadline & deadline );
+                std::vector< uint8_t >             _registers( Client & client, const Deadline & deadline );
+                std::vector< uint8_t >             _allRegisters( Client & client, const Deadline & deadline );
+                std::vector< uint8_t >             _stack( Client & client, const Deadline & deadline );
+                std::vector< uint8_t >             _allStacks( Client & client, const Deadline & deadline );
+                std::vector< uint8_t >             _memory( Client & client, BinaryStream & stream, const Deadline & deadline );
+                std::vector< uint8_t >             _pause( Client & client, const Deadline & deadline );
+                std::shared_ptr< Manage::Backend > _backendForVM( const std::string & vmName );
+                
+                int                                                       _socket;
+                uint16_t                                                  _port;
+                std::string                                               _address;
+                std::string                                               _token;
+                mutable std::mutex                                        _mtx;
+                bool                                                      _running;
+                bool                                                      _stop;
+                Cancellation                                              _cancellation;
+                uint64_t                                                  _nextID;
+                std::map< uint64_t, std::thread >                         _threads;
+                std::vector< uint64_t >                                   _finished;
+                std::set< int >                                           _clients;
+                std::map< std::string, std::weak_ptr< Manage::Backend > > _backends;
+                bool                                                      _managed;
+                std::vector< std::shared_ptr< Manage::Backend > >         _served;
+        };
+        
+        static const int    PollTimeout = 200;
+        static const int    SendTimeout = 30;
+        static const size_t MaxClients  = 64;
+        
+        static const std::chrono::seconds HandshakeTimeout( 10 );
+        
+        Agent::Agent( uint16_t port, const std::string & address, const std::string & token ):
+            impl( std::make_unique< IMPL >( port, address, token, true ) )
+        {}
+        
+        Agent::Agent( uint16_t port, const std::string & address, const std::string & token, const std::vector< std::shared_ptr< Manage::Backend > > & backends ):
+            impl( std::make_unique< IMPL >( port, address, token, false ) )
+        {
+            for( const auto & backend: backends )
+            {
+                this->impl->_backends[ backend->vmName() ] = backend;
+            }
+            
+            this->impl->_served = backends;
+        }
+        
+        Agent::~Agent( void )
+        {
+            this->stop();
+        }
+        
+        uint16_t Agent::port( void ) const
+        {
+            return this->impl->_port;
+        }
+        
+        std::string Agent::address( void ) const
+        {
+            return this->impl->_address;
+        }
+        
+        size_t Agent::clients( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_clients.size();
+        }
+        
+        void Agent::run( void )
+        {
+            std::optional< SignalHandler > signals;
+            
+            {
+                std::lock_guard< std::mutex > l( this->impl->_mtx );
+                
+                if( this->impl->_running )
+                {
+                    return;
+                }
+                
+                this->impl->_running = true;
+                this->impl->_stop    = false;
+            }
+            
+            signals.emplace();
+            
+            while( signals->interrupted() == false )
+            {
+                struct pollfd  p[ 2 ];
+                int            socket;
+                int            one( 1 );
+                struct timeval timeout;
+                
+                {
+                    std::lock_guard< std::mutex > l( this->impl->_mtx );
+                    
+                    if( this->impl->_stop )
+                    {
+                        break;
+                    }
+                    
+                    for( uint64_t id: this->impl->_finished )
+                    {
+                        this->impl->_threads[ id ].join();
+                        this->impl->_threads.erase( id );
+                    }
+                    
+                    this->impl->_finished.clear();
+                }
+                
+                memset( p, 0, sizeof( p ) );
+                
+                p[ 0 ].fd     = this->impl->_socket;
+                p[ 0 ].events = POLLIN;
+                p[ 1 ].fd     = this->impl->_cancellation.fd();
+                p[ 1 ].events = POLLIN;
+                
+                if( poll( p, 2, PollTimeout ) <= 0 || ( p[ 0 ].revents & POLLIN ) == 0 )
+                {
+                    continue;
+                }
+                
+                socket = Descriptors::accept( this->impl->_socket );
+                
+                if( socket == -1 )
+                {
+                    continue;
+                }
+                
+                memset( &timeout, 0, sizeof( timeout ) );
+                
+                timeout.tv_sec = SendTimeout;
+                
+                setsockopt( socket, IPPROTO_TCP, TCP_NODELAY, &one, sizeof( one ) );
+                setsockopt( socket, SOL_SOCKET,  SO_SNDTIMEO, &timeout, sizeof( timeout ) );
+                
+                #ifdef SO_NOSIGPIPE
+                setsockopt( socket, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof( one ) );
+                #endif
+                
+                {
+                    std::lock_guard< std::mutex > l( this->impl->_mtx );
+                    uint64_t                      id( this->impl->_nextID++ );
+                    
+                    if( this->impl->_clients.size() >= MaxClients )
+                    {
+                        ::close( socket );
+                        
+                        continue;
+                    }
+                    
+                    this->impl->_clients.insert( socket );
+                    
+                    this->impl->_threads[ id ] = std::thread( [ this, id, socket ] { this->impl->_serve( id, socket ); } );
+                }
+            }
+            
+            this->impl->_cancellation.cancel();
+            
+            {
+                std::map< uint64_t, std::thread > threads;
+                
+                {
+                    std::lock_guard< std::mutex > l( this->impl->_mtx );
+                    
+                    for( int socket: this->impl->_clients )
+                    {
+                        shutdown( socket, SHUT_RDWR );
+                    }
+                    
+                    std::swap( threads, this->impl->_threads );
+                }
+                
+                for( auto & thread: threads )
+                {
+                    thread.second.join();
+                }
+            }
+            
+            signals.reset();
+            
+            {
+                std::lock_guard< std::mutex > l( this->impl->_mtx );
+                
+                this->impl->_finished.clear();
+                this->impl->_cancellation.reset();
+                
+                this->impl->_running = false;
+            }
+        }
+        
+        void Agent::stop( void )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_stop = true;
+            
+            if( this->impl->_running )
+            {
+                this->impl->_cancellation.cancel();
+            }
+        }
+        
+        Agent::IMPL::IMPL( uint16_t port, const std::string & address, const std::string & token, bool managed ):
+            _socket(  -1 ),
+            _port(    port ),
+            _address( address ),
+            _token(   token ),
+            _running( false ),
+            _stop(    false ),
+            _nextID(  0 ),
+            _managed( managed )
+        {
+            struct addrinfo         hints;
+            struct addrinfo       * result( nullptr );
+            struct sockaddr_storage addr;
+            socklen_t               length( sizeof( addr ) );
+            int                     one( 1 );
+            int                     error( 0 );
+            
+            if( this->_token.empty() )
+            {
+                throw std::runtime_error( "Cannot start agent without a shared token" );
+            }
+            
+            memset( &hints, 0, sizeof( hints ) );
+            
+            hints.ai_family   = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+            hints.ai_flags    = AI_PASSIVE | AI_NUMERICHOST | AI_NUMERICSERV;
+            
+            if( getaddrinfo( address.c_str(), std::to_string( port ).c_str(), &hints, &result ) != 0 )
+            {
+                throw std::runtime_error( "Invalid listen address: " + address );
+            }
+            
+            for( struct addrinfo * info = result; info != nullptr && this->_socket == -1; info = info->ai_next )
+            {
+                this->_socket = Descriptors::socket( info->ai_family, info->ai_socktype, info->ai_protocol );
+                
+                if( this->_socket == -1 )
+                {
+                    error = errno;
+                    
+                    continue;
+                }
+                
+                setsockopt( this->_socket, SOL_SOCKET, SO_REUSEADDR, &one, sizeof( one ) );
+                
+                if( bind( this->_socket, info->ai_addr, info->ai_addrlen ) != 0 || listen( this->_socket, SOMAXCONN ) != 0 )
+                {
+                    error = errno;
+                    
+                    ::close( this->_socket );
+                    
+                    this->_socket = -1;
+                }
+            }
+            
+            freeaddrinfo( result );
+            
+            if( this->_socket == -1 )
+            {
+                throw std::runtime_error( "Cannot listen on " + address + " port " + std::to_string( port ) + " (" + strerror( error ) + ")" );
+            }
+            
+            if( getsockname( this->_socket, reinterpret_cast< struct sockaddr * >( &addr ), &length ) == 0 )
+            {
+                if( addr.ss_family == AF_INET6 )
+                {
+                    this->_port = ntohs( reinterpret_cast< struct sockaddr_in6 * >( &addr )->sin6_port );
+                }
+                else
+                {
+                    this->_port = ntohs( reinterpret_cast< struct sockaddr_in * >( &addr )->sin_port );
+                }
+            }
+        }
+        
+        Agent::IMPL::~IMPL( void )
+        {
+            ::close( this->_socket );
+        }
+        
+        void Agent::IMPL::_serve( uint64_t id, int socket )
+        {
+            Client   client;
+            Deadline handshake( Deadline::after( HandshakeTimeout ) );
+            
+            client._socket = socket;
+            
+            while( true )
+            {
+                bool                             authenticated( client._backend != nullptr );
+                Deadline                         deadline( ( authenticated ) ? Deadline::never() : handshake );
+                std::optional< Protocol::Frame > frame( Protocol::receive( socket, deadline, this->_cancellation, ( authenticated ) ? Protocol::MaxMessageSize : Protocol::MaxHelloSize ) );
+                
+                if( frame.has_value() == false )
+                {
+                    break;
+                }
+                
+                try
+                {
+                    if( this->_handle( client, frame.value() ) == false )
+                    {
+                        break;
+                    }
+                }
+                catch( const std::runtime_error & )
+                {
+                    break;
+                }
+            }
+            
+            {
+                std::lock_guard< std::mutex > l( this->_mtx );
+                
+                ::close( socket );
+                
+                this->_clients.erase( socket );
+                this->_finished.push_back( id );
+            }
+        }
+        
+        bool Agent::IMPL::_handle( Client & client, const Protocol::Frame & frame )
+        {
+            Stats::Timer           timer( "Remote::Agent::request" );
+            BinaryDataStream       stream( frame.second );
+            std::vector< uint8_t > out;
+            Deadline               deadline;
+            
+            if( frame.first == Protocol::Message::Hello )
+            {
+                return this->_hello( client, stream );
+            }
+            
+            if( frame.first == Protocol::Message::Authenticate )
+            {
+                return this->_authenticate( client, stream );
+            }
+            
+            if( client._backend == nullptr )
+            {
+                return false;
+            }
+            
+            deadline = Protocol::readTimeout( stream );
+            
+            switch( frame.first )
+            {
+                case Protocol::Message::Live:         out = this->_live( client, deadline );           break;
+                case Protocol::Message::Registers:    out = this->_registers( client, deadline );      break;
+                case Protocol::Message::AllRegisters: out = this->_allRegisters( client, deadline );   break;
+                case Protocol::Message::Stack:        out = this->_stack( client, deadline );          break;
+                case Protocol::Message::AllStacks:    out = this->_allStacks( client, deadline );      break;
+                case Protocol::Message::Memory:       out = this->_memory( client, stream, deadline ); break;
+                case Protocol::Message::Pause:        out = this->_pause( client, deadline );          break;
+                case Protocol::Message::Dump:         return this->_dump( client, deadline );
+                default:                              return this->_error( client, "Unsupported request" );
+            }
+            
+            return Protocol::send( client._socket, frame.first, out );
+        }
+        
+        bool Agent::IMPL::_error( Client & client, const std::string & message )
+        {
+            std::vector< uint8_t > out;
+            
+            Protocol::writeString( out, message );
+            
+            return Protocol::send( client._socket, Protocol::Message::Error, out );
+        }
+        
+        bool Agent::IMPL::_hello( Client & client, BinaryStream & stream )
+        {
+            std::vector< uint8_t > magic( stream.Read( Protocol::Magic.size() ) );
+            uint8_t                version( stream.ReadUInt8() );
+            std::vector< uint8_t > out;
+            
+            if( client._backend != nullptr || client._agentNonce.empty() == false || std::equal( magic.begin(), magic.end(), Protocol::Magic.begin() ) == false || version != Protocol::Version )
+            {
+                this->_error( client, "Unsupported protocol version" );
+                
+                return false;
+            }
+            
+            client._vmName      = Protocol::readString( stream );
+            client._clientNonce = Protocol::readNonce( stream );
+            client._agentNonce  = Protocol::nonce();
+            
+            out.insert( out.end(), client._agentNonce.begin(), client._agentNonce.end() );
+            
+            return Protocol::send( client._socket, Protocol::Message::Challenge, out );
+        }
+        
+        bool Agent::IMPL::_authenticate( Client & client, BinaryStream & stream )
+        {
+            SHA256::Digest         expected;
+            SHA256::Digest         proof;
+            std::vector< uint8_t > out;
+            
+            if( client._backend != nullptr || client._agentNonce.empty() )
+            {
+                return false;
+            }
+            
+            expected = Protocol::proof( this->_token, Protocol::ClientRole, client._vmName, client._clientNonce, client._agentNonce );
+            proof    = Protocol::readProof( stream );
+            
+            if( SHA256::equal( proof, expected ) == false )
+            {
+                this->_error( client, "Authentication failed" );
+                
+                return false;
+            }
+            
+            client._backend = this->_backendForVM( client._vmName );
+            
+            if( client._backend == nullptr )
+            {
+                this->_error( client, "Unknown virtual machine: " + client._vmName );
+                
+                return false;
+            }
+            
+            proof = Protocol::proof( this->_token, Protocol::AgentRole, client._vmName, client._clientNonce, client._agentNonce );
+            
+            Protocol::writeString( out, client._backend->name() );
+            
+            out.insert( out.end(), proof.begin(), proof.end() );
+            
+            return Protocol::send( client._socket, Protocol::Message::Hello, out );
+        }
+        
+        bool Agent::IMPL::_dump( Client & client, const Deadline & deadline )
+        {
+            std::shared_ptr< VM::CoreDump > dump;
+            std::vector< uint8_t >          out;
+            VM::MemoryView                  image;
+            size_t                          header( 0 );
+            
+            if( client._dumpDirectory == nullptr )
+            {
+                try
+                {
+                    client._dumpDirectory = std::make_unique< TemporaryDirectory >();
+                }
+                catch( const std::runtime_error & )
+                {}
+            }
+            
+            if( client._dumpDirectory != nullptr )
+            {
+                dump = client._backend->dump( client._dumpDirectory->path( "core" ), deadline, this->_cancellation );
+            }
+            
+            if( dump != nullptr )
+            {
+                image  = dump->image();
+                header = numeric_cast< size_t >( std::min< uint64_t >( dump->headerSize(), image.size() ) );
+            }
+            
+            Trace::Format::writeVarint( out, image.size() );
+            
+            if( Protocol::send( client._socket, Protocol::Message::Dump, out ) == false )
+            {
+                return false;
+            }
+            
+            for( size_t offset = 0; offset < header; offset += Protocol::DumpChunkSize )
+            {
+                const uint8_t * chunk( image.data() + offset );
+                size_t          size( std::min( Protocol::DumpChunkSize, header - offset ) );
+                
+                if( std::all_of( chunk, chunk + size, []( uint8_t byte ) { return byte == 0; } ) )
+                {
+                    continue;
+                }
+                
+                out.clear();
+                
+                Trace::Format::writeVarint( out, offset );
+                
+                out.insert( out.end(), chunk, chunk + size );
+                
+                if( Protocol::send( client._socket, Protocol::Message::DumpChunk, out ) == false )
+                {
+                    return false;
+                }
+            }
+            
+            return Protocol::send( client._socket, Protocol::Message::DumpEnd, {} );
+        }
+        
+        std::vector< uint8_t > Agent::IMPL::_live( Client & client, const Deadline & deadline )
+        {
+            return { static_cast< uint8_t >( ( client._backend->live( deadline, this->_cancellation ) ) ? 1 : 0 ) };
+        }
+        
+        std::vector< uint8_t > Agent::IMPL::_registers( Client & client, const Deadline & deadline )
+        {
+            std::optional< VM::Registers > registers( client._backend->registers( deadline, this->_cancellation ) );
+            std::vector< uint8_t >         out;
+            
+            out.push_back( ( registers.has_value() ) ? 1 : 0 );
+            
+            if( registers.has_value() )
+            {
+                client._deltas.write( out, Protocol::Message::Registers, 0, Protocol::words( registers.value() ) );
+            }
+            
+            return out;
+        }
+        
+        std::vector< uint8_t > Agent::IMPL::_allRegisters( Client & client, const Deadline & deadline )
+        {
+            std::vector< VM::Registers > all( client._backend->allRegisters( deadline, this->_cancellation ) );
+            std::vector< uint8_t >       out;
+            
+            Trace::Format::writeVarint( out, all.size() );
+            
+            for( size_t i = 0; i < all.size(); i++ )
+            {
+                client._deltas.write( out, Protocol::Message::AllRegisters, i, Protocol::words( all[ i ] ) );
+            }
+            
+            return out;
+        }
+        
+        std::vector< uint8_t > Agent::IMPL::_stack( Client & client, const Deadline & deadline )
+        {
+            std::vector< uint8_t > out;
+            
+            client._deltas.write( out, Protocol::Message::Stack, 0, Protocol::words( client._backend->stack( deadline, this->_cancellation ) ) );
+            
+            return out;
+        }
+        
+        std::vector< uint8_t > Agent::IMPL::_allStacks( Client & client, const Deadline & deadline )
+        {
+            std::vector< std::vector< VM::StackEntry > > all( client._backend->allStacks( deadline, this->_cancellation ) );
+            std::vector< uint8_t >                       out;
+            
+            Trace::Format::writeVarint( out, all.size() );
+            
+            for( size_t i = 0; i < all.size(); i++ )
+            {
+                client._deltas.write( out, Protocol::Message::AllStacks, i, Protocol::words( all[ i ] ) );
+            }
+            
+            return out;
+        }
+        
+        std::vector< uint8_t > Agent::IMPL::_memory( Client & client, BinaryStream & stream, const Deadline & deadline )
+        {
+            uint64_t                                address( Trace::Format::readVarint( stream ) );
+            uint64_t                                size(    Trace::Format::readVarint( stream ) );
+            uint64_t                                pageSize( VM::MemoryCache::pageSize() );
+            std::optional< std::vector< uint8_t > > data;
+            std::vector< uint8_t >                  out;
+            
+            if( size == 0 || size > Protocol::MaxMessageSize / 2 || address > UINT64_MAX - size )
+            {
+                throw std::runtime_error( "Invalid remote memory request" );
+            }
+            
+            data = client._backend->readMemory( address, numeric_cast< size_t >( size ), deadline, this->_cancellation );
+            
+            if( data.has_value() == false || data.value().size() != size )
+            {
+                return { 0 };
+            }
+            
+            out.push_back( 1 );
+            
+            for( uint64_t start = address; start < address + size; )
+            {
+                uint64_t        end( std::min( ( start / pageSize + 1 ) * pageSize, address + size ) );
+                const uint8_t * piece( data.value().data() + ( start - address ) );
+                uint64_t        hash( Hash::bytes( piece, numeric_cast< size_t >( end - start ) ) );
+                auto            it( client._hashes.find( start ) );
+                
+                if( it != client._hashes.end() && it->second == hash )
+                {
+                    out.push_back( 0 );
+                }
+                else
+                {
+                    client._hashes[ start ] = hash;
+                    
+                    out.push_back( 1 );
+                    out.insert( out.end(), piece, piece + ( end - start ) );
+                }
+                
+                {
+                    std::optional< uint64_t > evicted( client._order.touch( start ) );
+                    
+                    if( evicted.has_value() )
+                    {
+                        client._hashes.erase( evicted.value() );
+                    }
+                }
+                
+                start = end;
+            }
+            
+            return out;
+        }
+        
+        std::vector< uint8_t > Agent::IMPL::_pause( Client & client, const Deadline & deadline )
+        {
+            return { static_cast< uint8_t >( ( client._backend->pause( deadline, this->_cancellation ) ) ? 1 : 0 ) };
+        }
+        
+        std::shared_ptr< Manage::Backend > Agent::IMPL::_backendForVM( const std::string & vmName )
+        {
+            std::shared_ptr< Manage::Backend > backend;
+            
+            {
+                std::lock_guard< std::mutex > l( this->_mtx );
+                
+                backend = this->_backends[ vmName ].lock();
+            }
+            
+            if( backend != nullptr || this->_managed == false )
+            {
+                return backend;
+            }
+            
+            backend = Manage::Backend::forVM( vmName );
+            
+            {
+                std::lock_guard< std::mutex >      l( this->_mtx );
+                std::shared_ptr< Manage::Backend > existing( this->_backends[ vmName ].lock() );
+                
+                if( existing != nullptr )
+                {
+                    return existing;
+                }
+                
+                this->_backends[ vmName ] = backend;
+            }
+            
+            return backend;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_REMOTE_AGENT_HPP
+#define VBOX_REMOTE_AGENT_HPP
+
+#include "VBox/Manage/Backend.hpp"
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+
+namespace VBox
+{
+    namespace Remote
+    {
+        class Agent
+        {
+            public:
+                
+                Agent( uint16_t port, const std::string & address, const std::string & token );
+                Agent( uint16_t port, const std::string & address, const std::string & token, const std::vector< std::shared_ptr< Manage::Backend > > & backends );
+                ~Agent( void );
+                
+                Agent( const Agent & o )              = delete;
+                Agent( Agent && o )                   = delete;
+                Agent & operator =( const Agent & o ) = delete;
+                Agent & operator =( Agent && o )      = delete;
+                
+                uint16_t    port( void )    const;
+                std::string address( void ) const;
+                size_t      clients( void ) const;
+                
+                void run( void );
+                void stop( void );
+                
+            private:
+                
+                class IMPL;
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_REMOTE_AGENT_HPP */
@@ -0,0 +1,532 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Remote/Protocol.hpp"
+#include "VBox/Trace/Format.hpp"
+#include "VBox/LZ.hpp"
+#include "VBox/Casts.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+namespace VBox
+{
+    namespace Remote
+    {
+        namespace Protocol
+        {
+            static const int    PollTimeout     = 1000;
+            static const size_t StackEntryWords = 12;
+            
+            static const VM::Registers::Segment Segments[] =
+            {
+                VM::Registers::Segment::CS,
+                VM::Registers::Segment::DS,
+                VM::Registers::Segment::ES,
+                VM::Registers::Segment::FS,
+                VM::Registers::Segment::GS,
+                VM::Registers::Segment::SS
+            };
+            
+            static const size_t VectorCount   = 16;
+            static const size_t RegisterWords = VM::Registers::Count + 2 * ( sizeof( Segments ) / sizeof( Segments[ 0 ] ) ) + 4 * VectorCount;
+            
+            static void put32( uint8_t * p, size_t value )
+            {
+                for( unsigned int i = 0; i < 4; i++ )
+                {
+                    p[ i ] = static_cast< uint8_t >( value >> ( i * 8 ) );
+                }
+            }
+            
+            static size_t get32( const uint8_t * p )
+            {
+                size_t value( 0 );
+                
+                for( unsigned int i = 4; i > 0; i-- )
+                {
+                    value = ( value << 8 ) | p[ i - 1 ];
+                }
+                
+                return value;
+            }
+            
+            static bool read( int socket, uint8_t * buffer, size_t size, const Deadline & deadline, const Cancellation & cancellation )
+            {
+                size_t received( 0 );
+                
+                while( received < size )
+                {
+                    struct pollfd p[ 2 ];
+                    ssize_t       n;
+                    int           ready;
+                    
+                    memset( p, 0, sizeof( p ) );
+                    
+                    p[ 0 ].fd     = socket;
+                    p[ 0 ].events = POLLIN;
+                    p[ 1 ].fd     = cancellation.fd();
+                    p[ 1 ].events = POLLIN;
+                    
+                    if( cancellation.cancelled() || deadline.expired() )
+                    {
+                        return false;
+                    }
+                    
+                    ready = poll( p, 2, deadline.timeout( PollTimeout ) );
+                    
+                    if( ready < 0 && errno == EINTR )
+                    {
+                        continue;
+                    }
+                    
+                    if( ready < 0 || p[ 1 ].revents != 0 )
+                    {
+                        return false;
+                    }
+                    
+                    if( ready == 0 )
+                    {
+                        continue;
+                    }
+                    
+                    n = recv( socket, buffer + received, size - received, 0 );
+                    
+                    if( n <= 0 )
+                    {
+                        return false;
+                    }
+                    
+                    received += numeric_cast< size_t >( n );
+                }
+                
+                return true;
+            }
+            
+            void Deltas::write( std::vector< uint8_t > & out, Message channel, size_t index, const std::vector< uint64_t > & words )
+            {
+                std::vector< uint64_t > & previous( this->_previous[ { channel, index } ] );
+                size_t                    mask;
+                
+                Trace::Format::writeVarint( out, words.size() );
+                
+                mask = out.size();
+                
+                out.resize( mask + ( words.size() + 7 ) / 8, 0 );
+                
+                for( size_t i = 0; i < words.size(); i++ )
+                {
+                    uint64_t base( ( i < previous.size() ) ? previous[ i ] : 0 );
+                    
+                    if( words[ i ] != base )
+                    {
+                        out[ mask + i / 8 ] |= static_cast< uint8_t >( 1 << ( i % 8 ) );
+                        
+                        Trace::Format::writeSigned( out, static_cast< int64_t >( words[ i ] - base ) );
+                    }
+                }
+                
+                previous = words;
+            }
+            
+            std::vector< uint64_t > Deltas::read( BinaryStream & stream, Message channel, size_t index )
+            {
+                std::vector< uint64_t > & previous( this->_previous[ { channel, index } ] );
+                uint64_t                  count( Trace::Format::readVarint( stream ) );
+                std::vector< uint8_t >    mask;
+                std::vector< uint64_t >   words;
+                
+                if( count > MaxMessageSize )
+                {
+                    throw std::runtime_error( "Invalid remote delta" );
+                }
+                
+                mask = stream.Read( numeric_cast< size_t >( ( count + 7 ) / 8 ) );
+                
+                words.resize( numeric_cast< size_t >( count ) );
+                
+                for( size_t i = 0; i < words.size(); i++ )
+                {
+                    words[ i ] = ( i < previous.size() ) ? previous[ i ] : 0;
+                    
+                    if( ( mask[ i / 8 ] & ( 1 << ( i % 8 ) ) ) != 0 )
+                    {
+                        words[ i ] += static_cast< uint64_t >( Trace::Format::readSigned( stream ) );
+                    }
+                }
+                
+                previous = words;
+                
+                return words;
+            }
+            
+            std::optional< uint64_t > PageOrder::touch( uint64_t address )
+            {
+                auto it( this->_positions.find( address ) );
+                
+                if( it != this->_positions.end() )
+                {
+                    this->_order.splice( this->_order.end(), this->_order, it->second );
+                    
+                    return {};
+                }
+                
+                this->_positions[ address ] = this->_order.insert( this->_order.end(), address );
+                
+                if( this->_order.size() <= MaxCachedPages )
+                {
+                    return {};
+                }
+                
+                {
+                    uint64_t evicted( this->_order.front() );
+                    
+                    this->_positions.erase( evicted );
+                    this->_order.pop_front();
+                    
+                    return evicted;
+                }
+            }
+            
+            bool send( int socket, Message type, const std::vector< uint8_t > & payload )
+            {
+                std::vector< uint8_t > compressed;
+                std::vector< uint8_t > data( HeaderSize );
+                size_t                 sent( 0 );
+                
+                if( payload.size() >= CompressionThreshold )
+                {
+                    compressed = LZ::compress( payload );
+                }
+                
+                data[ 0 ] = static_cast< uint8_t >( type );
+                
+                put32( data.data() + 1, payload.size() );
+                
+                if( compressed.empty() == false && compressed.size() < payload.size() )
+                {
+                    put32( data.data() + 5, compressed.size() );
+                    data.insert( data.end(), compressed.begin(), compressed.end() );
+                }
+                else
+                {
+                    put32( data.data() + 5, 0 );
+                    data.insert( data.end(), payload.begin(), payload.end() );
+                }
+                
+                while( sent < data.size() )
+                {
+                    #ifdef MSG_NOSIGNAL
+                    ssize_t n( ::send( socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL ) );
+                    #else
+                    ssize_t n( ::send( socket, data.data() + sent, data.size() - sent, 0 ) );
+                    #endif
+                    
+                    if( n < 0 && errno == EINTR )
+                    {
+                        continue;
+                    }
+                    
+                    if( n <= 0 )
+                    {
+                        return false;
+                    }
+                    
+                    sent += numeric_cast< size_t >( n );
+                }
+                
+                return true;
+            }
+            
+            std::optional< Frame > receive( int socket, const Deadline & deadline, const Cancellation & cancellation, size_t maximum )
+            {
+                uint8_t                header[ HeaderSize ];
+                size_t                 size;
+                size_t                 stored;
+                std::vector< uint8_t > data;
+                
+                if( read( socket, header, sizeof( header ), deadline, cancellation ) == false )
+                {
+                    return {};
+                }
+                
+                size   = get32( header + 1 );
+                stored = get32( header + 5 );
+                
+                if( size > std::min( maximum, MaxMessageSize ) || stored > std::min( maximum, MaxMessageSize ) )
+                {
+                    return {};
+                }
+                
+                data.resize( ( stored == 0 ) ? size : stored );
+                
+                if( read( socket, data.data(), data.size(), deadline, cancellation ) == false )
+                {
+                    return {};
+                }
+                
+                if( stored != 0 )
+                {
+                    try
+                    {
+                        data = LZ::decompress( data, size );
+                    }
+                    catch( const std::runtime_error & )
+                    {
+                        return {};
+                    }
+                }
+                
+                return Frame( static_cast< Message >( header[ 0 ] ), std::move( data ) );
+            }
+            
+            void writeString( std::vector< uint8_t > & out, const std::string & s )
+            {
+                Trace::Format::writeVarint( out, s.size() );
+                
+                out.insert( out.end(), s.begin(), s.end() );
+            }
+            
+            std::string readString( BinaryStream & stream )
+            {
+                uint64_t size( Trace::Format::readVarint( stream ) );
+                
+                if( size > stream.AvailableBytes() )
+                {
+                    throw std::runtime_error( "Invalid remote string" );
+                }
+                
+                {
+                    std::vector< uint8_t > data( stream.Read( numeric_cast< size_t >( size ) ) );
+                    
+                    return std::string( data.begin(), data.end() );
+                }
+            }
+            
+            void writeTimeout( std::vector< uint8_t > & out, const Deadline & deadline )
+            {
+                if( deadline.infinite() )
+                {
+                    Trace::Format::writeVarint( out, 0 );
+                }
+                else
+                {
+                    Trace::Format::writeVarint( out, std::max< uint64_t >( 1, numeric_cast< uint64_t >( std::chrono::duration_cast< std::chrono::milliseconds >( deadline.remaining() ).count() ) ) );
+                }
+            }
+            
+            Deadline readTimeout( BinaryStream & stream )
+            {
+                uint64_t milliseconds( Trace::Format::readVarint( stream ) );
+                
+                if( milliseconds == 0 )
+                {
+                    return Deadline::never();
+                }
+                
+                return Deadline::after( std::chrono::milliseconds( std::min< uint64_t >( milliseconds, INT32_MAX ) ) );
+            }
+            
+            std::vector< uint8_t > nonce( void )
+            {
+                std::vector< uint8_t > data( NonceSize );
+                int                    fd( open( "/dev/urandom", O_RDONLY | O_CLOEXEC ) );
+                size_t                 done( 0 );
+                
+                if( fd == -1 )
+                {
+                    throw std::runtime_error( "Cannot open /dev/urandom" );
+                }
+                
+                while( done < data.size() )
+                {
+                    ssize_t n( ::read( fd, data.data() + done, data.size() - done ) );
+                    
+                    if( n <= 0 && errno != EINTR )
+                    {
+                        close( fd );
+                        
+                        throw std::runtime_error( "Cannot read /dev/urandom" );
+                    }
+                    
+                    done += ( n > 0 ) ? static_cast< size_t >( n ) : 0;
+                }
+                
+                close( fd );
+                
+                return data;
+            }
+            
+            std::vector< uint8_t > readNonce( BinaryStream & stream )
+            {
+                if( stream.AvailableBytes() < NonceSize )
+                {
+                    throw std::runtime_error( "Invalid remote nonce" );
+                }
+                
+                return stream.Read( NonceSize );
+            }
+            
+            SHA256::Digest proof( const std::string & token, const std::string & role, const std::string & vmName, const std::vector< uint8_t > & clientNonce, const std::vector< uint8_t > & agentNonce )
+            {
+                std::vector< uint8_t > message;
+                
+                writeString( message, role );
+                writeString( message, vmName );
+                
+                message.insert( message.end(), clientNonce.begin(), clientNonce.end() );
+                message.insert( message.end(), agentNonce.begin(),  agentNonce.end() );
+                
+                return SHA256::hmac( token, message );
+            }
+            
+            SHA256::Digest readProof( BinaryStream & stream )
+            {
+                SHA256::Digest digest;
+                
+                if( stream.AvailableBytes() < digest.size() )
+                {
+                    throw std::runtime_error( "Invalid remote proof" );
+                }
+                
+                stream.Read( digest.data(), digest.size() );
+                
+                return digest;
+            }
+            
+            std::vector< uint64_t > words( const VM::Registers & registers )
+            {
+                std::vector< uint64_t > words;
+                
+                words.reserve( RegisterWords );
+                
+                for( size_t i = 0; i < VM::Registers::Count; i++ )
+                {
+                    words.push_back( registers.valueAt( i ) );
+                }
+                
+                for( auto segment: Segments )
+                {
+                    words.push_back( registers.selector( segment ) );
+                    words.push_back( registers.base( segment ) );
+                }
+                
+                for( size_t i = 0; i < VectorCount; i++ )
+                {
+                    std::array< uint64_t, 4 > ymm( registers.ymm( i ) );
+                    
+                    words.insert( words.end(), ymm.begin(), ymm.end() );
+                }
+                
+                return words;
+            }
+            
+            std::vector< uint64_t > words( const std::vector< VM::StackEntry > & stack )
+            {
+                std::vector< uint64_t > words;
+                
+                words.reserve( stack.size() * StackEntryWords );
+                
+                for( const auto & entry: stack )
+                {
+                    for( const auto & address: { entry.bp(), entry.retBP(), entry.retIP(), entry.ip() } )
+                    {
+                        words.push_back( address.segment() );
+                        words.push_back( address.address() );
+                    }
+                    
+                    words.push_back( entry.arg0() );
+                    words.push_back( entry.arg1() );
+                    words.push_back( entry.arg2() );
+                    words.push_back( entry.arg3() );
+                }
+                
+                return words;
+            }
+            
+            VM::Registers registers( const std::vector< uint64_t > & words )
+            {
+                VM::Registers    registers;
+                const uint64_t * p( words.data() );
+                
+                if( words.size() != RegisterWords )
+                {
+                    throw std::runtime_error( "Invalid remote registers" );
+                }
+                
+                for( size_t i = 0; i < VM::Registers::Count; i++ )
+                {
+                    registers.valueAt( i, *( p++ ) );
+                }
+                
+                for( auto segment: Segments )
+                {
+                    registers.selector( segment, *( p++ ) );
+                    registers.base(     segment, *( p++ ) );
+                }
+                
+                for( size_t i = 0; i < VectorCount; i++, p += 4 )
+                {
+                    registers.ymm( i, { p[ 0 ], p[ 1 ], p[ 2 ], p[ 3 ] } );
+                }
+                
+                return registers;
+            }
+            
+            std::vector< VM::StackEntry > stack( const std::vector< uint64_t > & words )
+            {
+                std::vector< VM::StackEntry > stack;
+                
+                if( words.size() % StackEntryWords != 0 )
+                {
+                    throw std::runtime_error( "Invalid remote stack" );
+                }
+                
+                for( size_t i = 0; i < words.size(); i += StackEntryWords )
+                {
+                    const uint64_t * p( words.data() + i );
+                    VM::StackEntry   entry;
+                    
+                    entry.bp(    VM::SegmentAddress( static_cast< uint32_t >( p[ 0 ] ), p[ 1 ] ) );
+                    entry.retBP( VM::SegmentAddress( static_cast< uint32_t >( p[ 2 ] ), p[ 3 ] ) );
+                    entry.retIP( VM::SegmentAddress( static_cast< uint32_t >( p[ 4 ] ), p[ 5 ] ) );
+                    entry.ip(    VM::SegmentAddress( static_cast< uint32_t >( p[ 6 ] ), p[ 7 ] ) );
+                    entry.arg0(  p[ 8 ] );
+                    entry.arg1(  p[ 9 ] );
+                    entry.arg2(  p[ 10 ] );
+                    entry.arg3(  p[ 11 ] );
+                    
+                    stack.push_back( entry );
+                }
+                
+                return stack;
+            }
+        }
+    }
+}
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_REMOTE_PROTOCOL_HPP
+#define VBOX_REMOTE_PROTOCOL_HPP
+
+#include "VBox/VM/Registers.hpp"
+#include "VBox/VM/StackEntry.hpp"
+#include "VBox/BinaryStream.hpp"
+#include "VBox/Deadline.hpp"
+#include "VBox/Cancellation.hpp"
+#include "VBox/SHA256.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+#include <list>
+#include <unordered_map>
+#include <optional>
+#include <utility>
+
+namespace VBox
+{
+    namespace Remote
+    {
+        namespace Protocol
+        {
+            enum class Message: uint8_t
+            {
+                Hello        = 1,
+                Error        = 2,
+                Live         = 3,
+                Registers    = 4,
+                AllRegisters = 5,
+                Stack        = 6,
+                AllStacks    = 7,
+                Dump         = 8,
+                DumpChunk    = 9,
+                DumpEnd      = 10,
+                Memory       = 11,
+                Pause        = 12,
+                Challenge    = 13,
+                Authenticate = 14
+            };
+            
+            using Frame = std::pair< Message, std::vector< uint8_t > >;
+            
+            class Deltas
+            {
+                public:
+                    
+                    void                    write( std::vector< uint8_t > & out, Message channel, size_t index, const std::vector< uint64_t > & words );
+                    std::vector< uint64_t > read( BinaryStream & stream, Message channel, size_t index );
+                    
+                private:
+                    
+                    std::map< std::pair< Message, size_t >, std::vector< uint64_t > > _previous;
+            };
+            
+            class PageOrder
+            {
+                public:
+                    
+                    std::optional< uint64_t > touch( uint64_t address );
+                    
+                private:
+                    
+                    std::list< uint64_t >                                            _order;
+                    std::unordered_map< uint64_t, std::list< uint64_t >::iterator > _positions;
+            };
+            
+            constexpr std::array< uint8_t, 4 > Magic                = { { 'V', 'B', 'R', 'M' } };
+            constexpr uint8_t                  Version              = 3;
+            constexpr uint16_t                 DefaultPort          = 5100;
+            constexpr const char             * DefaultAddress       = "127.0.0.1";
+            constexpr const char             * TokenVariable        = "VBOX_MONITOR_TOKEN";
+            constexpr size_t                   HeaderSize           = 9;
+            constexpr size_t                   CompressionThreshold = 256;
+            constexpr size_t                   DumpChunkSize        = 1024 * 1024;
+            constexpr size_t                   MaxMessageSize       = 16 * 1024 * 1024;
+            constexpr size_t                   MaxHelloSize         = 4096;
+            constexpr size_t                   MaxCachedPages       = 16384;
+            constexpr size_t                   NonceSize            = 32;
+            constexpr const char             * ClientRole           = "client";
+            constexpr const char             * AgentRole            = "agent";
+            
+            bool                   send( int socket, Message type, const std::vector< uint8_t > & payload );
+            std::optional< Frame > receive( int socket, const Deadline & deadline, const Cancellation & cancellation, size_t maximum = MaxMessageSize );
+            
+            void        writeString( std::vector< uint8_t > & out, const std::string & s );
+            std::string readString( BinaryStream & stream );
+            
+            void     writeTimeout( std::vector< uint8_t > & out, const Deadline & deadline );
+            Deadline readTimeout( BinaryStream & stream );
+            
+            std::vector< uint8_t > nonce( void );
+            std::vector< uint8_t > readNonce( BinaryStream & stream );
+            SHA256::Digest         proof( const std::string & token, const std::string & role, const std::string & vmName, const std::vector< uint8_t > & clientNonce, const std::vector< uint8_t > & agentNonce );
+            SHA256::Digest         readProof( BinaryStream & stream );
+            
+            std::vector< uint64_t >       words( const VM::Registers & registers );
+            std::vector< uint64_t >       words( const std::vector< VM::StackEntry > & stack );
+            VM::Registers                 registers( const std::vector< uint64_t > & words );
+            std::vector< VM::StackEntry > stack( const std::vector< uint64_t > & words );
+        }
+    }
+}
+
+#endif /* VBOX_REMOTE_PROTOCOL_HPP */
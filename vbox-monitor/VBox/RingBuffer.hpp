@@ -0,0 +1,169 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_RING_BUFFER_HPP
+#define VBOX_RING_BUFFER_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+namespace VBox
+{
+    template< typename _T_ >
+    class RingBuffer
+    {
+        public:
+            
+            RingBuffer( size_t capacity ):
+                _storage( capacity ),
+                _begin(   0 ),
+                _end(     0 )
+            {}
+            
+            RingBuffer( const RingBuffer & o ):
+                _storage( o._storage ),
+                _begin(   o._begin ),
+                _end(     o._end )
+            {}
+            
+            RingBuffer( RingBuffer && o ):
+                _storage( std::move( o._storage ) ),
+                _begin(   o._begin ),
+                _end(     o._end )
+            {}
+            
+            ~RingBuffer( void )
+            {}
+            
+            RingBuffer & operator =( RingBuffer o )
+            {
+                swap( *( this ), o );
+                
+                return *( this );
+            }
+            
+            size_t capacity( void ) const
+            {
+                return this->_storage.size();
+            }
+            
+            size_t size( void ) const
+            {
+                return static_cast< size_t >( this->_end - this->_begin );
+            }
+            
+            bool empty( void ) const
+            {
+                return this->_end == this->_begin;
+            }
+            
+            uint64_t begin( void ) const
+            {
+                return this->_begin;
+            }
+            
+            uint64_t end( void ) const
+            {
+                return this->_end;
+            }
+            
+            bool contains( uint64_t index ) const
+            {
+                return index >= this->_begin && index < this->_end;
+            }
+            
+            const _T_ & operator []( uint64_t index ) const
+            {
+                if( this->contains( index ) == false )
+                {
+                    throw std::out_of_range( "Ring buffer index out of range" );
+                }
+                
+                return this->_storage[ static_cast< size_t >( index % this->_storage.size() ) ];
+            }
+            
+            const _T_ & back( void ) const
+            {
+                return ( *( this ) )[ this->_end - 1 ];
+            }
+            
+            uint64_t push( const _T_ & value )
+            {
+                if( this->_storage.empty() )
+                {
+                    this->_begin = ++( this->_end );
+                    
+                    return this->_end - 1;
+                }
+                
+                this->_storage[ static_cast< size_t >( this->_end % this->_storage.size() ) ] = value;
+                
+                if( this->size() == this->_storage.size() )
+                {
+                    this->_begin++;
+                }
+                
+                return this->_end++;
+            }
+            
+            void capacity( size_t value )
+            {
+                std::vector< _T_ > storage( value );
+                uint64_t           begin( this->_end - std::min< uint64_t >( this->size(), value ) );
+                
+                for( uint64_t i = begin; i < this->_end; i++ )
+                {
+                    storage[ static_cast< size_t >( i % value ) ] = ( *( this ) )[ i ];
+                }
+                
+                this->_storage = std::move( storage );
+                this->_begin   = begin;
+            }
+            
+            void clear( void )
+            {
+                this->_begin = this->_end;
+            }
+            
+            friend void swap( RingBuffer & o1, RingBuffer & o2 )
+            {
+                using std::swap;
+                
+                swap( o1._storage, o2._storage );
+                swap( o1._begin,   o2._begin );
+                swap( o1._end,     o2._end );
+            }
+            
+        private:
+            
+            std::vector< _T_ > _storage;
+            uint64_t           _begin;
+            uint64_t           _end;
+    };
+}
+
+#endif /* VBOX_RING_BUFFER_HPP */
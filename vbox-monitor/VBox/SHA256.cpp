@@ -0,0 +1,192 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/SHA256.hpp"
+#include <cstring>
+
+namespace VBox
+{
+    namespace SHA256
+    {
+        static const size_t BlockSize = 64;
+        
+        static const std::array< uint32_t, 64 > K =
+        {
+            {
+                0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+                0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+                0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+                0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+                0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+                0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+                0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+                0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+            }
+        };
+        
+        static uint32_t rotate( uint32_t x, unsigned int n )
+        {
+            return ( x >> n ) | ( x << ( 32 - n ) );
+        }
+        
+        static void compress( std::array< uint32_t, 8 > & state, const uint8_t * block )
+        {
+            std::array< uint32_t, 64 > w;
+            std::array< uint32_t, 8 >  v( state );
+            
+            for( size_t i = 0; i < 16; i++ )
+            {
+                w[ i ] = ( static_cast< uint32_t >( block[ i * 4 ] ) << 24 ) | ( static_cast< uint32_t >( block[ i * 4 + 1 ] ) << 16 ) | ( static_cast< uint32_t >( block[ i * 4 + 2 ] ) << 8 ) | block[ i * 4 + 3 ];
+            }
+            
+            for( size_t i = 16; i < 64; i++ )
+            {
+                uint32_t s0( rotate( w[ i - 15 ], 7 ) ^ rotate( w[ i - 15 ], 18 ) ^ ( w[ i - 15 ] >> 3 ) );
+                uint32_t s1( rotate( w[ i - 2 ], 17 ) ^ rotate( w[ i - 2 ], 19 ) ^ ( w[ i - 2 ] >> 10 ) );
+                
+                w[ i ] = w[ i - 16 ] + s0 + w[ i - 7 ] + s1;
+            }
+            
+            for( size_t i = 0; i < 64; i++ )
+            {
+                uint32_t s1( rotate( v[ 4 ], 6 ) ^ rotate( v[ 4 ], 11 ) ^ rotate( v[ 4 ], 25 ) );
+                uint32_t ch( ( v[ 4 ] & v[ 5 ] ) ^ ( ~v[ 4 ] & v[ 6 ] ) );
+                uint32_t t1( v[ 7 ] + s1 + ch + K[ i ] + w[ i ] );
+                uint32_t s0( rotate( v[ 0 ], 2 ) ^ rotate( v[ 0 ], 13 ) ^ rotate( v[ 0 ], 22 ) );
+                uint32_t mj( ( v[ 0 ] & v[ 1 ] ) ^ ( v[ 0 ] & v[ 2 ] ) ^ ( v[ 1 ] & v[ 2 ] ) );
+                
+                v[ 7 ] = v[ 6 ];
+                v[ 6 ] = v[ 5 ];
+                v[ 5 ] = v[ 4 ];
+                v[ 4 ] = v[ 3 ] + t1;
+                v[ 3 ] = v[ 2 ];
+                v[ 2 ] = v[ 1 ];
+                v[ 1 ] = v[ 0 ];
+                v[ 0 ] = t1 + s0 + mj;
+            }
+            
+            for( size_t i = 0; i < 8; i++ )
+            {
+                state[ i ] += v[ i ];
+            }
+        }
+        
+        Digest hash( const uint8_t * data, size_t size )
+        {
+            std::array< uint32_t, 8 >        state { { 0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19 } };
+            std::array< uint8_t, BlockSize > block {};
+            uint64_t                         bits( static_cast< uint64_t >( size ) * 8 );
+            size_t                           i( 0 );
+            size_t                           rest;
+            Digest                           digest;
+            
+            for( ; i + BlockSize <= size; i += BlockSize )
+            {
+                compress( state, data + i );
+            }
+            
+            rest = size - i;
+            
+            if( rest > 0 )
+            {
+                memcpy( block.data(), data + i, rest );
+            }
+            
+            block[ rest ] = 0x80;
+            
+            if( rest + 1 > BlockSize - 8 )
+            {
+                compress( state, block.data() );
+                block.fill( 0 );
+            }
+            
+            for( size_t j = 0; j < 8; j++ )
+            {
+                block[ BlockSize - 1 - j ] = static_cast< uint8_t >( bits >> ( j * 8 ) );
+            }
+            
+            compress( state, block.data() );
+            
+            for( size_t j = 0; j < 8; j++ )
+            {
+                digest[ j * 4 ]     = static_cast< uint8_t >( state[ j ] >> 24 );
+                digest[ j * 4 + 1 ] = static_cast< uint8_t >( state[ j ] >> 16 );
+                digest[ j * 4 + 2 ] = static_cast< uint8_t >( state[ j ] >> 8 );
+                digest[ j * 4 + 3 ] = static_cast< uint8_t >( state[ j ] );
+            }
+            
+            return digest;
+        }
+        
+        Digest hash( const std::vector< uint8_t > & data )
+        {
+            return hash( data.data(), data.size() );
+        }
+        
+        Digest hmac( const std::string & key, const std::vector< uint8_t > & message )
+        {
+            std::array< uint8_t, BlockSize > pad {};
+            std::vector< uint8_t >           inner;
+            std::vector< uint8_t >           outer;
+            Digest                           digest;
+            
+            if( key.size() > BlockSize )
+            {
+                Digest k( hash( reinterpret_cast< const uint8_t * >( key.data() ), key.size() ) );
+                
+                memcpy( pad.data(), k.data(), k.size() );
+            }
+            else if( key.empty() == false )
+            {
+                memcpy( pad.data(), key.data(), key.size() );
+            }
+            
+            for( uint8_t b: pad )
+            {
+                inner.push_back( b ^ 0x36 );
+                outer.push_back( b ^ 0x5C );
+            }
+            
+            inner.insert( inner.end(), message.begin(), message.end() );
+            
+            digest = hash( inner );
+            
+            outer.insert( outer.end(), digest.begin(), digest.end() );
+            
+            return hash( outer );
+        }
+        
+        bool equal( const Digest & d1, const Digest & d2 )
+        {
+            uint8_t difference( 0 );
+            
+            for( size_t i = 0; i < d1.size(); i++ )
+            {
+                difference |= static_cast< uint8_t >( d1[ i ] ^ d2[ i ] );
+            }
+            
+            return difference == 0;
+        }
+    }
+}
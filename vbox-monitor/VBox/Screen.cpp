@@ -23,6 +23,8 @@
  ******************************************************************************/
 
 #include "VBox/Screen.hpp"
+#include "VBox/Stats.hpp"
+#include "VBox/Descriptors.hpp"
 #include <algorithm>
 #include <ncurses.h>
 #include <sys/ioctl.h>
@@ -33,6 +35,7 @@
 #include <poll.h>
 #include <condition_variable>
 #include <mutex>
+#include <csignal>
 
 namespace VBox
 {
@@ -43,6 +46,14 @@ namespace VBox
             IMPL( void );
             ~IMPL( void );
             
+            static void _handleResize( int signal );
+            
+            void _drain( int fd );
+            bool _updateSize( void );
+            
+            static int              _resizePipe;
+            static struct sigaction _previousResizeAction;
+            
             std::vector< std::function< void( void ) > > _onResize;
             std::vector< std::function< void( int ) > >  _onKeyPress;
             std::vector< std::function< void( void ) > > _onUpdate;
@@ -51,9 +62,14 @@ namespace VBox
             std::size_t          _height;
             bool                 _colors;
             bool                 _running;
+            double               _maximumFrameRate;
+            int                  _wakePipe[ 2 ];
             std::recursive_mutex _rmtx;
     };
     
+    int              Screen::IMPL::_resizePipe( -1 );
+    struct sigaction Screen::IMPL::_previousResizeAction;
+    
     Screen & Screen::shared( void )
     {
         static Screen       * screen( nullptr );
@@ -67,7 +83,8 @@ namespace VBox
     Screen::Screen( void ):
         impl( std::make_unique< IMPL >() )
     {
-        struct winsize s;
+        struct winsize   s;
+        struct sigaction action;
         
         ::initscr();
         
@@ -99,6 +116,19 @@ namespace VBox
         
         this->impl->_width  = s.ws_col;
         this->impl->_height = s.ws_row;
+        
+        if( Descriptors::pipe( this->impl->_wakePipe, true ) )
+        {
+            IMPL::_resizePipe = this->impl->_wakePipe[ 1 ];
+            
+            memset( &action, 0, sizeof( action ) );
+            sigemptyset( &( action.sa_mask ) );
+            
+            action.sa_handler = IMPL::_handleResize;
+            action.sa_flags   = SA_RESTART;
+            
+            ::sigaction( SIGWINCH, &action, &( IMPL::_previousResizeAction ) );
+        }
     }
     
     std::size_t Screen::width( void ) const
@@ -150,6 +180,13 @@ namespace VBox
         ::refresh();
     }
     
+    void Screen::update( void ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        ::doupdate();
+    }
+    
     void Screen::print( const std::string & s )
     {
         std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
@@ -174,8 +211,33 @@ namespace VBox
         }
     }
     
+    double Screen::maximumFrameRate( void ) const
+    {
+        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        
+        return this->impl->_maximumFrameRate;
+    }
+    
+    void Screen::maximumFrameRate( double fps )
+    {
+        {
+            std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+            
+            this->impl->_maximumFrameRate = std::max( fps, 0.0 );
+        }
+        
+        this->wakeUp();
+    }
+    
     void Screen::start( void )
     {
+        std::chrono::steady_clock::time_point        last;
+        bool                                         pending( true );
+        std::vector< std::function< void( void ) > > onResize;
+        std::vector< std::function< void( int ) > >  onKeyPress;
+        std::vector< std::function< void( void ) > > onUpdate;
+        std::vector< int >                           keys;
+        
         {
             std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
             
@@ -187,55 +249,87 @@ namespace VBox
             this->impl->_running = true;
         }
         
-        while( this->impl->_running )
+        while( this->isRunning() )
         {
-            struct winsize                               s;
-            std::vector< std::function< void( void ) > > onResize;
-            std::vector< std::function< void( int ) > >  onKeyPress;
-            std::vector< std::function< void( void ) > > onUpdate;
-            int                                          key( 0 );
+            struct pollfd                               fds[ 2 ];
+            int                                         milliseconds( -1 );
+            double                                      fps( this->maximumFrameRate() );
+            std::chrono::duration< double, std::milli > remaining( 0 );
             
-            ::ioctl( STDOUT_FILENO, TIOCGWINSZ, &s );
+            keys.clear();
+            onResize.clear();
             
+            if( pending && fps > 0 )
             {
-                std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
-                
-                onKeyPress = this->impl->_onKeyPress;
-                onUpdate   = this->impl->_onUpdate;
-                
-                if( s.ws_col != this->impl->_width || s.ws_row != this->impl->_height )
+                remaining = std::chrono::duration< double, std::milli >( 1000.0 / fps ) - ( std::chrono::steady_clock::now() - last );
+            }
+            
+            if( pending )
+            {
+                milliseconds = std::max( 0, static_cast< int >( remaining.count() ) );
+            }
+            
+            memset( fds, 0, sizeof( fds ) );
+            
+            fds[ 0 ].fd     = STDIN_FILENO;
+            fds[ 0 ].events = POLLIN;
+            fds[ 1 ].fd     = this->impl->_wakePipe[ 0 ];
+            fds[ 1 ].events = POLLIN;
+            
+            if( ::poll( fds, ( fds[ 1 ].fd < 0 ) ? 1 : 2, milliseconds ) > 0 )
+            {
+                if( fds[ 0 ].revents & POLLIN )
                 {
-                    this->impl->_width  = s.ws_col;
-                    this->impl->_height = s.ws_row;
+                    unsigned char buffer[ 64 ];
+                    ssize_t       n( ::read( STDIN_FILENO, buffer, sizeof( buffer ) ) );
                     
-                    onResize = this->impl->_onResize;
+                    for( ssize_t i = 0; i < n; i++ )
+                    {
+                        keys.push_back( buffer[ i ] );
+                    }
                 }
                 
+                if( fds[ 1 ].revents & POLLIN )
                 {
-                    static struct pollfd p;
-                    
-                    memset( &p, 0, sizeof( p ) );
-                    
-                    p.fd      = 0;
-                    p.events  = POLLIN;
-                    p.revents = 0;
+                    this->impl->_drain( fds[ 1 ].fd );
+                }
+                
+                if( pending == false || remaining.count() > 0 )
+                {
+                    pending = true;
                     
-                    if( poll( &p, 1, 0 ) > 0 )
+                    if( keys.empty() )
                     {
-                        key        = getc( stdin );
-                        onKeyPress = this->impl->_onKeyPress;
+                        continue;
                     }
                 }
             }
             
+            Stats::Timer timer( "Screen::frame" );
+            
+            {
+                std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+                
+                onKeyPress = this->impl->_onKeyPress;
+                onUpdate   = this->impl->_onUpdate;
+                
+                if( this->impl->_updateSize() )
+                {
+                    onResize = this->impl->_onResize;
+                }
+            }
+            
             for( const auto & f: onResize )
             {
                 f();
             }
             
-            for( const auto & f: onKeyPress )
+            for( int key: keys )
             {
-                f( key );
+                for( const auto & f: onKeyPress )
+                {
+                    f( key );
+                }
             }
             
             for( const auto & f: onUpdate )
@@ -243,7 +337,10 @@ namespace VBox
                 f();
             }
             
-            this->refresh();
+            this->update();
+            
+            last    = std::chrono::steady_clock::now();
+            pending = false;
         }
         
         this->clear();
@@ -252,9 +349,23 @@ namespace VBox
     
     void Screen::stop( void )
     {
-        std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+        {
+            std::lock_guard< std::recursive_mutex > l( this->impl->_rmtx );
+            
+            this->impl->_running = false;
+        }
         
-        this->impl->_running = false;
+        this->wakeUp();
+    }
+    
+    void Screen::wakeUp( void )
+    {
+        char c( 0 );
+        
+        if( this->impl->_wakePipe[ 1 ] >= 0 )
+        {
+            ( void )::write( this->impl->_wakePipe[ 1 ], &c, 1 );
+        }
     }
     
     void Screen::onResize( const std::function< void( void ) > & f )
@@ -279,16 +390,73 @@ namespace VBox
     }
     
     Screen::IMPL::IMPL( void ):
-        _width( 0 ),
-        _height( 0 ),
-        _colors( false ),
-        _running( false )
+        _width(            0 ),
+        _height(           0 ),
+        _colors(           false ),
+        _running(          false ),
+        _maximumFrameRate( 30 ),
+        _wakePipe{         -1, -1 }
     {}
     
     Screen::IMPL::~IMPL( void )
     {
+        if( this->_wakePipe[ 0 ] >= 0 )
+        {
+            ::sigaction( SIGWINCH, &( IMPL::_previousResizeAction ), nullptr );
+            
+            IMPL::_resizePipe = -1;
+            
+            ::close( this->_wakePipe[ 0 ] );
+            ::close( this->_wakePipe[ 1 ] );
+        }
+        
         ::clrtoeol();
         ::refresh();
         ::endwin();
     }
+    
+    void Screen::IMPL::_handleResize( int signal )
+    {
+        char c( 0 );
+        
+        if( IMPL::_resizePipe >= 0 )
+        {
+            ( void )::write( IMPL::_resizePipe, &c, 1 );
+        }
+        
+        if( IMPL::_previousResizeAction.sa_handler != SIG_DFL && IMPL::_previousResizeAction.sa_handler != SIG_IGN )
+        {
+            IMPL::_previousResizeAction.sa_handler( signal );
+        }
+    }
+    
+    void Screen::IMPL::_drain( int fd )
+    {
+        char buffer[ 64 ];
+        
+        while( ::read( fd, buffer, sizeof( buffer ) ) > 0 )
+        {}
+    }
+    
+    bool Screen::IMPL::_updateSize( void )
+    {
+        struct winsize s;
+        
+        if( ::ioctl( STDOUT_FILENO, TIOCGWINSZ, &s ) != 0 )
+        {
+            return false;
+        }
+        
+        if( s.ws_col == this->_width && s.ws_row == this->_height )
+        {
+            return false;
+        }
+        
+        this->_width  = s.ws_col;
+        this->_height = s.ws_row;
+        
+        ::resizeterm( s.ws_row, s.ws_col );
+        
+        return true;
+    }
 }
@@ -50,12 +50,17 @@ namespace VBox
             bool isRunning( void )      const;
             void clear( void )          const;
             void refresh( void )        const;
+            void update( void )         const;
             
             void print( const std::string & s );
             void print( const Color & color, const std::string & s );
             
+            double maximumFrameRate( void ) const;
+            void   maximumFrameRate( double fps );
+            
             void start( void );
             void stop( void );
+            void wakeUp( void );
             
             void onResize( const std::function<   void( void ) > & f );
             void onKeyPress( const std::function< void( int key ) > & f );
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/SignalHandler.hpp"
+#include <cstring>
+
+namespace VBox
+{
+    volatile std::sig_atomic_t SignalHandler::_interrupted( 0 );
+    std::atomic< size_t >      SignalHandler::_scopes( 0 );
+    
+    SignalHandler::SignalHandler( void )
+    {
+        struct sigaction action;
+        struct sigaction ignore;
+        
+        memset( &action, 0, sizeof( action ) );
+        memset( &ignore, 0, sizeof( ignore ) );
+        sigemptyset( &( action.sa_mask ) );
+        sigemptyset( &( ignore.sa_mask ) );
+        
+        action.sa_handler = _handleSignal;
+        ignore.sa_handler = SIG_IGN;
+        
+        if( SignalHandler::_scopes++ == 0 )
+        {
+            SignalHandler::_interrupted = 0;
+        }
+        
+        ::sigaction( SIGINT,  &action, &( this->_previousInterruptAction ) );
+        ::sigaction( SIGTERM, &action, &( this->_previousTerminateAction ) );
+        ::sigaction( SIGPIPE, &ignore, &( this->_previousPipeAction ) );
+    }
+    
+    SignalHandler::~SignalHandler( void )
+    {
+        ::sigaction( SIGINT,  &( this->_previousInterruptAction ), nullptr );
+        ::sigaction( SIGTERM, &( this->_previousTerminateAction ), nullptr );
+        ::sigaction( SIGPIPE, &( this->_previousPipeAction ),      nullptr );
+        
+        SignalHandler::_scopes--;
+    }
+    
+    bool SignalHandler::interrupted( void ) const
+    {
+        return SignalHandler::_interrupted != 0;
+    }
+    
+    void SignalHandler::_handleSignal( int signal )
+    {
+        ( void )signal;
+        
+        SignalHandler::_interrupted = 1;
+    }
+}
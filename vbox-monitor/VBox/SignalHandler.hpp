@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_SIGNAL_HANDLER_HPP
+#define VBOX_SIGNAL_HANDLER_HPP
+
+#include <csignal>
+#include <atomic>
+#include <cstddef>
+
+namespace VBox
+{
+    class SignalHandler
+    {
+        public:
+            
+            SignalHandler( void );
+            SignalHandler( const SignalHandler & o )      = delete;
+            SignalHandler( SignalHandler && o ) noexcept  = delete;
+            SignalHandler & operator =( SignalHandler o ) = delete;
+            ~SignalHandler( void );
+            
+            bool interrupted( void ) const;
+            
+        private:
+            
+            static void _handleSignal( int signal );
+            
+            static volatile std::sig_atomic_t _interrupted;
+            static std::atomic< size_t >      _scopes;
+            
+            struct sigaction _previousInterruptAction;
+            struct sigaction _previousTerminateAction;
+            struct sigaction _previousPipeAction;
+    };
+}
+
+#endif /* VBOX_SIGNAL_HANDLER_HPP */
@@ -0,0 +1,232 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Stats.hpp"
+#include "VBox/String.hpp"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace VBox
+{
+    class Stats::IMPL
+    {
+        public:
+            
+            class Counters
+            {
+                public:
+                    
+                    Counters( void );
+                    
+                    std::array< std::atomic< uint64_t >, Histogram::Buckets > _counts;
+                    std::atomic< uint64_t >                                   _sum;
+                    std::atomic< uint64_t >                                   _min;
+                    std::atomic< uint64_t >                                   _max;
+            };
+            
+            class Table
+            {
+                public:
+                    
+                    std::mutex                                           _mtx;
+                    std::map< std::string, std::unique_ptr< Counters > > _counters;
+                    std::unordered_map< const char *, Counters * >       _cache;
+            };
+            
+            IMPL( void );
+            
+            Counters & _counters( const char * name );
+            
+            uint64_t                                _id;
+            mutable std::mutex                      _mtx;
+            std::vector< std::shared_ptr< Table > > _tables;
+    };
+    
+    static std::atomic< uint64_t > NextStatsID( 0 );
+    
+    Stats::Timer::Timer( const char * name ):
+        _name(  name ),
+        _start( std::chrono::steady_clock::now() )
+    {}
+    
+    Stats::Timer::~Timer( void )
+    {
+        Stats::shared().record( this->_name, std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - this->_start ) );
+    }
+    
+    Stats & Stats::shared( void )
+    {
+        static Stats        * stats( nullptr );
+        static std::once_flag once;
+        
+        std::call_once( once, [ & ]{ stats = new Stats(); } );
+        
+        return *( stats );
+    }
+    
+    Stats::Stats( void ):
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    Stats::~Stats( void )
+    {}
+    
+    void Stats::record( const char * name, std::chrono::nanoseconds duration )
+    {
+        IMPL::Counters & counters( this->impl->_counters( name ) );
+        uint64_t         value( static_cast< uint64_t >( std::max< std::chrono::nanoseconds::rep >( duration.count(), 0 ) ) );
+        
+        counters._counts[ Histogram::bucket( value ) ].fetch_add( 1, std::memory_order_relaxed );
+        counters._sum.fetch_add( value, std::memory_order_relaxed );
+        
+        if( value < counters._min.load( std::memory_order_relaxed ) )
+        {
+            counters._min.store( value, std::memory_order_relaxed );
+        }
+        
+        if( value > counters._max.load( std::memory_order_relaxed ) )
+        {
+            counters._max.store( value, std::memory_order_relaxed );
+        }
+    }
+    
+    std::map< std::string, Histogram > Stats::histograms( void ) const
+    {
+        std::map< std::string, Histogram > histograms;
+        std::lock_guard< std::mutex >      l1( this->impl->_mtx );
+        
+        for( const auto & table: this->impl->_tables )
+        {
+            std::lock_guard< std::mutex > l2( table->_mtx );
+            
+            for( const auto & p: table->_counters )
+            {
+                std::vector< uint64_t > counts( Histogram::Buckets, 0 );
+                
+                for( size_t i = 0; i < Histogram::Buckets; i++ )
+                {
+                    counts[ i ] = p.second->_counts[ i ].load( std::memory_order_relaxed );
+                }
+                
+                histograms[ p.first ].merge
+                (
+                    Histogram
+                    (
+                        counts,
+                        p.second->_sum.load( std::memory_order_relaxed ),
+                        p.second->_min.load( std::memory_order_relaxed ),
+                        p.second->_max.load( std::memory_order_relaxed )
+                    )
+                );
+            }
+        }
+        
+        return histograms;
+    }
+    
+    std::string Stats::json( void ) const
+    {
+        std::string json( "{\n    \"unit\": \"ns\",\n    \"timers\":\n    {" );
+        bool        first( true );
+        
+        for( const auto & p: this->histograms() )
+        {
+            json += ( first ) ? "\n" : ",\n";
+            json += "        \"" + String::jsonEscape( p.first ) + "\": { ";
+            json += "\"count\": " + std::to_string( p.second.count() );
+            json += ", \"min\": "  + std::to_string( p.second.min() );
+            json += ", \"mean\": " + std::to_string( static_cast< uint64_t >( std::llround( p.second.mean() ) ) );
+            json += ", \"p50\": "  + std::to_string( p.second.percentile( 50 ) );
+            json += ", \"p90\": "  + std::to_string( p.second.percentile( 90 ) );
+            json += ", \"p99\": "  + std::to_string( p.second.percentile( 99 ) );
+            json += ", \"p999\": " + std::to_string( p.second.percentile( 99.9 ) );
+            json += ", \"max\": "  + std::to_string( p.second.max() );
+            json += " }";
+            
+            first = false;
+        }
+        
+        json += "\n    }\n}\n";
+        
+        return json;
+    }
+    
+    Stats::IMPL::Counters::Counters( void ):
+        _sum( 0 ),
+        _min( std::numeric_limits< uint64_t >::max() ),
+        _max( 0 )
+    {
+        for( auto & count: this->_counts )
+        {
+            count.store( 0, std::memory_order_relaxed );
+        }
+    }
+    
+    Stats::IMPL::IMPL( void ):
+        _id( NextStatsID++ )
+    {}
+    
+    Stats::IMPL::Counters & Stats::IMPL::_counters( const char * name )
+    {
+        thread_local std::unordered_map< uint64_t, std::shared_ptr< Table > > tables;
+        std::shared_ptr< Table >                                            & table( tables[ this->_id ] );
+        
+        if( table == nullptr )
+        {
+            table = std::make_shared< Table >();
+            
+            std::lock_guard< std::mutex > l( this->_mtx );
+            
+            this->_tables.push_back( table );
+        }
+        
+        {
+            auto it( table->_cache.find( name ) );
+            
+            if( it != table->_cache.end() )
+            {
+                return *( it->second );
+            }
+        }
+        
+        {
+            std::lock_guard< std::mutex >   l( table->_mtx );
+            std::unique_ptr< Counters >   & counters( table->_counters[ name ] );
+            
+            if( counters == nullptr )
+            {
+                counters = std::make_unique< Counters >();
+            }
+            
+            table->_cache[ name ] = counters.get();
+            
+            return *( counters );
+        }
+    }
+}
@@ -24,6 +24,10 @@
 
 #include "VBox/String.hpp"
 
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
 namespace VBox
 {
     namespace String
@@ -59,5 +63,104 @@ namespace VBox
             
             return lower;
         }
+        
+        std::string jsonEscape( std::string_view s )
+        {
+            std::string escaped;
+            
+            escaped.reserve( s.size() );
+            
+            for( char c: s )
+            {
+                switch( c )
+                {
+                    case '"':  escaped += "\\\""; break;
+                    case '\\': escaped += "\\\\"; break;
+                    case '\b': escaped += "\\b";  break;
+                    case '\f': escaped += "\\f";  break;
+                    case '\n': escaped += "\\n";  break;
+                    case '\r': escaped += "\\r";  break;
+                    case '\t': escaped += "\\t";  break;
+                    
+                    default:
+                        
+                        if( static_cast< unsigned char >( c ) < 0x20 )
+                        {
+                            escaped += "\\u00";
+                            escaped += hexDigits[ static_cast< unsigned char >( c ) * 2 ];
+                            escaped += hexDigits[ static_cast< unsigned char >( c ) * 2 + 1 ];
+                        }
+                        else
+                        {
+                            escaped += c;
+                        }
+                        
+                        break;
+                }
+            }
+            
+            return escaped;
+        }
+        
+        size_t hexdumpLine( const uint8_t * bytes, size_t size, size_t bytesPerLine, char * out )
+        {
+            char * hex(   out );
+            char * ascii( out + bytesPerLine * 3 + 2 );
+            size_t i( 0 );
+            
+            size = std::min( size, bytesPerLine );
+            
+            #if defined( __SSE2__ )
+            
+            for( ; i + 16 <= size; i += 16 )
+            {
+                __m128i v(     _mm_loadu_si128( reinterpret_cast< const __m128i * >( bytes + i ) ) );
+                __m128i mask(  _mm_set1_epi8( 0x0F ) );
+                __m128i hi(    _mm_and_si128( _mm_srli_epi16( v, 4 ), mask ) );
+                __m128i lo(    _mm_and_si128( v, mask ) );
+                __m128i nine(  _mm_set1_epi8( 9 ) );
+                __m128i zero(  _mm_set1_epi8( '0' ) );
+                __m128i alpha( _mm_set1_epi8( 'A' - '0' - 10 ) );
+                __m128i print( _mm_and_si128( _mm_cmpgt_epi8( v, _mm_set1_epi8( 0x20 ) ), _mm_cmplt_epi8( v, _mm_set1_epi8( 0x7F ) ) ) );
+                char    digits[ 32 ];
+                
+                hi = _mm_add_epi8( _mm_add_epi8( hi, zero ), _mm_and_si128( _mm_cmpgt_epi8( hi, nine ), alpha ) );
+                lo = _mm_add_epi8( _mm_add_epi8( lo, zero ), _mm_and_si128( _mm_cmpgt_epi8( lo, nine ), alpha ) );
+                
+                _mm_storeu_si128( reinterpret_cast< __m128i * >( digits ),      _mm_unpacklo_epi8( hi, lo ) );
+                _mm_storeu_si128( reinterpret_cast< __m128i * >( digits + 16 ), _mm_unpackhi_epi8( hi, lo ) );
+                _mm_storeu_si128( reinterpret_cast< __m128i * >( ascii + i ),   _mm_or_si128( _mm_and_si128( print, v ), _mm_andnot_si128( print, _mm_set1_epi8( '.' ) ) ) );
+                
+                for( size_t j = 0; j < 16; j++ )
+                {
+                    *( hex++ ) = digits[ j * 2 ];
+                    *( hex++ ) = digits[ j * 2 + 1 ];
+                    *( hex++ ) = ' ';
+                }
+            }
+            
+            #endif
+            
+            for( ; i < size; i++ )
+            {
+                *( hex++ ) = hexDigits[ bytes[ i ] * 2 ];
+                *( hex++ ) = hexDigits[ bytes[ i ] * 2 + 1 ];
+                *( hex++ ) = ' ';
+                
+                ascii[ i ] = ( bytes[ i ] > 0x20 && bytes[ i ] < 0x7F ) ? static_cast< char >( bytes[ i ] ) : '.';
+            }
+            
+            for( ; i < bytesPerLine; i++ )
+            {
+                *( hex++ ) = ' ';
+                *( hex++ ) = ' ';
+                *( hex++ ) = ' ';
+            }
+            
+            *( hex++ ) = ' ';
+            *( hex++ ) = ' ';
+            
+            return bytesPerLine * 3 + 2 + size;
+        }
     }
 }
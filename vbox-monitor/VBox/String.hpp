@@ -30,6 +30,10 @@
 #include <sstream>
 #include <iomanip>
 #include <type_traits>
+#include <string_view>
+#include <limits>
+#include <array>
+#include <cstdint>
 
 namespace VBox
 {
@@ -39,33 +43,102 @@ namespace VBox
         
         std::string toUpper( const std::string & s );
         std::string toLower( const std::string & s );
+        std::string jsonEscape( std::string_view s );
         
         template< typename _T_ >
-        _T_ fromHex( const std::string & s, typename std::enable_if< std::is_integral< _T_ >::value >::type * = 0 )
+        const char * fromHex( const char * first, const char * last, _T_ & value, typename std::enable_if< std::is_integral< _T_ >::value >::type * = 0 )
         {
-            _T_               v( 0 );
-            std::stringstream ss;
+            typename std::make_unsigned< _T_ >::type v( 0 );
+            const char                             * p( first );
             
-            ss << std::hex << s;
-            ss >> v;
+            for( ; p != last; p++ )
+            {
+                unsigned int d;
+                
+                if(      *( p ) >= '0' && *( p ) <= '9' ) { d = static_cast< unsigned int >( *( p ) - '0' ); }
+                else if( *( p ) >= 'a' && *( p ) <= 'f' ) { d = static_cast< unsigned int >( *( p ) - 'a' + 10 ); }
+                else if( *( p ) >= 'A' && *( p ) <= 'F' ) { d = static_cast< unsigned int >( *( p ) - 'A' + 10 ); }
+                else                                      { break; }
+                
+                if( v > ( std::numeric_limits< decltype( v ) >::max() >> 4 ) )
+                {
+                    return first;
+                }
+                
+                v = static_cast< decltype( v ) >( ( v << 4 ) | d );
+            }
+            
+            if( p != first )
+            {
+                value = static_cast< _T_ >( v );
+            }
+            
+            return p;
+        }
+        
+        template< typename _T_ >
+        _T_ fromHex( std::string_view s, typename std::enable_if< std::is_integral< _T_ >::value >::type * = 0 )
+        {
+            _T_ v( 0 );
+            
+            while( s.empty() == false && ( s.front() == ' ' || s.front() == '\t' ) )
+            {
+                s.remove_prefix( 1 );
+            }
+            
+            if( s.length() > 2 && s[ 0 ] == '0' && ( s[ 1 ] == 'x' || s[ 1 ] == 'X' ) )
+            {
+                s.remove_prefix( 2 );
+            }
+            
+            fromHex( s.data(), s.data() + s.length(), v );
             
             return v;
         }
         
+        constexpr std::array< char, 512 > hexTable( void )
+        {
+            std::array< char, 512 > table {};
+            
+            for( size_t i = 0; i < 256; i++ )
+            {
+                table[ i * 2     ] = "0123456789ABCDEF"[ i >> 4 ];
+                table[ i * 2 + 1 ] = "0123456789ABCDEF"[ i & 15 ];
+            }
+            
+            return table;
+        }
+        
+        constexpr std::array< char, 512 > hexDigits = hexTable();
+        
+        template< typename _T_ >
+        char * toHex( _T_ v, char * out, typename std::enable_if< std::is_integral< _T_ >::value >::type * = 0 )
+        {
+            typename std::make_unsigned< _T_ >::type u( static_cast< typename std::make_unsigned< _T_ >::type >( v ) );
+            
+            for( size_t i = sizeof( _T_ ); i > 0; i-- )
+            {
+                size_t b( static_cast< size_t >( ( u >> ( ( i - 1 ) * 8 ) ) & 0xFF ) );
+                
+                *( out++ ) = hexDigits[ b * 2 ];
+                *( out++ ) = hexDigits[ b * 2 + 1 ];
+            }
+            
+            return out;
+        }
+        
         template< typename _T_ >
         std::string toHex( _T_ v, typename std::enable_if< std::is_integral< _T_ >::value >::type * = 0 )
         {
-            std::stringstream ss;
+            char buffer[ 2 + sizeof( _T_ ) * 2 ];
             
-            ss << "0x"
-               << std::hex
-               << std::uppercase
-               << std::setfill( '0' )
-               << std::setw( sizeof( _T_ ) * 2 )
-               << static_cast< uint64_t >( v );
+            buffer[ 0 ] = '0';
+            buffer[ 1 ] = 'x';
             
-            return ss.str();
+            return std::string( buffer, toHex( v, buffer + 2 ) );
         }
+        
+        size_t hexdumpLine( const uint8_t * bytes, size_t size, size_t bytesPerLine, char * out );
     }
 }
 
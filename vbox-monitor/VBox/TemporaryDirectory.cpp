@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/TemporaryDirectory.hpp"
+#include <vector>
+#include <stdexcept>
+#include <cstdlib>
+#include <unistd.h>
+#include <dirent.h>
+
+namespace VBox
+{
+    TemporaryDirectory::TemporaryDirectory( void )
+    {
+        const char        * directory( getenv( "TMPDIR" ) );
+        std::string         path( std::string( ( directory == nullptr || *( directory ) == 0 ) ? "/tmp" : directory ) + "/vbox-monitor.XXXXXX" );
+        std::vector< char > name( path.begin(), path.end() );
+        
+        name.push_back( 0 );
+        
+        if( mkdtemp( name.data() ) == nullptr )
+        {
+            throw std::runtime_error( "Cannot create a temporary directory in " + path.substr( 0, path.rfind( '/' ) ) );
+        }
+        
+        this->_path = name.data();
+    }
+    
+    TemporaryDirectory::~TemporaryDirectory( void )
+    {
+        DIR * dir( opendir( this->_path.c_str() ) );
+        
+        if( dir != nullptr )
+        {
+            for( struct dirent * entry = readdir( dir ); entry != nullptr; entry = readdir( dir ) )
+            {
+                std::string name( entry->d_name );
+                
+                if( name != "." && name != ".." )
+                {
+                    unlink( this->path( name ).c_str() );
+                }
+            }
+            
+            closedir( dir );
+        }
+        
+        rmdir( this->_path.c_str() );
+    }
+    
+    const std::string & TemporaryDirectory::path( void ) const
+    {
+        return this->_path;
+    }
+    
+    std::string TemporaryDirectory::path( const std::string & name ) const
+    {
+        return this->_path + "/" + name;
+    }
+}
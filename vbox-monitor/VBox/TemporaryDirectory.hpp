@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_TEMPORARY_DIRECTORY_HPP
+#define VBOX_TEMPORARY_DIRECTORY_HPP
+
+#include <string>
+
+namespace VBox
+{
+    class TemporaryDirectory
+    {
+        public:
+            
+            TemporaryDirectory( void );
+            TemporaryDirectory( const TemporaryDirectory & o )      = delete;
+            TemporaryDirectory( TemporaryDirectory && o ) noexcept  = delete;
+            TemporaryDirectory & operator =( TemporaryDirectory o ) = delete;
+            ~TemporaryDirectory( void );
+            
+            const std::string & path( void )                     const;
+            std::string         path( const std::string & name ) const;
+            
+        private:
+            
+            std::string _path;
+    };
+}
+
+#endif /* VBOX_TEMPORARY_DIRECTORY_HPP */
@@ -0,0 +1,306 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/ThreadPool.hpp"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <array>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace VBox
+{
+    class ThreadPool::IMPL
+    {
+        public:
+            
+            class Task
+            {
+                public:
+                    
+                    uint64_t                      _group;
+                    Priority                      _priority;
+                    std::function< void( void ) > _function;
+            };
+            
+            IMPL( std::size_t threads );
+            ~IMPL( void );
+            
+            void _work( void );
+            void _promote( std::chrono::steady_clock::time_point now );
+            bool _take( Task & task );
+            void _enqueue( Task task );
+            
+            std::vector< std::thread >                                    _threads;
+            std::array< std::map< uint64_t, std::deque< Task > >, 3 >     _ready;
+            std::array< uint64_t, 3 >                                     _cursors;
+            std::multimap< std::chrono::steady_clock::time_point, Task >  _delayed;
+            std::size_t                                                   _runningLow;
+            std::size_t                                                   _lowLimit;
+            uint64_t                                                      _groups;
+            mutable std::mutex                                            _mtx;
+            std::condition_variable                                       _cv;
+            bool                                                          _stop;
+    };
+    
+    ThreadPool & ThreadPool::shared( void )
+    {
+        static ThreadPool   * pool( nullptr );
+        static std::once_flag once;
+        
+        std::call_once( once, [ & ]{ pool = new ThreadPool(); } );
+        
+        return *( pool );
+    }
+    
+    ThreadPool::ThreadPool( std::size_t threads ):
+        impl( std::make_unique< IMPL >( threads ) )
+    {}
+    
+    ThreadPool::~ThreadPool( void )
+    {}
+    
+    std::size_t ThreadPool::threads( void ) const
+    {
+        return this->impl->_threads.size();
+    }
+    
+    std::size_t ThreadPool::pending( void ) const
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        std::size_t                   n( this->impl->_delayed.size() );
+        
+        for( const auto & queue: this->impl->_ready )
+        {
+            for( const auto & p: queue )
+            {
+                n += p.second.size();
+            }
+        }
+        
+        return n;
+    }
+    
+    uint64_t ThreadPool::group( void )
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        
+        return ++( this->impl->_groups );
+    }
+    
+    void ThreadPool::submit( uint64_t group, Priority priority, const std::function< void( void ) > & task )
+    {
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_enqueue( { group, priority, task } );
+        }
+        
+        this->impl->_cv.notify_one();
+    }
+    
+    void ThreadPool::submit( uint64_t group, Priority priority, std::chrono::steady_clock::time_point when, const std::function< void( void ) > & task )
+    {
+        if( when <= std::chrono::steady_clock::now() )
+        {
+            this->submit( group, priority, task );
+            
+            return;
+        }
+        
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_delayed.emplace( when, IMPL::Task { group, priority, task } );
+        }
+        
+        this->impl->_cv.notify_one();
+    }
+    
+    std::size_t ThreadPool::cancel( uint64_t group )
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mtx );
+        std::size_t                   n( 0 );
+        
+        for( auto & queue: this->impl->_ready )
+        {
+            auto it( queue.find( group ) );
+            
+            if( it != queue.end() )
+            {
+                n += it->second.size();
+                
+                queue.erase( it );
+            }
+        }
+        
+        for( auto it = this->impl->_delayed.begin(); it != this->impl->_delayed.end(); )
+        {
+            if( it->second._group == group )
+            {
+                it = this->impl->_delayed.erase( it );
+                
+                n++;
+            }
+            else
+            {
+                it++;
+            }
+        }
+        
+        return n;
+    }
+    
+    ThreadPool::IMPL::IMPL( std::size_t threads ):
+        _cursors(    {} ),
+        _runningLow( 0 ),
+        _lowLimit(   0 ),
+        _groups(     0 ),
+        _stop(       false )
+    {
+        if( threads == 0 )
+        {
+            threads = std::max< std::size_t >( std::thread::hardware_concurrency(), 2 );
+        }
+        
+        this->_lowLimit = std::max< std::size_t >( threads - 1, 1 );
+        
+        for( std::size_t i = 0; i < threads; i++ )
+        {
+            this->_threads.emplace_back( [ this ] { this->_work(); } );
+        }
+    }
+    
+    ThreadPool::IMPL::~IMPL( void )
+    {
+        {
+            std::lock_guard< std::mutex > l( this->_mtx );
+            
+            this->_stop = true;
+        }
+        
+        this->_cv.notify_all();
+        
+        for( auto & t: this->_threads )
+        {
+            t.join();
+        }
+    }
+    
+    void ThreadPool::IMPL::_work( void )
+    {
+        std::unique_lock< std::mutex > l( this->_mtx );
+        
+        while( this->_stop == false )
+        {
+            Task task;
+            
+            this->_promote( std::chrono::steady_clock::now() );
+            
+            if( this->_take( task ) )
+            {
+                bool low( task._priority == Priority::Low );
+                
+                if( low )
+                {
+                    this->_runningLow++;
+                }
+                
+                l.unlock();
+                task._function();
+                l.lock();
+                
+                if( low )
+                {
+                    this->_runningLow--;
+                    
+                    this->_cv.notify_all();
+                }
+            }
+            else if( this->_delayed.empty() )
+            {
+                this->_cv.wait( l );
+            }
+            else
+            {
+                std::chrono::steady_clock::time_point when( this->_delayed.begin()->first );
+                
+                this->_cv.wait_until( l, when );
+            }
+        }
+    }
+    
+    void ThreadPool::IMPL::_promote( std::chrono::steady_clock::time_point now )
+    {
+        while( this->_delayed.empty() == false && this->_delayed.begin()->first <= now )
+        {
+            this->_enqueue( std::move( this->_delayed.begin()->second ) );
+            this->_delayed.erase( this->_delayed.begin() );
+        }
+    }
+    
+    bool ThreadPool::IMPL::_take( Task & task )
+    {
+        for( std::size_t i = 0; i < this->_ready.size(); i++ )
+        {
+            auto & queue( this->_ready[ i ] );
+            
+            if( queue.empty() || ( static_cast< Priority >( i ) == Priority::Low && this->_runningLow >= this->_lowLimit ) )
+            {
+                continue;
+            }
+            
+            {
+                auto it( queue.upper_bound( this->_cursors[ i ] ) );
+                
+                if( it == queue.end() )
+                {
+                    it = queue.begin();
+                }
+                
+                task                = std::move( it->second.front() );
+                this->_cursors[ i ] = it->first;
+                
+                it->second.pop_front();
+                
+                if( it->second.empty() )
+                {
+                    queue.erase( it );
+                }
+            }
+            
+            return true;
+        }
+        
+        return false;
+    }
+    
+    void ThreadPool::IMPL::_enqueue( Task task )
+    {
+        this->_ready[ static_cast< std::size_t >( task._priority ) ][ task._group ].push_back( std::move( task ) );
+    }
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_THREAD_POOL_HPP
+#define VBOX_THREAD_POOL_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace VBox
+{
+    class ThreadPool
+    {
+        public:
+            
+            enum class Priority
+            {
+                High,
+                Normal,
+                Low
+            };
+            
+            static ThreadPool & shared( void );
+            
+            ThreadPool( std::size_t threads = 0 );
+            ThreadPool( const ThreadPool & o )      = delete;
+            ThreadPool( ThreadPool && o ) noexcept  = delete;
+            ThreadPool & operator =( ThreadPool o ) = delete;
+            ~ThreadPool( void );
+            
+            std::size_t threads( void ) const;
+            std::size_t pending( void ) const;
+            uint64_t    group( void );
+            
+            void        submit( uint64_t group, Priority priority, const std::function< void( void ) > & task );
+            void        submit( uint64_t group, Priority priority, std::chrono::steady_clock::time_point when, const std::function< void( void ) > & task );
+            std::size_t cancel( uint64_t group );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* VBOX_THREAD_POOL_HPP */
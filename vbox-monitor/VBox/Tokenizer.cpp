@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Tokenizer.hpp"
+
+namespace VBox
+{
+    Tokenizer::Tokenizer( void )
+    {}
+    
+    Tokenizer::Tokenizer( std::string_view input ):
+        _input( input )
+    {}
+    
+    Tokenizer::Tokenizer( const Tokenizer & o ):
+        _input( o._input )
+    {}
+    
+    Tokenizer::~Tokenizer( void )
+    {}
+    
+    Tokenizer & Tokenizer::operator =( Tokenizer o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    bool Tokenizer::atEnd( void ) const
+    {
+        return this->_input.empty();
+    }
+    
+    std::string_view Tokenizer::rest( void ) const
+    {
+        return this->_input;
+    }
+    
+    bool Tokenizer::line( std::string_view & line )
+    {
+        size_t pos;
+        
+        if( this->_input.empty() )
+        {
+            return false;
+        }
+        
+        pos = this->_input.find( '\n' );
+        
+        if( pos == std::string_view::npos )
+        {
+            line         = this->_input;
+            this->_input = {};
+        }
+        else
+        {
+            line = this->_input.substr( 0, pos );
+            
+            this->_input.remove_prefix( pos + 1 );
+        }
+        
+        return true;
+    }
+    
+    bool Tokenizer::expect( char c )
+    {
+        if( this->_input.empty() || this->_input.front() != c )
+        {
+            return false;
+        }
+        
+        this->_input.remove_prefix( 1 );
+        
+        return true;
+    }
+    
+    bool Tokenizer::expect( std::string_view s )
+    {
+        if( this->_input.substr( 0, s.length() ) != s )
+        {
+            return false;
+        }
+        
+        this->_input.remove_prefix( s.length() );
+        
+        return true;
+    }
+    
+    void Tokenizer::skip( char c )
+    {
+        while( this->_input.empty() == false && this->_input.front() == c )
+        {
+            this->_input.remove_prefix( 1 );
+        }
+    }
+    
+    std::string_view Tokenizer::until( char c )
+    {
+        size_t           pos( std::min( this->_input.find( c ), this->_input.length() ) );
+        std::string_view s(   this->_input.substr( 0, pos ) );
+        
+        this->_input.remove_prefix( pos );
+        
+        return s;
+    }
+    
+    void swap( Tokenizer & o1, Tokenizer & o2 )
+    {
+        using std::swap;
+        
+        swap( o1._input, o2._input );
+    }
+}
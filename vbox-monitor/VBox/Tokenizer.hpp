@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_TOKENIZER_HPP
+#define VBOX_TOKENIZER_HPP
+
+#include <string_view>
+#include <type_traits>
+#include "VBox/String.hpp"
+
+namespace VBox
+{
+    class Tokenizer
+    {
+        public:
+            
+            Tokenizer( void );
+            Tokenizer( std::string_view input );
+            Tokenizer( const Tokenizer & o );
+            ~Tokenizer( void );
+            
+            Tokenizer & operator =( Tokenizer o );
+            
+            bool             atEnd( void ) const;
+            std::string_view rest( void )  const;
+            
+            bool             line( std::string_view & line );
+            bool             expect( char c );
+            bool             expect( std::string_view s );
+            void             skip( char c );
+            std::string_view until( char c );
+            
+            template< typename _T_ >
+            bool hex( _T_ & value, typename std::enable_if< std::is_integral< _T_ >::value >::type * = 0 )
+            {
+                const char * p( String::fromHex( this->_input.data(), this->_input.data() + this->_input.length(), value ) );
+                
+                if( p == this->_input.data() )
+                {
+                    return false;
+                }
+                
+                this->_input.remove_prefix( static_cast< size_t >( p - this->_input.data() ) );
+                
+                return true;
+            }
+            
+            friend void swap( Tokenizer & o1, Tokenizer & o2 );
+            
+        private:
+            
+            std::string_view _input;
+    };
+}
+
+#endif /* VBOX_TOKENIZER_HPP */
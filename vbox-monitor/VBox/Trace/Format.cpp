@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Trace/Format.hpp"
+#include <stdexcept>
+
+namespace VBox
+{
+    namespace Trace
+    {
+        namespace Format
+        {
+            void writeVarint( std::vector< uint8_t > & out, uint64_t value )
+            {
+                while( value >= 0x80 )
+                {
+                    out.push_back( static_cast< uint8_t >( value | 0x80 ) );
+                    
+                    value >>= 7;
+                }
+                
+                out.push_back( static_cast< uint8_t >( value ) );
+            }
+            
+            void writeSigned( std::vector< uint8_t > & out, int64_t value )
+            {
+                writeVarint( out, ( static_cast< uint64_t >( value ) << 1 ) ^ static_cast< uint64_t >( value >> 63 ) );
+            }
+            
+            uint64_t readVarint( BinaryStream & stream )
+            {
+                uint64_t value( 0 );
+                
+                for( unsigned int shift = 0; shift < 64; shift += 7 )
+                {
+                    uint8_t byte( stream.ReadUInt8() );
+                    
+                    value |= static_cast< uint64_t >( byte & 0x7F ) << shift;
+                    
+                    if( ( byte & 0x80 ) == 0 )
+                    {
+                        return value;
+                    }
+                }
+                
+                throw std::runtime_error( "Invalid trace varint" );
+            }
+            
+            int64_t readSigned( BinaryStream & stream )
+            {
+                uint64_t value( readVarint( stream ) );
+                
+                return static_cast< int64_t >( value >> 1 ) ^ -static_cast< int64_t >( value & 1 );
+            }
+            
+            int64_t microseconds( std::chrono::system_clock::time_point time )
+            {
+                return std::chrono::duration_cast< std::chrono::microseconds >( time.time_since_epoch() ).count();
+            }
+            
+            std::chrono::system_clock::time_point time( int64_t microseconds )
+            {
+                return std::chrono::system_clock::time_point( std::chrono::duration_cast< std::chrono::system_clock::duration >( std::chrono::microseconds( microseconds ) ) );
+            }
+        }
+    }
+}
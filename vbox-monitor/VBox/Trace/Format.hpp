@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_TRACE_FORMAT_HPP
+#define VBOX_TRACE_FORMAT_HPP
+
+#include "VBox/BinaryStream.hpp"
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <chrono>
+
+namespace VBox
+{
+    namespace Trace
+    {
+        namespace Format
+        {
+            enum class Record: uint8_t
+            {
+                Keyframe = 1,
+                Delta    = 2,
+                Page     = 3,
+                Index    = 4
+            };
+            
+            constexpr std::array< uint8_t, 4 > Magic            = { { 'V', 'B', 'T', 'R' } };
+            constexpr std::array< uint8_t, 4 > IndexMagic       = { { 'V', 'B', 'T', 'I' } };
+            constexpr uint8_t                  Version          = 2;
+            constexpr uint64_t                 KeyframeInterval = 256;
+            constexpr size_t                   TrailerSize      = 12;
+            
+            void     writeVarint( std::vector< uint8_t > & out, uint64_t value );
+            void     writeSigned( std::vector< uint8_t > & out, int64_t value );
+            uint64_t readVarint( BinaryStream & stream );
+            int64_t  readSigned( BinaryStream & stream );
+            
+            int64_t                               microseconds( std::chrono::system_clock::time_point time );
+            std::chrono::system_clock::time_point time( int64_t microseconds );
+        }
+    }
+}
+
+#endif /* VBOX_TRACE_FORMAT_HPP */
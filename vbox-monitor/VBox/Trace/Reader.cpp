@@ -0,0 +1,507 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Trace/Reader.hpp"
+#include "VBox/Trace/Format.hpp"
+#include "VBox/BinaryFileStream.hpp"
+#include "VBox/BinaryDataStream.hpp"
+#include "VBox/Casts.hpp"
+#include <map>
+#include <algorithm>
+#include <stdexcept>
+
+namespace VBox
+{
+    namespace Trace
+    {
+        class Reader::IMPL
+        {
+            public:
+                
+                IMPL( const std::string & path );
+                
+                void                   _readHeader( void );
+                bool                   _readIndex( void );
+                void                   _scan( void );
+                void                   _seekKeyframe( size_t keyframe );
+                bool                   _step( void );
+                std::vector< uint8_t > _readRecord( uint64_t offset, Format::Record & type, uint64_t & next );
+                
+                std::string                                                           _path;
+                BinaryFileStream                                                      _stream;
+                std::string                                                           _vmName;
+                uint64_t                                                              _size;
+                uint64_t                                                              _dataBegin;
+                uint64_t                                                              _dataEnd;
+                uint64_t                                                              _samples;
+                int64_t                                                               _start;
+                int64_t                                                               _endTime;
+                bool                                                                  _indexed;
+                std::vector< std::pair< uint64_t, uint64_t > >                        _keyframes;
+                std::vector< int64_t >                                                _keyframeTimes;
+                std::map< uint64_t, std::vector< std::pair< uint64_t, uint64_t > > > _pages;
+                uint64_t                                                              _next;
+                uint64_t                                                              _position;
+                int64_t                                                               _time;
+                VM::Sample::Words                                                     _words;
+                std::optional< VM::Sample >                                           _current;
+                std::optional< VM::Sample >                                           _previous;
+        };
+        
+        Reader::Reader( const std::string & path ):
+            impl( std::make_unique< IMPL >( path ) )
+        {}
+        
+        Reader::~Reader( void )
+        {}
+        
+        std::string Reader::path( void ) const
+        {
+            return this->impl->_path;
+        }
+        
+        std::string Reader::vmName( void ) const
+        {
+            return this->impl->_vmName;
+        }
+        
+        uint64_t Reader::size( void ) const
+        {
+            return this->impl->_samples;
+        }
+        
+        bool Reader::indexed( void ) const
+        {
+            return this->impl->_indexed;
+        }
+        
+        std::chrono::system_clock::time_point Reader::startTime( void ) const
+        {
+            return Format::time( this->impl->_start + ( ( this->impl->_keyframeTimes.empty() ) ? 0 : this->impl->_keyframeTimes.front() ) );
+        }
+        
+        std::chrono::system_clock::time_point Reader::endTime( void ) const
+        {
+            return Format::time( this->impl->_start + this->impl->_endTime );
+        }
+        
+        uint64_t Reader::find( std::chrono::system_clock::time_point time )
+        {
+            int64_t  t( Format::microseconds( time ) - this->impl->_start );
+            size_t   keyframe( numeric_cast< size_t >( std::upper_bound( this->impl->_keyframeTimes.begin(), this->impl->_keyframeTimes.end(), t ) - this->impl->_keyframeTimes.begin() ) );
+            uint64_t index;
+            
+            if( keyframe-- == 0 )
+            {
+                return 0;
+            }
+            
+            if( this->impl->_current.has_value() && this->impl->_next > this->impl->_keyframes[ keyframe ].first && this->impl->_time <= t )
+            {
+                index = this->impl->_next - 1;
+            }
+            else
+            {
+                index = this->impl->_keyframes[ keyframe ].first;
+                
+                this->impl->_seekKeyframe( keyframe );
+            }
+            
+            while( this->impl->_next < this->impl->_samples && this->impl->_step() )
+            {
+                if( this->impl->_time > t )
+                {
+                    break;
+                }
+                
+                index = this->impl->_next - 1;
+            }
+            
+            return index;
+        }
+        
+        VM::Sample Reader::sample( uint64_t index )
+        {
+            size_t keyframe;
+            
+            if( index >= this->impl->_samples )
+            {
+                throw std::out_of_range( "Invalid trace sample index" );
+            }
+            
+            if( this->impl->_current.has_value() && index == this->impl->_next - 1 )
+            {
+                return this->impl->_current.value();
+            }
+            
+            if( this->impl->_previous.has_value() && index == this->impl->_next - 2 )
+            {
+                return this->impl->_previous.value();
+            }
+            
+            keyframe = numeric_cast< size_t >
+            (
+                std::upper_bound
+                (
+                    this->impl->_keyframes.begin(),
+                    this->impl->_keyframes.end(),
+                    index,
+                    []( uint64_t i, const std::pair< uint64_t, uint64_t > & k ) { return i < k.first; }
+                )
+                - this->impl->_keyframes.begin()
+            )
+            - 1;
+            
+            if( this->impl->_next > index || this->impl->_next < this->impl->_keyframes[ keyframe ].first )
+            {
+                this->impl->_seekKeyframe( keyframe );
+            }
+            
+            while( this->impl->_next <= index )
+            {
+                if( this->impl->_step() == false )
+                {
+                    throw std::runtime_error( "Invalid trace file: missing sample" );
+                }
+            }
+            
+            return this->impl->_current.value();
+        }
+        
+        std::optional< std::vector< uint8_t > > Reader::page( uint64_t address, uint64_t index )
+        {
+            auto           it( this->impl->_pages.find( address ) );
+            Format::Record type;
+            uint64_t       next;
+            
+            if( it == this->impl->_pages.end() )
+            {
+                return {};
+            }
+            
+            {
+                auto entry
+                (
+                    std::upper_bound
+                    (
+                        it->second.begin(),
+                        it->second.end(),
+                        index + 1,
+                        []( uint64_t i, const std::pair< uint64_t, uint64_t > & p ) { return i < p.first; }
+                    )
+                );
+                
+                if( entry == it->second.begin() )
+                {
+                    return {};
+                }
+                
+                {
+                    BinaryDataStream stream( this->impl->_readRecord( ( entry - 1 )->second, type, next ) );
+                    
+                    if( type != Format::Record::Page )
+                    {
+                        throw std::runtime_error( "Invalid trace file: bad page offset" );
+                    }
+                    
+                    Format::readVarint( stream );
+                    Format::readVarint( stream );
+                    
+                    {
+                        uint64_t size( Format::readVarint( stream ) );
+                        
+                        if( size != stream.AvailableBytes() )
+                        {
+                            throw std::runtime_error( "Invalid trace file: bad page size" );
+                        }
+                    }
+                    
+                    return stream.ReadAll();
+                }
+            }
+        }
+        
+        Reader::IMPL::IMPL( const std::string & path ):
+            _path(      path ),
+            _stream(    path ),
+            _size(      0 ),
+            _dataBegin( 0 ),
+            _dataEnd(   0 ),
+            _samples(   0 ),
+            _start(     0 ),
+            _endTime(   0 ),
+            _indexed(   false ),
+            _next(      0 ),
+            _position(  0 ),
+            _time(      0 ),
+            _words(     {} )
+        {
+            this->_stream.Seek( 0, BinaryStream::SeekDirection::End );
+            
+            this->_size = this->_stream.Tell();
+            
+            this->_readHeader();
+            
+            this->_indexed = this->_readIndex();
+            
+            if( this->_indexed == false )
+            {
+                this->_scan();
+            }
+            
+            if( this->_keyframes.empty() == false )
+            {
+                this->_seekKeyframe( this->_keyframes.size() - 1 );
+                
+                while( this->_step() )
+                {}
+                
+                this->_samples = this->_next;
+                this->_endTime = this->_time;
+            }
+        }
+        
+        void Reader::IMPL::_readHeader( void )
+        {
+            std::vector< uint8_t > magic;
+            
+            this->_stream.Seek( 0, BinaryStream::SeekDirection::Begin );
+            
+            if( this->_size < Format::Magic.size() + 1 )
+            {
+                throw std::runtime_error( "Invalid trace file: " + this->_path );
+            }
+            
+            magic = this->_stream.Read( Format::Magic.size() );
+            
+            if( std::equal( magic.begin(), magic.end(), Format::Magic.begin() ) == false || this->_stream.ReadUInt8() != Format::Version )
+            {
+                throw std::runtime_error( "Invalid trace file: " + this->_path );
+            }
+            
+            this->_vmName    = this->_stream.ReadString( numeric_cast< size_t >( Format::readVarint( this->_stream ) ) );
+            this->_start     = Format::readSigned( this->_stream );
+            this->_dataBegin = this->_stream.Tell();
+            this->_dataEnd   = this->_size;
+        }
+        
+        bool Reader::IMPL::_readIndex( void )
+        {
+            std::vector< uint8_t > magic;
+            uint64_t               offset;
+            Format::Record         type;
+            uint64_t               next;
+            
+            if( this->_size < this->_dataBegin + Format::TrailerSize )
+            {
+                return false;
+            }
+            
+            this->_stream.Seek( -static_cast< ssize_t >( Format::TrailerSize ), BinaryStream::SeekDirection::End );
+            
+            offset = this->_stream.ReadLittleEndianUInt64();
+            magic  = this->_stream.Read( Format::IndexMagic.size() );
+            
+            if( std::equal( magic.begin(), magic.end(), Format::IndexMagic.begin() ) == false || offset < this->_dataBegin || offset >= this->_size - Format::TrailerSize )
+            {
+                return false;
+            }
+            
+            {
+                BinaryDataStream stream( this->_readRecord( offset, type, next ) );
+                uint64_t         sample( 0 );
+                uint64_t         position( 0 );
+                int64_t          time( 0 );
+                
+                if( type != Format::Record::Index || next != this->_size - Format::TrailerSize )
+                {
+                    return false;
+                }
+                
+                for( uint64_t i = 0, n = Format::readVarint( stream ); i < n; i++ )
+                {
+                    sample   += Format::readVarint( stream );
+                    position += Format::readVarint( stream );
+                    time     += Format::readSigned( stream );
+                    
+                    if( position < this->_dataBegin || position >= offset )
+                    {
+                        throw std::runtime_error( "Invalid trace file: bad keyframe offset" );
+                    }
+                    
+                    this->_keyframes.emplace_back( sample, position );
+                    this->_keyframeTimes.push_back( time );
+                }
+                
+                for( uint64_t i = 0, n = Format::readVarint( stream ); i < n; i++ )
+                {
+                    uint64_t address( Format::readVarint( stream ) );
+                    uint64_t index(   Format::readVarint( stream ) );
+                    uint64_t page(    Format::readVarint( stream ) );
+                    
+                    this->_pages[ address ].emplace_back( index, page );
+                }
+            }
+            
+            this->_dataEnd = offset;
+            
+            return true;
+        }
+        
+        void Reader::IMPL::_scan( void )
+        {
+            uint64_t position( this->_dataBegin );
+            uint64_t samples( 0 );
+            
+            try
+            {
+                while( position < this->_size )
+                {
+                    Format::Record type;
+                    uint64_t       size;
+                    uint64_t       next;
+                    
+                    this->_stream.Seek( numeric_cast< ssize_t >( position ), BinaryStream::SeekDirection::Begin );
+                    
+                    type = static_cast< Format::Record >( this->_stream.ReadUInt8() );
+                    size = Format::readVarint( this->_stream );
+                    next = this->_stream.Tell() + size;
+                    
+                    if( next > this->_size || type == Format::Record::Index )
+                    {
+                        break;
+                    }
+                    
+                    if( type == Format::Record::Keyframe )
+                    {
+                        if( Format::readVarint( this->_stream ) != samples )
+                        {
+                            break;
+                        }
+                        
+                        this->_keyframes.emplace_back( samples, position );
+                        this->_keyframeTimes.push_back( Format::readSigned( this->_stream ) );
+                    }
+                    else if( type == Format::Record::Page )
+                    {
+                        uint64_t index( Format::readVarint( this->_stream ) );
+                        
+                        this->_pages[ Format::readVarint( this->_stream ) ].emplace_back( index, position );
+                    }
+                    
+                    if( type == Format::Record::Keyframe || type == Format::Record::Delta )
+                    {
+                        samples++;
+                    }
+                    
+                    position = next;
+                }
+            }
+            catch( const std::runtime_error & )
+            {}
+            
+            this->_dataEnd = position;
+        }
+        
+        void Reader::IMPL::_seekKeyframe( size_t keyframe )
+        {
+            this->_next     = this->_keyframes[ keyframe ].first;
+            this->_position = this->_keyframes[ keyframe ].second;
+            this->_current  = {};
+            this->_previous = {};
+        }
+        
+        bool Reader::IMPL::_step( void )
+        {
+            while( this->_position < this->_dataEnd )
+            {
+                Format::Record   type;
+                BinaryDataStream stream( this->_readRecord( this->_position, type, this->_position ) );
+                
+                if( type == Format::Record::Keyframe )
+                {
+                    this->_next = Format::readVarint( stream ) + 1;
+                    this->_time = Format::readSigned( stream );
+                    
+                    for( auto & word: this->_words )
+                    {
+                        word = Format::readVarint( stream );
+                    }
+                }
+                else if( type == Format::Record::Delta )
+                {
+                    std::vector< uint8_t > mask;
+                    
+                    if( this->_current.has_value() == false )
+                    {
+                        throw std::runtime_error( "Invalid trace file: delta without keyframe" );
+                    }
+                    
+                    this->_time += Format::readSigned( stream );
+                    
+                    mask = stream.Read( ( this->_words.size() + 7 ) / 8 );
+                    
+                    for( size_t i = 0; i < this->_words.size(); i++ )
+                    {
+                        if( mask[ i / 8 ] & ( 1 << ( i % 8 ) ) )
+                        {
+                            this->_words[ i ] += static_cast< uint64_t >( Format::readSigned( stream ) );
+                        }
+                    }
+                    
+                    this->_next++;
+                }
+                else
+                {
+                    continue;
+                }
+                
+                this->_previous = this->_current;
+                this->_current  = VM::Sample( Format::time( this->_start + this->_time ), this->_words );
+                
+                return true;
+            }
+            
+            return false;
+        }
+        
+        std::vector< uint8_t > Reader::IMPL::_readRecord( uint64_t offset, Format::Record & type, uint64_t & next )
+        {
+            uint64_t size;
+            
+            this->_stream.Seek( numeric_cast< ssize_t >( offset ), BinaryStream::SeekDirection::Begin );
+            
+            type = static_cast< Format::Record >( this->_stream.ReadUInt8() );
+            size = Format::readVarint( this->_stream );
+            next = this->_stream.Tell() + size;
+            
+            if( next > this->_size )
+            {
+                throw std::runtime_error( "Invalid trace file: truncated record" );
+            }
+            
+            return this->_stream.Read( numeric_cast< size_t >( size ) );
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_TRACE_READER_HPP
+#define VBOX_TRACE_READER_HPP
+
+#include "VBox/VM/Sample.hpp"
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+
+namespace VBox
+{
+    namespace Trace
+    {
+        class Reader
+        {
+            public:
+                
+                Reader( const std::string & path );
+                ~Reader( void );
+                
+                Reader( const Reader & o )              = delete;
+                Reader( Reader && o )                   = delete;
+                Reader & operator =( const Reader & o ) = delete;
+                Reader & operator =( Reader && o )      = delete;
+                
+                std::string                           path( void )      const;
+                std::string                           vmName( void )    const;
+                uint64_t                              size( void )      const;
+                bool                                  indexed( void )   const;
+                std::chrono::system_clock::time_point startTime( void ) const;
+                std::chrono::system_clock::time_point endTime( void )   const;
+                
+                uint64_t                                find( std::chrono::system_clock::time_point time );
+                VM::Sample                              sample( uint64_t index );
+                std::optional< std::vector< uint8_t > > page( uint64_t address, uint64_t index );
+                
+            private:
+                
+                class IMPL;
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_TRACE_READER_HPP */
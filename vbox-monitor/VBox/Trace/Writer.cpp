@@ -0,0 +1,322 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/Trace/Writer.hpp"
+#include "VBox/Trace/Format.hpp"
+#include "VBox/Casts.hpp"
+#include "VBox/Hash.hpp"
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <array>
+#include <stdexcept>
+
+namespace VBox
+{
+    namespace Trace
+    {
+        class Writer::IMPL
+        {
+            public:
+                
+                IMPL( const std::string & path, const std::string & vmName );
+                
+                void _append( std::unique_lock< std::mutex > & l, Format::Record type );
+                void _run( void );
+                
+                std::string                                    _path;
+                std::ofstream                                  _stream;
+                mutable std::mutex                             _mtx;
+                std::condition_variable                        _cv;
+                std::thread                                    _thread;
+                std::vector< uint8_t >                         _buffer;
+                std::vector< uint8_t >                         _payload;
+                uint64_t                                       _offset;
+                uint64_t                                       _written;
+                uint64_t                                       _samples;
+                int64_t                                        _start;
+                int64_t                                        _time;
+                VM::Sample::Words                              _previous;
+                std::vector< std::pair< uint64_t, uint64_t > > _keyframes;
+                std::vector< int64_t >                         _keyframeTimes;
+                std::vector< std::array< uint64_t, 3 > >       _pages;
+                std::unordered_map< uint64_t, uint64_t >       _hashes;
+                bool                                           _stop;
+                bool                                           _closed;
+        };
+        
+        static const uint64_t MaxPendingBytes = 16 * 1024 * 1024;
+        
+        Writer::Writer( const std::string & path, const std::string & vmName ):
+            impl( std::make_unique< IMPL >( path, vmName ) )
+        {
+            this->impl->_thread = std::thread( [ this ] { this->impl->_run(); } );
+        }
+        
+        Writer::~Writer( void )
+        {
+            this->close();
+        }
+        
+        std::string Writer::path( void ) const
+        {
+            return this->impl->_path;
+        }
+        
+        uint64_t Writer::samples( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_samples;
+        }
+        
+        uint64_t Writer::bytes( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_offset;
+        }
+        
+        void Writer::write( const VM::Sample & sample )
+        {
+            std::unique_lock< std::mutex > l( this->impl->_mtx );
+            VM::Sample::Words              words( sample.words() );
+            int64_t                        time( Format::microseconds( sample.timestamp() ) - this->impl->_start );
+            std::vector< uint8_t >       & payload( this->impl->_payload );
+            
+            if( this->impl->_closed )
+            {
+                return;
+            }
+            
+            payload.clear();
+            
+            if( this->impl->_samples % Format::KeyframeInterval == 0 )
+            {
+                this->impl->_keyframes.emplace_back( this->impl->_samples, this->impl->_offset );
+                this->impl->_keyframeTimes.push_back( time );
+                
+                Format::writeVarint( payload, this->impl->_samples );
+                Format::writeSigned( payload, time );
+                
+                for( uint64_t word: words )
+                {
+                    Format::writeVarint( payload, word );
+                }
+            }
+            else
+            {
+                size_t mask;
+                
+                Format::writeSigned( payload, time - this->impl->_time );
+                
+                mask = payload.size();
+                
+                payload.resize( mask + ( words.size() + 7 ) / 8, 0 );
+                
+                for( size_t i = 0; i < words.size(); i++ )
+                {
+                    if( words[ i ] != this->impl->_previous[ i ] )
+                    {
+                        payload[ mask + i / 8 ] |= static_cast< uint8_t >( 1 << ( i % 8 ) );
+                        
+                        Format::writeSigned( payload, static_cast< int64_t >( words[ i ] - this->impl->_previous[ i ] ) );
+                    }
+                }
+            }
+            
+            this->impl->_previous = words;
+            this->impl->_time     = time;
+            
+            this->impl->_append( l, ( this->impl->_samples++ % Format::KeyframeInterval == 0 ) ? Format::Record::Keyframe : Format::Record::Delta );
+        }
+        
+        void Writer::write( uint64_t address, const std::vector< uint8_t > & page )
+        {
+            std::unique_lock< std::mutex > l( this->impl->_mtx );
+            uint64_t                       hash( Hash::bytes( page.data(), page.size() ) );
+            std::vector< uint8_t >       & payload( this->impl->_payload );
+            auto                           it( this->impl->_hashes.find( address ) );
+            
+            if( this->impl->_closed || ( it != this->impl->_hashes.end() && it->second == hash ) )
+            {
+                return;
+            }
+            
+            this->impl->_hashes[ address ] = hash;
+            
+            this->impl->_pages.push_back( { address, this->impl->_samples, this->impl->_offset } );
+            
+            payload.clear();
+            
+            Format::writeVarint( payload, this->impl->_samples );
+            Format::writeVarint( payload, address );
+            Format::writeVarint( payload, page.size() );
+            
+            payload.insert( payload.end(), page.begin(), page.end() );
+            
+            this->impl->_append( l, Format::Record::Page );
+        }
+        
+        void Writer::flush( void )
+        {
+            std::unique_lock< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_cv.wait( l, [ & ] { return this->impl->_written == this->impl->_offset; } );
+            this->impl->_stream.flush();
+        }
+        
+        void Writer::close( void )
+        {
+            std::unique_lock< std::mutex > l( this->impl->_mtx );
+            std::vector< uint8_t >       & payload( this->impl->_payload );
+            uint64_t                       index( this->impl->_offset );
+            uint64_t                       sample( 0 );
+            uint64_t                       offset( 0 );
+            int64_t                        time( 0 );
+            
+            if( this->impl->_closed )
+            {
+                return;
+            }
+            
+            this->impl->_closed = true;
+            
+            payload.clear();
+            
+            Format::writeVarint( payload, this->impl->_keyframes.size() );
+            
+            for( size_t i = 0; i < this->impl->_keyframes.size(); i++ )
+            {
+                Format::writeVarint( payload, this->impl->_keyframes[ i ].first  - sample );
+                Format::writeVarint( payload, this->impl->_keyframes[ i ].second - offset );
+                Format::writeSigned( payload, this->impl->_keyframeTimes[ i ]    - time );
+                
+                sample = this->impl->_keyframes[ i ].first;
+                offset = this->impl->_keyframes[ i ].second;
+                time   = this->impl->_keyframeTimes[ i ];
+            }
+            
+            Format::writeVarint( payload, this->impl->_pages.size() );
+            
+            for( const auto & page: this->impl->_pages )
+            {
+                Format::writeVarint( payload, page[ 0 ] );
+                Format::writeVarint( payload, page[ 1 ] );
+                Format::writeVarint( payload, page[ 2 ] );
+            }
+            
+            this->impl->_append( l, Format::Record::Index );
+            
+            for( unsigned int i = 0; i < 8; i++ )
+            {
+                this->impl->_buffer.push_back( static_cast< uint8_t >( index >> ( i * 8 ) ) );
+            }
+            
+            this->impl->_buffer.insert( this->impl->_buffer.end(), Format::IndexMagic.begin(), Format::IndexMagic.end() );
+            
+            this->impl->_offset += Format::TrailerSize;
+            this->impl->_stop    = true;
+            
+            this->impl->_cv.notify_all();
+            l.unlock();
+            this->impl->_thread.join();
+            this->impl->_stream.close();
+        }
+        
+        Writer::IMPL::IMPL( const std::string & path, const std::string & vmName ):
+            _path(     path ),
+            _offset(   0 ),
+            _written(  0 ),
+            _samples(  0 ),
+            _start(    Format::microseconds( std::chrono::system_clock::now() ) ),
+            _time(     0 ),
+            _previous( {} ),
+            _stop(     false ),
+            _closed(   false )
+        {
+            this->_stream.open( path, std::ios::binary | std::ios::out | std::ios::trunc );
+            
+            if( this->_stream.good() == false )
+            {
+                throw std::runtime_error( "Cannot open trace file: " + path );
+            }
+            
+            this->_buffer.insert( this->_buffer.end(), Format::Magic.begin(), Format::Magic.end() );
+            this->_buffer.push_back( Format::Version );
+            
+            Format::writeVarint( this->_buffer, vmName.size() );
+            
+            this->_buffer.insert( this->_buffer.end(), vmName.begin(), vmName.end() );
+            
+            Format::writeSigned( this->_buffer, this->_start );
+            
+            this->_offset = this->_buffer.size();
+        }
+        
+        void Writer::IMPL::_append( std::unique_lock< std::mutex > & l, Format::Record type )
+        {
+            size_t size( this->_buffer.size() );
+            
+            this->_buffer.push_back( static_cast< uint8_t >( type ) );
+            
+            Format::writeVarint( this->_buffer, this->_payload.size() );
+            
+            this->_buffer.insert( this->_buffer.end(), this->_payload.begin(), this->_payload.end() );
+            
+            this->_offset += this->_buffer.size() - size;
+            
+            this->_cv.notify_all();
+            this->_cv.wait( l, [ & ] { return this->_offset - this->_written <= MaxPendingBytes || this->_stop; } );
+        }
+        
+        void Writer::IMPL::_run( void )
+        {
+            std::unique_lock< std::mutex > l( this->_mtx );
+            std::vector< uint8_t >         chunk;
+            
+            while( true )
+            {
+                this->_cv.wait( l, [ & ] { return this->_buffer.empty() == false || this->_stop; } );
+                
+                if( this->_buffer.empty() )
+                {
+                    break;
+                }
+                
+                std::swap( chunk, this->_buffer );
+                l.unlock();
+                this->_stream.write( reinterpret_cast< const char * >( chunk.data() ), numeric_cast< std::streamsize >( chunk.size() ) );
+                l.lock();
+                
+                this->_written += chunk.size();
+                
+                chunk.clear();
+                this->_cv.notify_all();
+            }
+        }
+    }
+}
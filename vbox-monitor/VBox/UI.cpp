@@ -23,13 +23,27 @@
  ******************************************************************************/
 
 #include "VBox/UI.hpp"
+#include "VBox/Arena.hpp"
 #include "VBox/Screen.hpp"
 #include "VBox/Window.hpp"
 #include "VBox/String.hpp"
-#include "VBox/Monitor.hpp"
+#include "VBox/Fleet.hpp"
 #include "VBox/Casts.hpp"
-#include "VBox/Capstone.hpp"
+#include "VBox/Stats.hpp"
+#include "VBox/Tokenizer.hpp"
+#include "VBox/SignalHandler.hpp"
+#include "VBox/Capstone/Disassembler.hpp"
+#include "VBox/VM/Search.hpp"
+#include "VBox/VM/AddressSpace.hpp"
+#include "VBox/VM/MemoryCache.hpp"
+#include "VBox/VM/MemoryOverview.hpp"
 #include <ncurses.h>
+#include <map>
+#include <set>
+#include <array>
+#include <bitset>
+#include <atomic>
+#include <mutex>
 
 namespace VBox
 {
@@ -37,37 +51,118 @@ namespace VBox
     {
         public:
             
-            IMPL( const std::string & vmName );
+            enum class Panel
+            {
+                Title,
+                Registers,
+                Stack,
+                Disassembly,
+                Memory,
+                CPUs,
+                Stats
+            };
+            
+            static constexpr size_t PanelCount = static_cast< size_t >( Panel::Stats ) + 1;
+            
+            IMPL( const std::vector< std::string > & vmNames );
+            IMPL( const std::vector< std::shared_ptr< Manage::Backend > > & backends );
             IMPL( const IMPL & o );
             
-            void _setup( void );
+            void                       _setup( void );
+            void                       _invalidate( void );
+            void                       _invalidate( Panel panel );
+            bool                       _invalid( Panel panel ) const;
+            Monitor &                  _monitor( void );
+            void                       _select( size_t index );
+            void                       _selectCPU( size_t index );
+            size_t                     _memoryWidth( void );
+            Window &                   _window( Panel panel, size_t x, size_t y, size_t width, size_t height );
+            const VM::AddressSpace &   _addressSpace( void );
+            VM::MemoryView             _memoryView( const VM::CoreDump & dump, size_t offset, size_t size );
+            std::optional< uint64_t >  _memoryGeneration( void );
+            Arena::Vector< uint64_t >  _memoryDiff( const VM::MemoryView & mem, size_t offset );
+            const VM::MemoryOverview & _memoryOverview( size_t cells );
+            
             void _drawTitle( void );
             void _drawRegisters( void );
             void _drawStack( void );
             void _drawDisassembly( void );
             void _drawMemory( void );
+            void _drawCPUs( void );
+            void _drawStats( void );
             
             void _memoryScrollUp( size_t n = 1 );
             void _memoryScrollDown( size_t n = 1 );
             void _memoryPageUp( void );
             void _memoryPageDown( void );
+            void _search( const std::string & query );
+            void _searchNext( void );
+            void _searchPrevious( void );
+            void _diffNext( void );
+            void _diffPrevious( void );
+            void _overviewNext( void );
+            void _overviewPrevious( void );
+            void _overviewData( void );
+            void _pause( void );
+            void _resume( void );
+            void _scrub( int64_t delta );
             
-            bool                            _running;
-            bool                            _paused;
-            std::string                     _vmName;
-            Monitor                         _monitor;
-            size_t                          _memoryOffset;
-            size_t                          _memoryBytesPerLine;
-            size_t                          _memoryLines;
-            size_t                          _totalMemory;
-            std::optional< VM::Registers >  _registers;
-            std::vector< VM::StackEntry >   _stack;
-            std::shared_ptr< VM::CoreDump > _dump;
-            std::optional< std::string >    _memoryAddressPrompt;
+            bool                                              _running;
+            bool                                              _paused;
+            bool                                              _showStats;
+            bool                                              _diff;
+            Fleet                                             _fleet;
+            std::atomic< size_t >                             _current;
+            std::vector< bool >                               _live;
+            size_t                                            _memoryOffset;
+            size_t                                            _memoryBytesPerLine;
+            size_t                                            _memoryLines;
+            size_t                                            _totalMemory;
+            size_t                                            _cpuCount;
+            std::shared_ptr< const VM::Snapshot >             _snapshot;
+            std::optional< uint64_t >                         _historyIndex;
+            std::optional< uint64_t >                         _generation;
+            std::optional< VM::Registers >                    _previousRegisters;
+            std::shared_ptr< const VM::SymbolIndex >          _symbols;
+            std::optional< std::string >                      _memoryAddressPrompt;
+            std::optional< std::string >                      _searchPrompt;
+            std::shared_ptr< VM::Search >                     _searchResults;
+            double                                            _searchProgress;
+            Capstone::Disassembler                            _disassembler;
+            VM::AddressSpace                                  _space;
+            std::array< uint64_t, 5 >                         _spaceKey;
+            VM::MemoryOverview                                _overview;
+            std::array< uint64_t, 3 >                         _overviewKey;
+            std::map< Panel, std::unique_ptr< Window > >      _windows;
+            Arena                                             _arena;
+            std::bitset< PanelCount >                         _dirty;
+            std::mutex                                        _tmtx;
+            std::optional< std::pair< size_t, std::string > > _triggered;
+            std::optional< std::string >                      _trigger;
+            std::optional< SignalHandler >                    _signals;
     };
     
+    static const size_t ArenaSize = 64 * 1024;
+    
+    template< typename _T_ >
+    static void printHex( Window & win, const Color & color, _T_ value )
+    {
+        char buffer[ 2 + sizeof( _T_ ) * 2 ] = { '0', 'x' };
+        
+        String::toHex( value, buffer + 2 );
+        win.write( color, buffer, sizeof( buffer ) );
+    }
+    
     UI::UI( const std::string & vmName ):
-        impl( std::make_unique< IMPL >( vmName ) )
+        UI( std::vector< std::string > { vmName } )
+    {}
+    
+    UI::UI( const std::vector< std::string > & vmNames ):
+        impl( std::make_unique< IMPL >( vmNames ) )
+    {}
+    
+    UI::UI( const std::vector< std::shared_ptr< Manage::Backend > > & backends ):
+        impl( std::make_unique< IMPL >( backends ) )
     {}
     
     UI::UI( const UI & o ):
@@ -95,8 +190,30 @@ namespace VBox
             return;
         }
         
-        this->impl->_monitor.start();
+        this->impl->_signals.emplace();
+        this->impl->_fleet.start();
         Screen::shared().start();
+        this->impl->_signals.reset();
+    }
+    
+    size_t UI::historyCapacity( void ) const
+    {
+        return this->impl->_fleet.historyCapacity();
+    }
+    
+    void UI::historyCapacity( size_t samples )
+    {
+        this->impl->_fleet.historyCapacity( samples );
+    }
+    
+    void UI::triggers( const std::vector< VM::Trigger > & triggers )
+    {
+        this->impl->_fleet.triggers( triggers );
+    }
+    
+    void UI::record( const std::string & directory )
+    {
+        this->impl->_fleet.record( directory );
     }
     
     void swap( UI & o1, UI & o2 )
@@ -106,15 +223,46 @@ namespace VBox
         swap( o1.impl, o2.impl );
     }
     
-    UI::IMPL::IMPL( const std::string & vmName ):
+    UI::IMPL::IMPL( const std::vector< std::string > & vmNames ):
+        _running(            false ),
+        _paused(             false ),
+        _showStats(          false ),
+        _diff(               false ),
+        _fleet(              vmNames ),
+        _current(            0 ),
+        _memoryOffset(       0 ),
+        _memoryBytesPerLine( 0 ),
+        _memoryLines(        0 ),
+        _totalMemory(        0 ),
+        _cpuCount(           0 ),
+        _snapshot(           _fleet.monitor( 0 ).snapshot() ),
+        _symbols(            _fleet.monitor( 0 ).symbols() ),
+        _searchProgress(     0 ),
+        _spaceKey(           {} ),
+        _overviewKey(        {} ),
+        _arena(              ArenaSize )
+    {
+        this->_setup();
+    }
+    
+    UI::IMPL::IMPL( const std::vector< std::shared_ptr< Manage::Backend > > & backends ):
         _running(            false ),
         _paused(             false ),
-        _vmName(             vmName ),
-        _monitor(            vmName ),
+        _showStats(          false ),
+        _diff(               false ),
+        _fleet(              backends ),
+        _current(            0 ),
         _memoryOffset(       0 ),
         _memoryBytesPerLine( 0 ),
         _memoryLines(        0 ),
-        _totalMemory(        0 )
+        _totalMemory(        0 ),
+        _cpuCount(           0 ),
+        _snapshot(           _fleet.monitor( 0 ).snapshot() ),
+        _symbols(            _fleet.monitor( 0 ).symbols() ),
+        _searchProgress(     0 ),
+        _spaceKey(           {} ),
+        _overviewKey(        {} ),
+        _arena(              ArenaSize )
     {
         this->_setup();
     }
@@ -122,41 +270,206 @@ namespace VBox
     UI::IMPL::IMPL( const IMPL & o ):
         _running(            false ),
         _paused(             o._paused ),
-        _vmName(             o._vmName ),
-        _monitor(            o._monitor ),
+        _showStats(          o._showStats ),
+        _diff(               o._diff ),
+        _fleet(              o._fleet ),
+        _current(            o._current.load() ),
         _memoryOffset(       o._memoryOffset ),
         _memoryBytesPerLine( o._memoryBytesPerLine ),
         _memoryLines(        o._memoryLines ),
         _totalMemory(        o._totalMemory ),
-        _registers(          o._registers ),
-        _stack(              o._stack ),
-        _dump(               o._dump )
+        _cpuCount(           o._cpuCount ),
+        _snapshot(           o._snapshot ),
+        _symbols(            o._symbols ),
+        _searchProgress(     0 ),
+        _spaceKey(           {} ),
+        _overviewKey(        {} ),
+        _arena(              ArenaSize )
     {
         this->_setup();
     }
     
     void UI::IMPL::_setup( void )
     {
+        for( size_t i = 0; i < this->_fleet.size(); i++ )
+        {
+            this->_fleet.monitor( i ).onChange
+            (
+                [ this, i ]( void )
+                {
+                    if( this->_current == i )
+                    {
+                        Screen::shared().wakeUp();
+                    }
+                }
+            );
+            
+            this->_fleet.monitor( i ).onTrigger
+            (
+                [ this, i ]( const VM::Trigger & trigger )
+                {
+                    {
+                        std::lock_guard< std::mutex > l( this->_tmtx );
+                        
+                        this->_triggered = std::make_pair( i, trigger.description() );
+                    }
+                    
+                    Screen::shared().wakeUp();
+                }
+            );
+        }
+        
+        this->_fleet.onChange( []( void ) { Screen::shared().wakeUp(); } );
+        this->_invalidate();
+        
+        Screen::shared().onResize
+        (
+            [ & ]( void )
+            {
+                this->_windows.clear();
+                
+                Screen::shared().clear();
+                Screen::shared().refresh();
+                
+                this->_invalidate();
+            }
+        );
+        
         Screen::shared().onUpdate
         (
             [ & ]( void )
             {
-                if( this->_paused == false )
                 {
-                    this->_registers = this->_monitor.registers();
-                    this->_stack     = this->_monitor.stack();
-                    this->_dump      = this->_monitor.dump();
+                    std::optional< std::pair< size_t, std::string > > triggered;
+                    
+                    {
+                        std::lock_guard< std::mutex > l( this->_tmtx );
+                        
+                        std::swap( triggered, this->_triggered );
+                    }
+                    
+                    if( triggered.has_value() )
+                    {
+                        this->_select( triggered->first );
+                        this->_resume();
+                        this->_pause();
+                        
+                        this->_trigger = triggered->second;
+                    }
+                }
+                
+                {
+                    uint64_t generation( this->_monitor().generation() );
+                    
+                    if( generation != this->_generation )
+                    {
+                        this->_generation = generation;
+                        
+                        if( this->_paused == false )
+                        {
+                            std::shared_ptr< const VM::Snapshot > snapshot( this->_monitor().snapshot() );
+                            
+                            if( snapshot->registersSequence() != this->_snapshot->registersSequence() )
+                            {
+                                this->_previousRegisters = this->_snapshot->registers();
+                                
+                                this->_invalidate( Panel::Registers );
+                                this->_invalidate( Panel::Disassembly );
+                                this->_invalidate( Panel::CPUs );
+                            }
+                            
+                            if( snapshot->stackSequence() != this->_snapshot->stackSequence() )
+                            {
+                                this->_invalidate( Panel::Stack );
+                            }
+                            
+                            if( snapshot->dumpSequence() != this->_snapshot->dumpSequence() )
+                            {
+                                this->_invalidate( Panel::Disassembly );
+                                this->_invalidate( Panel::Memory );
+                            }
+                            
+                            if( snapshot->timeouts() != this->_snapshot->timeouts() )
+                            {
+                                this->_invalidate( Panel::Title );
+                            }
+                            
+                            this->_snapshot = snapshot;
+                        }
+                        
+                        {
+                            std::shared_ptr< const VM::SymbolIndex > symbols( this->_monitor().symbols() );
+                            
+                            if( symbols != this->_symbols )
+                            {
+                                this->_invalidate( Panel::Disassembly );
+                                this->_invalidate( Panel::Memory );
+                                
+                                this->_symbols = symbols;
+                            }
+                        }
+                        
+                        {
+                            size_t cpus( this->_monitor().cpuCount() );
+                            
+                            if( cpus != this->_cpuCount )
+                            {
+                                this->_cpuCount = cpus;
+                                
+                                this->_windows.clear();
+                                
+                                Screen::shared().clear();
+                                Screen::shared().refresh();
+                                
+                                this->_invalidate();
+                            }
+                        }
+                    }
+                }
+                
+                if( this->_searchResults != nullptr && this->_searchResults->progress() != this->_searchProgress )
+                {
+                    this->_invalidate( Panel::Memory );
+                }
+                
+                {
+                    bool changed( this->_live.size() != this->_fleet.size() );
+                    
+                    this->_live.resize( this->_fleet.size() );
+                    
+                    for( size_t i = 0; i < this->_fleet.size(); i++ )
+                    {
+                        bool live( this->_fleet.monitor( i ).live() );
+                        
+                        changed         = changed || live != this->_live[ i ];
+                        this->_live[ i ] = live;
+                    }
+                    
+                    if( changed )
+                    {
+                        this->_invalidate( Panel::Title );
+                    }
+                }
+                
+                if( this->_showStats )
+                {
+                    this->_invalidate( Panel::Stats );
                 }
                 
-                this->_drawTitle();
-                this->_drawRegisters();
-                this->_drawStack();
-                this->_drawDisassembly();
-                this->_drawMemory();
+                if( this->_invalid( Panel::Title ) )       { this->_drawTitle(); }
+                if( this->_invalid( Panel::Registers ) )   { this->_drawRegisters(); }
+                if( this->_invalid( Panel::Stack ) )       { this->_drawStack(); }
+                if( this->_invalid( Panel::Disassembly ) ) { this->_drawDisassembly(); }
+                if( this->_invalid( Panel::Memory ) )      { this->_drawMemory(); }
+                if( this->_invalid( Panel::CPUs ) )        { this->_drawCPUs(); }
+                if( this->_invalid( Panel::Stats ) )       { this->_drawStats(); }
+                
+                this->_dirty.reset();
+                this->_arena.reset();
                 
-                if( this->_monitor.live() == false )
+                if( this->_fleet.live() == false || ( this->_signals.has_value() && this->_signals->interrupted() ) )
                 {
-                    this->_monitor.stop();
+                    this->_fleet.stop();
                     Screen::shared().stop();
                 }
             }
@@ -166,9 +479,44 @@ namespace VBox
         (
             [ & ]( int key )
             {
-                if( key == 'q' )
+                if( key == 12 )
+                {
+                    this->_invalidate();
+                    
+                    return;
+                }
+                
+                this->_monitor().wakeUp();
+                
+                this->_invalidate( Panel::Title );
+                this->_invalidate( Panel::Memory );
+                
+                if( this->_searchPrompt.has_value() )
                 {
-                    this->_monitor.stop();
+                    std::string prompt( this->_searchPrompt.value() );
+                    
+                    if( key == 10 || key == 13 )
+                    {
+                        this->_searchPrompt = {};
+                        
+                        this->_search( prompt );
+                    }
+                    else if( key == 27 )
+                    {
+                        this->_searchPrompt = {};
+                    }
+                    else if( key == 127 && prompt.length() > 0 )
+                    {
+                        this->_searchPrompt = prompt.substr( 0, prompt.length() - 1 );
+                    }
+                    else if( key >= 0 && key < 128 && isprint( key ) )
+                    {
+                        this->_searchPrompt = prompt + numeric_cast< char >( key );
+                    }
+                }
+                else if( key == 'q' )
+                {
+                    this->_fleet.stop();
                     Screen::shared().stop();
                 }
                 else if( key == 'm' )
@@ -188,7 +536,16 @@ namespace VBox
                     
                     if( prompt.length() > 0 )
                     {
-                        this->_memoryOffset = String::fromHex< size_t >( prompt );
+                        std::optional< VM::Symbol > symbol( this->_symbols->find( prompt ) );
+                        
+                        if( symbol.has_value() )
+                        {
+                            this->_memoryOffset = numeric_cast< size_t >( symbol->address() );
+                        }
+                        else
+                        {
+                            this->_memoryOffset = String::fromHex< size_t >( prompt );
+                        }
                     }
                     
                     this->_memoryAddressPrompt = {};
@@ -228,94 +585,386 @@ namespace VBox
                     {
                         this->_memoryOffset = 0;
                     }
+                    else if( key == '/' )
+                    {
+                        this->_searchPrompt = "";
+                    }
+                    else if( key == '.' )
+                    {
+                        this->_searchNext();
+                    }
+                    else if( key == ',' )
+                    {
+                        this->_searchPrevious();
+                    }
+                    else if( key == 'v' )
+                    {
+                        this->_diff = ( this->_diff == false );
+                    }
+                    else if( key == 'u' )
+                    {
+                        this->_monitor().refreshMemory();
+                    }
+                    else if( key == 'j' )
+                    {
+                        this->_diffNext();
+                    }
+                    else if( key == 'k' )
+                    {
+                        this->_diffPrevious();
+                    }
+                    else if( key == 'w' )
+                    {
+                        this->_overviewPrevious();
+                    }
+                    else if( key == 'e' )
+                    {
+                        this->_overviewNext();
+                    }
+                    else if( key == 'r' )
+                    {
+                        this->_overviewData();
+                    }
+                    else if( key == 'n' )
+                    {
+                        std::optional< VM::Symbol > symbol( this->_symbols->next( this->_memoryOffset ) );
+                        
+                        if( symbol.has_value() )
+                        {
+                            this->_memoryOffset = numeric_cast< size_t >( symbol->address() );
+                        }
+                    }
+                    else if( key == 'b' )
+                    {
+                        std::optional< VM::Symbol > symbol( this->_symbols->previous( this->_memoryOffset ) );
+                        
+                        if( symbol.has_value() )
+                        {
+                            this->_memoryOffset = numeric_cast< size_t >( symbol->address() );
+                        }
+                    }
                     else if( key == 'p' )
                     {
-                        this->_paused = ( this->_paused ) ? false : true;
+                        if( this->_paused )
+                        {
+                            this->_resume();
+                        }
+                        else
+                        {
+                            this->_pause();
+                        }
+                    }
+                    else if( key == '<' )
+                    {
+                        this->_scrub( -1 );
+                    }
+                    else if( key == '>' )
+                    {
+                        this->_scrub( 1 );
+                    }
+                    else if( key == '{' )
+                    {
+                        this->_scrub( -100 );
+                    }
+                    else if( key == '}' )
+                    {
+                        this->_scrub( 100 );
+                    }
+                    else if( key == '(' )
+                    {
+                        if( this->_monitor().seek( -10 ) )
+                        {
+                            this->_resume();
+                        }
+                    }
+                    else if( key == ')' )
+                    {
+                        if( this->_monitor().seek( 10 ) )
+                        {
+                            this->_resume();
+                        }
+                    }
+                    else if( key == ']' )
+                    {
+                        this->_select( ( this->_current + 1 ) % this->_fleet.size() );
+                    }
+                    else if( key == '[' )
+                    {
+                        this->_select( ( this->_current + this->_fleet.size() - 1 ) % this->_fleet.size() );
+                    }
+                    else if( key >= '1' && key <= '9' )
+                    {
+                        this->_select( numeric_cast< size_t >( key - '1' ) );
+                    }
+                    else if( key == 'i' )
+                    {
+                        this->_showStats = ( this->_showStats == false );
+                        
+                        this->_windows.clear();
+                        
+                        Screen::shared().clear();
+                        Screen::shared().refresh();
+                        
+                        this->_invalidate();
+                    }
+                    else if( key == 'c' && this->_cpuCount > 1 )
+                    {
+                        this->_selectCPU( ( this->_monitor().cpu() + 1 ) % this->_cpuCount );
+                    }
+                    else if( key == 'x' && this->_cpuCount > 1 )
+                    {
+                        this->_selectCPU( ( this->_monitor().cpu() + this->_cpuCount - 1 ) % this->_cpuCount );
                     }
                 }
             }
         );
     }
     
-    void UI::IMPL::_drawTitle( void )
+    void UI::IMPL::_invalidate( void )
+    {
+        this->_dirty.set();
+    }
+    
+    void UI::IMPL::_invalidate( Panel panel )
+    {
+        this->_dirty.set( static_cast< size_t >( panel ) );
+    }
+    
+    bool UI::IMPL::_invalid( Panel panel ) const
+    {
+        return this->_dirty.test( static_cast< size_t >( panel ) );
+    }
+    
+    Monitor & UI::IMPL::_monitor( void )
+    {
+        return this->_fleet.monitor( this->_current );
+    }
+    
+    void UI::IMPL::_select( size_t index )
+    {
+        if( index >= this->_fleet.size() || index == this->_current )
+        {
+            return;
+        }
+        
+        this->_current             = index;
+        this->_memoryOffset        = 0;
+        this->_totalMemory         = 0;
+        this->_snapshot            = this->_monitor().snapshot();
+        this->_historyIndex        = {};
+        this->_generation          = {};
+        this->_previousRegisters   = {};
+        this->_symbols             = this->_monitor().symbols();
+        this->_memoryAddressPrompt = {};
+        this->_searchPrompt        = {};
+        this->_searchResults       = nullptr;
+        this->_searchProgress      = 0;
+        this->_space               = VM::AddressSpace();
+        this->_spaceKey            = {};
+        this->_overview            = VM::MemoryOverview();
+        this->_overviewKey         = {};
+        
+        this->_invalidate();
+    }
+    
+    void UI::IMPL::_selectCPU( size_t index )
     {
-        Window win( 0, 0, Screen::shared().width(), 3 );
+        this->_monitor().cpu( index );
         
+        if( this->_paused == false )
         {
-            win.box();
-            win.move( 2, 1 );
-            win.print( "VirtualBox: ");
-            win.print( this->_vmName );
-            
-            if( this->_paused )
-            {
-                win.print( Color::red(), " [PAUSED]" );
-            }
+            this->_previousRegisters = {};
+            this->_snapshot          = this->_monitor().snapshot();
         }
         
-        Screen::shared().refresh();
-        win.refresh();
+        this->_invalidate();
     }
     
-    void UI::IMPL::_drawRegisters( void )
+    size_t UI::IMPL::_memoryWidth( void )
     {
-        if( Screen::shared().width() < 30 || Screen::shared().height() < 25 )
+        if( this->_cpuCount > 1 && Screen::shared().width() >= 60 )
         {
-            return;
+            return Screen::shared().width() - 30;
         }
         
+        return Screen::shared().width();
+    }
+    
+    const VM::AddressSpace & UI::IMPL::_addressSpace( void )
+    {
+        const std::optional< VM::Registers > & regs( this->_snapshot->registers() );
+        std::array< uint64_t, 5 >              key { this->_snapshot->dumpSequence(), 0, 0, 0, 0 };
+        
+        if( regs.has_value() )
         {
-            Window win( 0, 3, 30, 22 );
-            
-            {
-                win.box();
-                win.move( 2, 1 );
-                win.print( Color::blue(), "CPU Registers:" );
-                win.move( 1, 2 );
-                win.addHorizontalLine( 28 );
-            }
-            
-            {
-                
-                std::optional< VM::Registers > regs( this->_registers );
+            key = { this->_snapshot->dumpSequence(), regs->cr0(), regs->cr3(), regs->cr4(), regs->efer() };
+        }
+        
+        if( key != this->_spaceKey )
+        {
+            this->_space    = VM::AddressSpace( this->_snapshot->dump(), regs.value_or( VM::Registers() ) );
+            this->_spaceKey = key;
+        }
+        
+        return this->_space;
+    }
+    
+    Window & UI::IMPL::_window( Panel panel, size_t x, size_t y, size_t width, size_t height )
+    {
+        std::unique_ptr< Window > & win( this->_windows[ panel ] );
+        
+        if( win == nullptr )
+        {
+            win = std::make_unique< Window >( x, y, width, height );
+        }
+        
+        win->erase();
+        
+        return *( win );
+    }
+    
+    void UI::IMPL::_drawTitle( void )
+    {
+        Stats::Timer timer( "UI::drawTitle" );
+        
+        Window & win( this->_window( Panel::Title, 0, 0, Screen::shared().width(), 3 ) );
+        
+        {
+            win.box();
+            win.move( 2, 1 );
+            win.print( "VirtualBox:" );
+            
+            {
+                const std::vector< std::string > & vmNames( this->_fleet.vmNames() );
                 
-                if( regs.has_value() )
+                for( size_t i = 0; i < vmNames.size(); i++ )
                 {
-                    size_t y( 3 );
+                    const Color * color( &Color::clear() );
                     
-                    for( const auto & p: regs.value().all() )
+                    if( this->_fleet.monitor( i ).live() == false )
                     {
-                        std::string reg( String::toUpper( p.first ) );
-                        
-                        for( size_t i = reg.size(); i < 6; i++ )
-                        {
-                            reg = " " + reg;
-                        }
-                        
-                        win.move( 2, y );
-                        win.print( Color::cyan(), reg );
-                        win.print( ": " );
-                        win.print( Color::yellow(), String::toHex( p.second ) );
+                        color = &Color::red();
+                    }
+                    else if( vmNames.size() > 1 && i == this->_current )
+                    {
+                        color = &Color::green();
+                    }
+                    
+                    win.print( " " );
+                    
+                    if( vmNames.size() > 1 )
+                    {
+                        win.print( *( color ), "[%zu] ", i + 1 );
+                    }
+                    
+                    win.print( *( color ), vmNames[ i ] );
+                }
+            }
+            
+            if( this->_snapshot->timeouts() > 0 )
+            {
+                win.print( Color::yellow(), " [TIMEOUTS: %llu]", static_cast< unsigned long long >( this->_snapshot->timeouts() ) );
+            }
+            
+            if( this->_cpuCount > 1 )
+            {
+                win.print( Color::green(), " [CPU %zu/%zu]", this->_monitor().cpu() + 1, this->_cpuCount );
+            }
+            
+            if( this->_monitor().recording() )
+            {
+                win.print( Color::red(), " [REC]" );
+            }
+            
+            if( this->_paused )
+            {
+                win.print( Color::red(), " [PAUSED]" );
+            }
+            
+            if( this->_trigger.has_value() )
+            {
+                win.print( Color::red(), " [TRIGGER: %s]", this->_trigger->c_str() );
+            }
+            
+            if( this->_historyIndex.has_value() )
+            {
+                Monitor                   & monitor( this->_monitor() );
+                std::optional< VM::Sample > sample( monitor.sample( this->_historyIndex.value() ) );
+                
+                if( sample.has_value() )
+                {
+                    std::chrono::duration< double > age( std::chrono::system_clock::now() - sample->timestamp() );
+                    
+                    win.print
+                    (
+                        Color::yellow(),
+                        " [HISTORY %zu/%zu, %.3fs ago]",
+                        numeric_cast< size_t >( this->_historyIndex.value() - monitor.historyBegin() + 1 ),
+                        numeric_cast< size_t >( monitor.historyEnd() - monitor.historyBegin() ),
+                        age.count()
+                    );
+                }
+            }
+        }
+        
+        win.stage();
+    }
+    
+    void UI::IMPL::_drawRegisters( void )
+    {
+        Stats::Timer timer( "UI::drawRegisters" );
+        
+        if( Screen::shared().width() < 30 || Screen::shared().height() < 25 )
+        {
+            return;
+        }
+        
+        {
+            Window & win( this->_window( Panel::Registers, 0, 3, 30, 22 ) );
+            
+            {
+                win.box();
+                win.move( 2, 1 );
+                win.print( Color::blue(), "CPU Registers:" );
+                win.move( 1, 2 );
+                win.addHorizontalLine( 28 );
+            }
+            
+            {
+                
+                const std::optional< VM::Registers > & regs( this->_snapshot->registers() );
+                
+                if( regs.has_value() )
+                {
+                    for( size_t i = 0; i < VM::Registers::GeneralCount; i++ )
+                    {
+                        uint64_t         value( regs->valueAt( i ) );
+                        bool             changed( this->_previousRegisters.has_value() && this->_previousRegisters->valueAt( i ) != value );
+                        std::string_view label( VM::Registers::labelAt( i ) );
                         
-                        y++;
+                        win.move( 2, 3 + i );
+                        win.write( Color::cyan(), label.data(), label.size() );
+                        win.write( ": ", 2 );
+                        printHex( win, ( changed ) ? Color::red() : Color::yellow(), value );
                     }
                 }
             }
             
-            Screen::shared().refresh();
-            win.refresh();
+            win.stage();
         }
     }
     
     void UI::IMPL::_drawStack( void )
     {
+        Stats::Timer timer( "UI::drawStack" );
+        
         if( Screen::shared().width() < 180 || Screen::shared().height() < 25 )
         {
             return;
         }
         
         {
-            Window win( 30, 3, 150, 22 );
+            Window & win( this->_window( Panel::Stack, 30, 3, 150, 22 ) );
             
             {
                 win.box();
@@ -326,29 +975,57 @@ namespace VBox
             }
             
             {
+                const std::vector< VM::StackEntry > & stack( this->_snapshot->stack() );
+                size_t                                y( 5 );
+                bool                                  wide( false );
+                
+                for( const auto & entry: stack )
+                {
+                    if( std::max( { entry.bp().address(), entry.retIP().address(), entry.ip().address(), entry.arg0(), entry.arg1(), entry.arg2(), entry.arg3() } ) > 0xFFFFFFFF )
+                    {
+                        wide = true;
+                    }
+                }
+                
                 win.move( 2, 3 );
-                win.print( Color::blue(), "SS:BP:                " );
-                win.print( "| " );
-                win.print( Color::blue(), "Ret SS:BP:            " );
-                win.print( "| " );
-                win.print( Color::blue(), "Ret CS:EIP:           " );
-                win.print( "| " );
-                win.print( Color::blue(), "Arg 0:     " );
-                win.print( "| " );
-                win.print( Color::blue(), "Arg 1:     " );
-                win.print( "| " );
-                win.print( Color::blue(), "Arg 2:     " );
-                win.print( "| " );
-                win.print( Color::blue(), "Arg 3:     " );
-                win.print( "| " );
-                win.print( Color::blue(), "CS:EIP:" );
+                
+                if( wide )
+                {
+                    win.print( Color::blue(), "RBP:               " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "Ret RIP:           " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "Arg 0:             " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "Arg 1:             " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "Arg 2:             " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "Arg 3:             " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "RIP:" );
+                }
+                else
+                {
+                    win.print( Color::blue(), "SS:BP:                " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "Ret SS:BP:            " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "Ret CS:EIP:           " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "Arg 0:     " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "Arg 1:     " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "Arg 2:     " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "Arg 3:     " );
+                    win.print( "| " );
+                    win.print( Color::blue(), "CS:EIP:" );
+                }
+                
                 win.move( 1, 4 );
                 win.addHorizontalLine( 148 );
-            }
-            
-            {
-                std::vector< VM::StackEntry > stack( this->_stack );
-                size_t                        y( 5 );
                 
                 for( size_t i = 0; i < stack.size(); i++ )
                 {
@@ -359,52 +1036,72 @@ namespace VBox
                     
                     win.move( 2, y );
                     
-                    win.print( Color::cyan(), String::toHex( stack[ i ].bp().segment() ) );
-                    win.print( ":" );
-                    win.print( Color::yellow(), String::toHex( stack[ i ].bp().address() ) );
-                    win.print( " | " );
-                    
-                    win.print( Color::cyan(), String::toHex( stack[ i ].retBP().segment() ) );
-                    win.print( ":" );
-                    win.print( Color::yellow(), String::toHex( stack[ i ].retBP().address() ) );
-                    win.print( " | " );
-                    
-                    win.print( Color::cyan(), String::toHex( stack[ i ].retIP().segment() ) );
-                    win.print( ":" );
-                    win.print( Color::yellow(), String::toHex( stack[ i ].retIP().address() ) );
-                    win.print( " | " );
-                    
-                    win.print( Color::yellow(), String::toHex( stack[ i ].arg0() ) );
-                    win.print( " | " );
-                    win.print( Color::yellow(), String::toHex( stack[ i ].arg1() ) );
-                    win.print( " | " );
-                    win.print( Color::yellow(), String::toHex( stack[ i ].arg2() ) );
-                    win.print( " | " );
-                    win.print( Color::yellow(), String::toHex( stack[ i ].arg3() ) );
-                    win.print( " | " );
-                    
-                    win.print( Color::cyan(), String::toHex( stack[ i ].ip().segment() ) );
-                    win.print( ":" );
-                    win.print( Color::yellow(), String::toHex( stack[ i ].ip().address() ) );
+                    if( wide )
+                    {
+                        printHex( win, Color::yellow(), stack[ i ].bp().address() );
+                        win.print( " | " );
+                        printHex( win, Color::yellow(), stack[ i ].retIP().address() );
+                        win.print( " | " );
+                        printHex( win, Color::yellow(), stack[ i ].arg0() );
+                        win.print( " | " );
+                        printHex( win, Color::yellow(), stack[ i ].arg1() );
+                        win.print( " | " );
+                        printHex( win, Color::yellow(), stack[ i ].arg2() );
+                        win.print( " | " );
+                        printHex( win, Color::yellow(), stack[ i ].arg3() );
+                        win.print( " | " );
+                        printHex( win, Color::yellow(), stack[ i ].ip().address() );
+                    }
+                    else
+                    {
+                        printHex( win, Color::cyan(), stack[ i ].bp().segment() );
+                        win.print( ":" );
+                        printHex( win, Color::yellow(), static_cast< uint32_t >( stack[ i ].bp().address() ) );
+                        win.print( " | " );
+                        
+                        printHex( win, Color::cyan(), stack[ i ].retBP().segment() );
+                        win.print( ":" );
+                        printHex( win, Color::yellow(), static_cast< uint32_t >( stack[ i ].retBP().address() ) );
+                        win.print( " | " );
+                        
+                        printHex( win, Color::cyan(), stack[ i ].retIP().segment() );
+                        win.print( ":" );
+                        printHex( win, Color::yellow(), static_cast< uint32_t >( stack[ i ].retIP().address() ) );
+                        win.print( " | " );
+                        
+                        printHex( win, Color::yellow(), static_cast< uint32_t >( stack[ i ].arg0() ) );
+                        win.print( " | " );
+                        printHex( win, Color::yellow(), static_cast< uint32_t >( stack[ i ].arg1() ) );
+                        win.print( " | " );
+                        printHex( win, Color::yellow(), static_cast< uint32_t >( stack[ i ].arg2() ) );
+                        win.print( " | " );
+                        printHex( win, Color::yellow(), static_cast< uint32_t >( stack[ i ].arg3() ) );
+                        win.print( " | " );
+                        
+                        printHex( win, Color::cyan(), stack[ i ].ip().segment() );
+                        win.print( ":" );
+                        printHex( win, Color::yellow(), static_cast< uint32_t >( stack[ i ].ip().address() ) );
+                    }
                     
                     y++;
                 }
             }
             
-            Screen::shared().refresh();
-            win.refresh();
+            win.stage();
         }
     }
     
     void UI::IMPL::_drawDisassembly( void )
     {
+        Stats::Timer timer( "UI::drawDisassembly" );
+        
         if( Screen::shared().width() < 220 || Screen::shared().height() < 25 )
         {
             return;
         }
         
         {
-            Window win( 180, 3, Screen::shared().width() - 180, 22 );
+            Window & win( this->_window( Panel::Disassembly, 180, 3, Screen::shared().width() - 180, 22 ) );
             
             {
                 win.box();
@@ -414,58 +1111,127 @@ namespace VBox
                 win.addHorizontalLine( Screen::shared().width() - 182 );
             }
             
+            if( this->_snapshot->registers().has_value() )
+            {
+                std::optional< uint64_t > physical( this->_addressSpace().translate( this->_snapshot->registers()->rip() ) );
+                
+                if( physical.has_value() )
+                {
+                    std::string_view symbol( this->_symbols->describe( physical.value(), this->_arena ) );
+                    
+                    win.move( 15, 1 );
+                    win.write( Color::magenta(), symbol.data(), symbol.size() );
+                }
+            }
+            
             {
-                std::shared_ptr< VM::CoreDump > dump( this->_dump );
-                std::optional< VM::Registers >  regs( this->_registers );
+                std::shared_ptr< VM::CoreDump >        dump( this->_snapshot->dump() );
+                const std::optional< VM::Registers > & regs( this->_snapshot->registers() );
                 
-                if( dump != nullptr && dump->memorySize() > 0 && regs.has_value() )
+                if( dump != nullptr && regs.has_value() && this->_addressSpace().translate( regs.value().rip() ).has_value() )
                 {
-                    std::vector< uint8_t > code( dump->readMemory( regs.value().rip(), 512 ) );
+                    uint64_t  rip(   regs.value().rip() );
+                    uint64_t  start( ( rip > 64 ) ? rip - 64 : 0 );
+                    uint8_t * code(  static_cast< uint8_t * >( this->_arena.allocate( 576, 1 ) ) );
+                    size_t    size(  this->_addressSpace().readVirtual( start, code, 576 ) );
+                    size_t    y( 2 );
+                    
+                    if( size <= rip - start )
+                    {
+                        start = rip;
+                        size  = this->_addressSpace().readVirtual( start, code, 512 );
+                    }
                     
-                    if( code.size() > 0 )
+                    for( const auto & i: *( this->_disassembler.disassembleAround( code, size, start, rip, 4, 13 ) ) )
                     {
-                        size_t y( 2 );
+                        if( y > 19 )
+                        {
+                            break;
+                        }
+                        
+                        win.move( 2, ++y );
+                        printHex( win, ( i.address() == rip ) ? Color::red() : Color::cyan(), i.address() );
+                        win.print( ": " );
+                        win.write( Color::yellow(), i.mnemonic().data(), i.mnemonic().length() );
+                        win.write( " ", 1 );
+                        win.write( Color::yellow(), i.operands().data(), i.operands().length() );
                         
-                        for( const auto & p: Capstone::disassemble( code, regs.value().rip() ) )
                         {
-                            if( y > 19 )
+                            Tokenizer operands( i.operands() );
+                            uint64_t  target( 0 );
+                            
+                            if( i.mnemonic().substr( 0, 1 ) == "j" || i.mnemonic() == "call" )
                             {
-                                break;
+                                std::optional< uint64_t > physical;
+                                
+                                if( operands.expect( "0x" ) && operands.hex( target ) && operands.atEnd() && ( physical = this->_addressSpace().translate( target ) ).has_value() )
+                                {
+                                    std::string_view symbol( this->_symbols->describe( physical.value(), this->_arena ) );
+                                    
+                                    if( symbol.length() > 0 )
+                                    {
+                                        win.write( Color::magenta(), " <", 2 );
+                                        win.write( Color::magenta(), symbol.data(), symbol.size() );
+                                        win.write( Color::magenta(), ">", 1 );
+                                    }
+                                }
                             }
-                            
-                            win.move( 2, ++y );
-                            win.print( Color::cyan(), p.first );
-                            win.print( ": " );
-                            win.print( Color::yellow(), p.second );
                         }
                     }
                 }
             }
             
-            Screen::shared().refresh();
-            win.refresh();
+            win.stage();
         }
     }
     
     void UI::IMPL::_drawMemory( void )
     {
+        Stats::Timer timer( "UI::drawMemory" );
+        
         if( Screen::shared().width() < 30 || Screen::shared().height() < 35 )
         {
             return;
         }
         
         {
-            Window win( 0, 25, Screen::shared().width(), Screen::shared().height() - 25 );
+            Window & win( this->_window( Panel::Memory, 0, 25, this->_memoryWidth(), Screen::shared().height() - 25 ) );
             
             {
+                std::string_view symbol( this->_symbols->describe( this->_memoryOffset, this->_arena ) );
+                
                 win.box();
                 win.move( 2, 1 );
                 win.print( Color::blue(), "Memory:" );
+                win.move( 10, 1 );
+                win.write( Color::magenta(), symbol.data(), symbol.size() );
                 win.move( 1, 2 );
-                win.addHorizontalLine( Screen::shared().width() - 2 );
+                win.addHorizontalLine( this->_memoryWidth() - 2 );
             }
             
-            if( this->_memoryAddressPrompt.has_value() )
+            if( this->_searchResults != nullptr )
+            {
+                this->_searchProgress = this->_searchResults->progress();
+                
+                win.move( 40, 1 );
+                win.print
+                (
+                    Color::magenta(),
+                    "Search: %zu%s hits (%d%%)",
+                    this->_searchResults->count(),
+                    ( this->_searchResults->truncated() ) ? "+" : "",
+                    static_cast< int >( this->_searchProgress * 100 )
+                );
+            }
+            
+            if( this->_searchPrompt.has_value() )
+            {
+                win.move( 2, 3 );
+                win.print( Color::cyan(), "Search for hex bytes, \"ASCII\", u\"UTF-16\", d:DWORD or q:QWORD:" );
+                win.move( 2, 4 );
+                win.print( Color::yellow(), this->_searchPrompt.value() );
+            }
+            else if( this->_memoryAddressPrompt.has_value() )
             {
                 win.move( 2, 3 );
                 win.print( Color::cyan(), "Enter a memory address:" );
@@ -474,12 +1240,12 @@ namespace VBox
             }
             else
             {
-                std::shared_ptr< VM::CoreDump > dump( this->_dump );
+                std::shared_ptr< VM::CoreDump > dump( this->_snapshot->dump() );
                 
                 if( dump != nullptr && dump->memorySize() > 0 )
                 {
                     size_t y( 2 );
-                    size_t cols(  Screen::shared().width()  - 4 );
+                    size_t cols(  this->_memoryWidth()      - 8 );
                     size_t lines( Screen::shared().height() - 29 );
                     
                     this->_totalMemory        = dump->memorySize();
@@ -487,53 +1253,273 @@ namespace VBox
                     this->_memoryLines        = lines;
                     
                     {
-                        size_t                 size(  this->_memoryBytesPerLine * lines );
-                        size_t                 offset( this->_memoryOffset );
-                        std::vector< uint8_t > mem(   dump->readMemory( offset, size ) );
+                        size_t                    offset(  this->_memoryOffset );
+                        size_t                    size(    ( offset < this->_totalMemory ) ? std::min( this->_memoryBytesPerLine * lines, this->_totalMemory - offset ) : 0 );
+                        VM::MemoryView            mem(     this->_memoryView( *( dump ), offset, size ) );
+                        Arena::Vector< char >     line(    this->_memoryBytesPerLine * 4 + 2, 0, Arena::Allocator< char >( this->_arena ) );
+                        Arena::Vector< uint64_t > changes( Arena::Allocator< uint64_t >( this->_arena ) );
+                        size_t                    changed( 0 );
+                        char                      address[ 18 ];
                         
-                        for( size_t i = 0; i < mem.size(); i++ )
+                        if( this->_diff )
                         {
-                            if( i % this->_memoryBytesPerLine == 0 )
+                            changes = this->_memoryDiff( mem, offset );
+                            
+                            for( uint64_t bits: changes )
                             {
-                                win.move( 2, ++y );
-                                win.print( Color::yellow(), "%016X: ", offset );
-                                
-                                offset += this->_memoryBytesPerLine;
+                                changed += numeric_cast< size_t >( __builtin_popcountll( bits ) );
                             }
                             
-                            win.print( Color::cyan(), "%02X ", numeric_cast< int >( mem[ i ] ) );
+                            win.move( 70, 1 );
+                            win.print( Color::red(), "Diff: %zu bytes changed", changed );
                         }
                         
-                        y = 2;
+                        for( size_t i = 0; i < mem.size(); i += this->_memoryBytesPerLine )
+                        {
+                            size_t n( String::hexdumpLine( mem.data() + i, mem.size() - i, this->_memoryBytesPerLine, line.data() ) );
+                            
+                            String::toHex( numeric_cast< uint64_t >( offset + i ), address );
+                            
+                            address[ 16 ] = ':';
+                            address[ 17 ] = ' ';
+                            
+                            win.move( 2, ++y );
+                            win.write( Color::yellow(), address, sizeof( address ) );
+                            win.write( Color::cyan(), line.data(), n );
+                            
+                            for( size_t j = i; j < i + this->_memoryBytesPerLine && j < mem.size() && changes.empty() == false; j++ )
+                            {
+                                if( ( changes[ j / 64 ] & ( uint64_t( 1 ) << ( j % 64 ) ) ) == 0 )
+                                {
+                                    continue;
+                                }
+                                
+                                win.move( 2 + sizeof( address ) + ( j - i ) * 3, y );
+                                win.write( Color::red(), line.data() + ( j - i ) * 3, 2 );
+                                win.move( 2 + sizeof( address ) + this->_memoryBytesPerLine * 3 + 2 + ( j - i ), y );
+                                win.write( Color::red(), line.data() + this->_memoryBytesPerLine * 3 + 2 + ( j - i ), 1 );
+                            }
+                        }
                         
-                        win.move( ( this->_memoryBytesPerLine * 3 ) + 4 + 16, y + 1 );
+                        win.move( ( this->_memoryBytesPerLine * 3 ) + 4 + 16, 3 );
                         win.addVerticalLine( lines );
+                    }
+                    
+                    {
+                        const VM::MemoryOverview & overview( this->_memoryOverview( lines ) );
+                        size_t                     first(    overview.cell( this->_memoryOffset ) );
+                        size_t                     last(     overview.cell( this->_memoryOffset + this->_memoryBytesPerLine * lines - 1 ) );
                         
-                        for( size_t i = 0; i < mem.size(); i++ )
+                        for( size_t i = 0; i < overview.size(); i++ )
                         {
-                            char c = static_cast< char >( mem[ i ] );
+                            VM::MemoryOverview::Content content( overview.content( i ) );
                             
-                            if( i % this->_memoryBytesPerLine == 0 )
+                            if( i >= first && i <= last )
                             {
-                                win.move( ( this->_memoryBytesPerLine * 3 ) + 4 + 18, ++y );
+                                win.move( this->_memoryWidth() - 4, i + 3 );
+                                win.print( Color::green(), ">" );
                             }
                             
-                            if( isprint( c ) == false || isspace( c ) )
+                            if( content == VM::MemoryOverview::Content::Unmapped )
                             {
-                                win.print( Color::blue(), "." );
+                                continue;
+                            }
+                            
+                            win.move( this->_memoryWidth() - 3, i + 3 );
+                            
+                            if( overview.changes( i ) > 0 )
+                            {
+                                win.print( Color::red(), ( content == VM::MemoryOverview::Content::Data ) ? "#" : "." );
+                            }
+                            else if( overview.heat( i ) > 0 )
+                            {
+                                win.print( Color::yellow(), ( content == VM::MemoryOverview::Content::Data ) ? "#" : "." );
+                            }
+                            else if( content == VM::MemoryOverview::Content::Data )
+                            {
+                                win.print( Color::cyan(), "#" );
                             }
                             else
                             {
-                                win.print( "%c", c );
+                                win.print( Color::blue(), "." );
                             }
                         }
                     }
                 }
             }
             
-            Screen::shared().refresh();
-            win.refresh();
+            win.stage();
+        }
+    }
+    
+    void UI::IMPL::_drawCPUs( void )
+    {
+        Stats::Timer timer( "UI::drawCPUs" );
+        
+        if( this->_cpuCount < 2 || Screen::shared().width() < 60 || Screen::shared().height() < 35 )
+        {
+            return;
+        }
+        
+        {
+            Window                       & win( this->_window( Panel::CPUs, Screen::shared().width() - 30, 25, 30, Screen::shared().height() - 25 ) );
+            size_t                         lines( Screen::shared().height() - 29 );
+            Arena::Vector< VM::Registers > cpus( std::min( this->_cpuCount, lines ), VM::Registers(), Arena::Allocator< VM::Registers >( this->_arena ) );
+            size_t                         current( this->_monitor().cpu() );
+            
+            cpus.resize( this->_monitor().cpuRegisters( cpus.data(), cpus.size() ) );
+            
+            {
+                win.box();
+                win.move( 2, 1 );
+                win.print( Color::blue(), "vCPUs:" );
+                win.move( 1, 2 );
+                win.addHorizontalLine( 28 );
+            }
+            
+            for( size_t i = 0; i < cpus.size() && i < lines; i++ )
+            {
+                win.move( 2, i + 3 );
+                win.print( ( i == current ) ? Color::green() : Color::cyan(), "#%-3zu", i + 1 );
+                win.print( "RIP: " );
+                printHex( win, ( i == current ) ? Color::green() : Color::yellow(), cpus[ i ].rip() );
+            }
+            
+            win.stage();
+        }
+    }
+    
+    void UI::IMPL::_drawStats( void )
+    {
+        if( this->_showStats == false || Screen::shared().width() < 100 || Screen::shared().height() < 35 )
+        {
+            return;
+        }
+        
+        {
+            Window                           & win( this->_window( Panel::Stats, 0, 25, 100, Screen::shared().height() - 25 ) );
+            std::map< std::string, Histogram > histograms( Stats::shared().histograms() );
+            size_t                             lines( Screen::shared().height() - 29 );
+            size_t                             y( 3 );
+            
+            {
+                win.box();
+                win.move( 2, 1 );
+                win.print( Color::blue(), "Instrumentation (us):" );
+                win.move( 1, 2 );
+                win.addHorizontalLine( 98 );
+            }
+            
+            win.move( 2, y++ );
+            win.print( Color::cyan(), "%-36s %10s %9s %9s %9s %9s %9s", "Timer", "Count", "Mean", "P50", "P90", "P99", "Max" );
+            
+            for( const auto & p: histograms )
+            {
+                if( y - 3 >= lines )
+                {
+                    break;
+                }
+                
+                win.move( 2, y++ );
+                win.print( Color::magenta(), "%-36.36s ", p.first.c_str() );
+                win.print
+                (
+                    Color::yellow(),
+                    "%10s %9.1f %9.1f %9.1f %9.1f %9.1f",
+                    std::to_string( p.second.count() ).c_str(),
+                    p.second.mean() / 1000.0,
+                    static_cast< double >( p.second.percentile( 50 ) ) / 1000.0,
+                    static_cast< double >( p.second.percentile( 90 ) ) / 1000.0,
+                    static_cast< double >( p.second.percentile( 99 ) ) / 1000.0,
+                    static_cast< double >( p.second.max() )            / 1000.0
+                );
+            }
+            
+            win.stage();
+        }
+    }
+    
+    VM::MemoryView UI::IMPL::_memoryView( const VM::CoreDump & dump, size_t offset, size_t size )
+    {
+        std::shared_ptr< const VM::MemoryHistory > history( this->_monitor().memoryHistory() );
+        std::optional< uint64_t >                  generation( this->_memoryGeneration() );
+        
+        if( generation.has_value() && generation.value() + 1 < history->end() )
+        {
+            return history->memoryView( generation.value(), offset, size, this->_arena );
+        }
+        
+        return dump.memoryView( offset, size, this->_arena );
+    }
+    
+    std::optional< uint64_t > UI::IMPL::_memoryGeneration( void )
+    {
+        Monitor                                  & monitor( this->_monitor() );
+        std::shared_ptr< const VM::MemoryHistory > history( monitor.memoryHistory() );
+        uint64_t                                   end( history->end() );
+        
+        if( history->begin() == end )
+        {
+            return {};
+        }
+        
+        if( this->_historyIndex.has_value() )
+        {
+            std::optional< VM::Sample > sample( monitor.sample( this->_historyIndex.value() ) );
+            
+            if( sample.has_value() )
+            {
+                std::optional< uint64_t > generation( history->generation( sample->timestamp() ) );
+                
+                if( generation.has_value() && generation.value() + 1 < end )
+                {
+                    return generation;
+                }
+            }
+        }
+        
+        return end - 1;
+    }
+    
+    const VM::MemoryOverview & UI::IMPL::_memoryOverview( size_t cells )
+    {
+        std::shared_ptr< VM::CoreDump >            dump(       this->_snapshot->dump() );
+        std::shared_ptr< const VM::MemoryHistory > history(    this->_monitor().memoryHistory() );
+        std::optional< uint64_t >                  generation( this->_memoryGeneration() );
+        std::array< uint64_t, 3 >                  key { this->_snapshot->dumpSequence(), generation.value_or( UINT64_MAX ), cells };
+        
+        if( dump == nullptr )
+        {
+            this->_overview    = VM::MemoryOverview();
+            this->_overviewKey = {};
+        }
+        else if( key != this->_overviewKey )
+        {
+            Stats::Timer timer( "UI::memoryOverview" );
+            
+            this->_overview.update( *( dump ), *( history ), generation, cells );
+            
+            this->_overviewKey = key;
+        }
+        
+        return this->_overview;
+    }
+    
+    Arena::Vector< uint64_t > UI::IMPL::_memoryDiff( const VM::MemoryView & mem, size_t offset )
+    {
+        std::shared_ptr< const VM::MemoryHistory > history( this->_monitor().memoryHistory() );
+        std::optional< uint64_t >                  generation( this->_memoryGeneration() );
+        Arena::Vector< uint64_t >                  bits( Arena::Allocator< uint64_t >( this->_arena ) );
+        
+        if( generation.has_value() == false || generation.value() == history->begin() )
+        {
+            return bits;
         }
+        
+        bits.resize( ( mem.size() + 63 ) / 64 );
+        mem.diff( history->memoryView( generation.value() - 1, offset, mem.size(), this->_arena ), bits.data() );
+        
+        return bits;
     }
     
     void UI::IMPL::_memoryScrollUp( size_t n )
@@ -565,4 +1551,212 @@ namespace VBox
     {
         this->_memoryScrollDown( this->_memoryLines );
     }
+    
+    void UI::IMPL::_search( const std::string & query )
+    {
+        std::optional< VM::Pattern >    pattern( VM::Pattern::parse( query ) );
+        std::shared_ptr< VM::CoreDump > dump(    this->_snapshot->dump() );
+        
+        this->_searchResults  = nullptr;
+        this->_searchProgress = 0;
+        
+        if( pattern.has_value() == false || dump == nullptr )
+        {
+            return;
+        }
+        
+        this->_searchResults = std::make_shared< VM::Search >( dump, pattern.value() );
+        
+        this->_searchResults->onProgress( []( void ) { Screen::shared().wakeUp(); } );
+        this->_searchResults->start();
+    }
+    
+    void UI::IMPL::_searchNext( void )
+    {
+        if( this->_searchResults == nullptr )
+        {
+            return;
+        }
+        
+        {
+            std::vector< uint64_t > results( this->_searchResults->results() );
+            auto                    i( std::upper_bound( results.begin(), results.end(), this->_memoryOffset ) );
+            
+            if( i != results.end() )
+            {
+                this->_memoryOffset = numeric_cast< size_t >( *( i ) );
+            }
+        }
+    }
+    
+    void UI::IMPL::_searchPrevious( void )
+    {
+        if( this->_searchResults == nullptr )
+        {
+            return;
+        }
+        
+        {
+            std::vector< uint64_t > results( this->_searchResults->results() );
+            auto                    i( std::lower_bound( results.begin(), results.end(), this->_memoryOffset ) );
+            
+            if( i != results.begin() )
+            {
+                this->_memoryOffset = numeric_cast< size_t >( *( i - 1 ) );
+            }
+        }
+    }
+    
+    void UI::IMPL::_diffNext( void )
+    {
+        std::shared_ptr< const VM::MemoryHistory > history( this->_monitor().memoryHistory() );
+        std::optional< uint64_t >                  generation( this->_memoryGeneration() );
+        uint64_t                                   pageSize( VM::MemoryCache::pageSize() );
+        
+        if( generation.has_value() == false )
+        {
+            return;
+        }
+        
+        {
+            std::vector< uint64_t > pages( history->changedPages( generation.value() ) );
+            auto                    i( std::upper_bound( pages.begin(), pages.end(), this->_memoryOffset / pageSize ) );
+            
+            if( i != pages.end() )
+            {
+                this->_memoryOffset = numeric_cast< size_t >( *( i ) * pageSize );
+            }
+        }
+    }
+    
+    void UI::IMPL::_diffPrevious( void )
+    {
+        std::shared_ptr< const VM::MemoryHistory > history( this->_monitor().memoryHistory() );
+        std::optional< uint64_t >                  generation( this->_memoryGeneration() );
+        uint64_t                                   pageSize( VM::MemoryCache::pageSize() );
+        
+        if( generation.has_value() == false )
+        {
+            return;
+        }
+        
+        {
+            std::vector< uint64_t > pages( history->changedPages( generation.value() ) );
+            auto                    i( std::lower_bound( pages.begin(), pages.end(), ( this->_memoryOffset + pageSize - 1 ) / pageSize ) );
+            
+            if( i != pages.begin() )
+            {
+                this->_memoryOffset = numeric_cast< size_t >( *( i - 1 ) * pageSize );
+            }
+        }
+    }
+    
+    void UI::IMPL::_overviewNext( void )
+    {
+        size_t cell( this->_overview.cell( this->_memoryOffset ) );
+        
+        if( cell + 1 < this->_overview.size() )
+        {
+            this->_memoryOffset = numeric_cast< size_t >( this->_overview.address( cell + 1 ) );
+        }
+    }
+    
+    void UI::IMPL::_overviewPrevious( void )
+    {
+        size_t cell( this->_overview.cell( this->_memoryOffset ) );
+        
+        if( this->_overview.size() == 0 )
+        {
+            return;
+        }
+        
+        if( this->_memoryOffset > this->_overview.address( cell ) )
+        {
+            this->_memoryOffset = numeric_cast< size_t >( this->_overview.address( cell ) );
+        }
+        else if( cell > 0 )
+        {
+            this->_memoryOffset = numeric_cast< size_t >( this->_overview.address( cell - 1 ) );
+        }
+    }
+    
+    void UI::IMPL::_overviewData( void )
+    {
+        size_t cell( this->_overview.cell( this->_memoryOffset ) );
+        
+        for( size_t i = cell + 1; i < this->_overview.size(); i++ )
+        {
+            if( this->_overview.content( i ) == VM::MemoryOverview::Content::Data && this->_overview.content( i - 1 ) != VM::MemoryOverview::Content::Data )
+            {
+                this->_memoryOffset = numeric_cast< size_t >( this->_overview.address( i ) );
+                
+                return;
+            }
+        }
+    }
+    
+    void UI::IMPL::_pause( void )
+    {
+        this->_paused = true;
+    }
+    
+    void UI::IMPL::_resume( void )
+    {
+        this->_paused            = false;
+        this->_historyIndex      = {};
+        this->_generation        = {};
+        this->_previousRegisters = {};
+        this->_trigger           = {};
+        this->_snapshot          = this->_monitor().snapshot();
+        
+        this->_invalidate();
+    }
+    
+    void UI::IMPL::_scrub( int64_t delta )
+    {
+        Monitor                   & monitor( this->_monitor() );
+        uint64_t                    begin( monitor.historyBegin() );
+        uint64_t                    end( monitor.historyEnd() );
+        uint64_t                    index;
+        std::optional< VM::Sample > sample;
+        std::optional< VM::Sample > previous;
+        
+        if( begin == end )
+        {
+            return;
+        }
+        
+        this->_pause();
+        
+        index = std::max( this->_historyIndex.value_or( end - 1 ), begin );
+        
+        if( delta < 0 )
+        {
+            index -= std::min( index - begin, numeric_cast< uint64_t >( -delta ) );
+        }
+        else
+        {
+            index += std::min( end - 1 - index, numeric_cast< uint64_t >( delta ) );
+        }
+        
+        sample = monitor.sample( index );
+        
+        if( sample.has_value() == false )
+        {
+            return;
+        }
+        
+        if( index > begin )
+        {
+            previous = monitor.sample( index - 1 );
+        }
+        
+        this->_historyIndex      = index;
+        this->_previousRegisters = ( previous.has_value() ) ? previous->registers() : std::nullopt;
+        this->_snapshot          = std::make_shared< const VM::Snapshot >( this->_snapshot->withRegisters( sample->registers() ).withStack( sample->stack() ) );
+        
+        this->_invalidate( Panel::Registers );
+        this->_invalidate( Panel::Stack );
+        this->_invalidate( Panel::Disassembly );
+    }
 }
@@ -28,14 +28,23 @@
 #include <string>
 #include <memory>
 #include <algorithm>
+#include <vector>
+#include "VBox/VM/Trigger.hpp"
 
 namespace VBox
 {
+    namespace Manage
+    {
+        class Backend;
+    }
+    
     class UI
     {
         public:
             
             UI( const std::string & vmName );
+            UI( const std::vector< std::string > & vmNames );
+            UI( const std::vector< std::shared_ptr< Manage::Backend > > & backends );
             UI( const UI & o );
             UI( UI && o );
             ~UI( void );
@@ -44,6 +53,13 @@ namespace VBox
             
             void run( void );
             
+            size_t historyCapacity( void ) const;
+            void   historyCapacity( size_t samples );
+            
+            void triggers( const std::vector< VM::Trigger > & triggers );
+            
+            void record( const std::string & directory );
+            
             friend void swap( UI & o1, UI & o2 );
             
         private:
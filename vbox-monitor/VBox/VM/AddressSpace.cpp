@@ -0,0 +1,319 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/AddressSpace.hpp"
+#include <mutex>
+#include <unordered_map>
+
+namespace VBox
+{
+    namespace VM
+    {
+        class AddressSpace::IMPL
+        {
+            public:
+                
+                IMPL( const std::shared_ptr< CoreDump > & dump, const Registers & registers );
+                IMPL( const IMPL & o );
+                
+                static size_t _tlbSize( void );
+                
+                std::optional< uint64_t > _entry( uint64_t address, size_t size ) const;
+                std::optional< uint64_t > _walk( uint64_t address )              const;
+                std::optional< uint64_t > _walkLegacy( uint64_t address )        const;
+                
+                std::shared_ptr< CoreDump >                      _dump;
+                uint64_t                                         _cr3;
+                size_t                                           _levels;
+                bool                                             _pse;
+                mutable std::unordered_map< uint64_t, uint64_t > _tlb;
+                mutable std::mutex                               _mtx;
+        };
+        
+        AddressSpace::AddressSpace( void ):
+            AddressSpace( nullptr, Registers() )
+        {}
+        
+        AddressSpace::AddressSpace( const std::shared_ptr< CoreDump > & dump, const Registers & registers ):
+            impl( std::make_unique< IMPL >( dump, registers ) )
+        {}
+        
+        AddressSpace::AddressSpace( const AddressSpace & o ):
+            impl( std::make_unique< IMPL >( *( o.impl ) ) )
+        {}
+        
+        AddressSpace::AddressSpace( AddressSpace && o ):
+            impl( std::move( o.impl ) )
+        {}
+        
+        AddressSpace::~AddressSpace( void )
+        {}
+        
+        AddressSpace & AddressSpace::operator =( AddressSpace o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        size_t AddressSpace::levels( void ) const
+        {
+            return this->impl->_levels;
+        }
+        
+        std::optional< uint64_t > AddressSpace::translate( uint64_t address ) const
+        {
+            std::optional< uint64_t > page;
+            
+            if( this->impl->_dump == nullptr )
+            {
+                return {};
+            }
+            
+            if( this->impl->_levels == 0 )
+            {
+                return address;
+            }
+            
+            {
+                std::lock_guard< std::mutex > l( this->impl->_mtx );
+                auto                          i( this->impl->_tlb.find( address >> 12 ) );
+                
+                if( i != this->impl->_tlb.end() )
+                {
+                    return i->second | ( address & 0xFFF );
+                }
+            }
+            
+            page = ( this->impl->_levels == 2 ) ? this->impl->_walkLegacy( address & ~0xFFFULL ) : this->impl->_walk( address & ~0xFFFULL );
+            
+            if( page.has_value() == false )
+            {
+                return {};
+            }
+            
+            {
+                std::lock_guard< std::mutex > l( this->impl->_mtx );
+                
+                if( this->impl->_tlb.size() >= IMPL::_tlbSize() )
+                {
+                    this->impl->_tlb.clear();
+                }
+                
+                this->impl->_tlb[ address >> 12 ] = page.value();
+            }
+            
+            return page.value() | ( address & 0xFFF );
+        }
+        
+        size_t AddressSpace::readVirtual( uint64_t address, uint8_t * buffer, size_t size ) const
+        {
+            size_t done( 0 );
+            
+            while( done < size )
+            {
+                std::optional< uint64_t > physical( this->translate( address + done ) );
+                size_t                    n( std::min< size_t >( size - done, 0x1000 - ( ( address + done ) & 0xFFF ) ) );
+                
+                if( physical.has_value() == false || this->impl->_dump->readMemory( physical.value(), buffer + done, n ) != n )
+                {
+                    break;
+                }
+                
+                done += n;
+            }
+            
+            return done;
+        }
+        
+        std::vector< uint8_t > AddressSpace::readVirtual( uint64_t address, size_t size ) const
+        {
+            std::vector< uint8_t > data( size );
+            
+            data.resize( this->readVirtual( address, data.data(), size ) );
+            
+            return data;
+        }
+        
+        void swap( AddressSpace & o1, AddressSpace & o2 )
+        {
+            using std::swap;
+            
+            swap( o1.impl, o2.impl );
+        }
+        
+        AddressSpace::IMPL::IMPL( const std::shared_ptr< CoreDump > & dump, const Registers & registers ):
+            _dump(   dump ),
+            _cr3(    registers.cr3() ),
+            _levels( 0 ),
+            _pse(    ( registers.cr4() & ( 1 << 4 ) ) != 0 )
+        {
+            bool paging( ( registers.cr0() & ( 1ULL << 31 ) ) != 0 );
+            bool pae(    ( registers.cr4() & ( 1 << 5 ) ) != 0 );
+            bool la57(   ( registers.cr4() & ( 1 << 12 ) ) != 0 );
+            bool lma(    ( registers.efer() & ( 1 << 10 ) ) != 0 );
+            
+            if( paging == false )
+            {
+                this->_levels = 0;
+            }
+            else if( lma && pae )
+            {
+                this->_levels = ( la57 ) ? 5 : 4;
+            }
+            else if( pae )
+            {
+                this->_levels = 3;
+            }
+            else
+            {
+                this->_levels = 2;
+            }
+        }
+        
+        AddressSpace::IMPL::IMPL( const IMPL & o ):
+            _dump(   o._dump ),
+            _cr3(    o._cr3 ),
+            _levels( o._levels ),
+            _pse(    o._pse )
+        {
+            std::lock_guard< std::mutex > l( o._mtx );
+            
+            this->_tlb = o._tlb;
+        }
+        
+        size_t AddressSpace::IMPL::_tlbSize( void )
+        {
+            return 4096;
+        }
+        
+        std::optional< uint64_t > AddressSpace::IMPL::_entry( uint64_t address, size_t size ) const
+        {
+            uint64_t entry( 0 );
+            uint8_t  bytes[ sizeof( uint64_t ) ];
+            
+            if( this->_dump->readMemory( address, bytes, size ) != size )
+            {
+                return {};
+            }
+            
+            for( size_t i = size; i > 0; i-- )
+            {
+                entry = ( entry << 8 ) | bytes[ i - 1 ];
+            }
+            
+            if( ( entry & 1 ) == 0 )
+            {
+                return {};
+            }
+            
+            return entry;
+        }
+        
+        std::optional< uint64_t > AddressSpace::IMPL::_walk( uint64_t address ) const
+        {
+            uint64_t mask( 0x000FFFFFFFFFF000ULL );
+            uint64_t table;
+            size_t   level( this->_levels );
+            
+            if( level == 3 )
+            {
+                std::optional< uint64_t > pdpte;
+                
+                if( address > UINT32_MAX || ( pdpte = this->_entry( ( this->_cr3 & 0xFFFFFFE0 ) + ( ( address >> 30 ) & 3 ) * 8, 8 ) ).has_value() == false )
+                {
+                    return {};
+                }
+                
+                table = pdpte.value() & mask;
+                level = 2;
+            }
+            else
+            {
+                size_t bits( 12 + 9 * level );
+                
+                if( static_cast< uint64_t >( static_cast< int64_t >( address << ( 64 - bits ) ) >> ( 64 - bits ) ) != address )
+                {
+                    return {};
+                }
+                
+                table = this->_cr3 & mask;
+            }
+            
+            for( ; level > 0; level-- )
+            {
+                size_t                    shift( 12 + 9 * ( level - 1 ) );
+                std::optional< uint64_t > entry( this->_entry( table + ( ( address >> shift ) & 0x1FF ) * 8, 8 ) );
+                
+                if( entry.has_value() == false )
+                {
+                    return {};
+                }
+                
+                if( level == 1 || ( level <= 3 && ( entry.value() & 0x80 ) != 0 ) )
+                {
+                    uint64_t offset( ( 1ULL << shift ) - 1 );
+                    
+                    return ( entry.value() & mask & ~offset ) | ( address & offset );
+                }
+                
+                table = entry.value() & mask;
+            }
+            
+            return {};
+        }
+        
+        std::optional< uint64_t > AddressSpace::IMPL::_walkLegacy( uint64_t address ) const
+        {
+            std::optional< uint64_t > pde;
+            std::optional< uint64_t > pte;
+            
+            if( address > UINT32_MAX )
+            {
+                return {};
+            }
+            
+            pde = this->_entry( ( this->_cr3 & 0xFFFFF000 ) + ( ( address >> 22 ) & 0x3FF ) * 4, 4 );
+            
+            if( pde.has_value() == false )
+            {
+                return {};
+            }
+            
+            if( this->_pse && ( pde.value() & 0x80 ) != 0 )
+            {
+                return ( pde.value() & 0xFFC00000 ) | ( ( pde.value() & 0x1FE000 ) << 19 ) | ( address & 0x3FFFFF );
+            }
+            
+            pte = this->_entry( ( pde.value() & 0xFFFFF000 ) + ( ( address >> 12 ) & 0x3FF ) * 4, 4 );
+            
+            if( pte.has_value() == false )
+            {
+                return {};
+            }
+            
+            return ( pte.value() & 0xFFFFF000 ) | ( address & 0xFFF );
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_ADDRESS_SPACE_HPP
+#define VBOX_VM_ADDRESS_SPACE_HPP
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <cstdint>
+#include "VBox/VM/CoreDump.hpp"
+#include "VBox/VM/Registers.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        class AddressSpace
+        {
+            public:
+                
+                AddressSpace( void );
+                AddressSpace( const std::shared_ptr< CoreDump > & dump, const Registers & registers );
+                AddressSpace( const AddressSpace & o );
+                AddressSpace( AddressSpace && o );
+                ~AddressSpace( void );
+                
+                AddressSpace & operator =( AddressSpace o );
+                
+                size_t levels( void ) const;
+                
+                std::optional< uint64_t > translate( uint64_t address )                                const;
+                size_t                    readVirtual( uint64_t address, uint8_t * buffer, size_t size ) const;
+                std::vector< uint8_t >    readVirtual( uint64_t address, size_t size )                 const;
+                
+                friend void swap( AddressSpace & o1, AddressSpace & o2 );
+                
+            private:
+                
+                class IMPL;
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_VM_ADDRESS_SPACE_HPP */
@@ -23,10 +23,15 @@
  ******************************************************************************/
 
 #include "VBox/VM/CoreDump.hpp"
-#include "VBox/BinaryFileStream.hpp"
+#include "VBox/BinaryMappedStream.hpp"
 #include "VBox/BinaryDataStream.hpp"
 #include "VBox/ELF/File.hpp"
 #include "VBox/Casts.hpp"
+#include "VBox/Endian.hpp"
+#include "VBox/Stats.hpp"
+#include "VBox/ThreadPool.hpp"
+#include <mutex>
+#include <cstring>
 
 namespace VBox
 {
@@ -36,20 +41,71 @@ namespace VBox
         {
             public:
                 
+                class Segment
+                {
+                    public:
+                        
+                        uint64_t _address;
+                        uint64_t _offset;
+                        uint64_t _size;
+                };
+                
+                class Readahead
+                {
+                    public:
+                        
+                        std::mutex          _mtx;
+                        std::vector< bool > _chunks;
+                        uint64_t            _group;
+                };
+                
                 IMPL( const std::string & path );
+                IMPL( BinaryStream & stream, bool headersOnly );
                 IMPL( const IMPL & o );
                 
-                void _parse( void );
+                static Registers _cpu( const std::vector< uint8_t > & data );
                 
-                std::string      _path;
-                uint64_t         _memorySize;
-                BinaryDataStream _memory;
+                void            _parse( void );
+                const Segment * _segment( uint64_t address )                          const;
+                size_t          _copy( size_t offset, uint8_t * buffer, size_t size ) const;
+                size_t          _read( size_t offset, uint8_t * buffer, size_t size ) const;
+                MemoryView      _view( size_t offset, size_t size, Arena * arena )    const;
+                void            _prefetch( size_t offset, size_t size )               const;
+                
+                std::string                           _path;
+                uint64_t                              _memorySize;
+                uint64_t                              _headerSize;
+                std::vector< Segment >                _segments;
+                std::vector< Registers >              _cpus;
+                std::shared_ptr< BinaryMappedStream > _stream;
+                std::shared_ptr< MemoryCache >        _cache;
+                std::shared_ptr< Readahead >          _readahead;
+        };
+        
+        static const std::string CPUNoteName     = "VBCPU";
+        static const size_t      CPUNoteSize     = 496;
+        static const size_t      CPUSelectorSize = 24;
+        static const uint64_t    MaxHeaderSize   = 16 * 1024 * 1024;
+        static const size_t      ReadaheadSize   = 1024 * 1024;
+        
+        static const std::array< Registers::Segment, 6 > CPUSegments =
+        {
+            Registers::Segment::CS,
+            Registers::Segment::DS,
+            Registers::Segment::ES,
+            Registers::Segment::FS,
+            Registers::Segment::GS,
+            Registers::Segment::SS
         };
         
         CoreDump::CoreDump( const std::string & path ):
             impl( std::make_unique< IMPL >( path ) )
         {}
         
+        CoreDump::CoreDump( BinaryStream & stream, bool headersOnly ):
+            impl( std::make_unique< IMPL >( stream, headersOnly ) )
+        {}
+        
         CoreDump::CoreDump( const CoreDump & o ):
             impl( std::make_unique< IMPL >( *( o.impl ) ) )
         {}
@@ -68,6 +124,11 @@ namespace VBox
             return *( this );
         }
         
+        size_t CoreDump::pageSize( void )
+        {
+            return MemoryCache::pageSize();
+        }
+        
         std::string CoreDump::path( void ) const
         {
             return this->impl->_path;
@@ -78,18 +139,110 @@ namespace VBox
             return this->impl->_memorySize;
         }
         
+        uint64_t CoreDump::headerSize( void ) const
+        {
+            return this->impl->_headerSize;
+        }
+        
+        std::shared_ptr< MemoryCache > CoreDump::cache( void ) const
+        {
+            return this->impl->_cache;
+        }
+        
+        std::vector< std::pair< uint64_t, uint64_t > > CoreDump::segments( void ) const
+        {
+            std::vector< std::pair< uint64_t, uint64_t > > segments;
+            
+            this->segments( segments );
+            
+            return segments;
+        }
+        
+        void CoreDump::segments( std::vector< std::pair< uint64_t, uint64_t > > & segments ) const
+        {
+            segments.clear();
+            
+            for( const auto & segment: this->impl->_segments )
+            {
+                segments.push_back( { segment._address, segment._size } );
+            }
+        }
+        
+        bool CoreDump::contains( uint64_t address ) const
+        {
+            return this->impl->_segment( address ) != nullptr;
+        }
+        
+        const std::vector< Registers > & CoreDump::cpus( void ) const
+        {
+            return this->impl->_cpus;
+        }
+        
         std::vector< uint8_t > CoreDump::readMemory( size_t offset, size_t size )
         {
-            try
+            if( offset > this->impl->_memorySize || size > this->impl->_memorySize - offset )
             {
-                this->impl->_memory.Seek( numeric_cast< ssize_t >( offset ), BinaryStream::SeekDirection::Begin );
+                return {};
+            }
+            
+            {
+                std::vector< uint8_t > data( size );
+                
+                this->readMemory( offset, data.data(), size );
                 
-                return this->impl->_memory.Read( size );
+                return data;
             }
-            catch( ... )
+        }
+        
+        size_t CoreDump::readMemory( size_t offset, uint8_t * buffer, size_t size ) const
+        {
+            if( offset > this->impl->_memorySize || size > this->impl->_memorySize - offset )
             {
-                return {};
+                return 0;
+            }
+            
+            if( this->impl->_cache != nullptr )
+            {
+                this->impl->_cache->request( offset, size );
             }
+            
+            this->impl->_prefetch( offset, size );
+            
+            return this->impl->_read( offset, buffer, size );
+        }
+        
+        size_t CoreDump::peekMemory( size_t offset, uint8_t * buffer, size_t size ) const
+        {
+            if( offset > this->impl->_memorySize || size > this->impl->_memorySize - offset )
+            {
+                return 0;
+            }
+            
+            return this->impl->_read( offset, buffer, size );
+        }
+        
+        MemoryView CoreDump::memoryView( size_t offset, size_t size ) const
+        {
+            return this->impl->_view( offset, size, nullptr );
+        }
+        
+        MemoryView CoreDump::memoryView( size_t offset, size_t size, Arena & arena ) const
+        {
+            return this->impl->_view( offset, size, &arena );
+        }
+        
+        MemoryView CoreDump::image( void ) const
+        {
+            return MemoryView( this->impl->_stream->Data(), this->impl->_stream->Size(), this->impl->_stream );
+        }
+        
+        CoreDump CoreDump::withCache( const std::shared_ptr< MemoryCache > & cache ) const
+        {
+            CoreDump dump( *( this ) );
+            
+            dump.impl->_cache = cache;
+            
+            return dump;
         }
         
         void swap( CoreDump & o1, CoreDump & o2 )
@@ -100,43 +253,395 @@ namespace VBox
         }
         
         CoreDump::IMPL::IMPL( const std::string & path ):
-            _path( path ),
-            _memorySize( 0 )
+            _path(       path ),
+            _memorySize( 0 ),
+            _headerSize( 0 ),
+            _stream(     std::make_shared< BinaryMappedStream >( path ) ),
+            _readahead(  std::make_shared< Readahead >() )
         {
             this->_parse();
+            
+            this->_readahead->_chunks.resize( ( this->_stream->Size() + ReadaheadSize - 1 ) / ReadaheadSize, false );
+            
+            this->_readahead->_group = ThreadPool::shared().group();
+        }
+        
+        CoreDump::IMPL::IMPL( BinaryStream & stream, bool headersOnly ):
+            _memorySize( 0 ),
+            _headerSize( 0 )
+        {
+            Stats::Timer           timer( "VM::CoreDump::stream" );
+            std::vector< uint8_t > head( stream.Read( ELF::Header::Size ) );
+            ELF::Header            header( head.data() );
+            uint64_t               offset( header.programHeaderOffset() );
+            uint64_t               size( header.programHeaderEntrySize() );
+            uint64_t               count( header.programHeaderEntryCount() );
+            uint64_t               notes;
+            uint64_t               total;
+            
+            if( header.is64Bit() == false || offset < ELF::Header::Size || offset > MaxHeaderSize || size < ELF::ProgramHeaderEntry::Size || count == 0 )
+            {
+                throw std::runtime_error( "Invalid core dump" );
+            }
+            
+            head.resize( numeric_cast< size_t >( offset + size * count ) );
+            stream.Read( head.data() + ELF::Header::Size, head.size() - ELF::Header::Size );
+            
+            notes = head.size();
+            total = head.size();
+            
+            for( uint64_t i = 0; i < count; i++ )
+            {
+                ELF::ProgramHeaderEntry entry( head.data() + offset + i * size, header.bigEndian() );
+                
+                if( entry.offset() > UINT64_MAX - entry.fileSize() )
+                {
+                    throw std::runtime_error( "Invalid core dump" );
+                }
+                
+                total = std::max( total, entry.offset() + entry.fileSize() );
+                
+                if( entry.type() == 0x04 )
+                {
+                    notes = std::max( notes, entry.offset() + entry.fileSize() );
+                }
+            }
+            
+            this->_stream = std::make_shared< BinaryMappedStream >( numeric_cast< size_t >( total ) );
+            
+            {
+                BinaryDataStream data( head );
+                
+                this->_stream->Fill( data, 0, head.size() );
+            }
+            
+            this->_stream->Fill( stream, head.size(), numeric_cast< size_t >( notes - head.size() ) );
+            this->_parse();
+            
+            if( headersOnly == false )
+            {
+                this->_stream->Fill( stream, numeric_cast< size_t >( notes ), numeric_cast< size_t >( total - notes ) );
+            }
         }
         
         CoreDump::IMPL::IMPL( const IMPL & o ):
             _path(       o._path ),
             _memorySize( o._memorySize ),
-            _memory(     o._memory )
+            _headerSize( o._headerSize ),
+            _segments(   o._segments ),
+            _cpus(       o._cpus ),
+            _stream(     o._stream ),
+            _cache(      o._cache ),
+            _readahead(  o._readahead )
+        {}
+        
+        Registers CoreDump::IMPL::_cpu( const std::vector< uint8_t > & data )
         {
-            this->_parse();
+            Registers regs;
+            
+            regs.rax(    Endian::littleEndian< uint64_t >( data.data() +   0 ) );
+            regs.rbx(    Endian::littleEndian< uint64_t >( data.data() +   8 ) );
+            regs.rcx(    Endian::littleEndian< uint64_t >( data.data() +  16 ) );
+            regs.rdx(    Endian::littleEndian< uint64_t >( data.data() +  24 ) );
+            regs.rsi(    Endian::littleEndian< uint64_t >( data.data() +  32 ) );
+            regs.rdi(    Endian::littleEndian< uint64_t >( data.data() +  40 ) );
+            regs.r8(     Endian::littleEndian< uint64_t >( data.data() +  48 ) );
+            regs.r9(     Endian::littleEndian< uint64_t >( data.data() +  56 ) );
+            regs.r10(    Endian::littleEndian< uint64_t >( data.data() +  64 ) );
+            regs.r11(    Endian::littleEndian< uint64_t >( data.data() +  72 ) );
+            regs.r12(    Endian::littleEndian< uint64_t >( data.data() +  80 ) );
+            regs.r13(    Endian::littleEndian< uint64_t >( data.data() +  88 ) );
+            regs.r14(    Endian::littleEndian< uint64_t >( data.data() +  96 ) );
+            regs.r15(    Endian::littleEndian< uint64_t >( data.data() + 104 ) );
+            regs.rip(    Endian::littleEndian< uint64_t >( data.data() + 112 ) );
+            regs.rsp(    Endian::littleEndian< uint64_t >( data.data() + 120 ) );
+            regs.rbp(    Endian::littleEndian< uint64_t >( data.data() + 128 ) );
+            regs.eflags( Endian::littleEndian< uint64_t >( data.data() + 136 ) );
+            regs.cr0(    Endian::littleEndian< uint64_t >( data.data() + 288 ) );
+            regs.cr3(    Endian::littleEndian< uint64_t >( data.data() + 304 ) );
+            regs.cr4(    Endian::littleEndian< uint64_t >( data.data() + 312 ) );
+            regs.efer(   Endian::littleEndian< uint64_t >( data.data() + 488 ) );
+            
+            for( size_t i = 0; i < CPUSegments.size(); i++ )
+            {
+                const uint8_t * selector( data.data() + 144 + i * CPUSelectorSize );
+                
+                regs.selector( CPUSegments[ i ], Endian::littleEndian< uint16_t >( selector + 16 ) );
+                regs.base(     CPUSegments[ i ], Endian::littleEndian< uint64_t >( selector ) );
+            }
+            
+            return regs;
         }
         
         void CoreDump::IMPL::_parse( void )
         {
-            BinaryFileStream                       stream( this->_path );
-            ELF::File                              elf( stream );
-            std::vector< ELF::ProgramHeaderEntry > entries( elf.programHeader() );
+            Stats::Timer timer( "VM::CoreDump::parse" );
+            ELF::File    elf( *( this->_stream ) );
+            ELF::Header  header( elf.header() );
+            
+            this->_headerSize = header.programHeaderOffset() + static_cast< uint64_t >( header.programHeaderEntrySize() ) * header.programHeaderEntryCount();
+            
+            for( const auto & entry: elf.programHeader() )
+            {
+                if( entry.type() == 0x04 && entry.offset() <= UINT64_MAX - entry.fileSize() )
+                {
+                    this->_headerSize = std::max( this->_headerSize, entry.offset() + entry.fileSize() );
+                }
+                
+                if( entry.type() != 0x01 || entry.fileSize() == 0 )
+                {
+                    continue;
+                }
+                
+                if( entry.offset() > this->_stream->Size() || entry.fileSize() > this->_stream->Size() - entry.offset() )
+                {
+                    throw std::runtime_error( "Invalid core dump" );
+                }
+                
+                if( entry.fileSize() > entry.memorySize() || entry.paddress() > UINT64_MAX - entry.memorySize() )
+                {
+                    throw std::runtime_error( "Invalid core dump" );
+                }
+                
+                this->_segments.push_back( { entry.paddress(), entry.offset(), entry.fileSize() } );
+                
+                this->_memorySize = std::max( this->_memorySize, entry.paddress() + entry.memorySize() );
+            }
             
-            if( entries.size() < 2 || entries[ 0 ].type() != 0x04 || entries[ 1 ].type() != 0x01 )
+            if( this->_segments.empty() )
             {
                 throw std::runtime_error( "Invalid core dump" );
             }
             
+            for( const auto & note: elf.notes() )
             {
-                ELF::ProgramHeaderEntry mem( entries[ 1 ] );
-                
-                if( mem.offset() == 0 || mem.fileSize() == 0 || mem.fileSize() != mem.memorySize() )
+                if( note.name() == CPUNoteName && note.description().size() >= CPUNoteSize )
+                {
+                    this->_cpus.push_back( _cpu( note.description() ) );
+                }
+            }
+            
+            std::sort
+            (
+                this->_segments.begin(),
+                this->_segments.end(),
+                []( const Segment & s1, const Segment & s2 ) { return s1._address < s2._address; }
+            );
+            
+            for( size_t i = 1; i < this->_segments.size(); i++ )
+            {
+                if( this->_segments[ i ]._address < this->_segments[ i - 1 ]._address + this->_segments[ i - 1 ]._size )
                 {
                     throw std::runtime_error( "Invalid core dump" );
                 }
+            }
+        }
+        
+        const CoreDump::IMPL::Segment * CoreDump::IMPL::_segment( uint64_t address ) const
+        {
+            auto i
+            (
+                std::upper_bound
+                (
+                    this->_segments.begin(),
+                    this->_segments.end(),
+                    address,
+                    []( uint64_t a, const Segment & s ) { return a < s._address; }
+                )
+            );
+            
+            if( i == this->_segments.begin() || address - ( i - 1 )->_address >= ( i - 1 )->_size )
+            {
+                return nullptr;
+            }
+            
+            return &( *( i - 1 ) );
+        }
+        
+        size_t CoreDump::IMPL::_copy( size_t offset, uint8_t * buffer, size_t size ) const
+        {
+            size_t done( 0 );
+            
+            while( done < size )
+            {
+                uint64_t address( offset + done );
+                auto     i
+                (
+                    std::upper_bound
+                    (
+                        this->_segments.begin(),
+                        this->_segments.end(),
+                        address,
+                        []( uint64_t a, const Segment & s ) { return a < s._address; }
+                    )
+                );
                 
-                stream.Seek( numeric_cast< ssize_t >( mem.offset() ), BinaryStream::SeekDirection::Begin );
+                if( i != this->_segments.begin() && address - ( i - 1 )->_address < ( i - 1 )->_size )
+                {
+                    size_t n( static_cast< size_t >( std::min< uint64_t >( size - done, ( i - 1 )->_address + ( i - 1 )->_size - address ) ) );
+                    
+                    memcpy( buffer + done, this->_stream->Data() + ( i - 1 )->_offset + ( address - ( i - 1 )->_address ), n );
+                    
+                    done += n;
+                }
+                else
+                {
+                    size_t n( ( i == this->_segments.end() ) ? size - done : static_cast< size_t >( std::min< uint64_t >( size - done, i->_address - address ) ) );
+                    
+                    memset( buffer + done, 0, n );
+                    
+                    done += n;
+                }
+            }
+            
+            return size;
+        }
+        
+        size_t CoreDump::IMPL::_read( size_t offset, uint8_t * buffer, size_t size ) const
+        {
+            size_t done( 0 );
+            
+            if( this->_cache == nullptr )
+            {
+                return this->_copy( offset, buffer, size );
+            }
+            
+            while( done < size )
+            {
+                size_t                                          index( ( offset + done ) / pageSize() );
+                size_t                                          start( ( offset + done ) % pageSize() );
+                size_t                                          n(     std::min( pageSize() - start, size - done ) );
+                std::shared_ptr< const std::vector< uint8_t > > page(  this->_cache->page( index ) );
+                
+                if( page != nullptr && page->size() >= start + n )
+                {
+                    memcpy( buffer + done, page->data() + start, n );
+                }
+                else
+                {
+                    this->_copy( offset + done, buffer + done, n );
+                }
+                
+                done += n;
+            }
+            
+            return size;
+        }
+        
+        MemoryView CoreDump::IMPL::_view( size_t offset, size_t size, Arena * arena ) const
+        {
+            bool cached( false );
+            
+            if( offset > this->_memorySize || size > this->_memorySize - offset )
+            {
+                return {};
+            }
+            
+            this->_prefetch( offset, size );
+            
+            if( size > 0 && this->_cache != nullptr )
+            {
+                size_t first( offset / pageSize() );
+                size_t last(  ( offset + size - 1 ) / pageSize() );
+                
+                this->_cache->request( offset, size );
+                
+                for( size_t i = first; i <= last && cached == false; i++ )
+                {
+                    std::shared_ptr< const std::vector< uint8_t > > page( this->_cache->page( i ) );
+                    
+                    if( page == nullptr )
+                    {
+                        continue;
+                    }
+                    
+                    if( first == last && page->size() >= ( offset % pageSize() ) + size )
+                    {
+                        return MemoryView( page->data() + ( offset % pageSize() ), size, page );
+                    }
+                    
+                    cached = true;
+                }
+            }
+            
+            if( cached == false )
+            {
+                const Segment * segment( this->_segment( offset ) );
+                
+                if( segment != nullptr && size <= segment->_address + segment->_size - offset )
+                {
+                    return MemoryView( this->_stream->Data() + segment->_offset + ( offset - segment->_address ), size, this->_stream );
+                }
+            }
+            
+            if( arena != nullptr )
+            {
+                uint8_t * data( static_cast< uint8_t * >( arena->allocate( size, 1 ) ) );
+                
+                this->_read( offset, data, size );
+                
+                return MemoryView( data, size, nullptr );
+            }
+            
+            {
+                std::shared_ptr< std::vector< uint8_t > > data( std::make_shared< std::vector< uint8_t > >( size ) );
+                
+                this->_read( offset, data->data(), size );
+                
+                return MemoryView( data->data(), size, data );
+            }
+        }
+        
+        void CoreDump::IMPL::_prefetch( size_t offset, size_t size ) const
+        {
+            std::vector< std::pair< size_t, size_t > > runs;
+            
+            if( this->_readahead == nullptr || size == 0 )
+            {
+                return;
+            }
+            
+            {
+                std::lock_guard< std::mutex > l( this->_readahead->_mtx );
+                
+                for( const auto & segment: this->_segments )
+                {
+                    uint64_t start( std::max< uint64_t >( offset, segment._address ) );
+                    uint64_t end(   std::min< uint64_t >( offset + size, segment._address + segment._size ) );
+                    
+                    if( start >= end )
+                    {
+                        continue;
+                    }
+                    
+                    for( size_t i = numeric_cast< size_t >( ( segment._offset + start - segment._address ) / ReadaheadSize ); i <= numeric_cast< size_t >( ( segment._offset + end - segment._address - 1 ) / ReadaheadSize ); i++ )
+                    {
+                        if( i >= this->_readahead->_chunks.size() || this->_readahead->_chunks[ i ] )
+                        {
+                            continue;
+                        }
+                        
+                        this->_readahead->_chunks[ i ] = true;
+                        
+                        if( runs.empty() == false && runs.back().first + runs.back().second == i )
+                        {
+                            runs.back().second++;
+                        }
+                        else
+                        {
+                            runs.emplace_back( i, 1 );
+                        }
+                    }
+                }
+            }
+            
+            for( const auto & run: runs )
+            {
+                std::shared_ptr< BinaryMappedStream > stream( this->_stream );
+                size_t                                start( run.first * ReadaheadSize );
+                size_t                                count( run.second * ReadaheadSize );
                 
-                this->_memorySize = mem.fileSize();
-                this->_memory     = BinaryDataStream( stream.Read( mem.fileSize() ) );
+                ThreadPool::shared().submit( this->_readahead->_group, ThreadPool::Priority::Low, [ stream, start, count ] { stream->Prefetch( start, count ); } );
             }
         }
     }
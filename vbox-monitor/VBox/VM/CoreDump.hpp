@@ -28,6 +28,13 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
+#include <cstdint>
+#include "VBox/VM/MemoryView.hpp"
+#include "VBox/VM/MemoryCache.hpp"
+#include "VBox/VM/Registers.hpp"
+#include "VBox/BinaryStream.hpp"
+#include "VBox/Arena.hpp"
 
 namespace VBox
 {
@@ -38,16 +45,32 @@ namespace VBox
             public:
                 
                 CoreDump( const std::string & path );
+                CoreDump( BinaryStream & stream, bool headersOnly = false );
                 CoreDump( const CoreDump & o );
                 CoreDump( CoreDump && o );
                 ~CoreDump( void );
                 
                 CoreDump & operator =( CoreDump o );
                 
-                std::string path( void )       const;
-                uint64_t    memorySize( void ) const;
+                static size_t pageSize( void );
+                
+                std::string                                    path( void )                 const;
+                uint64_t                                       memorySize( void )           const;
+                uint64_t                                       headerSize( void )           const;
+                std::shared_ptr< MemoryCache >                 cache( void )                const;
+                std::vector< std::pair< uint64_t, uint64_t > > segments( void )             const;
+                bool                                           contains( uint64_t address ) const;
+                const std::vector< Registers >               & cpus( void )                 const;
+                
+                void segments( std::vector< std::pair< uint64_t, uint64_t > > & segments ) const;
                 
                 std::vector< uint8_t > readMemory( size_t offset, size_t size );
+                size_t                 readMemory( size_t offset, uint8_t * buffer, size_t size ) const;
+                size_t                 peekMemory( size_t offset, uint8_t * buffer, size_t size ) const;
+                MemoryView             memoryView( size_t offset, size_t size )                   const;
+                MemoryView             memoryView( size_t offset, size_t size, Arena & arena )    const;
+                MemoryView             image( void )                                              const;
+                CoreDump               withCache( const std::shared_ptr< MemoryCache > & cache )  const;
                 
                 friend void swap( CoreDump & o1, CoreDump & o2 );
                 
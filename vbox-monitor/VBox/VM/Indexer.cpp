@@ -0,0 +1,402 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/Indexer.hpp"
+#include "VBox/Capstone/Disassembler.hpp"
+#include "VBox/Tokenizer.hpp"
+#include "VBox/String.hpp"
+#include "VBox/Hash.hpp"
+#include <map>
+#include <set>
+#include <vector>
+#include <cstring>
+
+namespace VBox
+{
+    namespace VM
+    {
+        class Indexer::IMPL
+        {
+            public:
+                
+                class Page
+                {
+                    public:
+                        
+                        std::vector< uint64_t > _functions;
+                        std::vector< uint64_t > _calls;
+                        std::vector< uint64_t > _references;
+                };
+                
+                IMPL( void );
+                IMPL( const IMPL & o );
+                
+                static bool        _prologue( const uint8_t * data );
+                static std::string _name( const char * prefix, uint64_t address );
+                
+                void                                 _index( const CoreDump & dump, size_t index, std::vector< uint8_t > & buffer );
+                Page                                 _scan( const CoreDump & dump, uint64_t start, const uint8_t * data, size_t size, size_t available );
+                void                                 _follow( const CoreDump & dump, uint64_t address, Page & page );
+                std::shared_ptr< const SymbolIndex > _build( const CoreDump & dump ) const;
+                
+                std::vector< uint64_t >  _hashes;
+                std::map< size_t, Page > _pages;
+                Capstone::Disassembler   _disassembler;
+                size_t                   _scanned;
+        };
+        
+        static const size_t CancellationInterval = 256;
+        
+        Indexer::Indexer( void ):
+            impl( std::make_unique< IMPL >() )
+        {}
+        
+        Indexer::Indexer( const Indexer & o ):
+            impl( std::make_unique< IMPL >( *( o.impl ) ) )
+        {}
+        
+        Indexer::Indexer( Indexer && o ):
+            impl( std::move( o.impl ) )
+        {}
+        
+        Indexer::~Indexer( void )
+        {}
+        
+        Indexer & Indexer::operator =( Indexer o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        size_t Indexer::scanned( void ) const
+        {
+            return this->impl->_scanned;
+        }
+        
+        std::shared_ptr< const SymbolIndex > Indexer::update( const CoreDump & dump, const Cancellation & cancellation )
+        {
+            size_t                 page(    CoreDump::pageSize() );
+            size_t                 count(   static_cast< size_t >( ( dump.memorySize() + page - 1 ) / page ) );
+            std::vector< uint8_t > buffer(  page + 3 );
+            std::vector< bool >    present( count, false );
+            size_t                 n(       0 );
+            
+            this->impl->_scanned = 0;
+            
+            this->impl->_hashes.resize( count, 0 );
+            
+            for( const auto & segment: dump.segments() )
+            {
+                size_t first( static_cast< size_t >( segment.first / page ) );
+                size_t last(  static_cast< size_t >( ( segment.first + segment.second - 1 ) / page ) );
+                
+                for( size_t i = first; i <= last; i++ )
+                {
+                    if( n++ % CancellationInterval == 0 && cancellation.cancelled() )
+                    {
+                        return nullptr;
+                    }
+                    
+                    present[ i ] = true;
+                    
+                    this->impl->_index( dump, i, buffer );
+                }
+            }
+            
+            for( auto i = this->impl->_pages.begin(); i != this->impl->_pages.end(); )
+            {
+                if( i->first < count && present[ i->first ] )
+                {
+                    i++;
+                }
+                else
+                {
+                    i = this->impl->_pages.erase( i );
+                }
+            }
+            
+            for( size_t i = 0; i < count; i++ )
+            {
+                if( present[ i ] == false )
+                {
+                    this->impl->_hashes[ i ] = 0;
+                }
+            }
+            
+            return this->impl->_build( dump );
+        }
+        
+        std::shared_ptr< const SymbolIndex > Indexer::update( const CoreDump & dump, const std::vector< uint64_t > & pages, const Cancellation & cancellation )
+        {
+            size_t                 page(   CoreDump::pageSize() );
+            size_t                 count(  static_cast< size_t >( ( dump.memorySize() + page - 1 ) / page ) );
+            std::vector< uint8_t > buffer( page + 3 );
+            size_t                 n(      0 );
+            
+            this->impl->_scanned = 0;
+            
+            this->impl->_hashes.resize( count, 0 );
+            
+            for( uint64_t index: pages )
+            {
+                if( n++ % CancellationInterval == 0 && cancellation.cancelled() )
+                {
+                    return nullptr;
+                }
+                
+                if( index >= count )
+                {
+                    continue;
+                }
+                
+                if( dump.contains( index * page ) == false )
+                {
+                    this->impl->_hashes[ static_cast< size_t >( index ) ] = 0;
+                    
+                    this->impl->_pages.erase( static_cast< size_t >( index ) );
+                    
+                    continue;
+                }
+                
+                this->impl->_index( dump, static_cast< size_t >( index ), buffer );
+            }
+            
+            return this->impl->_build( dump );
+        }
+        
+        void swap( Indexer & o1, Indexer & o2 )
+        {
+            using std::swap;
+            
+            swap( o1.impl, o2.impl );
+        }
+        
+        Indexer::IMPL::IMPL( void ):
+            _scanned( 0 )
+        {}
+        
+        Indexer::IMPL::IMPL( const IMPL & o ):
+            _hashes(       o._hashes ),
+            _pages(        o._pages ),
+            _disassembler( o._disassembler ),
+            _scanned(      o._scanned )
+        {}
+        
+        void Indexer::IMPL::_index( const CoreDump & dump, size_t index, std::vector< uint8_t > & buffer )
+        {
+            uint64_t size(      dump.memorySize() );
+            size_t   page(      CoreDump::pageSize() );
+            uint64_t start(     static_cast< uint64_t >( index ) * page );
+            size_t   n(         static_cast< size_t >( std::min< uint64_t >( page, size - start ) ) );
+            size_t   available( static_cast< size_t >( std::min< uint64_t >( page + 3, size - start ) ) );
+            uint64_t hash;
+            
+            dump.peekMemory( static_cast< size_t >( start ), buffer.data(), available );
+            
+            hash = Hash::bytes( buffer.data(), n );
+            
+            if( hash == this->_hashes[ index ] )
+            {
+                return;
+            }
+            
+            this->_hashes[ index ] = hash;
+            this->_scanned++;
+            
+            {
+                Page p( this->_scan( dump, start, buffer.data(), n, available ) );
+                
+                if( p._functions.empty() )
+                {
+                    this->_pages.erase( index );
+                }
+                else
+                {
+                    this->_pages[ index ] = std::move( p );
+                }
+            }
+        }
+        
+        bool Indexer::IMPL::_prologue( const uint8_t * data )
+        {
+            static const uint8_t frame[] = { 0x55, 0x48, 0x89, 0xE5 };
+            static const uint8_t endbr[] = { 0xF3, 0x0F, 0x1E, 0xFA };
+            
+            return memcmp( data, frame, sizeof( frame ) ) == 0 || memcmp( data, endbr, sizeof( endbr ) ) == 0;
+        }
+        
+        std::string Indexer::IMPL::_name( const char * prefix, uint64_t address )
+        {
+            char   buffer[ 2 * sizeof( uint64_t ) ];
+            char * end(   String::toHex( address, buffer ) );
+            char * first( buffer );
+            
+            while( first < end - 1 && *( first ) == '0' )
+            {
+                first++;
+            }
+            
+            return std::string( prefix ) + std::string( first, end );
+        }
+        
+        Indexer::IMPL::Page Indexer::IMPL::_scan( const CoreDump & dump, uint64_t start, const uint8_t * data, size_t size, size_t available )
+        {
+            Page page;
+            
+            for( size_t i = 0; i < size && i + 4 <= available; i++ )
+            {
+                if( data[ i ] != 0x55 && data[ i ] != 0xF3 )
+                {
+                    continue;
+                }
+                
+                if( _prologue( data + i ) == false )
+                {
+                    continue;
+                }
+                
+                if( i >= 4 && data[ i ] == 0x55 && _prologue( data + i - 4 ) )
+                {
+                    continue;
+                }
+                
+                page._functions.push_back( start + i );
+                
+                this->_follow( dump, start + i, page );
+            }
+            
+            return page;
+        }
+        
+        void Indexer::IMPL::_follow( const CoreDump & dump, uint64_t address, Page & page )
+        {
+            size_t                 size( static_cast< size_t >( std::min< uint64_t >( 1024, dump.memorySize() - address ) ) );
+            std::vector< uint8_t > data( size );
+            
+            dump.peekMemory( static_cast< size_t >( address ), data.data(), size );
+            
+            this->_disassembler.iterate
+            (
+                data.data(),
+                data.size(),
+                address,
+                256,
+                [ & ]( const Capstone::Instruction & instruction )
+                {
+                    std::string_view mnemonic( instruction.mnemonic() );
+                    Tokenizer        operands( instruction.operands() );
+                    uint64_t         value( 0 );
+                    
+                    if( mnemonic == "ret" || mnemonic == "int3" || mnemonic == "hlt" || mnemonic == "ud2" )
+                    {
+                        return false;
+                    }
+                    
+                    if( mnemonic == "call" )
+                    {
+                        if( operands.expect( "0x" ) && operands.hex( value ) && operands.atEnd() )
+                        {
+                            page._calls.push_back( value );
+                        }
+                        
+                        return true;
+                    }
+                    
+                    operands.until( '[' );
+                    
+                    if( operands.expect( "[rip + 0x" ) && operands.hex( value ) )
+                    {
+                        page._references.push_back( instruction.address() + instruction.size() + value );
+                    }
+                    else if( operands.expect( "[rip - 0x" ) && operands.hex( value ) )
+                    {
+                        page._references.push_back( instruction.address() + instruction.size() - value );
+                    }
+                    
+                    return true;
+                }
+            );
+        }
+        
+        std::shared_ptr< const SymbolIndex > Indexer::IMPL::_build( const CoreDump & dump ) const
+        {
+            std::set< uint64_t >  functions;
+            std::set< uint64_t >  strings;
+            std::vector< Symbol > symbols;
+            
+            for( const auto & p: this->_pages )
+            {
+                functions.insert( p.second._functions.begin(), p.second._functions.end() );
+                
+                for( uint64_t address: p.second._calls )
+                {
+                    if( address < dump.memorySize() )
+                    {
+                        functions.insert( address );
+                    }
+                }
+                
+                for( uint64_t address: p.second._references )
+                {
+                    if( address < dump.memorySize() )
+                    {
+                        strings.insert( address );
+                    }
+                }
+            }
+            
+            for( uint64_t address: functions )
+            {
+                symbols.emplace_back( address, Symbol::Kind::Function, _name( "sub_", address ) );
+            }
+            
+            for( uint64_t address: strings )
+            {
+                uint8_t data[ 64 ];
+                size_t  size( static_cast< size_t >( std::min< uint64_t >( sizeof( data ), dump.memorySize() - address ) ) );
+                size_t  length( 0 );
+                
+                if( functions.count( address ) != 0 )
+                {
+                    continue;
+                }
+                
+                dump.peekMemory( static_cast< size_t >( address ), data, size );
+                
+                while( length < size && data[ length ] >= 0x20 && data[ length ] < 0x7F )
+                {
+                    length++;
+                }
+                
+                if( length >= 4 && ( length == size || data[ length ] == 0 ) )
+                {
+                    symbols.emplace_back( address, Symbol::Kind::String, _name( "str_", address ) );
+                }
+            }
+            
+            return std::make_shared< const SymbolIndex >( std::move( symbols ) );
+        }
+    }
+}
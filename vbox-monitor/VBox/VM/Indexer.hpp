@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_INDEXER_HPP
+#define VBOX_VM_INDEXER_HPP
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "VBox/Cancellation.hpp"
+#include "VBox/VM/CoreDump.hpp"
+#include "VBox/VM/SymbolIndex.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        class Indexer
+        {
+            public:
+                
+                Indexer( void );
+                Indexer( const Indexer & o );
+                Indexer( Indexer && o );
+                ~Indexer( void );
+                
+                Indexer & operator =( Indexer o );
+                
+                size_t scanned( void ) const;
+                
+                std::shared_ptr< const SymbolIndex > update( const CoreDump & dump, const Cancellation & cancellation = Cancellation::none() );
+                std::shared_ptr< const SymbolIndex > update( const CoreDump & dump, const std::vector< uint64_t > & pages, const Cancellation & cancellation = Cancellation::none() );
+                
+                friend void swap( Indexer & o1, Indexer & o2 );
+                
+            private:
+                
+                class IMPL;
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_VM_INDEXER_HPP */
@@ -0,0 +1,318 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/MemoryCache.hpp"
+#include <mutex>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+namespace VBox
+{
+    namespace VM
+    {
+        class MemoryCache::IMPL
+        {
+            public:
+                
+                class Requests
+                {
+                    public:
+                        
+                        std::vector< uint64_t > _pages;
+                        std::mutex              _mtx;
+                };
+                
+                class Page
+                {
+                    public:
+                        
+                        std::shared_ptr< const std::vector< uint8_t > > _data;
+                        uint64_t                                        _generation;
+                        uint64_t                                        _modified;
+                        std::list< uint64_t >::iterator                 _lru;
+                };
+                
+                IMPL( size_t capacity );
+                IMPL( const IMPL & o );
+                IMPL( const IMPL & o, const std::lock_guard< std::mutex > & l );
+                
+                void _evict( void );
+                
+                size_t                               _capacity;
+                size_t                               _size;
+                uint64_t                             _generation;
+                std::list< uint64_t >                _lru;
+                std::unordered_map< uint64_t, Page > _pages;
+                std::shared_ptr< Requests >          _requests;
+                mutable std::mutex                   _mtx;
+        };
+        
+        MemoryCache::MemoryCache( size_t capacity ):
+            impl( std::make_unique< IMPL >( capacity ) )
+        {}
+        
+        MemoryCache::MemoryCache( const MemoryCache & o ):
+            impl( std::make_unique< IMPL >( *( o.impl ) ) )
+        {}
+        
+        MemoryCache::MemoryCache( MemoryCache && o ):
+            impl( std::move( o.impl ) )
+        {}
+        
+        MemoryCache::~MemoryCache( void )
+        {}
+        
+        MemoryCache & MemoryCache::operator =( MemoryCache o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        size_t MemoryCache::pageSize( void )
+        {
+            return 4096;
+        }
+        
+        MemoryCache MemoryCache::snapshot( void ) const
+        {
+            MemoryCache cache( *( this ) );
+            
+            cache.impl->_requests = this->impl->_requests;
+            
+            return cache;
+        }
+        
+        size_t MemoryCache::capacity( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_capacity;
+        }
+        
+        size_t MemoryCache::size( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_size;
+        }
+        
+        uint64_t MemoryCache::generation( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_generation;
+        }
+        
+        void MemoryCache::capacity( size_t bytes )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_capacity = bytes;
+            
+            this->impl->_evict();
+        }
+        
+        void MemoryCache::advance( void )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_generation++;
+        }
+        
+        void MemoryCache::clear( void )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_pages.clear();
+            this->impl->_lru.clear();
+            
+            this->impl->_size = 0;
+        }
+        
+        std::shared_ptr< const std::vector< uint8_t > > MemoryCache::page( uint64_t index ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            auto it( this->impl->_pages.find( index ) );
+            
+            if( it == this->impl->_pages.end() )
+            {
+                return nullptr;
+            }
+            
+            this->impl->_lru.splice( this->impl->_lru.begin(), this->impl->_lru, it->second._lru );
+            
+            return it->second._data;
+        }
+        
+        bool MemoryCache::stale( uint64_t index ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            auto it( this->impl->_pages.find( index ) );
+            
+            return it == this->impl->_pages.end() || it->second._generation < this->impl->_generation;
+        }
+        
+        std::optional< uint64_t > MemoryCache::generation( uint64_t index ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            auto it( this->impl->_pages.find( index ) );
+            
+            if( it == this->impl->_pages.end() )
+            {
+                return {};
+            }
+            
+            return it->second._modified;
+        }
+        
+        void MemoryCache::store( uint64_t index, const std::vector< uint8_t > & data )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            auto it( this->impl->_pages.find( index ) );
+            
+            if( it == this->impl->_pages.end() )
+            {
+                this->impl->_lru.push_front( index );
+                
+                it = this->impl->_pages.insert( { index, IMPL::Page() } ).first;
+                
+                it->second._lru = this->impl->_lru.begin();
+            }
+            else
+            {
+                this->impl->_lru.splice( this->impl->_lru.begin(), this->impl->_lru, it->second._lru );
+                
+                if( *( it->second._data ) == data )
+                {
+                    it->second._generation = this->impl->_generation;
+                    
+                    return;
+                }
+                
+                this->impl->_size -= it->second._data->size();
+            }
+            
+            it->second._data       = std::make_shared< const std::vector< uint8_t > >( data );
+            it->second._generation = this->impl->_generation;
+            it->second._modified   = this->impl->_generation;
+            this->impl->_size     += data.size();
+            
+            this->impl->_evict();
+        }
+        
+        void MemoryCache::request( uint64_t address, size_t size )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_requests->_mtx );
+            std::vector< uint64_t >     & pages( this->impl->_requests->_pages );
+            
+            if( size == 0 )
+            {
+                return;
+            }
+            
+            for( uint64_t i = address / pageSize(); i <= ( address + size - 1 ) / pageSize(); i++ )
+            {
+                if( std::find( pages.begin(), pages.end(), i ) == pages.end() )
+                {
+                    pages.push_back( i );
+                }
+            }
+        }
+        
+        std::vector< uint64_t > MemoryCache::requests( void )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_requests->_mtx );
+            std::vector< uint64_t >       requests( this->impl->_requests->_pages );
+            
+            this->impl->_requests->_pages.clear();
+            
+            std::sort( requests.begin(), requests.end() );
+            
+            return requests;
+        }
+        
+        void swap( MemoryCache & o1, MemoryCache & o2 )
+        {
+            using std::swap;
+            
+            swap( o1.impl, o2.impl );
+        }
+        
+        MemoryCache::IMPL::IMPL( size_t capacity ):
+            _capacity(   capacity ),
+            _size(       0 ),
+            _generation( 0 ),
+            _requests(   std::make_shared< Requests >() )
+        {}
+        
+        MemoryCache::IMPL::IMPL( const IMPL & o ):
+            IMPL( o, std::lock_guard< std::mutex >( o._mtx ) )
+        {}
+        
+        MemoryCache::IMPL::IMPL( const IMPL & o, const std::lock_guard< std::mutex > & l ):
+            _capacity(   o._capacity ),
+            _size(       0 ),
+            _generation( o._generation ),
+            _requests(   std::make_shared< Requests >() )
+        {
+            ( void )l;
+            
+            {
+                std::lock_guard< std::mutex > r( o._requests->_mtx );
+                
+                this->_requests->_pages = o._requests->_pages;
+            }
+            
+            for( auto it = o._lru.rbegin(); it != o._lru.rend(); ++it )
+            {
+                const Page & page( o._pages.at( *( it ) ) );
+                
+                this->_lru.push_front( *( it ) );
+                
+                this->_pages[ *( it ) ]  = { page._data, page._generation, page._modified, this->_lru.begin() };
+                this->_size             += page._data->size();
+            }
+        }
+        
+        void MemoryCache::IMPL::_evict( void )
+        {
+            while( this->_size > this->_capacity && this->_lru.empty() == false )
+            {
+                auto it( this->_pages.find( this->_lru.back() ) );
+                
+                this->_size -= it->second._data->size();
+                
+                this->_pages.erase( it );
+                this->_lru.pop_back();
+            }
+        }
+    }
+}
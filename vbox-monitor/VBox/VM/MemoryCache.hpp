@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_MEMORY_CACHE_HPP
+#define VBOX_VM_MEMORY_CACHE_HPP
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <cstdint>
+
+namespace VBox
+{
+    namespace VM
+    {
+        class MemoryCache
+        {
+            public:
+                
+                MemoryCache( size_t capacity );
+                MemoryCache( const MemoryCache & o );
+                MemoryCache( MemoryCache && o );
+                ~MemoryCache( void );
+                
+                MemoryCache & operator =( MemoryCache o );
+                
+                static size_t pageSize( void );
+                
+                MemoryCache snapshot( void ) const;
+                
+                size_t   capacity( void )   const;
+                size_t   size( void )       const;
+                uint64_t generation( void ) const;
+                
+                void capacity( size_t bytes );
+                void advance( void );
+                void clear( void );
+                
+                std::shared_ptr< const std::vector< uint8_t > > page( uint64_t index )  const;
+                bool                                            stale( uint64_t index ) const;
+                std::optional< uint64_t >                       generation( uint64_t index ) const;
+                void                                            store( uint64_t index, const std::vector< uint8_t > & data );
+                
+                void                    request( uint64_t address, size_t size );
+                std::vector< uint64_t > requests( void );
+                
+                friend void swap( MemoryCache & o1, MemoryCache & o2 );
+                
+            private:
+                
+                class IMPL;
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_VM_MEMORY_CACHE_HPP */
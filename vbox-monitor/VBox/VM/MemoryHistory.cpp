@@ -0,0 +1,650 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/MemoryHistory.hpp"
+#include "VBox/VM/MemoryCache.hpp"
+#include "VBox/LZ.hpp"
+#include "VBox/Casts.hpp"
+#include <mutex>
+#include <deque>
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+#include <cstring>
+#include <stdexcept>
+
+namespace VBox
+{
+    namespace VM
+    {
+        class MemoryHistory::IMPL
+        {
+            public:
+                
+                class Page
+                {
+                    public:
+                        
+                        uint64_t               _hash;
+                        size_t                 _size;
+                        bool                   _compressed;
+                        std::vector< uint8_t > _data;
+                };
+                
+                class Generation
+                {
+                    public:
+                        
+                        uint64_t                                                        _id;
+                        std::chrono::system_clock::time_point                           _timestamp;
+                        uint64_t                                                        _memorySize;
+                        std::unordered_map< uint64_t, std::shared_ptr< const Page > > _pages;
+                };
+                
+                IMPL( size_t capacity, size_t cacheCapacity );
+                
+                static uint64_t _hash( const uint8_t * data, size_t size );
+                static bool     _equal( const Page & page, const uint8_t * data, size_t size );
+                
+                void                                            _store( Generation & generation, uint64_t index, const uint8_t * data, size_t size );
+                void                                            _rollback( const Generation & generation );
+                std::shared_ptr< const Page >                   _intern( const uint8_t * data, size_t size, uint64_t hash );
+                void                                            _push( Generation generation );
+                bool                                            _evict( void );
+                void                                            _prune( void );
+                const Generation *                              _find( uint64_t id ) const;
+                std::shared_ptr< const Page >                   _lookup( uint64_t id, uint64_t index ) const;
+                std::shared_ptr< const std::vector< uint8_t > > _decompress( const std::shared_ptr< const Page > & page ) const;
+                MemoryView                                      _view( uint64_t id, uint64_t offset, size_t size, Arena * arena ) const;
+                
+                size_t                                                       _capacity;
+                size_t                                                       _cacheCapacity;
+                uint64_t                                                     _next;
+                uint64_t                                                     _memorySize;
+                std::deque< Generation >                                     _generations;
+                std::vector< uint64_t >                                      _hashes;
+                std::unordered_map< uint64_t, std::weak_ptr< const Page > > _pool;
+                mutable std::mutex                                           _ingestMutex;
+                mutable std::mutex                                           _mtx;
+                mutable std::list< std::shared_ptr< const Page > >           _lru;
+                mutable std::unordered_map
+                <
+                    const Page *,
+                    std::pair
+                    <
+                        std::shared_ptr< const std::vector< uint8_t > >,
+                        std::list< std::shared_ptr< const Page > >::iterator
+                    >
+                >
+                _cache;
+        };
+        
+        static const uint64_t CancellationInterval = 256;
+        
+        MemoryHistory::MemoryHistory( size_t capacity, size_t cacheCapacity ):
+            impl( std::make_unique< IMPL >( capacity, cacheCapacity ) )
+        {}
+        
+        MemoryHistory::~MemoryHistory( void )
+        {}
+        
+        size_t MemoryHistory::capacity( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_capacity;
+        }
+        
+        void MemoryHistory::capacity( size_t generations )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_capacity = std::max< size_t >( generations, 1 );
+            
+            this->impl->_evict();
+        }
+        
+        uint64_t MemoryHistory::begin( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return ( this->impl->_generations.empty() ) ? this->impl->_next : this->impl->_generations.front()._id;
+        }
+        
+        uint64_t MemoryHistory::end( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_next;
+        }
+        
+        size_t MemoryHistory::pages( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_ingestMutex );
+            size_t                        n( 0 );
+            
+            for( const auto & p: this->impl->_pool )
+            {
+                if( p.second.expired() == false )
+                {
+                    n++;
+                }
+            }
+            
+            return n;
+        }
+        
+        size_t MemoryHistory::bytes( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_ingestMutex );
+            size_t                        n( 0 );
+            
+            for( const auto & p: this->impl->_pool )
+            {
+                std::shared_ptr< const IMPL::Page > page( p.second.lock() );
+                
+                n += ( page == nullptr ) ? 0 : page->_data.size();
+            }
+            
+            return n;
+        }
+        
+        std::optional< uint64_t > MemoryHistory::generation( std::chrono::system_clock::time_point time ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            auto it
+            (
+                std::upper_bound
+                (
+                    this->impl->_generations.begin(),
+                    this->impl->_generations.end(),
+                    time,
+                    []( std::chrono::system_clock::time_point t, const IMPL::Generation & g ) { return t < g._timestamp; }
+                )
+            );
+            
+            if( it == this->impl->_generations.begin() )
+            {
+                return {};
+            }
+            
+            return ( it - 1 )->_id;
+        }
+        
+        std::chrono::system_clock::time_point MemoryHistory::timestamp( uint64_t generation ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            const IMPL::Generation      * g( this->impl->_find( generation ) );
+            
+            return ( g == nullptr ) ? std::chrono::system_clock::time_point() : g->_timestamp;
+        }
+        
+        uint64_t MemoryHistory::memorySize( uint64_t generation ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            const IMPL::Generation      * g( this->impl->_find( generation ) );
+            
+            return ( g == nullptr ) ? 0 : g->_memorySize;
+        }
+        
+        MemoryView MemoryHistory::memoryView( uint64_t generation, uint64_t offset, size_t size ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_view( generation, offset, size, nullptr );
+        }
+        
+        MemoryView MemoryHistory::memoryView( uint64_t generation, uint64_t offset, size_t size, Arena & arena ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_view( generation, offset, size, &arena );
+        }
+        
+        std::vector< uint64_t > MemoryHistory::changedPages( uint64_t generation ) const
+        {
+            std::vector< uint64_t > pages;
+            
+            this->changedPages( generation, pages );
+            
+            return pages;
+        }
+        
+        void MemoryHistory::changedPages( uint64_t generation, std::vector< uint64_t > & pages ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            const IMPL::Generation      * g( this->impl->_find( generation ) );
+            
+            pages.clear();
+            
+            if( g == nullptr || g == &( this->impl->_generations.front() ) )
+            {
+                return;
+            }
+            
+            pages.reserve( g->_pages.size() );
+            
+            for( const auto & page: g->_pages )
+            {
+                pages.push_back( page.first );
+            }
+            
+            std::sort( pages.begin(), pages.end() );
+        }
+        
+        void MemoryHistory::add( const CoreDump & dump, std::chrono::system_clock::time_point time, const Cancellation & cancellation )
+        {
+            std::lock_guard< std::mutex >                  l( this->impl->_ingestMutex );
+            IMPL::Generation                               generation;
+            uint64_t                                       pageSize( MemoryCache::pageSize() );
+            std::vector< uint8_t >                         data( numeric_cast< size_t >( pageSize ) );
+            std::vector< std::pair< uint64_t, uint64_t > > segments( dump.segments() );
+            size_t                                         segment( 0 );
+            
+            generation._timestamp  = time;
+            generation._memorySize = dump.memorySize();
+            
+            this->impl->_hashes.resize( numeric_cast< size_t >( ( dump.memorySize() + pageSize - 1 ) / pageSize ), 0 );
+            
+            for( uint64_t index = 0; index * pageSize < dump.memorySize(); index++ )
+            {
+                size_t size( numeric_cast< size_t >( std::min< uint64_t >( pageSize, dump.memorySize() - index * pageSize ) ) );
+                
+                if( index % CancellationInterval == 0 && cancellation.cancelled() )
+                {
+                    this->impl->_rollback( generation );
+                    
+                    return;
+                }
+                
+                while( segment < segments.size() && segments[ segment ].first + segments[ segment ].second <= index * pageSize )
+                {
+                    segment++;
+                }
+                
+                if( segment == segments.size() || segments[ segment ].first >= index * pageSize + size )
+                {
+                    if( this->impl->_hashes[ numeric_cast< size_t >( index ) ] != 0 )
+                    {
+                        memset( data.data(), 0, size );
+                        
+                        this->impl->_store( generation, index, data.data(), size );
+                    }
+                    
+                    continue;
+                }
+                
+                if( dump.peekMemory( numeric_cast< size_t >( index * pageSize ), data.data(), size ) != size )
+                {
+                    memset( data.data(), 0, size );
+                }
+                
+                this->impl->_store( generation, index, data.data(), size );
+            }
+            
+            this->impl->_memorySize = dump.memorySize();
+            
+            this->impl->_push( std::move( generation ) );
+        }
+        
+        void MemoryHistory::update( const std::vector< std::pair< uint64_t, std::vector< uint8_t > > > & pages, std::chrono::system_clock::time_point time )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_ingestMutex );
+            IMPL::Generation              generation;
+            
+            generation._timestamp  = time;
+            generation._memorySize = this->impl->_memorySize;
+            
+            for( const auto & page: pages )
+            {
+                if( page.first < this->impl->_hashes.size() )
+                {
+                    this->impl->_store( generation, page.first, page.second.data(), page.second.size() );
+                }
+            }
+            
+            if( generation._pages.empty() == false )
+            {
+                this->impl->_push( std::move( generation ) );
+            }
+        }
+        
+        void MemoryHistory::clear( void )
+        {
+            std::lock_guard< std::mutex > l1( this->impl->_ingestMutex );
+            std::lock_guard< std::mutex > l2( this->impl->_mtx );
+            
+            this->impl->_generations.clear();
+            this->impl->_hashes.clear();
+            this->impl->_pool.clear();
+            this->impl->_lru.clear();
+            this->impl->_cache.clear();
+        }
+        
+        MemoryHistory::IMPL::IMPL( size_t capacity, size_t cacheCapacity ):
+            _capacity(      std::max< size_t >( capacity, 1 ) ),
+            _cacheCapacity( cacheCapacity ),
+            _next(          0 ),
+            _memorySize(    0 )
+        {}
+        
+        uint64_t MemoryHistory::IMPL::_hash( const uint8_t * data, size_t size )
+        {
+            uint64_t hash( 0x9E3779B97F4A7C15 ^ size );
+            uint64_t bits( 0 );
+            size_t   i( 0 );
+            
+            for( ; i + sizeof( uint64_t ) <= size; i += sizeof( uint64_t ) )
+            {
+                uint64_t word;
+                
+                memcpy( &word, data + i, sizeof( word ) );
+                
+                bits |= word;
+                hash  = ( hash ^ word ) * 0xFF51AFD7ED558CCD;
+                hash ^= hash >> 32;
+            }
+            
+            for( ; i < size; i++ )
+            {
+                bits |= data[ i ];
+                hash  = ( hash ^ data[ i ] ) * 0xFF51AFD7ED558CCD;
+            }
+            
+            if( bits == 0 )
+            {
+                return 0;
+            }
+            
+            return ( hash == 0 ) ? 1 : hash;
+        }
+        
+        bool MemoryHistory::IMPL::_equal( const Page & page, const uint8_t * data, size_t size )
+        {
+            std::vector< uint8_t > bytes;
+            
+            if( page._size != size )
+            {
+                return false;
+            }
+            
+            if( page._compressed == false )
+            {
+                return memcmp( page._data.data(), data, size ) == 0;
+            }
+            
+            bytes = LZ::decompress( page._data, page._size );
+            
+            return bytes.size() == size && memcmp( bytes.data(), data, size ) == 0;
+        }
+        
+        void MemoryHistory::IMPL::_store( Generation & generation, uint64_t index, const uint8_t * data, size_t size )
+        {
+            uint64_t hash( _hash( data, size ) );
+            
+            if( this->_next > 0 && this->_hashes[ index ] == hash )
+            {
+                return;
+            }
+            
+            this->_hashes[ index ] = hash;
+            
+            if( hash == 0 && this->_next == 0 )
+            {
+                return;
+            }
+            
+            generation._pages[ index ] = this->_intern( data, size, hash );
+        }
+        
+        void MemoryHistory::IMPL::_rollback( const Generation & generation )
+        {
+            std::lock_guard< std::mutex > l( this->_mtx );
+            
+            if( this->_generations.empty() )
+            {
+                std::fill( this->_hashes.begin(), this->_hashes.end(), 0 );
+                
+                return;
+            }
+            
+            for( const auto & page: generation._pages )
+            {
+                std::shared_ptr< const Page > previous( this->_lookup( this->_next - 1, page.first ) );
+                
+                this->_hashes[ page.first ] = ( previous == nullptr ) ? 0 : previous->_hash;
+            }
+        }
+        
+        std::shared_ptr< const MemoryHistory::IMPL::Page > MemoryHistory::IMPL::_intern( const uint8_t * data, size_t size, uint64_t hash )
+        {
+            std::shared_ptr< const Page > page;
+            bool                          collision( false );
+            
+            if( hash == 0 )
+            {
+                return nullptr;
+            }
+            
+            {
+                auto it( this->_pool.find( hash ) );
+                
+                if( it != this->_pool.end() )
+                {
+                    page = it->second.lock();
+                }
+            }
+            
+            if( page != nullptr && _equal( *( page ), data, size ) == false )
+            {
+                page      = nullptr;
+                collision = true;
+            }
+            
+            if( page == nullptr )
+            {
+                std::vector< uint8_t > compressed( LZ::compress( data, size ) );
+                
+                if( compressed.size() < size )
+                {
+                    page = std::make_shared< const Page >( Page { hash, size, true, std::move( compressed ) } );
+                }
+                else
+                {
+                    page = std::make_shared< const Page >( Page { hash, size, false, std::vector< uint8_t >( data, data + size ) } );
+                }
+                
+                if( collision == false )
+                {
+                    this->_pool[ hash ] = page;
+                }
+            }
+            
+            return page;
+        }
+        
+        void MemoryHistory::IMPL::_push( Generation generation )
+        {
+            bool evicted;
+            
+            {
+                std::lock_guard< std::mutex > l( this->_mtx );
+                
+                generation._id = this->_next++;
+                
+                this->_generations.push_back( std::move( generation ) );
+                
+                evicted = this->_evict();
+            }
+            
+            if( evicted )
+            {
+                this->_prune();
+            }
+        }
+        
+        bool MemoryHistory::IMPL::_evict( void )
+        {
+            bool evicted( false );
+            
+            while( this->_generations.size() > this->_capacity )
+            {
+                Generation & oldest( this->_generations[ 0 ] );
+                Generation & next(   this->_generations[ 1 ] );
+                
+                for( auto & page: oldest._pages )
+                {
+                    if( page.second != nullptr )
+                    {
+                        next._pages.emplace( page.first, std::move( page.second ) );
+                    }
+                }
+                
+                this->_generations.pop_front();
+                
+                evicted = true;
+            }
+            
+            return evicted;
+        }
+        
+        void MemoryHistory::IMPL::_prune( void )
+        {
+            for( auto it = this->_pool.begin(); it != this->_pool.end(); )
+            {
+                it = ( it->second.expired() ) ? this->_pool.erase( it ) : std::next( it );
+            }
+        }
+        
+        const MemoryHistory::IMPL::Generation * MemoryHistory::IMPL::_find( uint64_t id ) const
+        {
+            if( this->_generations.empty() || id < this->_generations.front()._id || id >= this->_next )
+            {
+                return nullptr;
+            }
+            
+            return &( this->_generations[ numeric_cast< size_t >( id - this->_generations.front()._id ) ] );
+        }
+        
+        std::shared_ptr< const MemoryHistory::IMPL::Page > MemoryHistory::IMPL::_lookup( uint64_t id, uint64_t index ) const
+        {
+            for( size_t i = numeric_cast< size_t >( id - this->_generations.front()._id ) + 1; i > 0; i-- )
+            {
+                auto it( this->_generations[ i - 1 ]._pages.find( index ) );
+                
+                if( it != this->_generations[ i - 1 ]._pages.end() )
+                {
+                    return it->second;
+                }
+            }
+            
+            return nullptr;
+        }
+        
+        std::shared_ptr< const std::vector< uint8_t > > MemoryHistory::IMPL::_decompress( const std::shared_ptr< const Page > & page ) const
+        {
+            std::shared_ptr< const std::vector< uint8_t > > data;
+            
+            if( page->_compressed == false )
+            {
+                return std::shared_ptr< const std::vector< uint8_t > >( page, &( page->_data ) );
+            }
+            
+            {
+                auto it( this->_cache.find( page.get() ) );
+                
+                if( it != this->_cache.end() )
+                {
+                    this->_lru.splice( this->_lru.begin(), this->_lru, it->second.second );
+                    
+                    return it->second.first;
+                }
+            }
+            
+            data = std::make_shared< const std::vector< uint8_t > >( LZ::decompress( page->_data, page->_size ) );
+            
+            this->_lru.push_front( page );
+            
+            this->_cache[ page.get() ] = { data, this->_lru.begin() };
+            
+            while( this->_lru.size() > this->_cacheCapacity )
+            {
+                this->_cache.erase( this->_lru.back().get() );
+                this->_lru.pop_back();
+            }
+            
+            return data;
+        }
+        
+        MemoryView MemoryHistory::IMPL::_view( uint64_t id, uint64_t offset, size_t size, Arena * arena ) const
+        {
+            const Generation                        * g( this->_find( id ) );
+            uint64_t                                  pageSize( MemoryCache::pageSize() );
+            uint8_t                                 * data;
+            std::shared_ptr< std::vector< uint8_t > > buffer;
+            
+            if( g == nullptr || offset >= g->_memorySize )
+            {
+                return {};
+            }
+            
+            size = numeric_cast< size_t >( std::min< uint64_t >( size, g->_memorySize - offset ) );
+            
+            if( arena != nullptr )
+            {
+                data = static_cast< uint8_t * >( arena->allocate( size, 1 ) );
+                
+                memset( data, 0, size );
+            }
+            else
+            {
+                buffer = std::make_shared< std::vector< uint8_t > >( size, 0 );
+                data   = buffer->data();
+            }
+            
+            for( uint64_t address = offset; address < offset + size; )
+            {
+                uint64_t                      index( address / pageSize );
+                uint64_t                      start( address - index * pageSize );
+                size_t                        n( numeric_cast< size_t >( std::min< uint64_t >( pageSize - start, offset + size - address ) ) );
+                std::shared_ptr< const Page > page( this->_lookup( id, index ) );
+                
+                if( page != nullptr )
+                {
+                    std::shared_ptr< const std::vector< uint8_t > > bytes( this->_decompress( page ) );
+                    
+                    if( start < bytes->size() )
+                    {
+                        memcpy( data + ( address - offset ), bytes->data() + start, std::min< size_t >( n, bytes->size() - numeric_cast< size_t >( start ) ) );
+                    }
+                }
+                
+                address += n;
+            }
+            
+            return MemoryView( data, size, buffer );
+        }
+    }
+}
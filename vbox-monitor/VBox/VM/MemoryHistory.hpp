@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_MEMORY_HISTORY_HPP
+#define VBOX_VM_MEMORY_HISTORY_HPP
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+#include "VBox/Arena.hpp"
+#include "VBox/Cancellation.hpp"
+#include "VBox/VM/CoreDump.hpp"
+#include "VBox/VM/MemoryView.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        class MemoryHistory
+        {
+            public:
+                
+                MemoryHistory( size_t capacity, size_t cacheCapacity );
+                ~MemoryHistory( void );
+                
+                MemoryHistory( const MemoryHistory & o )              = delete;
+                MemoryHistory( MemoryHistory && o )                   = delete;
+                MemoryHistory & operator =( const MemoryHistory & o ) = delete;
+                MemoryHistory & operator =( MemoryHistory && o )      = delete;
+                
+                size_t   capacity( void ) const;
+                void     capacity( size_t generations );
+                uint64_t begin( void )    const;
+                uint64_t end( void )      const;
+                size_t   pages( void )    const;
+                size_t   bytes( void )    const;
+                
+                std::optional< uint64_t >             generation( std::chrono::system_clock::time_point time )                       const;
+                std::chrono::system_clock::time_point timestamp( uint64_t generation )                                               const;
+                uint64_t                              memorySize( uint64_t generation )                                              const;
+                MemoryView                            memoryView( uint64_t generation, uint64_t offset, size_t size )                const;
+                MemoryView                            memoryView( uint64_t generation, uint64_t offset, size_t size, Arena & arena ) const;
+                std::vector< uint64_t >               changedPages( uint64_t generation )                                            const;
+                void                                  changedPages( uint64_t generation, std::vector< uint64_t > & pages )           const;
+                
+                void add( const CoreDump & dump, std::chrono::system_clock::time_point time, const Cancellation & cancellation = Cancellation::none() );
+                void update( const std::vector< std::pair< uint64_t, std::vector< uint8_t > > > & pages, std::chrono::system_clock::time_point time );
+                void clear( void );
+                
+            private:
+                
+                class IMPL;
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_VM_MEMORY_HISTORY_HPP */
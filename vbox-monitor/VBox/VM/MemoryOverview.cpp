@@ -0,0 +1,258 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/MemoryOverview.hpp"
+#include "VBox/Casts.hpp"
+#include <utility>
+
+namespace VBox
+{
+    namespace VM
+    {
+        static const size_t   SamplePages     = 16;
+        static const uint64_t HeatGenerations = 16;
+        
+        static bool zero( const std::vector< uint8_t > & data, size_t size )
+        {
+            return std::all_of( data.begin(), data.begin() + numeric_cast< std::ptrdiff_t >( size ), []( uint8_t b ) { return b == 0; } );
+        }
+        
+        MemoryOverview::MemoryOverview( void ):
+            _memorySize( 0 ),
+            _cellSize(   0 )
+        {}
+        
+        MemoryOverview::MemoryOverview( const CoreDump & dump, const MemoryHistory & history, std::optional< uint64_t > generation, size_t cells ):
+            _memorySize( 0 ),
+            _cellSize(   0 )
+        {
+            this->update( dump, history, generation, cells );
+        }
+        
+        void MemoryOverview::update( const CoreDump & dump, const MemoryHistory & history, std::optional< uint64_t > generation, size_t cells )
+        {
+            uint64_t pageSize( CoreDump::pageSize() );
+            size_t   segment( 0 );
+            
+            this->_memorySize = dump.memorySize();
+            this->_cellSize   = 0;
+            
+            this->_contents.clear();
+            this->_changes.clear();
+            this->_heat.clear();
+            
+            if( cells == 0 || this->_memorySize == 0 )
+            {
+                return;
+            }
+            
+            this->_cellSize = std::max( pageSize, ( ( ( this->_memorySize + cells - 1 ) / cells + pageSize - 1 ) / pageSize ) * pageSize );
+            
+            {
+                size_t n( numeric_cast< size_t >( ( this->_memorySize + this->_cellSize - 1 ) / this->_cellSize ) );
+                
+                this->_contents.resize( n, Content::Unmapped );
+                this->_changes.resize( n, 0 );
+                this->_heat.resize( n, 0 );
+            }
+            
+            dump.segments( this->_segments );
+            this->_buffer.resize( numeric_cast< size_t >( pageSize ) );
+            
+            for( size_t i = 0; i < this->_contents.size(); i++ )
+            {
+                uint64_t start( i * this->_cellSize );
+                uint64_t end( std::min( start + this->_cellSize, this->_memorySize ) );
+                uint64_t total( 0 );
+                
+                this->_backed.clear();
+                
+                while( segment < this->_segments.size() && this->_segments[ segment ].first + this->_segments[ segment ].second <= start )
+                {
+                    segment++;
+                }
+                
+                for( size_t j = segment; j < this->_segments.size() && this->_segments[ j ].first < end; j++ )
+                {
+                    uint64_t a( std::max( start, this->_segments[ j ].first ) );
+                    uint64_t b( std::min( end,   this->_segments[ j ].first + this->_segments[ j ].second ) );
+                    
+                    if( a < b )
+                    {
+                        this->_backed.push_back( { a, b - a } );
+                        
+                        total += b - a;
+                    }
+                }
+                
+                if( total == 0 )
+                {
+                    continue;
+                }
+                
+                this->_contents[ i ] = Content::Zero;
+                
+                {
+                    uint64_t step( std::max( pageSize, total / SamplePages ) );
+                    size_t   range( 0 );
+                    uint64_t skipped( 0 );
+                    
+                    for( uint64_t position = 0; position < total && this->_contents[ i ] == Content::Zero; position += step )
+                    {
+                        while( position - skipped >= this->_backed[ range ].second )
+                        {
+                            skipped += this->_backed[ range++ ].second;
+                        }
+                        
+                        {
+                            uint64_t address( std::max( this->_backed[ range ].first, ( ( this->_backed[ range ].first + position - skipped ) / pageSize ) * pageSize ) );
+                            size_t   size( numeric_cast< size_t >( std::min( pageSize, this->_backed[ range ].first + this->_backed[ range ].second - address ) ) );
+                            
+                            if( dump.peekMemory( numeric_cast< size_t >( address ), this->_buffer.data(), size ) == size && zero( this->_buffer, size ) == false )
+                            {
+                                this->_contents[ i ] = Content::Data;
+                            }
+                        }
+                    }
+                }
+            }
+            
+            if( generation.has_value() && generation.value() >= history.begin() )
+            {
+                uint64_t first( ( generation.value() - history.begin() >= HeatGenerations ) ? generation.value() - HeatGenerations + 1 : history.begin() );
+                
+                this->_seen.assign( this->_contents.size(), UINT64_MAX );
+                
+                for( uint64_t g = first; g <= generation.value(); g++ )
+                {
+                    history.changedPages( g, this->_pages );
+                    
+                    for( uint64_t page: this->_pages )
+                    {
+                        size_t i( numeric_cast< size_t >( std::min< uint64_t >( ( page * pageSize ) / this->_cellSize, this->_contents.size() ) ) );
+                        
+                        if( i == this->_contents.size() )
+                        {
+                            break;
+                        }
+                        
+                        if( this->_seen[ i ] != g )
+                        {
+                            this->_seen[ i ] = g;
+                            
+                            this->_heat[ i ]++;
+                        }
+                        
+                        if( g == generation.value() )
+                        {
+                            this->_changes[ i ]++;
+                        }
+                    }
+                }
+            }
+        }
+        
+        MemoryOverview::MemoryOverview( const MemoryOverview & o ):
+            _memorySize( o._memorySize ),
+            _cellSize(   o._cellSize ),
+            _contents(   o._contents ),
+            _changes(    o._changes ),
+            _heat(       o._heat )
+        {}
+        
+        MemoryOverview::MemoryOverview( MemoryOverview && o ) noexcept:
+            _memorySize( o._memorySize ),
+            _cellSize(   o._cellSize ),
+            _contents(   std::move( o._contents ) ),
+            _changes(    std::move( o._changes ) ),
+            _heat(       std::move( o._heat ) )
+        {}
+        
+        MemoryOverview::~MemoryOverview( void )
+        {}
+        
+        MemoryOverview & MemoryOverview::operator =( MemoryOverview o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        size_t MemoryOverview::size( void ) const
+        {
+            return this->_contents.size();
+        }
+        
+        uint64_t MemoryOverview::cellSize( void ) const
+        {
+            return this->_cellSize;
+        }
+        
+        uint64_t MemoryOverview::memorySize( void ) const
+        {
+            return this->_memorySize;
+        }
+        
+        size_t MemoryOverview::cell( uint64_t address ) const
+        {
+            if( this->_contents.empty() )
+            {
+                return 0;
+            }
+            
+            return numeric_cast< size_t >( std::min< uint64_t >( address / this->_cellSize, this->_contents.size() - 1 ) );
+        }
+        
+        uint64_t MemoryOverview::address( size_t cell ) const
+        {
+            return std::min< uint64_t >( cell, this->_contents.size() ) * this->_cellSize;
+        }
+        
+        MemoryOverview::Content MemoryOverview::content( size_t cell ) const
+        {
+            return ( cell < this->_contents.size() ) ? this->_contents[ cell ] : Content::Unmapped;
+        }
+        
+        size_t MemoryOverview::changes( size_t cell ) const
+        {
+            return ( cell < this->_changes.size() ) ? this->_changes[ cell ] : 0;
+        }
+        
+        size_t MemoryOverview::heat( size_t cell ) const
+        {
+            return ( cell < this->_heat.size() ) ? this->_heat[ cell ] : 0;
+        }
+        
+        void swap( MemoryOverview & o1, MemoryOverview & o2 )
+        {
+            using std::swap;
+            
+            swap( o1._memorySize, o2._memorySize );
+            swap( o1._cellSize,   o2._cellSize );
+            swap( o1._contents,   o2._contents );
+            swap( o1._changes,    o2._changes );
+            swap( o1._heat,       o2._heat );
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_MEMORY_OVERVIEW_HPP
+#define VBOX_VM_MEMORY_OVERVIEW_HPP
+
+#include <algorithm>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include "VBox/VM/CoreDump.hpp"
+#include "VBox/VM/MemoryHistory.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        class MemoryOverview
+        {
+            public:
+                
+                enum class Content
+                {
+                    Unmapped,
+                    Zero,
+                    Data
+                };
+                
+                MemoryOverview( void );
+                MemoryOverview( const CoreDump & dump, const MemoryHistory & history, std::optional< uint64_t > generation, size_t cells );
+                MemoryOverview( const MemoryOverview & o );
+                MemoryOverview( MemoryOverview && o ) noexcept;
+                ~MemoryOverview( void );
+                
+                MemoryOverview & operator =( MemoryOverview o );
+                
+                void update( const CoreDump & dump, const MemoryHistory & history, std::optional< uint64_t > generation, size_t cells );
+                
+                size_t   size( void )       const;
+                uint64_t cellSize( void )   const;
+                uint64_t memorySize( void ) const;
+                
+                size_t   cell( uint64_t address ) const;
+                uint64_t address( size_t cell )   const;
+                Content  content( size_t cell )   const;
+                size_t   changes( size_t cell )   const;
+                size_t   heat( size_t cell )      const;
+                
+                friend void swap( MemoryOverview & o1, MemoryOverview & o2 );
+                
+            private:
+                
+                uint64_t                                       _memorySize;
+                uint64_t                                       _cellSize;
+                std::vector< Content >                         _contents;
+                std::vector< size_t >                          _changes;
+                std::vector< size_t >                          _heat;
+                std::vector< std::pair< uint64_t, uint64_t > > _segments;
+                std::vector< std::pair< uint64_t, uint64_t > > _backed;
+                std::vector< uint8_t >                         _buffer;
+                std::vector< uint64_t >                        _seen;
+                std::vector< uint64_t >                        _pages;
+        };
+    }
+}
+
+#endif /* VBOX_VM_MEMORY_OVERVIEW_HPP */
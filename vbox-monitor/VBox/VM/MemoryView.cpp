@@ -0,0 +1,204 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/MemoryView.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#elif defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+namespace VBox
+{
+    namespace VM
+    {
+        MemoryView::MemoryView( void ):
+            _data( nullptr ),
+            _size( 0 )
+        {}
+        
+        MemoryView::MemoryView( const uint8_t * data, size_t size, const std::shared_ptr< const void > & owner ):
+            _data(  data ),
+            _size(  size ),
+            _owner( owner )
+        {}
+        
+        MemoryView::MemoryView( const MemoryView & o ):
+            _data(  o._data ),
+            _size(  o._size ),
+            _owner( o._owner )
+        {}
+        
+        MemoryView::MemoryView( MemoryView && o ) noexcept:
+            _data(  o._data ),
+            _size(  o._size ),
+            _owner( std::move( o._owner ) )
+        {
+            o._data = nullptr;
+            o._size = 0;
+        }
+        
+        MemoryView::~MemoryView( void )
+        {}
+        
+        MemoryView & MemoryView::operator =( MemoryView o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        uint8_t MemoryView::operator []( size_t index ) const
+        {
+            return this->_data[ index ];
+        }
+        
+        const uint8_t * MemoryView::data( void ) const
+        {
+            return this->_data;
+        }
+        
+        size_t MemoryView::size( void ) const
+        {
+            return this->_size;
+        }
+        
+        bool MemoryView::empty( void ) const
+        {
+            return this->_size == 0;
+        }
+        
+        const uint8_t * MemoryView::begin( void ) const
+        {
+            return this->_data;
+        }
+        
+        const uint8_t * MemoryView::end( void ) const
+        {
+            return this->_data + this->_size;
+        }
+        
+        MemoryView MemoryView::subview( size_t offset, size_t size ) const
+        {
+            if( offset > this->_size )
+            {
+                return {};
+            }
+            
+            return MemoryView( this->_data + offset, std::min( size, this->_size - offset ), this->_owner );
+        }
+        
+        std::vector< uint64_t > MemoryView::diff( const MemoryView & o ) const
+        {
+            std::vector< uint64_t > bits( ( this->_size + 63 ) / 64, 0 );
+            
+            this->diff( o, bits.data() );
+            
+            return bits;
+        }
+        
+        void MemoryView::diff( const MemoryView & o, uint64_t * bits ) const
+        {
+            size_t size( std::min( this->_size, o._size ) );
+            size_t i( 0 );
+            
+            std::fill( bits, bits + ( this->_size + 63 ) / 64, 0 );
+            
+            #if defined( __AVX2__ )
+            
+            for( ; i + 64 <= size; i += 64 )
+            {
+                __m256i  a0( _mm256_loadu_si256( reinterpret_cast< const __m256i * >( this->_data + i ) ) );
+                __m256i  b0( _mm256_loadu_si256( reinterpret_cast< const __m256i * >( o._data + i ) ) );
+                __m256i  a1( _mm256_loadu_si256( reinterpret_cast< const __m256i * >( this->_data + i + 32 ) ) );
+                __m256i  b1( _mm256_loadu_si256( reinterpret_cast< const __m256i * >( o._data + i + 32 ) ) );
+                uint64_t lo( static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( a0, b0 ) ) ) );
+                uint64_t hi( static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_cmpeq_epi8( a1, b1 ) ) ) );
+                
+                bits[ i / 64 ] = ~( lo | ( hi << 32 ) );
+            }
+            
+            #elif defined( __SSE2__ )
+            
+            for( ; i + 64 <= size; i += 64 )
+            {
+                uint64_t equal( 0 );
+                
+                for( size_t j = 0; j < 64; j += 16 )
+                {
+                    __m128i a( _mm_loadu_si128( reinterpret_cast< const __m128i * >( this->_data + i + j ) ) );
+                    __m128i b( _mm_loadu_si128( reinterpret_cast< const __m128i * >( o._data + i + j ) ) );
+                    
+                    equal |= static_cast< uint64_t >( static_cast< uint32_t >( _mm_movemask_epi8( _mm_cmpeq_epi8( a, b ) ) ) ) << j;
+                }
+                
+                bits[ i / 64 ] = ~equal;
+            }
+            
+            #endif
+            
+            for( ; i + sizeof( uint64_t ) <= size; i += sizeof( uint64_t ) )
+            {
+                uint64_t a;
+                uint64_t b;
+                
+                memcpy( &a, this->_data + i, sizeof( a ) );
+                memcpy( &b, o._data + i,     sizeof( b ) );
+                
+                if( a == b )
+                {
+                    continue;
+                }
+                
+                for( size_t j = i; j < i + sizeof( uint64_t ); j++ )
+                {
+                    if( this->_data[ j ] != o._data[ j ] )
+                    {
+                        bits[ j / 64 ] |= uint64_t( 1 ) << ( j % 64 );
+                    }
+                }
+            }
+            
+            for( ; i < this->_size; i++ )
+            {
+                if( i >= size || this->_data[ i ] != o._data[ i ] )
+                {
+                    bits[ i / 64 ] |= uint64_t( 1 ) << ( i % 64 );
+                }
+            }
+        }
+        
+        void swap( MemoryView & o1, MemoryView & o2 )
+        {
+            using std::swap;
+            
+            swap( o1._data,  o2._data );
+            swap( o1._size,  o2._size );
+            swap( o1._owner, o2._owner );
+        }
+    }
+}
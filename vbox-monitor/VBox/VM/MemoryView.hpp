@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_MEMORY_VIEW_HPP
+#define VBOX_VM_MEMORY_VIEW_HPP
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+
+namespace VBox
+{
+    namespace VM
+    {
+        class MemoryView
+        {
+            public:
+                
+                MemoryView( void );
+                MemoryView( const uint8_t * data, size_t size, const std::shared_ptr< const void > & owner );
+                MemoryView( const MemoryView & o );
+                MemoryView( MemoryView && o ) noexcept;
+                ~MemoryView( void );
+                
+                MemoryView & operator =( MemoryView o );
+                
+                uint8_t operator []( size_t index ) const;
+                
+                const uint8_t * data( void )  const;
+                size_t          size( void )  const;
+                bool            empty( void ) const;
+                const uint8_t * begin( void ) const;
+                const uint8_t * end( void )   const;
+                
+                MemoryView              subview( size_t offset, size_t size )         const;
+                std::vector< uint64_t > diff( const MemoryView & o )                  const;
+                void                    diff( const MemoryView & o, uint64_t * bits ) const;
+                
+                friend void swap( MemoryView & o1, MemoryView & o2 );
+                
+            private:
+                
+                const uint8_t               * _data;
+                size_t                        _size;
+                std::shared_ptr< const void > _owner;
+        };
+    }
+}
+
+#endif /* VBOX_VM_MEMORY_VIEW_HPP */
@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/Pattern.hpp"
+#include "VBox/String.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        Pattern::Pattern( void ):
+            _alignment( 1 )
+        {}
+        
+        Pattern::Pattern( const std::vector< uint8_t > & bytes, size_t alignment ):
+            _bytes(     bytes ),
+            _alignment( std::max< size_t >( alignment, 1 ) )
+        {}
+        
+        Pattern::Pattern( const Pattern & o ):
+            _bytes(     o._bytes ),
+            _alignment( o._alignment )
+        {}
+        
+        Pattern::Pattern( Pattern && o ) noexcept:
+            _bytes(     std::move( o._bytes ) ),
+            _alignment( o._alignment )
+        {}
+        
+        Pattern::~Pattern( void )
+        {}
+        
+        Pattern & Pattern::operator =( Pattern o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        std::optional< Pattern > Pattern::parse( const std::string & query )
+        {
+            std::string_view       s( query );
+            std::vector< uint8_t > bytes;
+            
+            while( s.empty() == false && s.front() == ' ' ) { s.remove_prefix( 1 ); }
+            while( s.empty() == false && s.back()  == ' ' ) { s.remove_suffix( 1 ); }
+            
+            if( s.length() >= 3 && s.front() == '"' && s.back() == '"' )
+            {
+                s = s.substr( 1, s.length() - 2 );
+                
+                return Pattern( std::vector< uint8_t >( s.begin(), s.end() ) );
+            }
+            
+            if( s.length() >= 4 && ( s[ 0 ] == 'u' || s[ 0 ] == 'U' ) && s[ 1 ] == '"' && s.back() == '"' )
+            {
+                for( char c: s.substr( 2, s.length() - 3 ) )
+                {
+                    bytes.push_back( static_cast< uint8_t >( c ) );
+                    bytes.push_back( 0 );
+                }
+                
+                return Pattern( bytes, 2 );
+            }
+            
+            if( s.length() > 2 && ( s[ 0 ] == 'd' || s[ 0 ] == 'q' ) && s[ 1 ] == ':' )
+            {
+                size_t       size( ( s[ 0 ] == 'd' ) ? sizeof( uint32_t ) : sizeof( uint64_t ) );
+                uint64_t     value( 0 );
+                std::string  digits( s.substr( 2 ) );
+                const char * first( digits.data() );
+                const char * last(  digits.data() + digits.length() );
+                
+                if( digits.length() > 2 && digits[ 0 ] == '0' && ( digits[ 1 ] == 'x' || digits[ 1 ] == 'X' ) )
+                {
+                    first += 2;
+                }
+                
+                if( String::fromHex( first, last, value ) != last || first == last )
+                {
+                    return {};
+                }
+                
+                if( size == sizeof( uint32_t ) && value > UINT32_MAX )
+                {
+                    return {};
+                }
+                
+                for( size_t i = 0; i < size; i++ )
+                {
+                    bytes.push_back( static_cast< uint8_t >( value >> ( i * 8 ) ) );
+                }
+                
+                return Pattern( bytes, size );
+            }
+            
+            {
+                std::string digits;
+                
+                while( s.empty() == false )
+                {
+                    if( s.length() >= 2 && s[ 0 ] == '0' && ( s[ 1 ] == 'x' || s[ 1 ] == 'X' ) )
+                    {
+                        s.remove_prefix( 2 );
+                    }
+                    else if( s.front() == ' ' )
+                    {
+                        s.remove_prefix( 1 );
+                    }
+                    else
+                    {
+                        digits += s.front();
+                        
+                        s.remove_prefix( 1 );
+                    }
+                }
+                
+                if( digits.empty() || digits.length() % 2 != 0 )
+                {
+                    return {};
+                }
+                
+                for( size_t i = 0; i < digits.length(); i += 2 )
+                {
+                    uint8_t byte( 0 );
+                    
+                    if( String::fromHex( digits.data() + i, digits.data() + i + 2, byte ) != digits.data() + i + 2 )
+                    {
+                        return {};
+                    }
+                    
+                    bytes.push_back( byte );
+                }
+                
+                return Pattern( bytes );
+            }
+        }
+        
+        const std::vector< uint8_t > & Pattern::bytes( void ) const
+        {
+            return this->_bytes;
+        }
+        
+        size_t Pattern::alignment( void ) const
+        {
+            return this->_alignment;
+        }
+        
+        bool Pattern::empty( void ) const
+        {
+            return this->_bytes.empty();
+        }
+        
+        void swap( Pattern & o1, Pattern & o2 )
+        {
+            using std::swap;
+            
+            swap( o1._bytes,     o2._bytes );
+            swap( o1._alignment, o2._alignment );
+        }
+    }
+}
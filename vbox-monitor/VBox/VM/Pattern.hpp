@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_PATTERN_HPP
+#define VBOX_VM_PATTERN_HPP
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace VBox
+{
+    namespace VM
+    {
+        class Pattern
+        {
+            public:
+                
+                Pattern( void );
+                Pattern( const std::vector< uint8_t > & bytes, size_t alignment = 1 );
+                Pattern( const Pattern & o );
+                Pattern( Pattern && o ) noexcept;
+                ~Pattern( void );
+                
+                Pattern & operator =( Pattern o );
+                
+                static std::optional< Pattern > parse( const std::string & query );
+                
+                const std::vector< uint8_t > & bytes( void )     const;
+                size_t                         alignment( void ) const;
+                bool                           empty( void )     const;
+                
+                friend void swap( Pattern & o1, Pattern & o2 );
+                
+            private:
+                
+                std::vector< uint8_t > _bytes;
+                size_t                 _alignment;
+        };
+    }
+}
+
+#endif /* VBOX_VM_PATTERN_HPP */
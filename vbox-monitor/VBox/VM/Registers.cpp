@@ -24,322 +24,599 @@
 
 #include "VBox/VM/Registers.hpp"
 #include "VBox/String.hpp"
+#include <stdexcept>
+#include <type_traits>
 
 namespace VBox
 {
     namespace VM
     {
-        class Registers::IMPL
+        static_assert( std::is_trivially_copyable_v< Registers > );
+        
+        static constexpr std::string_view Names[] =
         {
-            public:
-                
-                IMPL( void );
-                IMPL( const IMPL & o );
-                
-                uint64_t _rax;
-                uint64_t _rbx;
-                uint64_t _rcx;
-                uint64_t _rdx;
-                uint64_t _rdi;
-                uint64_t _rsi;
-                uint64_t _r8;
-                uint64_t _r9;
-                uint64_t _r10;
-                uint64_t _r11;
-                uint64_t _r12;
-                uint64_t _r13;
-                uint64_t _r14;
-                uint64_t _r15;
-                uint64_t _rbp;
-                uint64_t _rsp;
-                uint64_t _rip;
-                uint64_t _eflags;
+            "rax", "rbx", "rcx", "rdx", "rdi", "rsi",
+            "r8",  "r9",  "r10", "r11", "r12", "r13",
+            "r14", "r15", "rbp", "rsp", "rip", "eflags",
+            "cr0", "cr3", "cr4", "efer"
         };
         
-        Registers::Registers( void ):
-            impl( std::make_unique< IMPL >() )
-        {}
+        static constexpr std::pair< std::string_view, std::string_view > Aliases[] =
+        {
+            { "rflags", "eflags" },
+            { "efl",    "eflags" }
+        };
         
-        Registers::Registers( const Registers & o ):
-            impl( std::make_unique< IMPL >( *( o.impl ) ) )
-        {}
+        static_assert( sizeof( Names ) / sizeof( Names[ 0 ] ) == Registers::Count );
+        static_assert( Registers::GeneralCount <= Registers::Count );
         
-        Registers::Registers( Registers && o ):
-            impl( std::move( o.impl ) )
-        {}
+        static constexpr std::array< std::array< char, Registers::LabelWidth >, Registers::Count > labelTable( void )
+        {
+            std::array< std::array< char, Registers::LabelWidth >, Registers::Count > table {};
+            
+            for( size_t i = 0; i < Registers::Count; i++ )
+            {
+                size_t padding( Registers::LabelWidth - Names[ i ].size() );
+                
+                for( size_t j = 0; j < Registers::LabelWidth; j++ )
+                {
+                    char c( ( j < padding ) ? ' ' : Names[ i ][ j - padding ] );
+                    
+                    table[ i ][ j ] = ( c >= 'a' && c <= 'z' ) ? static_cast< char >( c - 'a' + 'A' ) : c;
+                }
+            }
+            
+            return table;
+        }
         
-        Registers::~Registers( void )
-        {}
+        static constexpr std::array< std::array< char, Registers::LabelWidth >, Registers::Count > Labels = labelTable();
+        
+        const std::array< uint64_t Registers::*, Registers::Count > Registers::_fields =
+        {
+            &Registers::_rax, &Registers::_rbx, &Registers::_rcx, &Registers::_rdx,
+            &Registers::_rdi, &Registers::_rsi, &Registers::_r8,  &Registers::_r9,
+            &Registers::_r10, &Registers::_r11, &Registers::_r12, &Registers::_r13,
+            &Registers::_r14, &Registers::_r15, &Registers::_rbp, &Registers::_rsp,
+            &Registers::_rip, &Registers::_eflags,
+            &Registers::_cr0, &Registers::_cr3, &Registers::_cr4, &Registers::_efer
+        };
         
-        Registers & Registers::operator =( Registers o )
+        const std::string_view Registers::_segments[] =
         {
-            swap( *( this ), o );
+            "cs", "ds", "es", "fs", "gs", "ss"
+        };
+        
+        Registers::Registers( void ):
+            _rax(       0 ),
+            _rbx(       0 ),
+            _rcx(       0 ),
+            _rdx(       0 ),
+            _rdi(       0 ),
+            _rsi(       0 ),
+            _r8(        0 ),
+            _r9(        0 ),
+            _r10(       0 ),
+            _r11(       0 ),
+            _r12(       0 ),
+            _r13(       0 ),
+            _r14(       0 ),
+            _r15(       0 ),
+            _rbp(       0 ),
+            _rsp(       0 ),
+            _rip(       0 ),
+            _eflags(    0 ),
+            _cr0(       0 ),
+            _cr3(       0 ),
+            _cr4(       0 ),
+            _efer(      0 ),
+            _selectors( {} ),
+            _bases(     {} ),
+            _ymm(       {} )
+        {}
+        
+        const std::vector< std::string > & Registers::names( void )
+        {
+            static const std::vector< std::string > names
+            (
+                []( void )
+                {
+                    std::vector< std::string > v( std::begin( Names ), std::end( Names ) );
+                    
+                    for( std::string_view segment: _segments )
+                    {
+                        v.push_back( std::string( segment ) );
+                        v.push_back( std::string( segment ) + "_base" );
+                    }
+                    
+                    for( size_t i = 0; i < 16; i++ )
+                    {
+                        v.push_back( "ymm" + std::to_string( i ) );
+                    }
+                    
+                    return v;
+                }
+                ()
+            );
             
-            return *( this );
+            return names;
         }
         
         uint64_t Registers::rax( void ) const
         {
-            return this->impl->_rax;
+            return this->_rax;
         }
         
         uint64_t Registers::rbx( void ) const
         {
-            return this->impl->_rbx;
+            return this->_rbx;
         }
         
         uint64_t Registers::rcx( void ) const
         {
-            return this->impl->_rcx;
+            return this->_rcx;
         }
         
         uint64_t Registers::rdx( void ) const
         {
-            return this->impl->_rdx;
+            return this->_rdx;
         }
         
         uint64_t Registers::rdi( void ) const
         {
-            return this->impl->_rdi;
+            return this->_rdi;
         }
         
         uint64_t Registers::rsi( void ) const
         {
-            return this->impl->_rsi;
+            return this->_rsi;
         }
         
         uint64_t Registers::r8( void ) const
         {
-            return this->impl->_r8;
+            return this->_r8;
         }
         
         uint64_t Registers::r9( void ) const
         {
-            return this->impl->_r9;
+            return this->_r9;
         }
         
         uint64_t Registers::r10( void ) const
         {
-            return this->impl->_r10;
+            return this->_r10;
         }
         
         uint64_t Registers::r11( void ) const
         {
-            return this->impl->_r11;
+            return this->_r11;
         }
         
         uint64_t Registers::r12( void ) const
         {
-            return this->impl->_r12;
+            return this->_r12;
         }
         
         uint64_t Registers::r13( void ) const
         {
-            return this->impl->_r13;
+            return this->_r13;
         }
         
         uint64_t Registers::r14( void ) const
         {
-            return this->impl->_r14;
+            return this->_r14;
         }
         
         uint64_t Registers::r15( void ) const
         {
-            return this->impl->_r15;
+            return this->_r15;
         }
         
         uint64_t Registers::rbp( void ) const
         {
-            return this->impl->_rbp;
+            return this->_rbp;
         }
         
         uint64_t Registers::rsp( void ) const
         {
-            return this->impl->_rsp;
+            return this->_rsp;
         }
         
         uint64_t Registers::rip( void ) const
         {
-            return this->impl->_rip;
+            return this->_rip;
         }
         
         uint64_t Registers::eflags( void ) const
         {
-            return this->impl->_eflags;
+            return this->_eflags;
+        }
+        
+        uint64_t Registers::cr0( void ) const
+        {
+            return this->_cr0;
+        }
+        
+        uint64_t Registers::cr3( void ) const
+        {
+            return this->_cr3;
+        }
+        
+        uint64_t Registers::cr4( void ) const
+        {
+            return this->_cr4;
+        }
+        
+        uint64_t Registers::efer( void ) const
+        {
+            return this->_efer;
+        }
+        
+        uint64_t Registers::selector( Segment segment ) const
+        {
+            return this->_selectors[ static_cast< size_t >( segment ) ];
+        }
+        
+        uint64_t Registers::base( Segment segment ) const
+        {
+            return this->_bases[ static_cast< size_t >( segment ) ];
+        }
+        
+        std::array< uint64_t, 2 > Registers::xmm( size_t index ) const
+        {
+            return { this->_ymm.at( index )[ 0 ], this->_ymm.at( index )[ 1 ] };
+        }
+        
+        std::array< uint64_t, 4 > Registers::ymm( size_t index ) const
+        {
+            return this->_ymm.at( index );
         }
         
         void Registers::rax( uint64_t value )
         {
-            this->impl->_rax = value;
+            this->_rax = value;
         }
         
         void Registers::rbx( uint64_t value )
         {
-            this->impl->_rbx = value;
+            this->_rbx = value;
         }
         
         void Registers::rcx( uint64_t value )
         {
-            this->impl->_rcx = value;
+            this->_rcx = value;
         }
         
         void Registers::rdx( uint64_t value )
         {
-            this->impl->_rdx = value;
+            this->_rdx = value;
         }
         
         void Registers::rdi( uint64_t value )
         {
-            this->impl->_rdi = value;
+            this->_rdi = value;
         }
         
         void Registers::rsi( uint64_t value )
         {
-            this->impl->_rsi = value;
+            this->_rsi = value;
         }
         
-        void Registers::r8(  uint64_t value )
+        void Registers::r8( uint64_t value )
         {
-            this->impl->_r8 = value;
+            this->_r8 = value;
         }
         
-        void Registers::r9(  uint64_t value )
+        void Registers::r9( uint64_t value )
         {
-            this->impl->_r9 = value;
+            this->_r9 = value;
         }
         
         void Registers::r10( uint64_t value )
         {
-            this->impl->_r10 = value;
+            this->_r10 = value;
         }
         
         void Registers::r11( uint64_t value )
         {
-            this->impl->_r11 = value;
+            this->_r11 = value;
         }
         
         void Registers::r12( uint64_t value )
         {
-            this->impl->_r12 = value;
+            this->_r12 = value;
         }
         
         void Registers::r13( uint64_t value )
         {
-            this->impl->_r13 = value;
+            this->_r13 = value;
         }
         
         void Registers::r14( uint64_t value )
         {
-            this->impl->_r14 = value;
+            this->_r14 = value;
         }
         
         void Registers::r15( uint64_t value )
         {
-            this->impl->_r15 = value;
+            this->_r15 = value;
         }
         
         void Registers::rbp( uint64_t value )
         {
-            this->impl->_rbp = value;
+            this->_rbp = value;
         }
         
         void Registers::rsp( uint64_t value )
         {
-            this->impl->_rsp = value;
+            this->_rsp = value;
         }
         
         void Registers::rip( uint64_t value )
         {
-            this->impl->_rip = value;
+            this->_rip = value;
         }
         
         void Registers::eflags( uint64_t value )
         {
-            this->impl->_eflags = value;
+            this->_eflags = value;
+        }
+        
+        void Registers::cr0( uint64_t value )
+        {
+            this->_cr0 = value;
+        }
+        
+        void Registers::cr3( uint64_t value )
+        {
+            this->_cr3 = value;
+        }
+        
+        void Registers::cr4( uint64_t value )
+        {
+            this->_cr4 = value;
+        }
+        
+        void Registers::efer( uint64_t value )
+        {
+            this->_efer = value;
+        }
+        
+        void Registers::selector( Segment segment, uint64_t value )
+        {
+            this->_selectors[ static_cast< size_t >( segment ) ] = value;
+        }
+        
+        void Registers::base( Segment segment, uint64_t value )
+        {
+            this->_bases[ static_cast< size_t >( segment ) ] = value;
+        }
+        
+        void Registers::xmm( size_t index, const std::array< uint64_t, 2 > & value )
+        {
+            this->_ymm.at( index )[ 0 ] = value[ 0 ];
+            this->_ymm.at( index )[ 1 ] = value[ 1 ];
+        }
+        
+        void Registers::ymm( size_t index, const std::array< uint64_t, 4 > & value )
+        {
+            this->_ymm.at( index ) = value;
+        }
+        
+        std::optional< size_t > Registers::indexOf( std::string_view name )
+        {
+            for( const auto & alias: Aliases )
+            {
+                if( alias.first == name )
+                {
+                    name = alias.second;
+                    
+                    break;
+                }
+            }
+            
+            for( size_t i = 0; i < Count; i++ )
+            {
+                if( Names[ i ] == name )
+                {
+                    return i;
+                }
+            }
+            
+            return {};
+        }
+        
+        std::string_view Registers::nameAt( size_t index )
+        {
+            if( index >= Count )
+            {
+                throw std::runtime_error( "Invalid register index" );
+            }
+            
+            return Names[ index ];
+        }
+        
+        std::string_view Registers::labelAt( size_t index )
+        {
+            if( index >= Count )
+            {
+                throw std::runtime_error( "Invalid register index" );
+            }
+            
+            return std::string_view( Labels[ index ].data(), Labels[ index ].size() );
+        }
+        
+        uint64_t Registers::valueAt( size_t index ) const
+        {
+            if( index >= Count )
+            {
+                throw std::runtime_error( "Invalid register index" );
+            }
+            
+            return this->*( _fields[ index ] );
         }
         
-        std::vector< std::pair< std::string, uint64_t > > Registers::all( void ) const
+        void Registers::valueAt( size_t index, uint64_t value )
         {
-            return
+            if( index >= Count )
             {
-                { "rax",    this->impl->_rax },
-                { "rbx",    this->impl->_rbx },
-                { "rcx",    this->impl->_rcx },
-                { "rdx",    this->impl->_rdx },
-                { "rdi",    this->impl->_rdi },
-                { "rsi",    this->impl->_rsi },
-                { "r8",     this->impl->_r8 },
-                { "r9",     this->impl->_r9 },
-                { "r10",    this->impl->_r10 },
-                { "r11",    this->impl->_r11 },
-                { "r12",    this->impl->_r12 },
-                { "r13",    this->impl->_r13 },
-                { "r14",    this->impl->_r14 },
-                { "r15",    this->impl->_r15 },
-                { "rbp",    this->impl->_rbp },
-                { "rsp",    this->impl->_rsp },
-                { "rip",    this->impl->_rip },
-                { "eflags", this->impl->_eflags }
-            };
+                throw std::runtime_error( "Invalid register index" );
+            }
+            
+            this->*( _fields[ index ] ) = value;
+        }
+        
+        bool Registers::set( std::string_view name, uint64_t value )
+        {
+            std::optional< size_t > index( indexOf( name ) );
+            
+            if( index.has_value() )
+            {
+                this->valueAt( index.value(), value );
+                
+                return true;
+            }
+            
+            for( size_t i = 0; i < 6; i++ )
+            {
+                if( name.substr( 0, 2 ) != _segments[ i ] )
+                {
+                    continue;
+                }
+                
+                if( name.length() == 2 )
+                {
+                    this->_selectors[ i ] = value;
+                    
+                    return true;
+                }
+                
+                if( name.substr( 2 ) == "_base" )
+                {
+                    this->_bases[ i ] = value;
+                    
+                    return true;
+                }
+            }
+            
+            return false;
+        }
+        
+        bool Registers::set( std::string_view name, std::string_view hex )
+        {
+            std::string digits;
+            size_t      lanes( 1 );
+            size_t      index( 0 );
+            
+            if( hex.empty() == false && hex[ 0 ] == '{' )
+            {
+                hex.remove_prefix( std::min( hex.find_first_not_of( ' ', 1 ), hex.length() ) );
+            }
+            
+            if( hex.length() > 2 && hex[ 0 ] == '0' && ( hex[ 1 ] == 'x' || hex[ 1 ] == 'X' ) )
+            {
+                hex.remove_prefix( 2 );
+            }
+            
+            for( char c: hex )
+            {
+                if( isxdigit( static_cast< unsigned char >( c ) ) )
+                {
+                    digits += c;
+                }
+                else if( c != '\'' && c != '_' )
+                {
+                    break;
+                }
+            }
+            
+            if( name.length() > 3 && ( name.substr( 0, 3 ) == "xmm" || name.substr( 0, 3 ) == "ymm" ) )
+            {
+                const char * first( name.data() + 3 );
+                const char * last(  name.data() + name.length() );
+                
+                for( const char * p = first; p != last; p++ )
+                {
+                    if( *( p ) < '0' || *( p ) > '9' )
+                    {
+                        return false;
+                    }
+                    
+                    index = index * 10 + static_cast< size_t >( *( p ) - '0' );
+                }
+                
+                if( index >= this->_ymm.size() )
+                {
+                    return false;
+                }
+                
+                lanes = ( name[ 0 ] == 'x' ) ? 2 : 4;
+            }
+            
+            if( digits.empty() || digits.length() > lanes * 16 )
+            {
+                return false;
+            }
+            
+            if( lanes == 1 )
+            {
+                return this->set( name, String::fromHex< uint64_t >( digits ) );
+            }
+            
+            for( size_t i = 0; i < lanes; i++ )
+            {
+                size_t   end( ( digits.length() > i * 16 ) ? digits.length() - i * 16 : 0 );
+                size_t   start( ( end > 16 ) ? end - 16 : 0 );
+                uint64_t value( 0 );
+                
+                String::fromHex( digits.data() + start, digits.data() + end, value );
+                
+                this->_ymm[ index ][ i ] = value;
+            }
+            
+            return true;
         }
         
         void swap( Registers & o1, Registers & o2 )
         {
             using std::swap;
             
-            swap( o1.impl, o2.impl );
+            swap( o1._rax,       o2._rax );
+            swap( o1._rbx,       o2._rbx );
+            swap( o1._rcx,       o2._rcx );
+            swap( o1._rdx,       o2._rdx );
+            swap( o1._rdi,       o2._rdi );
+            swap( o1._rsi,       o2._rsi );
+            swap( o1._r8,        o2._r8 );
+            swap( o1._r9,        o2._r9 );
+            swap( o1._r10,       o2._r10 );
+            swap( o1._r11,       o2._r11 );
+            swap( o1._r12,       o2._r12 );
+            swap( o1._r13,       o2._r13 );
+            swap( o1._r14,       o2._r14 );
+            swap( o1._r15,       o2._r15 );
+            swap( o1._rbp,       o2._rbp );
+            swap( o1._rsp,       o2._rsp );
+            swap( o1._rip,       o2._rip );
+            swap( o1._eflags,    o2._eflags );
+            swap( o1._cr0,       o2._cr0 );
+            swap( o1._cr3,       o2._cr3 );
+            swap( o1._cr4,       o2._cr4 );
+            swap( o1._efer,      o2._efer );
+            swap( o1._selectors, o2._selectors );
+            swap( o1._bases,     o2._bases );
+            swap( o1._ymm,       o2._ymm );
         }
         
         std::ostream & operator <<( std::ostream & os, const Registers & o )
         {
-            for( const auto & p: o.all() )
+            for( size_t i = 0; i < Registers::GeneralCount; i++ )
             {
-                os << String::toUpper( p.first ) << ": " << String::toHex( p.second ) << std::endl;
+                std::string_view label( Registers::labelAt( i ) );
+                
+                os << label.substr( label.find_first_not_of( ' ' ) ) << ": " << String::toHex( o.valueAt( i ) ) << std::endl;
             }
             
             return os;
         }
-        
-        Registers::IMPL::IMPL( void ):
-            _rax(    0 ),
-            _rbx(    0 ),
-            _rcx(    0 ),
-            _rdx(    0 ),
-            _rdi(    0 ),
-            _rsi(    0 ),
-            _r8(     0 ),
-            _r9(     0 ),
-            _r10(    0 ),
-            _r11(    0 ),
-            _r12(    0 ),
-            _r13(    0 ),
-            _r14(    0 ),
-            _r15(    0 ),
-            _rbp(    0 ),
-            _rsp(    0 ),
-            _rip(    0 ),
-            _eflags( 0 )
-        {}
-        
-        Registers::IMPL::IMPL( const IMPL & o ):
-            _rax(    o._rax ),
-            _rbx(    o._rbx ),
-            _rcx(    o._rcx ),
-            _rdx(    o._rdx ),
-            _rdi(    o._rdi ),
-            _rsi(    o._rsi ),
-            _r8(     o._r8 ),
-            _r9(     o._r9 ),
-            _r10(    o._r10 ),
-            _r11(    o._r11 ),
-            _r12(    o._r12 ),
-            _r13(    o._r13 ),
-            _r14(    o._r14 ),
-            _r15(    o._r15 ),
-            _rbp(    o._rbp ),
-            _rsp(    o._rsp ),
-            _rip(    o._rip ),
-            _eflags( o._eflags )
-        {}
     }
 }
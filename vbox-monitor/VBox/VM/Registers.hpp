@@ -26,10 +26,13 @@
 #define VBOX_VM_REGISTERS_HPP
 
 #include <cstdint>
-#include <memory>
 #include <algorithm>
+#include <array>
 #include <ostream>
+#include <string>
 #include <vector>
+#include <optional>
+#include <string_view>
 
 namespace VBox
 {
@@ -39,12 +42,26 @@ namespace VBox
         {
             public:
                 
+                enum class Segment
+                {
+                    CS,
+                    DS,
+                    ES,
+                    FS,
+                    GS,
+                    SS
+                };
+                
+                static constexpr size_t Count        = 22;
+                static constexpr size_t GeneralCount = 18;
+                static constexpr size_t LabelWidth   = 6;
+                
                 Registers( void );
-                Registers( const Registers & o );
-                Registers( Registers && o );
-                ~Registers( void );
                 
-                Registers & operator =( Registers o );
+                static const std::vector< std::string > & names( void );
+                static std::optional< size_t >             indexOf( std::string_view name );
+                static std::string_view                    nameAt( size_t index );
+                static std::string_view                    labelAt( size_t index );
                 
                 uint64_t rax( void )    const;
                 uint64_t rbx( void )    const;
@@ -64,6 +81,16 @@ namespace VBox
                 uint64_t rsp( void )    const;
                 uint64_t rip( void )    const;
                 uint64_t eflags( void ) const;
+                uint64_t cr0( void )    const;
+                uint64_t cr3( void )    const;
+                uint64_t cr4( void )    const;
+                uint64_t efer( void )   const;
+                
+                uint64_t                  selector( Segment segment ) const;
+                uint64_t                  base( Segment segment )     const;
+                std::array< uint64_t, 2 > xmm( size_t index )         const;
+                std::array< uint64_t, 4 > ymm( size_t index )         const;
+                uint64_t                  valueAt( size_t index )     const;
                 
                 void rax( uint64_t value );
                 void rbx( uint64_t value );
@@ -83,8 +110,19 @@ namespace VBox
                 void rsp( uint64_t value );
                 void rip( uint64_t value );
                 void eflags( uint64_t value );
+                void cr0( uint64_t value );
+                void cr3( uint64_t value );
+                void cr4( uint64_t value );
+                void efer( uint64_t value );
                 
-                std::vector< std::pair< std::string, uint64_t > > all( void ) const;
+                void selector( Segment segment, uint64_t value );
+                void base( Segment segment, uint64_t value );
+                void xmm( size_t index, const std::array< uint64_t, 2 > & value );
+                void ymm( size_t index, const std::array< uint64_t, 4 > & value );
+                void valueAt( size_t index, uint64_t value );
+                
+                bool set( std::string_view name, uint64_t value );
+                bool set( std::string_view name, std::string_view hex );
                 
                 friend void swap( Registers & o1, Registers & o2 );
                 
@@ -92,8 +130,34 @@ namespace VBox
                 
             private:
                 
-                class IMPL;
-                std::unique_ptr< IMPL > impl;
+                static const std::array< uint64_t Registers::*, Count > _fields;
+                static const std::string_view                           _segments[];
+                
+                uint64_t                                    _rax;
+                uint64_t                                    _rbx;
+                uint64_t                                    _rcx;
+                uint64_t                                    _rdx;
+                uint64_t                                    _rdi;
+                uint64_t                                    _rsi;
+                uint64_t                                    _r8;
+                uint64_t                                    _r9;
+                uint64_t                                    _r10;
+                uint64_t                                    _r11;
+                uint64_t                                    _r12;
+                uint64_t                                    _r13;
+                uint64_t                                    _r14;
+                uint64_t                                    _r15;
+                uint64_t                                    _rbp;
+                uint64_t                                    _rsp;
+                uint64_t                                    _rip;
+                uint64_t                                    _eflags;
+                uint64_t                                    _cr0;
+                uint64_t                                    _cr3;
+                uint64_t                                    _cr4;
+                uint64_t                                    _efer;
+                std::array< uint64_t, 6 >                   _selectors;
+                std::array< uint64_t, 6 >                   _bases;
+                std::array< std::array< uint64_t, 4 >, 16 > _ymm;
         };
     }
 }
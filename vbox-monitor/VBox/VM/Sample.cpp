@@ -0,0 +1,215 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/Sample.hpp"
+#include "VBox/Casts.hpp"
+#include <type_traits>
+
+namespace VBox
+{
+    namespace VM
+    {
+        static_assert( std::is_trivially_copyable_v< Sample > );
+        
+        static const Registers::Segment Segments[] =
+        {
+            Registers::Segment::CS,
+            Registers::Segment::DS,
+            Registers::Segment::ES,
+            Registers::Segment::FS,
+            Registers::Segment::GS,
+            Registers::Segment::SS
+        };
+        
+        static uint64_t * pack( const SegmentAddress & address, uint64_t * p )
+        {
+            *( p++ ) = address.segment();
+            *( p++ ) = address.address();
+            
+            return p;
+        }
+        
+        static SegmentAddress unpack( const uint64_t * & p )
+        {
+            uint32_t segment( static_cast< uint32_t >( *( p++ ) ) );
+            
+            return SegmentAddress( segment, *( p++ ) );
+        }
+        
+        Sample::Sample( void ):
+            _sequence(     0 ),
+            _hasRegisters( false ),
+            _registers(    {} ),
+            _selectors(    {} ),
+            _bases(        {} ),
+            _stackDepth(   0 )
+        {}
+        
+        Sample::Sample( const Snapshot & snapshot ):
+            Sample()
+        {
+            const std::optional< Registers > & registers( snapshot.registers() );
+            const std::vector< StackEntry >  & stack( snapshot.stack() );
+            
+            this->_sequence   = snapshot.sequence();
+            this->_timestamp  = snapshot.timestamp();
+            this->_stackDepth = std::min( stack.size(), MaxStackDepth );
+            
+            if( registers.has_value() )
+            {
+                this->_hasRegisters = true;
+                
+                for( size_t i = 0; i < this->_registers.size(); i++ )
+                {
+                    this->_registers[ i ] = registers.value().valueAt( i );
+                }
+                
+                for( size_t i = 0; i < this->_selectors.size(); i++ )
+                {
+                    this->_selectors[ i ] = registers.value().selector( Segments[ i ] );
+                    this->_bases[ i ]     = registers.value().base( Segments[ i ] );
+                }
+            }
+            
+            std::copy( stack.begin(), stack.begin() + numeric_cast< std::ptrdiff_t >( this->_stackDepth ), this->_stack.begin() );
+        }
+        
+        Sample::Sample( std::chrono::system_clock::time_point timestamp, const Words & words ):
+            Sample()
+        {
+            const uint64_t * p( words.data() );
+            
+            this->_sequence     = *( p++ );
+            this->_timestamp    = timestamp;
+            this->_hasRegisters = *( p++ ) != 0;
+            
+            std::copy( p, p + this->_registers.size(), this->_registers.begin() );
+            
+            p += this->_registers.size();
+            
+            std::copy( p, p + this->_selectors.size(), this->_selectors.begin() );
+            
+            p += this->_selectors.size();
+            
+            std::copy( p, p + this->_bases.size(), this->_bases.begin() );
+            
+            p += this->_bases.size();
+            
+            this->_stackDepth = numeric_cast< size_t >( std::min< uint64_t >( *( p++ ), MaxStackDepth ) );
+            
+            for( auto & entry: this->_stack )
+            {
+                entry.bp(    unpack( p ) );
+                entry.retBP( unpack( p ) );
+                entry.retIP( unpack( p ) );
+                entry.ip(    unpack( p ) );
+                entry.arg0(  *( p++ ) );
+                entry.arg1(  *( p++ ) );
+                entry.arg2(  *( p++ ) );
+                entry.arg3(  *( p++ ) );
+            }
+        }
+        
+        uint64_t Sample::sequence( void ) const
+        {
+            return this->_sequence;
+        }
+        
+        std::chrono::system_clock::time_point Sample::timestamp( void ) const
+        {
+            return this->_timestamp;
+        }
+        
+        std::optional< Registers > Sample::registers( void ) const
+        {
+            Registers registers;
+            
+            if( this->_hasRegisters == false )
+            {
+                return {};
+            }
+            
+            for( size_t i = 0; i < this->_registers.size(); i++ )
+            {
+                registers.valueAt( i, this->_registers[ i ] );
+            }
+            
+            for( size_t i = 0; i < this->_selectors.size(); i++ )
+            {
+                registers.selector( Segments[ i ], this->_selectors[ i ] );
+                registers.base( Segments[ i ], this->_bases[ i ] );
+            }
+            
+            return registers;
+        }
+        
+        std::vector< StackEntry > Sample::stack( void ) const
+        {
+            return std::vector< StackEntry >( this->_stack.begin(), this->_stack.begin() + numeric_cast< std::ptrdiff_t >( this->_stackDepth ) );
+        }
+        
+        Sample::Words Sample::words( void ) const
+        {
+            Words      words {};
+            uint64_t * p( words.data() );
+            
+            *( p++ ) = this->_sequence;
+            *( p++ ) = ( this->_hasRegisters ) ? 1 : 0;
+            
+            p = std::copy( this->_registers.begin(), this->_registers.end(), p );
+            p = std::copy( this->_selectors.begin(), this->_selectors.end(), p );
+            p = std::copy( this->_bases.begin(),     this->_bases.end(),     p );
+            
+            *( p++ ) = this->_stackDepth;
+            
+            for( const auto & entry: this->_stack )
+            {
+                p = pack( entry.bp(),    p );
+                p = pack( entry.retBP(), p );
+                p = pack( entry.retIP(), p );
+                p = pack( entry.ip(),    p );
+                *( p++ ) = entry.arg0();
+                *( p++ ) = entry.arg1();
+                *( p++ ) = entry.arg2();
+                *( p++ ) = entry.arg3();
+            }
+            
+            return words;
+        }
+        
+        void swap( Sample & o1, Sample & o2 )
+        {
+            using std::swap;
+            
+            swap( o1._sequence,     o2._sequence );
+            swap( o1._timestamp,    o2._timestamp );
+            swap( o1._hasRegisters, o2._hasRegisters );
+            swap( o1._registers,    o2._registers );
+            swap( o1._selectors,    o2._selectors );
+            swap( o1._bases,        o2._bases );
+            swap( o1._stackDepth,   o2._stackDepth );
+            swap( o1._stack,        o2._stack );
+        }
+    }
+}
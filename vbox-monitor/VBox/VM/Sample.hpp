@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_SAMPLE_HPP
+#define VBOX_VM_SAMPLE_HPP
+
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <optional>
+#include <chrono>
+#include "VBox/VM/Registers.hpp"
+#include "VBox/VM/StackEntry.hpp"
+#include "VBox/VM/Snapshot.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        class Sample
+        {
+            public:
+                
+                static constexpr size_t MaxStackDepth = 16;
+                static constexpr size_t WordCount     = 37 + MaxStackDepth * 12;
+                
+                using Words = std::array< uint64_t, WordCount >;
+                
+                Sample( void );
+                Sample( const Snapshot & snapshot );
+                Sample( std::chrono::system_clock::time_point timestamp, const Words & words );
+                
+                uint64_t                              sequence( void )  const;
+                std::chrono::system_clock::time_point timestamp( void ) const;
+                std::optional< Registers >            registers( void ) const;
+                std::vector< StackEntry >             stack( void )     const;
+                Words                                 words( void )     const;
+                
+                friend void swap( Sample & o1, Sample & o2 );
+                
+            private:
+                
+                uint64_t                                 _sequence;
+                std::chrono::system_clock::time_point    _timestamp;
+                bool                                     _hasRegisters;
+                std::array< uint64_t, Registers::Count > _registers;
+                std::array< uint64_t, 6 >                _selectors;
+                std::array< uint64_t, 6 >                _bases;
+                size_t                                   _stackDepth;
+                std::array< StackEntry, MaxStackDepth >  _stack;
+        };
+    }
+}
+
+#endif /* VBOX_VM_SAMPLE_HPP */
@@ -0,0 +1,404 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/Search.hpp"
+#include "VBox/ThreadPool.hpp"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <cstring>
+
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#elif defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+namespace VBox
+{
+    namespace VM
+    {
+        class Search::IMPL
+        {
+            public:
+                
+                IMPL( const std::shared_ptr< CoreDump > & dump, const Pattern & pattern, size_t maximum );
+                IMPL( const IMPL & o );
+                ~IMPL( void );
+                
+                static size_t _blockSize( void );
+                
+                void _run( size_t block );
+                void _scan( const uint8_t * data, size_t size, uint64_t base, uint64_t end, std::vector< uint64_t > & hits ) const;
+                void _stop( void );
+                
+                std::shared_ptr< CoreDump >                             _dump;
+                Pattern                                                 _pattern;
+                size_t                                                  _maximum;
+                uint64_t                                                _group;
+                size_t                                                  _jobs;
+                std::atomic< bool >                                     _started;
+                std::atomic< bool >                                     _cancel;
+                std::atomic< bool >                                     _truncated;
+                std::atomic< size_t >                                   _running;
+                std::vector< std::pair< uint64_t, uint64_t > >          _blocks;
+                uint64_t                                                _total;
+                std::atomic< uint64_t >                                 _scanned;
+                std::vector< uint64_t >                                 _results;
+                std::vector< std::optional< std::vector< uint64_t > > > _pending;
+                size_t                                                  _merged;
+                std::vector< std::function< void( void ) > >            _onProgress;
+                mutable std::mutex                                      _mtx;
+                std::condition_variable                                 _cv;
+        };
+        
+        Search::Search( const std::shared_ptr< CoreDump > & dump, const Pattern & pattern, size_t maximum ):
+            impl( std::make_unique< IMPL >( dump, pattern, maximum ) )
+        {}
+        
+        Search::Search( const Search & o ):
+            impl( std::make_unique< IMPL >( *( o.impl ) ) )
+        {}
+        
+        Search::Search( Search && o ):
+            impl( std::move( o.impl ) )
+        {}
+        
+        Search::~Search( void )
+        {}
+        
+        Search & Search::operator =( Search o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        Pattern Search::pattern( void ) const
+        {
+            return this->impl->_pattern;
+        }
+        
+        bool Search::done( void ) const
+        {
+            return this->impl->_started.load() && this->impl->_running.load() == 0;
+        }
+        
+        bool Search::truncated( void ) const
+        {
+            return this->impl->_truncated.load();
+        }
+        
+        double Search::progress( void ) const
+        {
+            if( this->impl->_total == 0 )
+            {
+                return 1;
+            }
+            
+            return std::min( static_cast< double >( this->impl->_scanned.load() ) / static_cast< double >( this->impl->_total ), 1.0 );
+        }
+        
+        size_t Search::count( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_results.size();
+        }
+        
+        std::vector< uint64_t > Search::results( void ) const
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            return this->impl->_results;
+        }
+        
+        void Search::start( void )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            if( this->impl->_started )
+            {
+                return;
+            }
+            
+            {
+                size_t n( std::max< size_t >( this->impl->_blocks.size(), 1 ) );
+                IMPL * search( this->impl.get() );
+                
+                this->impl->_running = n;
+                this->impl->_jobs    = n;
+                this->impl->_started = true;
+                
+                for( size_t i = 0; i < n; i++ )
+                {
+                    ThreadPool::shared().submit( this->impl->_group, ThreadPool::Priority::Low, [ search, i ] { search->_run( i ); } );
+                }
+            }
+        }
+        
+        void Search::cancel( void )
+        {
+            this->impl->_stop();
+        }
+        
+        void Search::onProgress( const std::function< void( void ) > & f )
+        {
+            std::lock_guard< std::mutex > l( this->impl->_mtx );
+            
+            this->impl->_onProgress.push_back( f );
+        }
+        
+        void swap( Search & o1, Search & o2 )
+        {
+            using std::swap;
+            
+            swap( o1.impl, o2.impl );
+        }
+        
+        Search::IMPL::IMPL( const std::shared_ptr< CoreDump > & dump, const Pattern & pattern, size_t maximum ):
+            _dump(      dump ),
+            _pattern(   pattern ),
+            _maximum(   maximum ),
+            _group(     ThreadPool::shared().group() ),
+            _jobs(      0 ),
+            _started(   false ),
+            _cancel(    false ),
+            _truncated( false ),
+            _running(   0 ),
+            _total(     0 ),
+            _scanned(   0 ),
+            _merged(    0 )
+        {
+            if( dump == nullptr )
+            {
+                return;
+            }
+            
+            for( const auto & segment: dump->segments() )
+            {
+                for( uint64_t start = segment.first; start < segment.first + segment.second; start += _blockSize() )
+                {
+                    this->_blocks.push_back( { start, std::min< uint64_t >( start + _blockSize(), segment.first + segment.second ) } );
+                }
+                
+                this->_total += segment.second;
+            }
+            
+            std::sort( this->_blocks.begin(), this->_blocks.end() );
+            
+            this->_pending.resize( this->_blocks.size() );
+        }
+        
+        Search::IMPL::IMPL( const IMPL & o ):
+            IMPL( o._dump, o._pattern, o._maximum )
+        {}
+        
+        Search::IMPL::~IMPL( void )
+        {
+            this->_stop();
+        }
+        
+        size_t Search::IMPL::_blockSize( void )
+        {
+            return 4 * 1024 * 1024;
+        }
+        
+        void Search::IMPL::_run( size_t block )
+        {
+            size_t length( this->_pattern.bytes().size() );
+            
+            if( this->_cancel == false && length > 0 && block < this->_blocks.size() )
+            {
+                uint64_t                size(  this->_dump->memorySize() );
+                uint64_t                start( this->_blocks[ block ].first );
+                uint64_t                end(   this->_blocks[ block ].second );
+                size_t                  n(     static_cast< size_t >( std::min< uint64_t >( end - start + length - 1, size - start ) ) );
+                std::vector< uint8_t >  buffer( n );
+                std::vector< uint64_t > hits;
+                
+                this->_dump->peekMemory( static_cast< size_t >( start ), buffer.data(), n );
+                this->_scan( buffer.data(), n, start, end, hits );
+                
+                {
+                    std::vector< std::function< void( void ) > > onProgress;
+                    
+                    {
+                        std::lock_guard< std::mutex > l( this->_mtx );
+                        
+                        if( hits.size() > this->_maximum )
+                        {
+                            hits.resize( this->_maximum + 1 );
+                        }
+                        
+                        this->_pending[ block ] = std::move( hits );
+                        
+                        while( this->_truncated == false && this->_merged < this->_pending.size() && this->_pending[ this->_merged ].has_value() )
+                        {
+                            std::vector< uint64_t > & next( this->_pending[ this->_merged ].value() );
+                            
+                            if( this->_results.size() + next.size() > this->_maximum )
+                            {
+                                next.resize( this->_maximum - this->_results.size() );
+                                
+                                this->_truncated = true;
+                                this->_cancel    = true;
+                            }
+                            
+                            this->_results.insert( this->_results.end(), next.begin(), next.end() );
+                            this->_pending[ this->_merged ].reset();
+                            
+                            this->_merged++;
+                        }
+                        
+                        this->_scanned += end - start;
+                        onProgress      = this->_onProgress;
+                    }
+                    
+                    for( const auto & f: onProgress )
+                    {
+                        f();
+                    }
+                }
+            }
+            
+            if( this->_running.fetch_sub( 1 ) == 1 )
+            {
+                std::vector< std::function< void( void ) > > onProgress;
+                
+                {
+                    std::lock_guard< std::mutex > l( this->_mtx );
+                    
+                    onProgress = this->_onProgress;
+                }
+                
+                for( const auto & f: onProgress )
+                {
+                    f();
+                }
+            }
+            
+            {
+                std::lock_guard< std::mutex > l( this->_mtx );
+                
+                this->_jobs--;
+                
+                this->_cv.notify_all();
+            }
+        }
+        
+        void Search::IMPL::_scan( const uint8_t * data, size_t size, uint64_t base, uint64_t end, std::vector< uint64_t > & hits ) const
+        {
+            const uint8_t * pattern(   this->_pattern.bytes().data() );
+            size_t          length(    this->_pattern.bytes().size() );
+            size_t          alignment( this->_pattern.alignment() );
+            size_t          last;
+            size_t          i( 0 );
+            
+            if( size < length )
+            {
+                return;
+            }
+            
+            last = std::min< size_t >( size - length, static_cast< size_t >( end - base - 1 ) );
+            
+            auto verify = [ & ]( size_t offset )
+            {
+                if( ( base + offset ) % alignment == 0 && memcmp( data + offset, pattern, length ) == 0 )
+                {
+                    hits.push_back( base + offset );
+                }
+            };
+            
+            #if defined( __AVX2__ )
+            {
+                __m256i first( _mm256_set1_epi8( static_cast< char >( pattern[ 0 ] ) ) );
+                __m256i final( _mm256_set1_epi8( static_cast< char >( pattern[ length - 1 ] ) ) );
+                
+                for( ; i + 32 <= last + 1; i += 32 )
+                {
+                    __m256i  a( _mm256_loadu_si256( reinterpret_cast< const __m256i * >( data + i ) ) );
+                    __m256i  b( _mm256_loadu_si256( reinterpret_cast< const __m256i * >( data + i + length - 1 ) ) );
+                    uint32_t mask( static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_and_si256( _mm256_cmpeq_epi8( a, first ), _mm256_cmpeq_epi8( b, final ) ) ) ) );
+                    
+                    while( mask != 0 )
+                    {
+                        verify( i + static_cast< size_t >( __builtin_ctz( mask ) ) );
+                        
+                        mask &= mask - 1;
+                    }
+                }
+            }
+            #elif defined( __SSE2__ )
+            {
+                __m128i first( _mm_set1_epi8( static_cast< char >( pattern[ 0 ] ) ) );
+                __m128i final( _mm_set1_epi8( static_cast< char >( pattern[ length - 1 ] ) ) );
+                
+                for( ; i + 16 <= last + 1; i += 16 )
+                {
+                    __m128i  a( _mm_loadu_si128( reinterpret_cast< const __m128i * >( data + i ) ) );
+                    __m128i  b( _mm_loadu_si128( reinterpret_cast< const __m128i * >( data + i + length - 1 ) ) );
+                    uint32_t mask( static_cast< uint32_t >( _mm_movemask_epi8( _mm_and_si128( _mm_cmpeq_epi8( a, first ), _mm_cmpeq_epi8( b, final ) ) ) ) );
+                    
+                    while( mask != 0 )
+                    {
+                        verify( i + static_cast< size_t >( __builtin_ctz( mask ) ) );
+                        
+                        mask &= mask - 1;
+                    }
+                }
+            }
+            #endif
+            
+            while( i <= last )
+            {
+                const uint8_t * p( static_cast< const uint8_t * >( memchr( data + i, pattern[ 0 ], last + 1 - i ) ) );
+                
+                if( p == nullptr )
+                {
+                    break;
+                }
+                
+                i = static_cast< size_t >( p - data );
+                
+                verify( i++ );
+            }
+        }
+        
+        void Search::IMPL::_stop( void )
+        {
+            std::unique_lock< std::mutex > l( this->_mtx );
+            size_t                         n;
+            
+            this->_cancel = true;
+            n             = ThreadPool::shared().cancel( this->_group );
+            
+            this->_running -= n;
+            this->_jobs    -= n;
+            
+            this->_cv.wait( l, [ & ] { return this->_jobs == 0; } );
+        }
+    }
+}
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_SEARCH_HPP
+#define VBOX_VM_SEARCH_HPP
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "VBox/VM/CoreDump.hpp"
+#include "VBox/VM/Pattern.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        class Search
+        {
+            public:
+                
+                Search( const std::shared_ptr< CoreDump > & dump, const Pattern & pattern, size_t maximum = 65536 );
+                Search( const Search & o );
+                Search( Search && o );
+                ~Search( void );
+                
+                Search & operator =( Search o );
+                
+                Pattern                 pattern( void )   const;
+                bool                    done( void )      const;
+                bool                    truncated( void ) const;
+                double                  progress( void )  const;
+                size_t                  count( void )     const;
+                std::vector< uint64_t > results( void )   const;
+                
+                void start( void );
+                void cancel( void );
+                void onProgress( const std::function< void( void ) > & f );
+                
+                friend void swap( Search & o1, Search & o2 );
+                
+            private:
+                
+                class IMPL;
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_VM_SEARCH_HPP */
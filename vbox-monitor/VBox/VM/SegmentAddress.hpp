@@ -27,7 +27,6 @@
 
 #include <cstdint>
 #include <algorithm>
-#include <memory>
 
 namespace VBox
 {
@@ -38,25 +37,20 @@ namespace VBox
             public:
                 
                 SegmentAddress( void );
-                SegmentAddress( uint32_t segment, uint32_t address );
-                SegmentAddress( const SegmentAddress & o );
-                SegmentAddress( SegmentAddress && o );
-                ~SegmentAddress( void );
-                
-                SegmentAddress & operator =( SegmentAddress o );
+                SegmentAddress( uint32_t segment, uint64_t address );
                 
                 uint32_t segment( void ) const;
-                uint32_t address( void ) const;
+                uint64_t address( void ) const;
                 
                 void segment( uint32_t value );
-                void address( uint32_t value );
+                void address( uint64_t value );
                 
                 friend void swap( SegmentAddress & o1, SegmentAddress & o2 );
                 
             private:
                 
-                class IMPL;
-                std::unique_ptr< IMPL > impl;
+                uint32_t _segment;
+                uint64_t _address;
         };
     }
 }
@@ -0,0 +1,201 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/Snapshot.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        class Snapshot::IMPL
+        {
+            public:
+                
+                IMPL( void );
+                IMPL( const IMPL & o );
+                
+                void _advance( void );
+                
+                uint64_t                                           _sequence;
+                uint64_t                                           _registersSequence;
+                uint64_t                                           _stackSequence;
+                uint64_t                                           _dumpSequence;
+                uint64_t                                           _timeouts;
+                std::chrono::system_clock::time_point              _timestamp;
+                std::optional< Registers >                         _registers;
+                std::shared_ptr< const std::vector< StackEntry > > _stack;
+                std::shared_ptr< CoreDump >                        _dump;
+        };
+        
+        Snapshot::Snapshot( void ):
+            impl( std::make_unique< IMPL >() )
+        {}
+        
+        Snapshot::Snapshot( const Snapshot & o ):
+            impl( std::make_unique< IMPL >( *( o.impl ) ) )
+        {}
+        
+        Snapshot::Snapshot( Snapshot && o ):
+            impl( std::move( o.impl ) )
+        {}
+        
+        Snapshot::~Snapshot( void )
+        {}
+        
+        Snapshot & Snapshot::operator =( Snapshot o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        uint64_t Snapshot::sequence( void ) const
+        {
+            return this->impl->_sequence;
+        }
+        
+        uint64_t Snapshot::registersSequence( void ) const
+        {
+            return this->impl->_registersSequence;
+        }
+        
+        uint64_t Snapshot::stackSequence( void ) const
+        {
+            return this->impl->_stackSequence;
+        }
+        
+        uint64_t Snapshot::dumpSequence( void ) const
+        {
+            return this->impl->_dumpSequence;
+        }
+        
+        uint64_t Snapshot::timeouts( void ) const
+        {
+            return this->impl->_timeouts;
+        }
+        
+        std::chrono::system_clock::time_point Snapshot::timestamp( void ) const
+        {
+            return this->impl->_timestamp;
+        }
+        
+        const std::optional< Registers > & Snapshot::registers( void ) const
+        {
+            return this->impl->_registers;
+        }
+        
+        const std::vector< StackEntry > & Snapshot::stack( void ) const
+        {
+            return *( this->impl->_stack );
+        }
+        
+        std::shared_ptr< CoreDump > Snapshot::dump( void ) const
+        {
+            return this->impl->_dump;
+        }
+        
+        Snapshot Snapshot::withRegisters( const std::optional< Registers > & registers ) const
+        {
+            Snapshot s( *( this ) );
+            
+            s.impl->_advance();
+            
+            s.impl->_registers         = registers;
+            s.impl->_registersSequence = s.impl->_sequence;
+            
+            return s;
+        }
+        
+        Snapshot Snapshot::withStack( const std::vector< StackEntry > & stack ) const
+        {
+            Snapshot s( *( this ) );
+            
+            s.impl->_advance();
+            
+            s.impl->_stack         = std::make_shared< const std::vector< StackEntry > >( stack );
+            s.impl->_stackSequence = s.impl->_sequence;
+            
+            return s;
+        }
+        
+        Snapshot Snapshot::withDump( const std::shared_ptr< CoreDump > & dump ) const
+        {
+            Snapshot s( *( this ) );
+            
+            s.impl->_advance();
+            
+            s.impl->_dump         = dump;
+            s.impl->_dumpSequence = s.impl->_sequence;
+            
+            return s;
+        }
+        
+        Snapshot Snapshot::withTimeout( void ) const
+        {
+            Snapshot s( *( this ) );
+            
+            s.impl->_advance();
+            
+            s.impl->_timeouts++;
+            
+            return s;
+        }
+        
+        void swap( Snapshot & o1, Snapshot & o2 )
+        {
+            using std::swap;
+            
+            swap( o1.impl, o2.impl );
+        }
+        
+        Snapshot::IMPL::IMPL( void ):
+            _sequence(          0 ),
+            _registersSequence( 0 ),
+            _stackSequence(     0 ),
+            _dumpSequence(      0 ),
+            _timeouts(          0 ),
+            _timestamp(         std::chrono::system_clock::now() ),
+            _stack(             std::make_shared< const std::vector< StackEntry > >() )
+        {}
+        
+        Snapshot::IMPL::IMPL( const IMPL & o ):
+            _sequence(          o._sequence ),
+            _registersSequence( o._registersSequence ),
+            _stackSequence(     o._stackSequence ),
+            _dumpSequence(      o._dumpSequence ),
+            _timeouts(          o._timeouts ),
+            _timestamp(         o._timestamp ),
+            _registers(         o._registers ),
+            _stack(             o._stack ),
+            _dump(              o._dump )
+        {}
+        
+        void Snapshot::IMPL::_advance( void )
+        {
+            this->_sequence++;
+            
+            this->_timestamp = std::chrono::system_clock::now();
+        }
+    }
+}
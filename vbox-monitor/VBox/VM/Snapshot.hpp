@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_SNAPSHOT_HPP
+#define VBOX_VM_SNAPSHOT_HPP
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+#include "VBox/VM/Registers.hpp"
+#include "VBox/VM/StackEntry.hpp"
+#include "VBox/VM/CoreDump.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        class Snapshot
+        {
+            public:
+                
+                Snapshot( void );
+                Snapshot( const Snapshot & o );
+                Snapshot( Snapshot && o );
+                ~Snapshot( void );
+                
+                Snapshot & operator =( Snapshot o );
+                
+                uint64_t                              sequence( void )          const;
+                uint64_t                              registersSequence( void ) const;
+                uint64_t                              stackSequence( void )     const;
+                uint64_t                              dumpSequence( void )      const;
+                uint64_t                              timeouts( void )          const;
+                std::chrono::system_clock::time_point timestamp( void )         const;
+                const std::optional< Registers >    & registers( void )         const;
+                const std::vector< StackEntry >     & stack( void )             const;
+                std::shared_ptr< CoreDump >           dump( void )              const;
+                
+                Snapshot withRegisters( const std::optional< Registers > & registers ) const;
+                Snapshot withStack( const std::vector< StackEntry > & stack )          const;
+                Snapshot withDump( const std::shared_ptr< CoreDump > & dump )          const;
+                Snapshot withTimeout( void )                                           const;
+                
+                friend void swap( Snapshot & o1, Snapshot & o2 );
+                
+            private:
+                
+                class IMPL;
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_VM_SNAPSHOT_HPP */
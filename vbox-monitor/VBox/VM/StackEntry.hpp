@@ -27,7 +27,6 @@
 
 #include "VBox/VM/SegmentAddress.hpp"
 #include <cstdint>
-#include <memory>
 #include <algorithm>
 #include <ostream>
 #include <vector>
@@ -41,36 +40,37 @@ namespace VBox
             public:
                 
                 StackEntry( void );
-                StackEntry( const StackEntry & o );
-                StackEntry( StackEntry && o );
-                ~StackEntry( void );
-                
-                StackEntry & operator =( StackEntry o );
                 
                 SegmentAddress bp( void )    const;
                 SegmentAddress retBP( void ) const;
                 SegmentAddress retIP( void ) const;
-                uint32_t       arg0( void )  const;
-                uint32_t       arg1( void )  const;
-                uint32_t       arg2( void )  const;
-                uint32_t       arg3( void )  const;
+                uint64_t       arg0( void )  const;
+                uint64_t       arg1( void )  const;
+                uint64_t       arg2( void )  const;
+                uint64_t       arg3( void )  const;
                 SegmentAddress ip( void )    const;
                 
                 void bp(    const SegmentAddress & value );
                 void retBP( const SegmentAddress & value );
                 void retIP( const SegmentAddress & value );
-                void arg0(  uint32_t value );
-                void arg1(  uint32_t value );
-                void arg2(  uint32_t value );
-                void arg3(  uint32_t value );
+                void arg0(  uint64_t value );
+                void arg1(  uint64_t value );
+                void arg2(  uint64_t value );
+                void arg3(  uint64_t value );
                 void ip(    const SegmentAddress & value );
                 
                 friend void swap( StackEntry & o1, StackEntry & o2 );
                 
             private:
                 
-                class IMPL;
-                std::unique_ptr< IMPL > impl;
+                SegmentAddress _bp;
+                SegmentAddress _retBP;
+                SegmentAddress _retIP;
+                uint64_t       _arg0;
+                uint64_t       _arg1;
+                uint64_t       _arg2;
+                uint64_t       _arg3;
+                SegmentAddress _ip;
         };
     }
 }
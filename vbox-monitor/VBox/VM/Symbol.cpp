@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/Symbol.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        Symbol::Symbol( void ):
+            _address( 0 ),
+            _kind(    Kind::Function )
+        {}
+        
+        Symbol::Symbol( uint64_t address, Kind kind, const std::string & name ):
+            _address( address ),
+            _kind(    kind ),
+            _name(    name )
+        {}
+        
+        Symbol::Symbol( const Symbol & o ):
+            _address( o._address ),
+            _kind(    o._kind ),
+            _name(    o._name )
+        {}
+        
+        Symbol::Symbol( Symbol && o ) noexcept:
+            _address( o._address ),
+            _kind(    o._kind ),
+            _name(    std::move( o._name ) )
+        {}
+        
+        Symbol::~Symbol( void )
+        {}
+        
+        Symbol & Symbol::operator =( Symbol o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        uint64_t Symbol::address( void ) const
+        {
+            return this->_address;
+        }
+        
+        Symbol::Kind Symbol::kind( void ) const
+        {
+            return this->_kind;
+        }
+        
+        const std::string & Symbol::name( void ) const
+        {
+            return this->_name;
+        }
+        
+        void swap( Symbol & o1, Symbol & o2 )
+        {
+            using std::swap;
+            
+            swap( o1._address, o2._address );
+            swap( o1._kind,    o2._kind );
+            swap( o1._name,    o2._name );
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_SYMBOL_HPP
+#define VBOX_VM_SYMBOL_HPP
+
+#include <algorithm>
+#include <string>
+#include <cstdint>
+
+namespace VBox
+{
+    namespace VM
+    {
+        class Symbol
+        {
+            public:
+                
+                enum class Kind
+                {
+                    Function,
+                    String
+                };
+                
+                Symbol( void );
+                Symbol( uint64_t address, Kind kind, const std::string & name );
+                Symbol( const Symbol & o );
+                Symbol( Symbol && o ) noexcept;
+                ~Symbol( void );
+                
+                Symbol & operator =( Symbol o );
+                
+                uint64_t            address( void ) const;
+                Kind                kind( void )    const;
+                const std::string & name( void )    const;
+                
+                friend void swap( Symbol & o1, Symbol & o2 );
+                
+            private:
+                
+                uint64_t    _address;
+                Kind        _kind;
+                std::string _name;
+        };
+    }
+}
+
+#endif /* VBOX_VM_SYMBOL_HPP */
@@ -0,0 +1,275 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/SymbolIndex.hpp"
+#include "VBox/String.hpp"
+#include "VBox/Casts.hpp"
+#include <unordered_map>
+#include <cstring>
+
+namespace VBox
+{
+    namespace VM
+    {
+        class SymbolIndex::IMPL
+        {
+            public:
+                
+                IMPL( std::vector< Symbol > symbols );
+                IMPL( const IMPL & o );
+                
+                std::vector< Symbol >                     _symbols;
+                std::unordered_map< std::string, size_t > _names;
+        };
+        
+        SymbolIndex::SymbolIndex( void ):
+            SymbolIndex( std::vector< Symbol >() )
+        {}
+        
+        SymbolIndex::SymbolIndex( std::vector< Symbol > symbols ):
+            impl( std::make_unique< IMPL >( std::move( symbols ) ) )
+        {}
+        
+        SymbolIndex::SymbolIndex( const SymbolIndex & o ):
+            impl( std::make_unique< IMPL >( *( o.impl ) ) )
+        {}
+        
+        SymbolIndex::SymbolIndex( SymbolIndex && o ):
+            impl( std::move( o.impl ) )
+        {}
+        
+        SymbolIndex::~SymbolIndex( void )
+        {}
+        
+        SymbolIndex & SymbolIndex::operator =( SymbolIndex o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        size_t SymbolIndex::size( void ) const
+        {
+            return this->impl->_symbols.size();
+        }
+        
+        bool SymbolIndex::empty( void ) const
+        {
+            return this->impl->_symbols.empty();
+        }
+        
+        std::optional< Symbol > SymbolIndex::at( uint64_t address ) const
+        {
+            auto i
+            (
+                std::upper_bound
+                (
+                    this->impl->_symbols.begin(),
+                    this->impl->_symbols.end(),
+                    address,
+                    []( uint64_t a, const Symbol & s ) { return a < s.address(); }
+                )
+            );
+            
+            if( i == this->impl->_symbols.begin() )
+            {
+                return {};
+            }
+            
+            return *( i - 1 );
+        }
+        
+        std::optional< Symbol > SymbolIndex::next( uint64_t address ) const
+        {
+            auto i
+            (
+                std::upper_bound
+                (
+                    this->impl->_symbols.begin(),
+                    this->impl->_symbols.end(),
+                    address,
+                    []( uint64_t a, const Symbol & s ) { return a < s.address(); }
+                )
+            );
+            
+            if( i == this->impl->_symbols.end() )
+            {
+                return {};
+            }
+            
+            return *( i );
+        }
+        
+        std::optional< Symbol > SymbolIndex::previous( uint64_t address ) const
+        {
+            auto i
+            (
+                std::lower_bound
+                (
+                    this->impl->_symbols.begin(),
+                    this->impl->_symbols.end(),
+                    address,
+                    []( const Symbol & s, uint64_t a ) { return s.address() < a; }
+                )
+            );
+            
+            if( i == this->impl->_symbols.begin() )
+            {
+                return {};
+            }
+            
+            return *( i - 1 );
+        }
+        
+        std::optional< Symbol > SymbolIndex::find( const std::string & name ) const
+        {
+            auto i( this->impl->_names.find( name ) );
+            
+            if( i == this->impl->_names.end() )
+            {
+                return {};
+            }
+            
+            return this->impl->_symbols[ i->second ];
+        }
+        
+        std::string SymbolIndex::describe( uint64_t address ) const
+        {
+            std::optional< Symbol > symbol( this->at( address ) );
+            
+            if( symbol.has_value() == false )
+            {
+                return "";
+            }
+            
+            if( symbol->address() == address )
+            {
+                return symbol->name();
+            }
+            
+            {
+                char   buffer[ 2 * sizeof( uint64_t ) ];
+                char * end(   String::toHex( address - symbol->address(), buffer ) );
+                char * first( buffer );
+                
+                while( first < end - 1 && *( first ) == '0' )
+                {
+                    first++;
+                }
+                
+                return symbol->name() + "+0x" + std::string( first, end );
+            }
+        }
+        
+        std::string_view SymbolIndex::describe( uint64_t address, Arena & arena ) const
+        {
+            auto i
+            (
+                std::upper_bound
+                (
+                    this->impl->_symbols.begin(),
+                    this->impl->_symbols.end(),
+                    address,
+                    []( uint64_t a, const Symbol & s ) { return a < s.address(); }
+                )
+            );
+            
+            if( i == this->impl->_symbols.begin() )
+            {
+                return {};
+            }
+            
+            {
+                const Symbol      & symbol( *( i - 1 ) );
+                const std::string & name( symbol.name() );
+                
+                if( symbol.address() == address )
+                {
+                    return name;
+                }
+                
+                {
+                    char   buffer[ 2 * sizeof( uint64_t ) ];
+                    char * end(   String::toHex( address - symbol.address(), buffer ) );
+                    char * first( buffer );
+                    size_t length( 0 );
+                    char * out( nullptr );
+                    
+                    while( first < end - 1 && *( first ) == '0' )
+                    {
+                        first++;
+                    }
+                    
+                    length = name.size() + 3 + numeric_cast< size_t >( end - first );
+                    out    = static_cast< char * >( arena.allocate( length, 1 ) );
+                    
+                    std::memcpy( out, name.data(), name.size() );
+                    std::memcpy( out + name.size(), "+0x", 3 );
+                    std::memcpy( out + name.size() + 3, first, numeric_cast< size_t >( end - first ) );
+                    
+                    return std::string_view( out, length );
+                }
+            }
+        }
+        
+        void swap( SymbolIndex & o1, SymbolIndex & o2 )
+        {
+            using std::swap;
+            
+            swap( o1.impl, o2.impl );
+        }
+        
+        SymbolIndex::IMPL::IMPL( std::vector< Symbol > symbols ):
+            _symbols( std::move( symbols ) )
+        {
+            std::sort
+            (
+                this->_symbols.begin(),
+                this->_symbols.end(),
+                []( const Symbol & s1, const Symbol & s2 ) { return s1.address() < s2.address(); }
+            );
+            
+            this->_symbols.erase
+            (
+                std::unique
+                (
+                    this->_symbols.begin(),
+                    this->_symbols.end(),
+                    []( const Symbol & s1, const Symbol & s2 ) { return s1.address() == s2.address(); }
+                ),
+                this->_symbols.end()
+            );
+            
+            for( size_t i = 0; i < this->_symbols.size(); i++ )
+            {
+                this->_names[ this->_symbols[ i ].name() ] = i;
+            }
+        }
+        
+        SymbolIndex::IMPL::IMPL( const IMPL & o ):
+            _symbols( o._symbols ),
+            _names(   o._names )
+        {}
+    }
+}
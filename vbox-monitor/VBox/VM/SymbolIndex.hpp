@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_SYMBOL_INDEX_HPP
+#define VBOX_VM_SYMBOL_INDEX_HPP
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "VBox/VM/Symbol.hpp"
+#include "VBox/Arena.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        class SymbolIndex
+        {
+            public:
+                
+                SymbolIndex( void );
+                SymbolIndex( std::vector< Symbol > symbols );
+                SymbolIndex( const SymbolIndex & o );
+                SymbolIndex( SymbolIndex && o );
+                ~SymbolIndex( void );
+                
+                SymbolIndex & operator =( SymbolIndex o );
+                
+                size_t size( void )  const;
+                bool   empty( void ) const;
+                
+                std::optional< Symbol > at( uint64_t address )                     const;
+                std::optional< Symbol > next( uint64_t address )                   const;
+                std::optional< Symbol > previous( uint64_t address )               const;
+                std::optional< Symbol > find( const std::string & name )           const;
+                std::string             describe( uint64_t address )               const;
+                std::string_view        describe( uint64_t address, Arena & arena ) const;
+                
+                friend void swap( SymbolIndex & o1, SymbolIndex & o2 );
+                
+            private:
+                
+                class IMPL;
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_VM_SYMBOL_INDEX_HPP */
@@ -0,0 +1,299 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/Trigger.hpp"
+#include "VBox/VM/Registers.hpp"
+#include "VBox/String.hpp"
+#include <vector>
+
+namespace VBox
+{
+    namespace VM
+    {
+        static const uint64_t MaxPatternRange = 1024 * 1024;
+        
+        Trigger::Trigger( void ):
+            _kind(          Kind::RegisterEquals ),
+            _registerIndex( 0 ),
+            _begin(         0 ),
+            _end(           0 ),
+            _width(         0 )
+        {}
+        
+        Trigger::Trigger( const Trigger & o ):
+            _kind(          o._kind ),
+            _description(   o._description ),
+            _registerIndex( o._registerIndex ),
+            _begin(         o._begin ),
+            _end(           o._end ),
+            _width(         o._width ),
+            _pattern(       o._pattern )
+        {}
+        
+        Trigger::Trigger( Trigger && o ) noexcept:
+            _kind(          o._kind ),
+            _description(   std::move( o._description ) ),
+            _registerIndex( o._registerIndex ),
+            _begin(         o._begin ),
+            _end(           o._end ),
+            _width(         o._width ),
+            _pattern(       std::move( o._pattern ) )
+        {}
+        
+        Trigger::~Trigger( void )
+        {}
+        
+        Trigger & Trigger::operator =( Trigger o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        std::optional< Trigger > Trigger::parse( const std::string & spec )
+        {
+            Trigger                    trigger;
+            std::string_view           s( spec );
+            std::string                lower;
+            std::vector< std::string > tokens;
+            
+            while( s.empty() == false && s.front() == ' ' ) { s.remove_prefix( 1 ); }
+            while( s.empty() == false && s.back()  == ' ' ) { s.remove_suffix( 1 ); }
+            
+            trigger._description = std::string( s );
+            lower                = String::toLower( trigger._description );
+            
+            if( lower.rfind( "find ", 0 ) == 0 )
+            {
+                size_t                   in( lower.rfind( " in " ) );
+                std::optional< Pattern > pattern;
+                
+                if( in == std::string::npos || in < 5 )
+                {
+                    return {};
+                }
+                
+                pattern = Pattern::parse( trigger._description.substr( 5, in - 5 ) );
+                
+                if( pattern.has_value() == false || pattern->empty() || _range( std::string_view( lower ).substr( in + 4 ), trigger._begin, trigger._end ) == false )
+                {
+                    return {};
+                }
+                
+                if( trigger._end - trigger._begin > MaxPatternRange )
+                {
+                    return {};
+                }
+                
+                trigger._kind    = Kind::PatternInRange;
+                trigger._pattern = pattern.value();
+                
+                return trigger;
+            }
+            
+            for( size_t i = 0; i < lower.length(); )
+            {
+                size_t n( lower.find( ' ', i ) );
+                
+                if( n == std::string::npos )
+                {
+                    n = lower.length();
+                }
+                
+                if( n > i )
+                {
+                    tokens.push_back( lower.substr( i, n - i ) );
+                }
+                
+                i = n + 1;
+            }
+            
+            if( tokens.size() == 4 && tokens[ 1 ] == "at" && tokens[ 3 ] == "changed" )
+            {
+                if(      tokens[ 0 ] == "u8" )  { trigger._width = 1; }
+                else if( tokens[ 0 ] == "u16" ) { trigger._width = 2; }
+                else if( tokens[ 0 ] == "u32" ) { trigger._width = 4; }
+                else if( tokens[ 0 ] == "u64" ) { trigger._width = 8; }
+                else                            { return {}; }
+                
+                if( _number( tokens[ 2 ], trigger._begin ) == false || trigger._begin > UINT64_MAX - trigger._width )
+                {
+                    return {};
+                }
+                
+                trigger._kind = Kind::MemoryChanged;
+                trigger._end  = trigger._begin + trigger._width;
+                
+                return trigger;
+            }
+            
+            if( tokens.size() < 3 )
+            {
+                return {};
+            }
+            
+            {
+                std::optional< size_t > index( Registers::indexOf( tokens[ 0 ] ) );
+                
+                if( index.has_value() == false )
+                {
+                    return {};
+                }
+                
+                trigger._registerIndex = index.value();
+            }
+            
+            if( tokens[ 1 ] == "in" )
+            {
+                if( _range( std::string_view( lower ).substr( lower.find( " in " ) + 4 ), trigger._begin, trigger._end ) == false )
+                {
+                    return {};
+                }
+                
+                trigger._kind = Kind::RegisterInRange;
+                
+                return trigger;
+            }
+            
+            if( tokens.size() != 3 || _number( tokens[ 2 ], trigger._begin ) == false )
+            {
+                return {};
+            }
+            
+            if(      tokens[ 1 ] == "<" )  { trigger._kind = Kind::RegisterBelow; }
+            else if( tokens[ 1 ] == ">" )  { trigger._kind = Kind::RegisterAbove; }
+            else if( tokens[ 1 ] == "==" ) { trigger._kind = Kind::RegisterEquals; }
+            else                           { return {}; }
+            
+            return trigger;
+        }
+        
+        Trigger::Kind Trigger::kind( void ) const
+        {
+            return this->_kind;
+        }
+        
+        const std::string & Trigger::description( void ) const
+        {
+            return this->_description;
+        }
+        
+        size_t Trigger::registerIndex( void ) const
+        {
+            return this->_registerIndex;
+        }
+        
+        uint64_t Trigger::begin( void ) const
+        {
+            return this->_begin;
+        }
+        
+        uint64_t Trigger::end( void ) const
+        {
+            return this->_end;
+        }
+        
+        size_t Trigger::width( void ) const
+        {
+            return this->_width;
+        }
+        
+        const Pattern & Trigger::pattern( void ) const
+        {
+            return this->_pattern;
+        }
+        
+        void swap( Trigger & o1, Trigger & o2 )
+        {
+            using std::swap;
+            
+            swap( o1._kind,          o2._kind );
+            swap( o1._description,   o2._description );
+            swap( o1._registerIndex, o2._registerIndex );
+            swap( o1._begin,         o2._begin );
+            swap( o1._end,           o2._end );
+            swap( o1._width,         o2._width );
+            swap( o1._pattern,       o2._pattern );
+        }
+        
+        bool Trigger::_number( std::string_view s, uint64_t & value )
+        {
+            const char * first( s.data() );
+            const char * last(  s.data() + s.length() );
+            
+            if( s.length() > 2 && s[ 0 ] == '0' && s[ 1 ] == 'x' )
+            {
+                first += 2;
+            }
+            
+            if( first == last || last - first > 16 )
+            {
+                return false;
+            }
+            
+            return String::fromHex( first, last, value ) == last;
+        }
+        
+        bool Trigger::_range( std::string_view s, uint64_t & begin, uint64_t & end )
+        {
+            std::string compact;
+            size_t      separator;
+            
+            for( char c: s )
+            {
+                if( c != ' ' )
+                {
+                    compact += c;
+                }
+            }
+            
+            if( compact.length() > 2 && compact.front() == '[' && compact.back() == ')' )
+            {
+                compact   = compact.substr( 1, compact.length() - 2 );
+                separator = compact.find( ',' );
+                
+                if( separator == std::string::npos )
+                {
+                    return false;
+                }
+                
+                compact.replace( separator, 1, ".." );
+            }
+            
+            separator = compact.find( ".." );
+            
+            if( separator == std::string::npos )
+            {
+                return false;
+            }
+            
+            if( _number( std::string_view( compact ).substr( 0, separator ), begin ) == false || _number( std::string_view( compact ).substr( separator + 2 ), end ) == false )
+            {
+                return false;
+            }
+            
+            return begin < end;
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_TRIGGER_HPP
+#define VBOX_VM_TRIGGER_HPP
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include "VBox/VM/Pattern.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        class Trigger
+        {
+            public:
+                
+                enum class Kind
+                {
+                    RegisterInRange,
+                    RegisterBelow,
+                    RegisterAbove,
+                    RegisterEquals,
+                    MemoryChanged,
+                    PatternInRange
+                };
+                
+                Trigger( void );
+                Trigger( const Trigger & o );
+                Trigger( Trigger && o ) noexcept;
+                ~Trigger( void );
+                
+                Trigger & operator =( Trigger o );
+                
+                static std::optional< Trigger > parse( const std::string & spec );
+                
+                Kind                kind( void )          const;
+                const std::string & description( void )   const;
+                size_t              registerIndex( void ) const;
+                uint64_t            begin( void )         const;
+                uint64_t            end( void )           const;
+                size_t              width( void )         const;
+                const Pattern     & pattern( void )       const;
+                
+                friend void swap( Trigger & o1, Trigger & o2 );
+                
+            private:
+                
+                static bool _number( std::string_view s, uint64_t & value );
+                static bool _range( std::string_view s, uint64_t & begin, uint64_t & end );
+                
+                Kind        _kind;
+                std::string _description;
+                size_t      _registerIndex;
+                uint64_t    _begin;
+                uint64_t    _end;
+                size_t      _width;
+                Pattern     _pattern;
+        };
+    }
+}
+
+#endif /* VBOX_VM_TRIGGER_HPP */
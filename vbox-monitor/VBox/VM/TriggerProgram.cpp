@@ -0,0 +1,365 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/TriggerProgram.hpp"
+#include "VBox/VM/MemoryCache.hpp"
+#include "VBox/VM/CoreDump.hpp"
+#include "VBox/VM/MemoryView.hpp"
+#include "VBox/Stats.hpp"
+#include "VBox/Casts.hpp"
+#include <array>
+#include <cstring>
+
+namespace VBox
+{
+    namespace VM
+    {
+        class TriggerProgram::IMPL
+        {
+            public:
+                
+                class Op
+                {
+                    public:
+                        
+                        Trigger::Kind _kind;
+                        size_t        _register;
+                        uint64_t      _begin;
+                        uint64_t      _end;
+                        size_t        _memory;
+                        bool          _matched;
+                };
+                
+                class Memory
+                {
+                    public:
+                        
+                        MemoryView                               _image;
+                        std::vector< std::optional< uint64_t > > _generations;
+                        std::vector< bool >                      _hits;
+                        std::array< uint8_t, 8 >                 _value;
+                        bool                                     _hasValue;
+                };
+                
+                IMPL( const std::vector< Trigger > & triggers );
+                IMPL( const IMPL & o );
+                
+                bool _changed( const Op & op, Memory & memory, const std::shared_ptr< CoreDump > & dump );
+                bool _found( const Op & op, const Pattern & pattern, Memory & memory, const std::shared_ptr< CoreDump > & dump );
+                
+                static bool                                     _sameImage( const Memory & memory, const MemoryView & image );
+                static std::vector< std::optional< uint64_t > > _generations( const CoreDump & dump, uint64_t begin, uint64_t end );
+                
+                std::vector< Trigger > _triggers;
+                std::vector< Op >      _ops;
+                std::vector< Memory >  _memory;
+                uint64_t               _registersSequence;
+                uint64_t               _dumpSequence;
+        };
+        
+        TriggerProgram::TriggerProgram( void ):
+            impl( std::make_unique< IMPL >( std::vector< Trigger >() ) )
+        {}
+        
+        TriggerProgram::TriggerProgram( const std::vector< Trigger > & triggers ):
+            impl( std::make_unique< IMPL >( triggers ) )
+        {}
+        
+        TriggerProgram::TriggerProgram( const TriggerProgram & o ):
+            impl( std::make_unique< IMPL >( *( o.impl ) ) )
+        {}
+        
+        TriggerProgram::TriggerProgram( TriggerProgram && o ):
+            impl( std::move( o.impl ) )
+        {}
+        
+        TriggerProgram::~TriggerProgram( void )
+        {}
+        
+        TriggerProgram & TriggerProgram::operator =( TriggerProgram o )
+        {
+            swap( *( this ), o );
+            
+            return *( this );
+        }
+        
+        const std::vector< Trigger > & TriggerProgram::triggers( void ) const
+        {
+            return this->impl->_triggers;
+        }
+        
+        bool TriggerProgram::empty( void ) const
+        {
+            return this->impl->_ops.empty();
+        }
+        
+        std::optional< size_t > TriggerProgram::evaluate( const Snapshot & snapshot )
+        {
+            Stats::Timer                timer( "VM::TriggerProgram::evaluate" );
+            std::optional< size_t >     fired;
+            std::shared_ptr< CoreDump > dump( snapshot.dump() );
+            bool                        registers( snapshot.registersSequence() != this->impl->_registersSequence && snapshot.registers().has_value() );
+            bool                        memory( snapshot.dumpSequence() != this->impl->_dumpSequence && dump != nullptr );
+            
+            this->impl->_registersSequence = snapshot.registersSequence();
+            this->impl->_dumpSequence      = snapshot.dumpSequence();
+            
+            if( registers == false && memory == false )
+            {
+                return {};
+            }
+            
+            for( size_t i = 0; i < this->impl->_ops.size(); i++ )
+            {
+                IMPL::Op & op( this->impl->_ops[ i ] );
+                bool       match( false );
+                
+                switch( op._kind )
+                {
+                    case Trigger::Kind::RegisterInRange:
+                    case Trigger::Kind::RegisterBelow:
+                    case Trigger::Kind::RegisterAbove:
+                    case Trigger::Kind::RegisterEquals:
+                        
+                        if( registers == false )
+                        {
+                            continue;
+                        }
+                        
+                        {
+                            uint64_t value( snapshot.registers()->valueAt( op._register ) );
+                            
+                            if(      op._kind == Trigger::Kind::RegisterInRange ) { match = value >= op._begin && value < op._end; }
+                            else if( op._kind == Trigger::Kind::RegisterBelow )   { match = value < op._begin; }
+                            else if( op._kind == Trigger::Kind::RegisterAbove )   { match = value > op._begin; }
+                            else                                                  { match = value == op._begin; }
+                        }
+                        
+                        break;
+                        
+                    case Trigger::Kind::MemoryChanged:
+                        
+                        if( memory == false )
+                        {
+                            continue;
+                        }
+                        
+                        match = this->impl->_changed( op, this->impl->_memory[ op._memory ], dump );
+                        
+                        break;
+                        
+                    case Trigger::Kind::PatternInRange:
+                        
+                        if( memory == false )
+                        {
+                            continue;
+                        }
+                        
+                        match = this->impl->_found( op, this->impl->_triggers[ i ].pattern(), this->impl->_memory[ op._memory ], dump );
+                        
+                        break;
+                }
+                
+                if( match && op._matched == false && fired.has_value() == false )
+                {
+                    fired = i;
+                }
+                
+                op._matched = match;
+            }
+            
+            return fired;
+        }
+        
+        void TriggerProgram::reset( void )
+        {
+            this->impl = std::make_unique< IMPL >( this->impl->_triggers );
+        }
+        
+        void swap( TriggerProgram & o1, TriggerProgram & o2 )
+        {
+            using std::swap;
+            
+            swap( o1.impl, o2.impl );
+        }
+        
+        TriggerProgram::IMPL::IMPL( const std::vector< Trigger > & triggers ):
+            _triggers(          triggers ),
+            _registersSequence( 0 ),
+            _dumpSequence(      0 )
+        {
+            this->_ops.reserve( triggers.size() );
+            
+            for( const auto & trigger: triggers )
+            {
+                Op op { trigger.kind(), trigger.registerIndex(), trigger.begin(), trigger.end(), 0, false };
+                
+                if( trigger.kind() == Trigger::Kind::MemoryChanged || trigger.kind() == Trigger::Kind::PatternInRange )
+                {
+                    op._memory = this->_memory.size();
+                    
+                    this->_memory.push_back( { {}, {}, {}, {}, false } );
+                }
+                
+                this->_ops.push_back( op );
+            }
+        }
+        
+        TriggerProgram::IMPL::IMPL( const IMPL & o ):
+            _triggers(          o._triggers ),
+            _ops(               o._ops ),
+            _memory(            o._memory ),
+            _registersSequence( o._registersSequence ),
+            _dumpSequence(      o._dumpSequence )
+        {}
+        
+        bool TriggerProgram::IMPL::_changed( const Op & op, Memory & memory, const std::shared_ptr< CoreDump > & dump )
+        {
+            std::shared_ptr< MemoryCache >           cache( dump->cache() );
+            MemoryView                               image( dump->image() );
+            std::vector< std::optional< uint64_t > > generations( _generations( *( dump ), op._begin, op._end ) );
+            std::array< uint8_t, 8 >                 value {};
+            size_t                                   width( numeric_cast< size_t >( op._end - op._begin ) );
+            bool                                     changed;
+            
+            if( cache != nullptr )
+            {
+                cache->request( op._begin, width );
+            }
+            
+            if( _sameImage( memory, image ) && memory._generations == generations )
+            {
+                return false;
+            }
+            
+            if( dump->peekMemory( numeric_cast< size_t >( op._begin ), value.data(), width ) != width )
+            {
+                return false;
+            }
+            
+            changed             = memory._hasValue && memcmp( memory._value.data(), value.data(), width ) != 0;
+            memory._image       = image;
+            memory._generations = generations;
+            memory._value       = value;
+            memory._hasValue    = true;
+            
+            return changed;
+        }
+        
+        bool TriggerProgram::IMPL::_found( const Op & op, const Pattern & pattern, Memory & memory, const std::shared_ptr< CoreDump > & dump )
+        {
+            std::shared_ptr< MemoryCache >           cache( dump->cache() );
+            MemoryView                               image( dump->image() );
+            std::vector< std::optional< uint64_t > > generations( _generations( *( dump ), op._begin, op._end ) );
+            bool                                     same( _sameImage( memory, image ) && memory._hits.size() == generations.size() );
+            uint64_t                                 size( CoreDump::pageSize() );
+            uint64_t                                 first( op._begin / size );
+            const std::vector< uint8_t >           & bytes( pattern.bytes() );
+            std::vector< uint8_t >                   buffer;
+            
+            if( cache != nullptr )
+            {
+                cache->request( op._begin, numeric_cast< size_t >( op._end - op._begin ) );
+            }
+            
+            if( same == false )
+            {
+                memory._generations = std::vector< std::optional< uint64_t > >( generations.size() );
+                memory._hits        = std::vector< bool >( generations.size(), false );
+            }
+            
+            for( size_t i = 0; i < generations.size(); i++ )
+            {
+                bool dirty( same == false || memory._generations[ i ] != generations[ i ] );
+                
+                if( dirty == false && bytes.size() > 1 && i + 1 < generations.size() )
+                {
+                    dirty = memory._generations[ i + 1 ] != generations[ i + 1 ];
+                }
+                
+                if( dirty == false )
+                {
+                    continue;
+                }
+                
+                {
+                    Stats::Timer scan( "VM::TriggerProgram::scan" );
+                    uint64_t     start( std::max( op._begin, ( first + i ) * size ) );
+                    uint64_t     stop(  std::min( op._end,   ( first + i + 1 ) * size ) );
+                    uint64_t     limit( std::min( op._end,   stop + bytes.size() - 1 ) );
+                    
+                    buffer.resize( numeric_cast< size_t >( limit - start ) );
+                    
+                    memory._hits[ i ] = false;
+                    
+                    if( dump->peekMemory( numeric_cast< size_t >( start ), buffer.data(), buffer.size() ) != buffer.size() )
+                    {
+                        continue;
+                    }
+                    
+                    for( auto it = std::search( buffer.begin(), buffer.end(), bytes.begin(), bytes.end() ); it != buffer.end(); it = std::search( it + 1, buffer.end(), bytes.begin(), bytes.end() ) )
+                    {
+                        uint64_t address( start + numeric_cast< uint64_t >( it - buffer.begin() ) );
+                        
+                        if( address >= stop )
+                        {
+                            break;
+                        }
+                        
+                        if( address % pattern.alignment() == 0 )
+                        {
+                            memory._hits[ i ] = true;
+                            
+                            break;
+                        }
+                    }
+                }
+            }
+            
+            memory._image       = image;
+            memory._generations = generations;
+            
+            return std::find( memory._hits.begin(), memory._hits.end(), true ) != memory._hits.end();
+        }
+        
+        bool TriggerProgram::IMPL::_sameImage( const Memory & memory, const MemoryView & image )
+        {
+            return memory._image.empty() == false && memory._image.data() == image.data() && memory._image.size() == image.size();
+        }
+        
+        std::vector< std::optional< uint64_t > > TriggerProgram::IMPL::_generations( const CoreDump & dump, uint64_t begin, uint64_t end )
+        {
+            std::shared_ptr< MemoryCache >           cache( dump.cache() );
+            uint64_t                                 size( CoreDump::pageSize() );
+            std::vector< std::optional< uint64_t > > generations;
+            
+            for( uint64_t i = begin / size; i <= ( end - 1 ) / size; i++ )
+            {
+                generations.push_back( ( cache == nullptr ) ? std::optional< uint64_t >( 0 ) : cache->generation( i ) );
+            }
+            
+            return generations;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#ifndef VBOX_VM_TRIGGER_PROGRAM_HPP
+#define VBOX_VM_TRIGGER_PROGRAM_HPP
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "VBox/VM/Trigger.hpp"
+#include "VBox/VM/Snapshot.hpp"
+
+namespace VBox
+{
+    namespace VM
+    {
+        class TriggerProgram
+        {
+            public:
+                
+                TriggerProgram( void );
+                TriggerProgram( const std::vector< Trigger > & triggers );
+                TriggerProgram( const TriggerProgram & o );
+                TriggerProgram( TriggerProgram && o );
+                ~TriggerProgram( void );
+                
+                TriggerProgram & operator =( TriggerProgram o );
+                
+                const std::vector< Trigger > & triggers( void ) const;
+                bool                           empty( void )    const;
+                
+                std::optional< size_t > evaluate( const Snapshot & snapshot );
+                void                    reset( void );
+                
+                friend void swap( TriggerProgram & o1, TriggerProgram & o2 );
+                
+            private:
+                
+                class IMPL;
+                std::unique_ptr< IMPL > impl;
+        };
+    }
+}
+
+#endif /* VBOX_VM_TRIGGER_PROGRAM_HPP */
@@ -0,0 +1,209 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Jean-David Gadina - www.xs-labs.com
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "VBox/VM/Unwinder.hpp"
+#include <optional>
+#include <array>
+#include <cstring>
+
+namespace VBox
+{
+    namespace VM
+    {
+        namespace Unwinder
+        {
+            static const uint64_t MaxFrameSize = 0x100000;
+            static const size_t   ScanSize     = 0x1000;
+            static const uint64_t MinAddress   = 0x1000;
+            
+            static std::optional< uint64_t > read( const AddressSpace & space, uint64_t address, size_t width )
+            {
+                uint8_t  data[ sizeof( uint64_t ) ];
+                uint64_t value( 0 );
+                
+                if( space.readVirtual( address, data, width ) != width )
+                {
+                    return {};
+                }
+                
+                memcpy( &value, data, width );
+                
+                return value;
+            }
+            
+            static size_t callLength( uint8_t modrm, uint8_t sib )
+            {
+                uint8_t mod( modrm >> 6 );
+                uint8_t rm(  modrm & 7 );
+                size_t  length( 2 );
+                
+                if( mod != 3 && rm == 4 )
+                {
+                    length++;
+                }
+                
+                if( mod == 1 )
+                {
+                    length += 1;
+                }
+                else if( mod == 2 || ( mod == 0 && rm == 5 ) || ( mod == 0 && rm == 4 && ( sib & 7 ) == 5 ) )
+                {
+                    length += 4;
+                }
+                
+                return length;
+            }
+            
+            static bool returnAddress( const AddressSpace & space, uint64_t address )
+            {
+                std::array< uint8_t, 8 > code;
+                
+                if( address < MinAddress || space.readVirtual( address - 7, code.data(), code.size() ) != code.size() )
+                {
+                    return false;
+                }
+                
+                if( code[ 2 ] == 0xE8 )
+                {
+                    return true;
+                }
+                
+                for( size_t i = 0; i < 6; i++ )
+                {
+                    if( code[ i ] == 0xFF && ( ( code[ i + 1 ] >> 3 ) & 7 ) == 2 && callLength( code[ i + 1 ], code[ i + 2 ] ) == 7 - i )
+                    {
+                        return true;
+                    }
+                }
+                
+                return false;
+            }
+            
+            std::vector< StackEntry > unwind( const AddressSpace & space, const Registers & registers, size_t depth )
+            {
+                bool                      lma( ( registers.efer() & ( 1 << 10 ) ) != 0 );
+                size_t                    width( ( lma ) ? 8 : 4 );
+                uint64_t                  mask( ( lma ) ? ~uint64_t( 0 ) : 0xFFFFFFFF );
+                uint64_t                  stackBase( ( lma ) ? 0 : registers.base( Registers::Segment::SS ) );
+                uint64_t                  codeBase(  ( lma ) ? 0 : registers.base( Registers::Segment::CS ) );
+                uint32_t                  cs( static_cast< uint32_t >( registers.selector( Registers::Segment::CS ) ) );
+                uint32_t                  ss( static_cast< uint32_t >( registers.selector( Registers::Segment::SS ) ) );
+                uint64_t                  sp( registers.rsp() & mask );
+                uint64_t                  bp( registers.rbp() & mask );
+                uint64_t                  ip( registers.rip() & mask );
+                std::vector< StackEntry > frames;
+                
+                if( ( registers.cr0() & 1 ) == 0 || depth == 0 )
+                {
+                    return {};
+                }
+                
+                auto push = [ & ]( uint64_t frame, uint64_t savedBP, uint64_t retIP )
+                {
+                    StackEntry entry;
+                    uint64_t   args( stackBase + frame + width * 2 );
+                    
+                    entry.bp(    { ss, frame } );
+                    entry.retBP( { ss, savedBP } );
+                    entry.retIP( { cs, retIP } );
+                    entry.ip(    { cs, ip } );
+                    entry.arg0(  read( space, args,             width ).value_or( 0 ) );
+                    entry.arg1(  read( space, args + width,     width ).value_or( 0 ) );
+                    entry.arg2(  read( space, args + width * 2, width ).value_or( 0 ) );
+                    entry.arg3(  read( space, args + width * 3, width ).value_or( 0 ) );
+                    
+                    frames.push_back( entry );
+                };
+                
+                if( bp >= sp && bp - sp <= MaxFrameSize )
+                {
+                    while( frames.size() < depth )
+                    {
+                        std::optional< uint64_t > savedBP( read( space, stackBase + bp,         width ) );
+                        std::optional< uint64_t > retIP(   read( space, stackBase + bp + width, width ) );
+                        bool                      valid;
+                        
+                        if( savedBP.has_value() == false || retIP.has_value() == false )
+                        {
+                            break;
+                        }
+                        
+                        valid = returnAddress( space, codeBase + retIP.value() );
+                        
+                        if( valid == false && frames.empty() )
+                        {
+                            break;
+                        }
+                        
+                        push( bp, savedBP.value(), retIP.value() );
+                        
+                        if( valid == false || savedBP.value() <= bp || savedBP.value() - bp > MaxFrameSize )
+                        {
+                            break;
+                        }
+                        
+                        ip = retIP.value();
+                        bp = savedBP.value();
+                    }
+                    
+                    if( frames.empty() == false )
+                    {
+                        return frames;
+                    }
+                }
+                
+                {
+                    std::vector< uint8_t > stack( space.readVirtual( stackBase + sp, ScanSize ) );
+                    
+                    for( size_t offset = 0; offset + width <= stack.size() && frames.size() < depth; offset += width )
+                    {
+                        uint64_t value( 0 );
+                        uint64_t saved( 0 );
+                        uint64_t frame( sp + offset );
+                        
+                        memcpy( &value, stack.data() + offset, width );
+                        
+                        if( returnAddress( space, codeBase + value ) == false )
+                        {
+                            continue;
+                        }
+                        
+                        if( offset >= width )
+                        {
+                            memcpy( &saved, stack.data() + offset - width, width );
+                            
+                            frame -= width;
+                        }
+                        
+                        push( frame, saved, value );
+                        
+                        ip = value;
+                    }
+                }
+                
+                return frames;
+            }
+        }
+    }
+}
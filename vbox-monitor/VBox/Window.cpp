@@ -71,6 +71,16 @@ namespace VBox
         ::wrefresh( this->impl->_win );
     }
     
+    void Window::stage( void )
+    {
+        ::wnoutrefresh( this->impl->_win );
+    }
+    
+    void Window::erase( void )
+    {
+        ::werase( this->impl->_win );
+    }
+    
     void Window::move( size_t x, size_t y )
     {
         ::wmove( this->impl->_win, numeric_cast< int >( y ), numeric_cast< int >( x ) );
@@ -126,6 +136,26 @@ namespace VBox
         va_end( ap );
     }
     
+    void Window::write( const char * s, size_t length )
+    {
+        ::waddnstr( this->impl->_win, s, numeric_cast< int >( length ) );
+    }
+    
+    void Window::write( const Color & color, const char * s, size_t length )
+    {
+        if( Screen::shared().supportsColors() )
+        {
+            ::wattrset( this->impl->_win, COLOR_PAIR( color.index() ) );
+        }
+        
+        ::waddnstr( this->impl->_win, s, numeric_cast< int >( length ) );
+        
+        if( Screen::shared().supportsColors() )
+        {
+            ::wattrset( this->impl->_win, COLOR_PAIR( Color::clear().index() ) );
+        }
+    }
+    
     void Window::box( void )
     {
         ::box( this->impl->_win, 0, 0 );
@@ -45,11 +45,15 @@ namespace VBox
             Window & operator =( Window o );
             
             void refresh( void );
+            void stage( void );
+            void erase( void );
             void move( size_t x, size_t y );
             void print( const std::string & s );
             void print( const char * format, ... );
             void print( const Color & color, const std::string & s );
             void print( const Color & color, const char * format, ... );
+            void write( const char * s, size_t length );
+            void write( const Color & color, const char * s, size_t length );
             void box( void );
             void addHorizontalLine( size_t width );
             void addVerticalLine( size_t height );
@@ -24,77 +24,425 @@
 
 #include "VBox/Arguments.hpp"
 #include "VBox/UI.hpp"
+#include "VBox/Fleet.hpp"
+#include "VBox/Exporter.hpp"
 #include "VBox/Manage.hpp"
+#include "VBox/Manage/ConsoleBackend.hpp"
+#include "VBox/Manage/ReplayBackend.hpp"
+#include "VBox/Manage/RemoteBackend.hpp"
+#include "VBox/Remote/Agent.hpp"
+#include "VBox/Remote/Protocol.hpp"
+#include "VBox/Stats.hpp"
+#include "VBox/SignalHandler.hpp"
+#include "VBox/VM/Trigger.hpp"
 #include <iostream>
+#include <fstream>
 #include <cstdlib>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <optional>
 
-void ShowHelp( void );
+void        ShowHelp( void );
+void        WriteStats( const VBox::Arguments & args );
+void        ShutdownVMs( const std::vector< std::string > & vmNames );
+int         RunHeadless( VBox::Fleet & fleet, const VBox::Arguments & args, const std::vector< VBox::VM::Trigger > & triggers );
+int         RunAgent( const VBox::Arguments & args, const std::vector< std::shared_ptr< VBox::Manage::Backend > > & backends );
+std::string Token( const VBox::Arguments & args );
 
 int main( int argc, const char * argv[] )
 {
-    VBox::Arguments args( argc, argv );
+    VBox::Arguments                  args( argc, argv );
+    std::vector< VBox::VM::Trigger > triggers;
     
-    if( args.showHelp() || args.vmName().length() == 0 || args.vmPath().length() == 0 )
+    if
+    (
+           args.showHelp()
+        || ( args.replay() && args.tracePaths().empty() )
+        || ( args.replay() == false && args.remoteHost().has_value() && args.remoteVMs().empty() )
+        || ( args.replay() == false && args.remoteHost().has_value() == false && args.agentPort().has_value() == false && ( args.vmNames().empty() || args.vmNames().size() != args.vmPaths().size() ) )
+    )
     {
         ShowHelp();
         
         return EXIT_SUCCESS;
     }
     
-    VBox::Manage::unregisterVM( args.vmName() );
-    
-    if( VBox::Manage::registerVM( args.vmPath() ) == false )
+    for( const auto & spec: args.triggers() )
     {
-        std::cerr << "Cannot register virtual machine: " << args.vmPath() << std::endl;
+        std::optional< VBox::VM::Trigger > trigger( VBox::VM::Trigger::parse( spec ) );
         
-        return EXIT_FAILURE;
+        if( trigger.has_value() == false )
+        {
+            std::cerr << "Invalid trigger: " << spec << std::endl;
+            
+            return EXIT_FAILURE;
+        }
+        
+        triggers.push_back( trigger.value() );
     }
     
-    if( VBox::Manage::startVM( args.vmName() ) == false )
+    if( ( args.agentPort().has_value() || ( args.remoteHost().has_value() && args.replay() == false ) ) && Token( args ).empty() )
     {
-        std::cerr << "Cannot start virtual machine: " << args.vmPath() << std::endl;
+        std::cerr << "A shared token is required: use --token SECRET or set " << VBox::Remote::Protocol::TokenVariable << std::endl;
         
         return EXIT_FAILURE;
     }
     
-    std::cout << "Wating for virtual machine to start..." << std::endl;
+    if( args.agentPort().has_value() && args.replay() == false )
+    {
+        return RunAgent( args, {} );
+    }
+    
+    if( args.replay() || args.remoteHost().has_value() )
+    {
+        std::vector< std::shared_ptr< VBox::Manage::Backend > > backends;
+        
+        for( const auto & vmName: ( args.replay() ) ? std::vector< std::string >() : args.remoteVMs() )
+        {
+            backends.push_back( std::make_shared< VBox::Manage::RemoteBackend >( args.remoteHost().value(), args.remotePort().value_or( VBox::Remote::Protocol::DefaultPort ), vmName, Token( args ) ) );
+        }
+        
+        for( const auto & path: ( args.replay() ) ? args.tracePaths() : std::vector< std::string >() )
+        {
+            try
+            {
+                backends.push_back( std::make_shared< VBox::Manage::ReplayBackend >( path ) );
+            }
+            catch( const std::runtime_error & e )
+            {
+                std::cerr << "Cannot open trace file: " << path << " (" << e.what() << ")" << std::endl;
+                
+                return EXIT_FAILURE;
+            }
+        }
+        
+        int status( EXIT_SUCCESS );
+        
+        if( args.agentPort().has_value() )
+        {
+            status = RunAgent( args, backends );
+        }
+        else if( args.headless() )
+        {
+            VBox::Fleet fleet( backends );
+            
+            status = RunHeadless( fleet, args, triggers );
+        }
+        else
+        {
+            VBox::UI ui( backends );
+            
+            if( args.historyCapacity().has_value() )
+            {
+                ui.historyCapacity( args.historyCapacity().value() );
+            }
+            
+            ui.triggers( triggers );
+            
+            ui.run();
+        }
+        
+        WriteStats( args );
+        
+        return status;
+    }
     
     {
-        bool running( false );
+        int                 status( EXIT_SUCCESS );
+        std::ostream      & log( ( args.headless() ) ? std::cerr : std::cout );
+        VBox::SignalHandler signals;
+        VBox::Deadline      deadline;
+        bool                running( false );
+        
+        std::vector< std::string > vmNames( args.vmNames() );
+        std::vector< std::string > vmPaths( args.vmPaths() );
+        
+        for( size_t i = 0; i < vmNames.size(); i++ )
+        {
+            std::optional< uint16_t > port;
+            
+            if( signals.interrupted() )
+            {
+                ShutdownVMs( { vmNames.begin(), vmNames.begin() + static_cast< std::ptrdiff_t >( i ) } );
+                
+                return EXIT_FAILURE;
+            }
+            
+            VBox::Manage::unregisterVM( vmNames[ i ] );
+            
+            if( VBox::Manage::registerVM( vmPaths[ i ] ) == false )
+            {
+                std::cerr << "Cannot register virtual machine: " << vmPaths[ i ] << std::endl;
+                
+                ShutdownVMs( { vmNames.begin(), vmNames.begin() + static_cast< std::ptrdiff_t >( i ) } );
+                
+                return EXIT_FAILURE;
+            }
+            
+            port = VBox::Manage::ConsoleBackend::availablePort();
+            
+            if( port.has_value() == false || VBox::Manage::ConsoleBackend::enable( vmNames[ i ], port.value() ) == false )
+            {
+                std::cerr << "Cannot enable the debugger console, falling back to VBoxManage: " << vmPaths[ i ] << std::endl;
+            }
+            
+            if( VBox::Manage::startVM( vmNames[ i ] ) == false )
+            {
+                std::cerr << "Cannot start virtual machine: " << vmPaths[ i ] << std::endl;
+                
+                ShutdownVMs( { vmNames.begin(), vmNames.begin() + static_cast< std::ptrdiff_t >( i + 1 ) } );
+                
+                return EXIT_FAILURE;
+            }
+        }
         
-        while( running == false )
+        log << "Wating for virtual machines to start..." << std::endl;
+        
+        deadline = VBox::Deadline::after( std::chrono::seconds( 60 ) );
+        
+        while( running == false && signals.interrupted() == false && deadline.expired() == false )
+        {
+            running = VBox::Manage::waitUntilRunning( vmNames, VBox::Deadline( std::min( deadline.time(), std::chrono::steady_clock::now() + std::chrono::seconds( 1 ) ) ) );
+        }
+        
+        if( running == false )
+        {
+            if( signals.interrupted() == false )
+            {
+                std::cerr << "Timed out waiting for virtual machines to start" << std::endl;
+            }
+            
+            ShutdownVMs( vmNames );
+            
+            return EXIT_FAILURE;
+        }
+        
+        if( args.headless() )
+        {
+            VBox::Fleet fleet( vmNames );
+            
+            status = RunHeadless( fleet, args, triggers );
+        }
+        else
         {
-            for( const auto & vm: VBox::Manage::runningVMs() )
+            VBox::UI ui( vmNames );
+            
+            if( args.historyCapacity().has_value() )
+            {
+                ui.historyCapacity( args.historyCapacity().value() );
+            }
+            
+            ui.triggers( triggers );
+            
+            if( args.recordDirectory().has_value() )
             {
-                if( vm.name() == args.vmName() )
+                try
                 {
-                    running = true;
+                    ui.record( args.recordDirectory().value() );
+                }
+                catch( const std::runtime_error & e )
+                {
+                    std::cerr << e.what() << std::endl;
                     
-                    break;
+                    status = EXIT_FAILURE;
                 }
             }
+            
+            if( status == EXIT_SUCCESS )
+            {
+                ui.run();
+            }
         }
+        
+        ShutdownVMs( vmNames );
+        
+        log << "Virtual machines have powered-off." << std::endl;
+        
+        WriteStats( args );
+        
+        return status;
+    }
+}
+
+void WriteStats( const VBox::Arguments & args )
+{
+    if( args.statsPath().has_value() == false )
+    {
+        return;
     }
     
-    VBox::UI( args.vmName() ).run();
-    VBox::Manage::powerOffVM( args.vmName() );
-    VBox::Manage::unregisterVM( args.vmName() );
+    {
+        std::ofstream out( args.statsPath().value() );
+        
+        if( out.good() == false )
+        {
+            std::cerr << "Cannot write statistics: " << args.statsPath().value() << std::endl;
+            
+            return;
+        }
+        
+        out << VBox::Stats::shared().json();
+    }
+}
+
+void ShutdownVMs( const std::vector< std::string > & vmNames )
+{
+    for( const auto & vmName: vmNames )
+    {
+        VBox::Manage::powerOffVM( vmName );
+        VBox::Manage::ConsoleBackend::restore( vmName );
+        VBox::Manage::unregisterVM( vmName );
+    }
+}
+
+int RunHeadless( VBox::Fleet & fleet, const VBox::Arguments & args, const std::vector< VBox::VM::Trigger > & triggers )
+{
+    try
+    {
+        VBox::Exporter exporter( fleet, args.socketPath() );
+        
+        if( args.historyCapacity().has_value() )
+        {
+            fleet.historyCapacity( args.historyCapacity().value() );
+        }
+        
+        fleet.triggers( triggers );
+        
+        if( args.rate().has_value() )
+        {
+            exporter.rate( args.rate().value() );
+        }
+        
+        if( args.batch().has_value() )
+        {
+            exporter.batch( args.batch().value() );
+        }
+        
+        if( args.replay() == false && args.recordDirectory().has_value() )
+        {
+            fleet.record( args.recordDirectory().value() );
+        }
+        
+        exporter.run();
+    }
+    catch( const std::runtime_error & e )
+    {
+        std::cerr << e.what() << std::endl;
+        
+        return EXIT_FAILURE;
+    }
     
-    std::cout << "Virtual machine has powered-off." << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int RunAgent( const VBox::Arguments & args, const std::vector< std::shared_ptr< VBox::Manage::Backend > > & backends )
+{
+    try
+    {
+        std::unique_ptr< VBox::Remote::Agent > agent;
+        std::string                            address( args.agentAddress().value_or( VBox::Remote::Protocol::DefaultAddress ) );
+        
+        if( backends.empty() )
+        {
+            agent = std::make_unique< VBox::Remote::Agent >( args.agentPort().value(), address, Token( args ) );
+        }
+        else
+        {
+            agent = std::make_unique< VBox::Remote::Agent >( args.agentPort().value(), address, Token( args ), backends );
+        }
+        
+        std::cerr << "Listening on " << agent->address() << " port " << agent->port() << std::endl;
+        
+        agent->run();
+    }
+    catch( const std::runtime_error & e )
+    {
+        std::cerr << e.what() << std::endl;
+        
+        return EXIT_FAILURE;
+    }
     
     return EXIT_SUCCESS;
 }
 
+std::string Token( const VBox::Arguments & args )
+{
+    const char * token( getenv( VBox::Remote::Protocol::TokenVariable ) );
+    
+    if( args.token().has_value() )
+    {
+        return args.token().value();
+    }
+    
+    return ( token == nullptr ) ? "" : token;
+}
+
 void ShowHelp( void )
 {
-    std::cout << "Usage: vbox-monitor VM_NAME VM_PATH"
+    std::cout << "Usage: vbox-monitor [--history SAMPLES] [--record DIRECTORY] [--stats FILE] [--trigger SPEC] [HEADLESS] VM_NAME VM_PATH [VM_NAME VM_PATH ...]"
+              << std::endl
+              << "       vbox-monitor [--history SAMPLES] [--stats FILE] [--trigger SPEC] [HEADLESS] --replay TRACE [TRACE ...]"
+              << std::endl
+              << "       vbox-monitor [--history SAMPLES] [--stats FILE] [--trigger SPEC] [HEADLESS] [--token SECRET] --remote HOST[:PORT] VM_NAME [VM_NAME ...]"
+              << std::endl
+              << "       vbox-monitor [--stats FILE] [--bind ADDRESS] [--token SECRET] --agent PORT [--replay TRACE [TRACE ...]]"
+              << std::endl
+              << std::endl
+              << "Headless: --headless [--socket PATH] [--rate HZ] [--batch SAMPLES]"
+              << std::endl
+              << std::endl
+              << "Options:"
+              << std::endl
+              << "    --history SAMPLES:  Register/stack samples kept per VM (default: 10000)"
+              << std::endl
+              << "    --record DIRECTORY: Record a trace of each VM to DIRECTORY/VM_NAME.vbtrace"
+              << std::endl
+              << "    --stats FILE:       Write timing statistics to FILE as JSON on exit"
+              << std::endl
+              << "    --replay:           Replay recorded trace files instead of running VMs"
+              << std::endl
+              << "    --remote HOST:PORT: Monitor VMs through the agent running on HOST (default port: 5100)"
+              << std::endl
+              << "    --agent PORT:       Serve the VMs running on this host to remote monitors on PORT"
+              << std::endl
+              << "    --bind ADDRESS:     Address the agent listens on (default: 127.0.0.1)"
+              << std::endl
+              << "    --token SECRET:     Shared secret the agent and remote monitors prove to each other (default: $VBOX_MONITOR_TOKEN)"
+              << std::endl
+              << "    --trigger SPEC:     Pause and focus a VM when SPEC matches (repeatable):"
+              << std::endl
+              << "                          REG in A..B, REG < N, REG > N, REG == N,"
+              << std::endl
+              << "                          u8/u16/u32/u64 at ADDR changed, find PATTERN in A..B"
+              << std::endl
+              << "    --headless:         Stream samples as newline-delimited JSON instead of running the UI"
+              << std::endl
+              << "    --socket PATH:      Send headless output to the Unix socket at PATH (default: stdout)"
+              << std::endl
+              << "    --rate HZ:          Headless export rate (default: 10)"
+              << std::endl
+              << "    --batch SAMPLES:    Samples buffered before each headless write (default: 1)"
               << std::endl
               << std::endl
               << "Shortcuts:"
               << std::endl
               << "    - p: Pause/Resume"
               << std::endl
-              << "    - m: Enter a memory address"
+              << "    - <: Step back one sample in history (pauses)"
+              << std::endl
+              << "    - >: Step forward one sample in history"
+              << std::endl
+              << "    - {: Step back 100 samples in history"
+              << std::endl
+              << "    - }: Step forward 100 samples in history"
+              << std::endl
+              << "    - (: Seek back 10 seconds (replay only)"
+              << std::endl
+              << "    - ): Seek forward 10 seconds (replay only)"
+              << std::endl
+              << "    - m: Enter a memory address or symbol"
               << std::endl
               << "    - a: Scroll memory up (one line)"
               << std::endl
@@ -105,5 +453,41 @@ void ShowHelp( void )
               << "    - f: Scroll memory down (one page)"
               << std::endl
               << "    - g: Scroll memory top top"
+              << std::endl
+              << "    - n: Jump memory to the next symbol"
+              << std::endl
+              << "    - b: Jump memory to the previous symbol"
+              << std::endl
+              << "    - /: Search memory (hex bytes, \"ASCII\", u\"UTF-16\", d:DWORD or q:QWORD)"
+              << std::endl
+              << "    - .: Jump memory to the next search hit"
+              << std::endl
+              << "    - ,: Jump memory to the previous search hit"
+              << std::endl
+              << "    - v: Show/Hide changed bytes since the previous memory generation"
+              << std::endl
+              << "    - j: Jump memory to the next changed page"
+              << std::endl
+              << "    - k: Jump memory to the previous changed page"
+              << std::endl
+              << "    - e: Jump memory to the next overview region"
+              << std::endl
+              << "    - w: Jump memory to the previous overview region"
+              << std::endl
+              << "    - r: Jump memory to the next region containing data"
+              << std::endl
+              << "    - ]: Switch to the next virtual machine"
+              << std::endl
+              << "    - [: Switch to the previous virtual machine"
+              << std::endl
+              << "    - 1-9: Switch to a virtual machine by number"
+              << std::endl
+              << "    - c: Switch to the next vCPU"
+              << std::endl
+              << "    - x: Switch to the previous vCPU"
+              << std::endl
+              << "    - i: Show/Hide the instrumentation overlay"
+              << std::endl
+              << "    - Ctrl-L: Redraw all panels"
               << std::endl;
 }